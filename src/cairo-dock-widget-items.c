@@ -199,6 +199,7 @@ static gboolean _on_select_one_item_in_tree (G_GNUC_UNUSED GtkTreeSelection * se
 		// load custom widgets
 		if (pInstance->pModule->pInterface->load_custom_widget != NULL)
 		{
+			gldi_module_instance_init_deferred (pInstance);  // the applet may need its config/data to build its widgets.
 			pInstance->pModule->pInterface->load_custom_widget (pInstance, pKeyFile, pWidgetList);
 		}
 		
@@ -85,7 +85,7 @@ static void _module_widget_apply (CDWidget *pCdWidget)
 	g_return_if_fail (pKeyFile != NULL);
 
 	cairo_dock_update_keyfile_from_widget_list (pKeyFile, pCdWidget->pWidgetList);
-	if (pModule->pInterface->save_custom_widget != NULL)
+	if (gldi_module_has_custom_widgets (pModule) && gldi_module_load_interface (pModule) && pModule->pInterface->save_custom_widget != NULL)
 		pModule->pInterface->save_custom_widget (pModuleWidget->pModuleInstance, pKeyFile, pCdWidget->pWidgetList);  // the instance can be NULL
 	cairo_dock_write_keys_to_conf_file (pKeyFile, pModuleWidget->cConfFilePath);
 	g_key_file_free (pKeyFile);
@@ -122,21 +122,35 @@ static void _build_module_widget (ModuleWidget *pModuleWidget)
 	GKeyFile* pKeyFile = cairo_dock_open_key_file (pModuleWidget->cConfFilePath);
 	g_return_if_fail (pKeyFile != NULL);
 	
-	GSList *pWidgetList = NULL;
 	GPtrArray *pDataGarbage = g_ptr_array_new ();
 	gchar *cOriginalConfFilePath = g_strdup_printf ("%s/%s", pModuleWidget->pModule->pVisitCard->cShareDataDir, pModuleWidget->pModule->pVisitCard->cConfFileName);
-	pModuleWidget->widget.pWidget = cairo_dock_build_key_file_widget (pKeyFile,
-		pModuleWidget->pModule->pVisitCard->cGettextDomain,
-		pModuleWidget->pMainWindow,
-		&pWidgetList,
-		pDataGarbage,
-		cOriginalConfFilePath);  // cOriginalConfFilePath is taken by the function
-	pModuleWidget->widget.pWidgetList = pWidgetList;
+	gboolean bCustomWidgets = (gldi_module_has_custom_widgets (pModuleWidget->pModule)
+		&& gldi_module_load_interface (pModuleWidget->pModule));  // the module may be inactive, with its library not opened yet; only open it if we need its interface.
+	pModuleWidget->widget.pWidgetList = NULL;
 	pModuleWidget->widget.pDataGarbage = pDataGarbage;
+	if (bCustomWidgets)  // the applet will look for its widgets right after, so build all the pages now.
+	{
+		pModuleWidget->widget.pWidget = cairo_dock_build_key_file_widget (pKeyFile,
+			pModuleWidget->pModule->pVisitCard->cGettextDomain,
+			pModuleWidget->pMainWindow,
+			&pModuleWidget->widget.pWidgetList,
+			pDataGarbage,
+			cOriginalConfFilePath);  // cOriginalConfFilePath is taken by the function
+	}
+	else  // only build the first page, the other ones will be built when the user looks at them (the widgets list belongs to us and lives as long as the notebook).
+	{
+		pModuleWidget->widget.pWidget = cairo_dock_build_key_file_widget_lazy (pKeyFile,
+			pModuleWidget->pModule->pVisitCard->cGettextDomain,
+			pModuleWidget->pMainWindow,
+			&pModuleWidget->widget.pWidgetList,
+			pDataGarbage,
+			cOriginalConfFilePath);  // cOriginalConfFilePath is taken by the function
+	}
 	
-	if (pModuleWidget->pModule->pInterface->load_custom_widget != NULL)
+	if (bCustomWidgets && pModuleWidget->pModule->pInterface->load_custom_widget != NULL)
 	{
-		pModuleWidget->pModule->pInterface->load_custom_widget (pModuleWidget->pModuleInstance, pKeyFile, pWidgetList);
+		gldi_module_instance_init_deferred (pModuleWidget->pModuleInstance);  // the applet may need its config/data to build its widgets (does nothing if there is no instance).
+		pModuleWidget->pModule->pInterface->load_custom_widget (pModuleWidget->pModuleInstance, pKeyFile, pModuleWidget->widget.pWidgetList);
 	}
 	
 	g_key_file_free (pKeyFile);
@@ -184,17 +184,36 @@ static void _cairo_dock_render_category (G_GNUC_UNUSED GtkTreeViewColumn *tree_c
 	}
 }
 
+static void _cairo_dock_render_module_icon (G_GNUC_UNUSED GtkTreeViewColumn *tree_column, GtkCellRenderer *cell, GtkTreeModel *model,GtkTreeIter *iter, G_GNUC_UNUSED gpointer data)
+{
+	GdkPixbuf *pixbuf = NULL;
+	gtk_tree_model_get (model, iter, CAIRO_DOCK_MODEL_ICON, &pixbuf, -1);
+	if (pixbuf == NULL)  // 1st time this line is displayed, load its icon now (only the visible lines are rendered, so we don't load the icons of all the plug-ins).
+	{
+		gchar *cModuleName = NULL;
+		gtk_tree_model_get (model, iter, CAIRO_DOCK_MODEL_RESULT, &cModuleName, -1);
+		GldiModule *pModule = gldi_module_get (cModuleName);
+		g_free (cModuleName);
+		if (pModule != NULL)
+		{
+			int iSize = cairo_dock_search_icon_size (GTK_ICON_SIZE_LARGE_TOOLBAR);
+			gchar *cIcon = cairo_dock_search_icon_s_path (pModule->pVisitCard->cIconFilePath, iSize);
+			pixbuf = gdk_pixbuf_new_from_file_at_size (cIcon, iSize, iSize, NULL);
+			g_free (cIcon);
+			if (pixbuf != NULL)
+				gtk_list_store_set (GTK_LIST_STORE (model), iter, CAIRO_DOCK_MODEL_ICON, pixbuf, -1);
+		}
+	}
+	g_object_set (cell, "pixbuf", pixbuf, NULL);
+	if (pixbuf != NULL)
+		g_object_unref (pixbuf);
+}
+
 static gboolean _cairo_dock_add_module_to_modele (gchar *cModuleName, GldiModule *pModule, GtkListStore *pModel)
 {
 	if (pModule->pVisitCard->iCategory != CAIRO_DOCK_CATEGORY_THEME  // don't display the animations plug-ins
 		&& ! gldi_module_is_auto_loaded (pModule))  // don't display modules that can't be disabled
 	{
-		//g_print (" + %s\n",  pModule->pVisitCard->cIconFilePath);
-		int iSize = cairo_dock_search_icon_size (GTK_ICON_SIZE_LARGE_TOOLBAR);
-		gchar *cIcon = cairo_dock_search_icon_s_path (pModule->pVisitCard->cIconFilePath, iSize);
-		GdkPixbuf *pixbuf = gdk_pixbuf_new_from_file_at_size (cIcon, iSize, iSize, NULL);
-		g_free (cIcon);
-
 		GtkTreeIter iter;
 		memset (&iter, 0, sizeof (GtkTreeIter));
 		gtk_list_store_append (GTK_LIST_STORE (pModel), &iter);
@@ -203,10 +222,8 @@ static gboolean _cairo_dock_add_module_to_modele (gchar *cModuleName, GldiModule
 			CAIRO_DOCK_MODEL_RESULT, cModuleName,
 			CAIRO_DOCK_MODEL_DESCRIPTION_FILE, dgettext (pModule->pVisitCard->cGettextDomain, pModule->pVisitCard->cDescription),
 			CAIRO_DOCK_MODEL_IMAGE, pModule->pVisitCard->cPreviewFilePath,
-			CAIRO_DOCK_MODEL_ICON, pixbuf,
 			CAIRO_DOCK_MODEL_STATE, pModule->pVisitCard->iCategory,
-			CAIRO_DOCK_MODEL_ACTIVE, (pModule->pInstancesList != NULL), -1);
-		g_object_unref (pixbuf);
+			CAIRO_DOCK_MODEL_ACTIVE, (pModule->pInstancesList != NULL), -1);  // the icon is loaded when the line is displayed.
 	}
 	return FALSE;
 }
@@ -229,30 +246,50 @@ static GtkWidget *_cairo_dock_build_modules_treeview (void)
 	gldi_module_foreach ((GHRFunc) _cairo_dock_add_module_to_modele, pModel);
 	
 	//\______________ On definit l'affichage du modele dans le tree-view.
+	// toutes les colonnes ont une largeur fixe, pour que seules les lignes visibles soient mesurees et rendues.
 	GtkTreeViewColumn* col;
 	GtkCellRenderer *rend;
+	int iSize = cairo_dock_search_icon_size (GTK_ICON_SIZE_LARGE_TOOLBAR);
 	// case a cocher
 	rend = gtk_cell_renderer_toggle_new ();
 	col = gtk_tree_view_column_new_with_attributes (NULL, rend, "active", CAIRO_DOCK_MODEL_ACTIVE, NULL);
 	gtk_tree_view_column_set_sort_column_id (col, CAIRO_DOCK_MODEL_ACTIVE);
+	cairo_dock_gui_set_column_fixed_width (pOneWidget, col, 16, NULL);
 	gtk_tree_view_append_column (GTK_TREE_VIEW (pOneWidget), col);
 	g_signal_connect (G_OBJECT (rend), "toggled", (GCallback) _cairo_dock_activate_one_module, pModel);
 	// icone
 	rend = gtk_cell_renderer_pixbuf_new ();
-	gtk_tree_view_insert_column_with_attributes (GTK_TREE_VIEW (pOneWidget), -1, NULL, rend, "pixbuf", CAIRO_DOCK_MODEL_ICON, NULL);
+	gtk_cell_renderer_set_fixed_size (rend, iSize, iSize);  // all the lines have the same height, even before their icon is loaded.
+	col = gtk_tree_view_column_new ();
+	gtk_tree_view_column_pack_start (col, rend, FALSE);
+	gtk_tree_view_column_set_cell_data_func (col, rend, (GtkTreeCellDataFunc)_cairo_dock_render_module_icon, NULL, NULL);
+	cairo_dock_gui_set_column_fixed_width (pOneWidget, col, iSize, NULL);
+	gtk_tree_view_append_column (GTK_TREE_VIEW (pOneWidget), col);
 	// nom
 	rend = gtk_cell_renderer_text_new ();
 	col = gtk_tree_view_column_new_with_attributes (_("Plug-in"), rend, "text", CAIRO_DOCK_MODEL_NAME, NULL);
 	gtk_tree_view_column_set_cell_data_func (col, rend, (GtkTreeCellDataFunc)_cairo_dock_render_module_name, NULL, NULL);
 	gtk_tree_view_column_set_sort_column_id (col, CAIRO_DOCK_MODEL_NAME);
+	cairo_dock_gui_set_column_fixed_width (pOneWidget, col, 200, NULL);
+	gtk_tree_view_column_set_expand (col, TRUE);
 	gtk_tree_view_append_column (GTK_TREE_VIEW (pOneWidget), col);
 	// categorie
 	rend = gtk_cell_renderer_text_new ();
 	col = gtk_tree_view_column_new_with_attributes (_("Category"), rend, "text", CAIRO_DOCK_MODEL_STATE, NULL);
 	gtk_tree_view_column_set_cell_data_func (col, rend, (GtkTreeCellDataFunc)_cairo_dock_render_category, NULL, NULL);
 	gtk_tree_view_column_set_sort_column_id (col, CAIRO_DOCK_MODEL_STATE);
+	const gchar *cCategories[] = {_("Files"), _("Internet"), _("Desktop"), _("Accessory"), _("System"), _("Fun"), _("Behaviour"), NULL};
+	const gchar *cLongestCategory = cCategories[0];
+	int i;
+	for (i = 1; cCategories[i] != NULL; i ++)
+	{
+		if (g_utf8_strlen (cCategories[i], -1) > g_utf8_strlen (cLongestCategory, -1))
+			cLongestCategory = cCategories[i];
+	}
+	cairo_dock_gui_set_column_fixed_width (pOneWidget, col, 0, cLongestCategory);
 	gtk_tree_view_append_column (GTK_TREE_VIEW (pOneWidget), col);
 	
+	gtk_tree_view_set_fixed_height_mode (GTK_TREE_VIEW (pOneWidget), TRUE);
 	return pOneWidget;
 }
 
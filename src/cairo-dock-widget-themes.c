@@ -507,13 +507,24 @@ static void _make_tree_view_for_themes (ThemesWidget *pThemesWidget, GPtrArray *
 	GtkTreeModel *pModel = gtk_tree_view_get_model (GTK_TREE_VIEW (pOneWidget));
 	GtkTreeViewColumn* col;
 	GtkCellRenderer *rend;
+	// all the columns have a fixed width, so that only the visible lines are measured and rendered (there can be hundreds of themes).
+	GString *sSampleRating = g_string_sized_new (CD_MAX_RATING*4+1);
+	int i;
+	for (i = 0; i < CD_MAX_RATING; i ++)
+		g_string_append (sSampleRating, "★");
+	const gchar *cSampleRating = sSampleRating->str;
 	// state
 	rend = gtk_cell_renderer_pixbuf_new ();
-	gtk_tree_view_insert_column_with_attributes (GTK_TREE_VIEW (pOneWidget), -1, NULL, rend, "pixbuf", CAIRO_DOCK_MODEL_ICON, NULL);
+	gtk_cell_renderer_set_fixed_size (rend, 24, 24);  // size of the state icons
+	col = gtk_tree_view_column_new_with_attributes (NULL, rend, "pixbuf", CAIRO_DOCK_MODEL_ICON, NULL);
+	cairo_dock_gui_set_column_fixed_width (pOneWidget, col, 24, NULL);
+	gtk_tree_view_append_column (GTK_TREE_VIEW (pOneWidget), col);
 	// nom du theme
 	rend = gtk_cell_renderer_text_new ();
 	col = gtk_tree_view_column_new_with_attributes (_("Theme"), rend, "text", CAIRO_DOCK_MODEL_NAME, NULL);
 	gtk_tree_view_column_set_sort_column_id (col, CAIRO_DOCK_MODEL_NAME);
+	cairo_dock_gui_set_column_fixed_width (pOneWidget, col, 150, NULL);
+	gtk_tree_view_column_set_expand (col, TRUE);
 	gtk_tree_view_append_column (GTK_TREE_VIEW (pOneWidget), col);
 	// rating
 	GtkListStore *note_list = _make_rate_list_store ();
@@ -528,13 +539,17 @@ static void _make_tree_view_for_themes (ThemesWidget *pThemesWidget, GPtrArray *
 	col = gtk_tree_view_column_new_with_attributes (_("Rating"), rend, "text", CAIRO_DOCK_MODEL_ORDER, NULL);
 	gtk_tree_view_column_set_sort_column_id (col, CAIRO_DOCK_MODEL_ORDER);
 	gtk_tree_view_column_set_cell_data_func (col, rend, (GtkTreeCellDataFunc)_cairo_dock_render_rating, NULL, NULL);
+	cairo_dock_gui_set_column_fixed_width (pOneWidget, col, 0, cSampleRating);
 	gtk_tree_view_append_column (GTK_TREE_VIEW (pOneWidget), col);
 	// soberty
 	rend = gtk_cell_renderer_text_new ();
 	col = gtk_tree_view_column_new_with_attributes (_("Sobriety"), rend, "text", CAIRO_DOCK_MODEL_ORDER2, NULL);
 	gtk_tree_view_column_set_sort_column_id (col, CAIRO_DOCK_MODEL_ORDER2);
 	gtk_tree_view_column_set_cell_data_func (col, rend, (GtkTreeCellDataFunc)_cairo_dock_render_sobriety, NULL, NULL);
+	cairo_dock_gui_set_column_fixed_width (pOneWidget, col, 0, cSampleRating);
 	gtk_tree_view_append_column (GTK_TREE_VIEW (pOneWidget), col);
+	g_string_free (sSampleRating, TRUE);
+	gtk_tree_view_set_fixed_height_mode (GTK_TREE_VIEW (pOneWidget), TRUE);
 	// vertical scrollbar
 	pThemesWidget->pTreeView = pOneWidget;
 	GtkWidget *pScrolledWindow = gtk_scrolled_window_new (NULL, NULL);
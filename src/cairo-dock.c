@@ -58,7 +58,7 @@
 #include "config.h"
 #include "cairo-dock-icon-facility.h"  // cairo_dock_get_first_icon
 #include "cairo-dock-module-manager.h"  // gldi_modules_new_from_directory
-#include "cairo-dock-module-instance-manager.h"  // GldiModuleInstance
+#include "cairo-dock-module-instance-manager.h"  // GldiModuleInstance, gldi_module_instances_set_deferred_activation
 #include "cairo-dock-dock-manager.h"
 #include "cairo-dock-desklet-manager.h"
 #include "cairo-dock-themes-manager.h"
@@ -67,6 +67,11 @@
 #include "cairo-dock-config.h"
 #include "cairo-dock-file-manager.h"
 #include "cairo-dock-log.h"
+#include "cairo-dock-trace.h"  // gldi_trace_enable
+#include "cairo-dock-profiler.h"  // gldi_profiler_enable
+#include "cairo-dock-image-buffer.h"  // cairo_dock_set_image_buffers_gl_only
+#include "cairo-dock-draw-opengl.h"  // cairo_dock_set_textures_compression
+#include "implementations/cairo-dock-gauge.h"  // cairo_dock_set_gauge_needle_frames
 #include "cairo-dock-keybinder.h"
 #include "cairo-dock-opengl.h"
 #include "cairo-dock-packages.h"
@@ -178,6 +183,7 @@ static void _cairo_dock_quit (G_GNUC_UNUSED int signal)
 static void _cairo_dock_intercept_signal (int signal)
 {
 	cd_warning ("Cairo-Dock has crashed (sig %d).\nIt will be restarted now.\nFeel free to report this bug on glx-dock.org to help improving the dock!", signal);
+	gldi_trace_dump_to_file ();  // does nothing if the trace is not enabled.
 	g_print ("info on the system :\n");
 	int r = system ("uname -a");
 	if (r < 0)
@@ -340,7 +346,8 @@ int main (int argc, char** argv)
 	textdomain (CAIRO_DOCK_GETTEXT_PACKAGE);
 	
 	//\___________________ get app's options.
-	gboolean bSafeMode = FALSE, bMaintenance = FALSE, bNoSticky = FALSE, bCappuccino = FALSE, bPrintVersion = FALSE, bTesting = FALSE, bForceOpenGL = FALSE, bToggleIndirectRendering = FALSE, bKeepAbove = FALSE, bForceColors = FALSE, bAskBackend = FALSE, bMetacityWorkaround = FALSE;
+	gboolean bSafeMode = FALSE, bLazyApplets = FALSE, bMaintenance = FALSE, bNoSticky = FALSE, bCappuccino = FALSE, bPrintVersion = FALSE, bTesting = FALSE, bForceOpenGL = FALSE, bToggleIndirectRendering = FALSE, bKeepAbove = FALSE, bForceColors = FALSE, bAskBackend = FALSE, bMetacityWorkaround = FALSE, bTrace = FALSE, bProfile = FALSE, bGLOnlyImages = FALSE, bCompressTextures = FALSE;
+	gint iNbNeedleFrames = 0;
 	gchar *cEnvironment = NULL, *cUserDefinedDataDir = NULL, *cVerbosity = 0, *cUserDefinedModuleDir = NULL, *cExcludeModule = NULL, *cThemeServerAdress = NULL;
 	int iDelay = 0;
 	GOptionEntry pOptionsTable[] =
@@ -379,12 +386,30 @@ int main (int argc, char** argv)
 		{"safe-mode", 'f', G_OPTION_FLAG_IN_MAIN, G_OPTION_ARG_NONE,
 			&bSafeMode,
 			_("Don't load any plug-ins."), NULL},
+		{"lazy-applets", 0, G_OPTION_FLAG_IN_MAIN, G_OPTION_ARG_NONE,
+			&bLazyApplets,
+			_("Don't initialize on startup the applets inside closed sub-docks or in desklets on other desktops, until they are shown. They won't poll or notify until then."), NULL},
 		{"metacity-workaround", 'W', G_OPTION_FLAG_IN_MAIN, G_OPTION_ARG_NONE,
 			&bMetacityWorkaround,
 			_("Work around some bugs in Metacity Window-Manager (invisible dialogs or sub-docks)"), NULL},
 		{"log", 'l', G_OPTION_FLAG_IN_MAIN, G_OPTION_ARG_STRING,
 			&cVerbosity,
 			_("Log verbosity (debug,message,warning,critical,error); default is warning."), NULL},
+		{"trace", 0, G_OPTION_FLAG_IN_MAIN, G_OPTION_ARG_NONE,
+			&bTrace,
+			_("Record a light trace of the events of the dock, dumped on crash or when receiving SIGUSR2."), NULL},
+		{"profile", 0, G_OPTION_FLAG_IN_MAIN, G_OPTION_ARG_NONE,
+			&bProfile,
+			_("Measure where the time of the dock goes from the start; the report can be retrieved on the bus (org.cairodock.Profiler)."), NULL},
+		{"gl-only-images", 0, G_OPTION_FLAG_IN_MAIN, G_OPTION_ARG_NONE,
+			&bGLOnlyImages,
+			_("In OpenGL, keep the images of the icons on the graphic card only, without their copy in memory."), NULL},
+		{"compress-textures", 0, G_OPTION_FLAG_IN_MAIN, G_OPTION_ARG_NONE,
+			&bCompressTextures,
+			_("In OpenGL, compress the images of the theme (backgrounds, indicators, etc) on the graphic card; they take less memory but may show some artefacts."), NULL},
+		{"gauge-needle-frames", 0, G_OPTION_FLAG_IN_MAIN, G_OPTION_ARG_INT,
+			&iNbNeedleFrames,
+			_("Pre-render the needles of the gauges at N positions, instead of rotating them on each update (unless their theme says otherwise)."), NULL},
 		{"colors", 'F', G_OPTION_FLAG_IN_MAIN, G_OPTION_ARG_NONE,
 			&bForceColors,
 			_("Force to display some output messages with colors."), NULL},
@@ -445,6 +470,21 @@ int main (int argc, char** argv)
 	if (bForceColors)
 		cd_log_force_use_color ();
 	
+	if (bTrace)
+		gldi_trace_enable (TRUE);
+	
+	if (bProfile)
+		gldi_profiler_enable (TRUE);
+	
+	if (bGLOnlyImages)
+		cairo_dock_set_image_buffers_gl_only (TRUE);
+	
+	if (bCompressTextures)
+		cairo_dock_set_textures_compression (TRUE);
+	
+	if (iNbNeedleFrames > 0)
+		cairo_dock_set_gauge_needle_frames (iNbNeedleFrames);
+	
 	CairoDockDesktopEnv iDesktopEnv = CAIRO_DOCK_UNKNOWN_ENV;
 	if (cEnvironment != NULL)
 	{
@@ -590,6 +630,8 @@ int main (int argc, char** argv)
 		g_bUseOpenGL);
 	
 	//\___________________ load plug-ins (must be done after everything is initialized).
+	if (bLazyApplets)
+		gldi_module_instances_set_deferred_activation (TRUE);
 	if (! bSafeMode)
 	{
 		gldi_modules_new_from_directory (NULL, &erreur);  // load gldi-based plug-ins
@@ -820,6 +862,9 @@ int main (int argc, char** argv)
 	}
 	cairo_dock_load_current_theme ();
 	
+	//\___________________ the profiler can be enabled at any time from the bus.
+	gldi_profiler_register_dbus_service ();
+	
 	//\___________________ lock mode.
 	if (g_bLocked)  // comme on ne pourra pas ouvrir le panneau de conf, ces 2 variables resteront tel quel.
 	{
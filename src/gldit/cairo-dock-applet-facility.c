@@ -42,6 +42,7 @@
 #include "cairo-dock-gui-manager.h"
 #include "cairo-dock-backends-manager.h"
 #include "cairo-dock-dock-facility.h"
+#include "cairo-dock-icon-index.h"  // cairo_dock_icon_index_invalidate
 #include "cairo-dock-icon-facility.h"
 #include "cairo-dock-applet-facility.h"
 
@@ -434,6 +435,7 @@ void cairo_dock_remove_all_icons_from_applet (GldiModuleInstance *pInstance)
 			cd_debug (" destroy sub-dock icons");
 			GList *icons = pIcon->pSubDock->icons;
 			pIcon->pSubDock->icons = NULL;
+			cairo_dock_icon_index_invalidate (pIcon->pSubDock);
 			GList *ic;
 			Icon *icon;
 			for (ic = icons; ic != NULL; ic = ic->next)
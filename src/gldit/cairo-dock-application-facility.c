@@ -58,7 +58,12 @@ static void _gldi_appli_icon_demands_attention (Icon *icon, CairoDock *pDock, gb
 		{
 			pDialog = gldi_dialog_show_temporary (pHiddenIcon->cName, icon, CAIRO_CONTAINER (pDock), 1000*myTaskbarParam.iDialogDuration); // mieux vaut montrer pas d'icone dans le dialogue que de montrer une icone qui n'a pas de rapport avec l'appli demandant l'attention.
 			g_return_if_fail (pDialog != NULL);
-			gldi_dialog_set_icon_surface (pDialog, pHiddenIcon->image.pSurface, pDialog->iIconSize);
+			cairo_surface_t *pHiddenSurface = cairo_dock_image_buffer_ref_surface (&pHiddenIcon->image);
+			if (pHiddenSurface != NULL)
+			{
+				gldi_dialog_set_icon_surface (pDialog, pHiddenSurface, pDialog->iIconSize);
+				cairo_surface_destroy (pHiddenSurface);
+			}
 		}
 		if (pDialog && bForceDemand)
 		{
@@ -454,14 +459,12 @@ void gldi_appli_reserve_geometry_for_window_manager (GldiWindowActor *pAppli, Ic
 
 const CairoDockImageBuffer *gldi_appli_icon_get_image_buffer (Icon *pIcon)
 {
-	static CairoDockImageBuffer image;
-	
 	// if the given icon is not loaded
-	if (pIcon->image.pSurface == NULL)
+	if (pIcon->image.pSurface == NULL && pIcon->image.iTexture == 0)
 	{
 		// try to get the image from the class
 		const CairoDockImageBuffer *pImageBuffer = cairo_dock_get_class_image_buffer (pIcon->cClass);
-		if (pImageBuffer && pImageBuffer->pSurface)
+		if (pImageBuffer && cairo_dock_image_buffer_has_surface (pImageBuffer))
 		{
 			return pImageBuffer;
 		}
@@ -492,8 +495,7 @@ const CairoDockImageBuffer *gldi_appli_icon_get_image_buffer (Icon *pIcon)
 	// if the given icon is loaded, use its image.
 	if (pIcon->image.pSurface != NULL || pIcon->image.iTexture != 0)
 	{
-		memcpy (&image, &pIcon->image, sizeof (CairoDockImageBuffer));
-		return &image;
+		return &pIcon->image;  // not a copy: the state of a buffer is looked up by its address (see cairo_dock_image_buffer_ref_surface).
 	}
 	else
 	{
@@ -66,11 +66,16 @@ static void _load_image (Icon *icon)
 			{
 				Icon *pOneIcon = (Icon *) (g_list_last ((GList*)pApplis)->data);  // on prend le dernier car les applis sont inserees a l'envers, et on veut avoir celle qui etait deja present dans le dock (pour 2 raisons : continuite, et la nouvelle (en 1ere position) n'est pas forcement deja dans un dock, ce qui fausse le ratio).
 				cd_debug ("  load from %s (%dx%d)", pOneIcon->cName, iWidth, iHeight);
-				pSurface = cairo_dock_duplicate_surface (pOneIcon->image.pSurface,
-					pOneIcon->image.iWidth,
-					pOneIcon->image.iHeight,
-					iWidth,
-					iHeight);  /// could make a gldi_image_buffer_load_from_buffer (&pOneIcon->image, iWidth, iHeight) and duplicate the texture only...
+				cairo_surface_t *pOneSurface = cairo_dock_image_buffer_ref_surface (&pOneIcon->image);
+				if (pOneSurface != NULL)
+				{
+					pSurface = cairo_dock_duplicate_surface (pOneSurface,
+						pOneIcon->image.iWidth,
+						pOneIcon->image.iHeight,
+						iWidth,
+						iHeight);  /// could make a gldi_image_buffer_load_from_buffer (&pOneIcon->image, iWidth, iHeight) and duplicate the texture only...
+					cairo_surface_destroy (pOneSurface);
+				}
 			}
 		}
 	}
@@ -40,6 +40,7 @@
 #include "cairo-dock-module-manager.h"  // GldiModule
 #include "cairo-dock-module-instance-manager.h"  // GldiModuleInstance
 #include "cairo-dock-dock-facility.h"
+#include "cairo-dock-icon-index.h"  // cairo_dock_icon_index_invalidate
 #include "cairo-dock-applications-manager.h"
 #include "cairo-dock-draw.h"
 #include "cairo-dock-image-buffer.h"
@@ -475,6 +476,7 @@ void cairo_dock_deinhibite_class (const gchar *cClass, Icon *pInhibitorIcon)
 		// we empty the sub-dock then destroy it, then re-insert the appli icons
 		GList *icons = pInhibitorIcon->pSubDock->icons;
 		pInhibitorIcon->pSubDock->icons = NULL;  // empty the sub-dock
+		cairo_dock_icon_index_invalidate (pInhibitorIcon->pSubDock);
 		cairo_dock_destroy_class_subdock (cClass);  // destroy the sub-dock without destroying its icons
 		pInhibitorIcon->pSubDock = NULL;  // since the inhibitor can already be detached, the sub-dock can't find it
 
@@ -641,11 +643,16 @@ cairo_surface_t *cairo_dock_create_surface_from_class (const gchar *cClass, int
 				if (pInhibitorIcon->pSubDock == NULL || myIndicatorsParam.bUseClassIndic)  // in the case where a launcher has more than one instance of its class and which represents the stack, we doesn't take the icon.
 				{
 					cd_debug ("%s will give its surface", pInhibitorIcon->cName);
-					return cairo_dock_duplicate_surface (pInhibitorIcon->image.pSurface,
+					cairo_surface_t *pInhibitorSurface = cairo_dock_image_buffer_ref_surface (&pInhibitorIcon->image);
+					if (pInhibitorSurface == NULL)
+						return NULL;
+					cairo_surface_t *pSurface = cairo_dock_duplicate_surface (pInhibitorSurface,
 						pInhibitorIcon->image.iWidth,
 						pInhibitorIcon->image.iHeight,
 						iWidth,
 						iHeight);
+					cairo_surface_destroy (pInhibitorSurface);
+					return pSurface;
 				}
 				else if (pInhibitorIcon->cFileName != NULL)
 				{
@@ -1567,7 +1574,6 @@ const gchar *cairo_dock_get_class_wm_class (const gchar *cClass)
 
 const CairoDockImageBuffer *cairo_dock_get_class_image_buffer (const gchar *cClass)
 {
-	static CairoDockImageBuffer image;
 	g_return_val_if_fail (cClass != NULL, NULL);
 	CairoDockClassAppli *pClassAppli = cairo_dock_get_class (cClass);
 	Icon *pIcon;
@@ -1575,20 +1581,14 @@ const CairoDockImageBuffer *cairo_dock_get_class_image_buffer (const gchar *cCla
 	for (ic = pClassAppli->pIconsOfClass; ic != NULL; ic = ic->next)
 	{
 		pIcon = ic->data;
-		if (CAIRO_DOCK_ICON_TYPE_IS_LAUNCHER (pIcon) && pIcon->image.pSurface)  // avoid applets
-		{
-			memcpy (&image, &pIcon->image, sizeof (CairoDockImageBuffer));
-			return &image;
-		}
+		if (CAIRO_DOCK_ICON_TYPE_IS_LAUNCHER (pIcon) && cairo_dock_image_buffer_has_surface (&pIcon->image))  // avoid applets; a released surface can be got back with cairo_dock_image_buffer_ref_surface().
+			return &pIcon->image;  // not a copy: the state of a buffer is looked up by its address.
 	}
 	for (ic = pClassAppli->pAppliOfClass; ic != NULL; ic = ic->next)
 	{
 		pIcon = ic->data;
-		if (pIcon->image.pSurface)
-		{
-			memcpy (&image, &pIcon->image, sizeof (CairoDockImageBuffer));
-			return &image;
-		}
+		if (cairo_dock_image_buffer_has_surface (&pIcon->image))
+			return &pIcon->image;
 	}
 
 	return NULL;
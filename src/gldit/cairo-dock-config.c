@@ -24,6 +24,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <sys/resource.h>  // getrusage
 
 #include "gldi-config.h"
 
@@ -44,11 +45,14 @@ static char DES_crypt_key[64] =
 #include "cairo-dock-icon-manager.h"  // cairo_dock_hide_show_launchers_on_other_desktops
 #include "cairo-dock-applications-manager.h"  // cairo_dock_start_applications_manager
 #include "cairo-dock-module-manager.h"  // gldi_modules_activate_from_list
+#include "cairo-dock-module-instance-manager.h"  // gldi_module_instances_get_nb_deferred
 #include "cairo-dock-themes-manager.h"  // cairo_dock_update_conf_file
 #include "cairo-dock-dock-factory.h"  // gldi_dock_new
+#include "cairo-dock-dock-manager.h"  // gldi_docks_redraw_all_root
 #include "cairo-dock-file-manager.h"  // cairo_dock_get_file_size
-#include "cairo-dock-user-icon-manager.h"  // gldi_user_icons_new_from_directory
+#include "cairo-dock-user-icon-manager.h"  // gldi_user_icons_new_from_directory_full
 #include "cairo-dock-core.h"  // gldi_free_all
+#include "cairo-dock-trace.h"  // gldi_trace
 #include "cairo-dock-config.h"
 
 gboolean g_bEasterEggs = FALSE;
@@ -56,8 +60,26 @@ gboolean g_bEasterEggs = FALSE;
 extern gchar *g_cCurrentLaunchersPath;
 extern gchar *g_cConfFile;
 extern gboolean g_bUseOpenGL;
+extern CairoDock *g_pMainDock;
 
 static gboolean s_bLoading = FALSE;
+static gboolean s_bLoadingMainDock = FALSE;
+
+// the theme is loaded in several stages: the main dock and its launchers first (so that it can be painted as soon as possible), then the rest in small slices of time.
+typedef enum {
+	CAIRO_DOCK_LOADING_LAUNCHERS = 0,  // launchers of the other docks (sub-docks, etc)
+	CAIRO_DOCK_LOADING_APPLETS,
+	CAIRO_DOCK_LOADING_TASKBAR,
+	CAIRO_DOCK_LOADING_DONE
+	} CairoDockLoadingStage;
+#define CAIRO_DOCK_LOADING_SLICE 5000  // duration of a slice, in us.
+static CairoDockLoadingStage s_iLoadingStage;
+static guint s_iSidLoadTheme = 0;
+static GList *s_pPendingLaunchers = NULL;
+static gchar **s_cPendingModules = NULL;
+static int s_iNextModule;
+static gint64 s_iLoadingStartTime;
+static guint s_iThemeLoadedEvent = 0;
 
 
 gboolean cairo_dock_get_boolean_key_value (GKeyFile *pKeyFile, const gchar *cGroupName, const gchar *cKeyName, gboolean *bFlushConfFileNeeded, gboolean bDefaultValue, const gchar *cDefaultGroupName, const gchar *cDefaultKeyName)
@@ -444,10 +466,91 @@ void cairo_dock_get_size_key_value (GKeyFile *pKeyFile, const gchar *cGroupName,
 }
 
 
+static void _trace_loading_stage (const gchar *cStage)
+{
+	struct rusage usage;
+	long iMaxRss = (getrusage (RUSAGE_SELF, &usage) == 0 ? usage.ru_maxrss : -1);  // in kB
+	cd_message ("theme loading: %s done after %.1fms (max RSS: %ldkB)", cStage, (g_get_monotonic_time () - s_iLoadingStartTime) / 1000., iMaxRss);
+}
+
+static void _cancel_staged_loading (void)
+{
+	if (s_iSidLoadTheme != 0)
+	{
+		g_source_remove (s_iSidLoadTheme);
+		s_iSidLoadTheme = 0;
+	}
+	g_list_free_full (s_pPendingLaunchers, g_free);
+	s_pPendingLaunchers = NULL;
+	g_strfreev (s_cPendingModules);
+	s_cPendingModules = NULL;
+}
+
+static gboolean _load_theme_slice (G_GNUC_UNUSED gpointer data)
+{
+	gint64 t0 = g_get_monotonic_time ();
+	do
+	{
+		switch (s_iLoadingStage)
+		{
+			case CAIRO_DOCK_LOADING_LAUNCHERS:
+				if (s_pPendingLaunchers != NULL)
+				{
+					GList *l = s_pPendingLaunchers;
+					s_pPendingLaunchers = g_list_remove_link (s_pPendingLaunchers, l);
+					gldi_user_icon_load (l->data);
+					g_free (l->data);
+					g_list_free_1 (l);
+				}
+				else
+				{
+					cairo_dock_hide_show_launchers_on_other_desktops ();
+					_trace_loading_stage ("sub-docks");
+					s_iLoadingStage ++;
+				}
+			break;
+			case CAIRO_DOCK_LOADING_APPLETS:
+				if (s_cPendingModules != NULL && s_cPendingModules[s_iNextModule] != NULL)
+				{
+					const gchar *cModuleName = s_cPendingModules[s_iNextModule++];
+					GldiModule *pModule = gldi_module_get (cModuleName);
+					if (pModule == NULL)
+						cd_debug ("No such module (%s)", cModuleName);
+					else if (pModule->pInstancesList == NULL)  // not yet active
+						gldi_module_activate (pModule);
+				}
+				else
+				{
+					cd_message ("theme loading: %d applet(s) deferred", gldi_module_instances_get_nb_deferred ());
+					_trace_loading_stage ("applets");
+					s_iLoadingStage ++;
+				}
+			break;
+			case CAIRO_DOCK_LOADING_TASKBAR:
+				cairo_dock_start_applications_manager (g_pMainDock);  // will load the icons if the option is enabled.
+				_trace_loading_stage ("taskbar");
+				s_iLoadingStage ++;
+			break;
+			case CAIRO_DOCK_LOADING_DONE:
+			default:
+				gldi_trace (gldi_trace_get_event (&s_iThemeLoadedEvent, "theme-loaded"), gldi_module_instances_get_nb_deferred (), g_get_monotonic_time () - s_iLoadingStartTime);  // nb deferred applets, duration
+				s_iSidLoadTheme = 0;  // the source is removed by returning FALSE.
+				_cancel_staged_loading ();  // free the lists.
+				s_bLoading = FALSE;
+			return FALSE;
+		}
+	}
+	while (g_get_monotonic_time () - t0 < CAIRO_DOCK_LOADING_SLICE);
+	return TRUE;
+}
+
 void cairo_dock_load_current_theme (void)
 {
 	cd_message ("%s ()", __func__);
+	_cancel_staged_loading ();  // in case the previous theme is not completely loaded yet.
+	s_iLoadingStartTime = g_get_monotonic_time ();
 	s_bLoading = TRUE;
+	s_bLoadingMainDock = TRUE;
 	
 	//\___________________ Free everything.
 	gldi_free_all ();  // do nothing if there is nothing to unload.
@@ -456,24 +559,26 @@ void cairo_dock_load_current_theme (void)
 	gldi_managers_get_config (g_cConfFile, GLDI_VERSION);  /// en fait, CAIRO_DOCK_VERSION ...
 	
 	//\___________________ Create the primary container (needed to have a cairo/opengl context).
-	CairoDock *pMainDock = gldi_dock_new (CAIRO_DOCK_MAIN_DOCK_NAME);
+	gldi_dock_new (CAIRO_DOCK_MAIN_DOCK_NAME);
 	
 	//\___________________ Load all managers data.
 	gldi_managers_load ();
 	gldi_modules_activate_from_list (NULL);  // load auto-loaded modules before loading anything (views, etc)
 	
-	//\___________________ Now load the user icons (launchers, etc).
-	gldi_user_icons_new_from_directory (g_cCurrentLaunchersPath);
+	//\___________________ Now load the launchers of the main dock, the others will come later.
+	s_pPendingLaunchers = gldi_user_icons_new_from_directory_full (g_cCurrentLaunchersPath, CAIRO_DOCK_MAIN_DOCK_NAME);
 	
 	cairo_dock_hide_show_launchers_on_other_desktops ();
 	
-	//\___________________ Load the applets.
-	gldi_modules_activate_from_list (myModulesParam.cActiveModuleList);
-	
-	//\___________________ Start the applications manager (will load the icons if the option is enabled).
-	cairo_dock_start_applications_manager (pMainDock);
+	s_bLoadingMainDock = FALSE;  // the main dock can be drawn now.
+	gldi_docks_redraw_all_root ();
+	_trace_loading_stage ("main dock");
 	
-	s_bLoading = FALSE;
+	//\___________________ Load the rest (sub-docks, applets, applications) in slices of time, so that the main loop can run in-between.
+	s_cPendingModules = g_strdupv (myModulesParam.cActiveModuleList);
+	s_iNextModule = 0;
+	s_iLoadingStage = CAIRO_DOCK_LOADING_LAUNCHERS;
+	s_iSidLoadTheme = g_idle_add (_load_theme_slice, NULL);  // lower priority than the redraws.
 }
 
 
@@ -482,6 +587,11 @@ gboolean cairo_dock_is_loading (void)
 	return s_bLoading;
 }
 
+gboolean cairo_dock_is_loading_main_dock (void)
+{
+	return s_bLoadingMainDock;
+}
+
 
 
 void cairo_dock_decrypt_string( const gchar *cEncryptedString,  gchar **cDecryptedString )
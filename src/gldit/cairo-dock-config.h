@@ -150,6 +150,7 @@ void cairo_dock_get_color_key_value (GKeyFile *pKeyFile, const gchar *cGroupName
 
 
 /** Load the current theme. This will (re)load all the parameters of Cairo-Dock and all the plug-ins, as if you just started the dock.
+The main dock and its launchers are loaded immediately; the rest is loaded progressively from the main loop.
 */
 void cairo_dock_load_current_theme (void);
 
@@ -159,6 +160,11 @@ void cairo_dock_load_current_theme (void);
 */
 gboolean cairo_dock_is_loading (void);
 
+/** Say if the main dock is being loaded. The docks are not drawn until it's done; the rest of the theme (sub-docks, applets, applications) is then loaded in slices of time in the background, while \ref cairo_dock_is_loading still returns TRUE.
+*@return TRUE if the main dock and its launchers are not yet loaded.
+*/
+gboolean cairo_dock_is_loading_main_dock (void);
+
 
 /** Decrypt a string (uses DES-encryption from libcrypt).
 *@param cEncryptedString the encrypted string.
@@ -172,7 +172,17 @@ static inline void _redraw_container_area (GldiContainer *pContainer, GdkRectang
 		pArea->width = pContainer->iHeight - pArea->x;
 	
 	if (pArea->width > 0 && pArea->height > 0)
+	{
+		if (g_bUseOpenGL)  // remember the damage until the next frame, so that only this part is repainted.
+		{
+			GdkRectangle *pDamage = &pContainer->pRepaint->damageArea;
+			if (pDamage->width > 0 && pDamage->height > 0)
+				gdk_rectangle_union (pDamage, pArea, pDamage);
+			else
+				*pDamage = *pArea;
+		}
 		gdk_window_invalidate_rect (gldi_container_get_gdk_window (pContainer), pArea, FALSE);
+	}
 }
 
 void cairo_dock_redraw_container_area (GldiContainer *pContainer, GdkRectangle *pArea)
@@ -490,6 +500,7 @@ static void init_object (GldiObject *obj, gpointer attr)
 	pContainer->fRatio = 1;
 	pContainer->bIsHorizontal = TRUE;
 	pContainer->bDirectionUp = TRUE;
+	pContainer->pRepaint = g_new0 (GldiContainerRepaint, 1);
 	
 	// create a window
 	GtkWidget* pWindow = gtk_window_new (GTK_WINDOW_TOPLEVEL);
@@ -568,6 +579,9 @@ static void reset_object (GldiObject *obj)
 	
 	if (g_pPrimaryContainer == pContainer)
 		g_pPrimaryContainer = NULL;
+	
+	g_free (pContainer->pRepaint);
+	pContainer->pRepaint = NULL;
 }
 
 void gldi_register_containers_manager (void)
@@ -53,6 +53,7 @@ extern GldiObjectManager myContainerObjectMgr;
 #endif
 
 #define CD_DOUBLE_CLICK_DELAY 250  // ms
+#define GLDI_CONTAINER_REPAINT_HISTORY 4  // number of frames we remember, for buffer-age
 
 // params
 struct _GldiContainersParam{
@@ -113,6 +114,17 @@ struct _GldiContainerInterface {
 	void (*insert_icon) (GldiContainer *pContainer, Icon *pIcon, gboolean bAnimateIcon);
 	};
 
+/// Areas damaged and repainted in a Container (OpenGL only). It's allocated along with the Container, out of its structure.
+typedef struct _GldiContainerRepaint {
+	/// area damaged since the last frame, accumulated by the redraw functions.
+	GdkRectangle damageArea;
+	/// area repainted at the last frame, in window coordinates.
+	GdkRectangle repaintArea;
+	/// areas repainted at the previous frames, to update a back buffer that is several frames old.
+	GdkRectangle pRepaintHistory[GLDI_CONTAINER_REPAINT_HISTORY];
+	gint iRepaintHistoryIndex;
+	} GldiContainerRepaint;
+
 /// Definition of a Container, whom derive Dock, Desklet, Dialog and FlyingContainer. 
 struct _GldiContainer {
 	/// object.
@@ -162,7 +174,9 @@ struct _GldiContainer {
 	GldiContainerInterface iface;
 	
 	gboolean bIgnoreNextReleaseEvent;
-	gpointer reserved[4];
+	/// areas damaged and repainted (OpenGL only).
+	GldiContainerRepaint *pRepaint;
+	gpointer reserved[3];
 };
 
 
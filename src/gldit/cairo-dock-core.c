@@ -56,6 +56,8 @@
 #include "cairo-dock-overlay.h"
 #include "cairo-dock-log.h"
 #include "cairo-dock-opengl.h"
+#include "cairo-dock-draw-opengl.h"  // cairo_dock_init_icons_batch
+#include "cairo-dock-texture-manager.h"  // gldi_textures_init
 #include "cairo-dock-core.h"
 
 extern GldiContainer *g_pPrimaryContainer;
@@ -106,6 +108,10 @@ void gldi_init (GldiRenderingMethod iRendering)
 	
 	gldi_managers_init ();
 	
+	cairo_dock_init_icons_batch ();  // the only callbacks on the icons' rendering are the core's ones for now.
+	
+	gldi_textures_init ();
+	
 	// register internal backends.
 	cairo_dock_register_built_in_data_renderers ();
 	
@@ -42,6 +42,7 @@
 #include "cairo-dock-gauge.h"
 #include "cairo-dock-graph.h"
 #include "cairo-dock-progressbar.h"
+#include "cairo-dock-trace.h"  // gldi_trace
 #include "cairo-dock-data-renderer.h"
 
 extern gboolean g_bUseOpenGL;
@@ -294,6 +295,15 @@ void cairo_dock_render_overlays_to_context (CairoDataRenderer *pRenderer, int iN
 }
 
 
+static void _trace_render (CairoDataRenderer *pRenderer, gint64 iTraceStartTime)
+{
+	if (G_UNLIKELY (g_bGldiTraceEnabled))
+	{
+		static guint s_iRenderEvent = 0;
+		gldi_trace (gldi_trace_get_event (&s_iRenderEvent, "data-render"), cairo_data_renderer_get_nb_values (pRenderer), g_get_monotonic_time () - iTraceStartTime);  // nb values, duration
+	}
+}
+
 static void _cairo_dock_render_to_context (CairoDataRenderer *pRenderer, Icon *pIcon, GldiContainer *pContainer, cairo_t *pCairoContext)
 {
 	cairo_t *ctx = NULL;
@@ -323,7 +333,9 @@ static void _cairo_dock_render_to_context (CairoDataRenderer *pRenderer, Icon *p
 	}
 	
 	//cairo_save (pCairoContext);
+	gint64 iTraceStartTime = (G_UNLIKELY (g_bGldiTraceEnabled) ? g_get_monotonic_time () : 0);
 	pRenderer->interface.render (pRenderer, pCairoContext);
+	_trace_render (pRenderer, iTraceStartTime);
 	//cairo_restore (pCairoContext);
 	
 	//\________________ On dessine les overlays.
@@ -379,7 +391,9 @@ static void _cairo_dock_render_to_texture (CairoDataRenderer *pRenderer, Icon *p
 	}
 	
 	//glPushMatrix ();
+	gint64 iTraceStartTime = (G_UNLIKELY (g_bGldiTraceEnabled) ? g_get_monotonic_time () : 0);
 	pRenderer->interface.render_opengl (pRenderer);
+	_trace_render (pRenderer, iTraceStartTime);
 	//glPopMatrix ();
 	
 	//\________________ On dessine les overlays.
@@ -33,7 +33,9 @@
 
 #include "cairo-dock-draw.h"
 #include "cairo-dock-icon-facility.h"  // cairo_dock_set_icon_container
+#include "cairo-dock-module-manager.h"  // pVisitCard->cModuleName
 #include "cairo-dock-module-instance-manager.h"  // gldi_module_instance_detach
+#include "cairo-dock-profiler.h"  // gldi_profile_begin
 #include "cairo-dock-dialog-manager.h"  // gldi_dialogs_replace_all
 #include "cairo-dock-icon-factory.h"
 #include "cairo-dock-icon-facility.h"
@@ -80,6 +82,7 @@ static gboolean on_expose_desklet(G_GNUC_UNUSED GtkWidget *pWidget, G_GNUC_UNUSE
 		return FALSE;
 	}
 	
+	gint64 iProfileTime = gldi_profile_begin ();
 	if (g_bUseOpenGL && pDesklet->pRenderer && pDesklet->pRenderer->render_opengl)
 	{
 		if (! gldi_gl_container_begin_draw (CAIRO_CONTAINER (pDesklet)))
@@ -95,6 +98,9 @@ static gboolean on_expose_desklet(G_GNUC_UNUSED GtkWidget *pWidget, G_GNUC_UNUSE
 		
 		gldi_object_notify (pDesklet, NOTIFICATION_RENDER, pDesklet, pCairoContext);
 	}
+	gldi_profile_end (iProfileTime, GLDI_PROFILE_FRAME, pDesklet,
+		pDesklet->pIcon && pDesklet->pIcon->pModuleInstance ? pDesklet->pIcon->pModuleInstance->pModule->pVisitCard->cModuleName : "desklet",
+		"desklet");
 	
 	return FALSE;
 }
@@ -686,7 +692,11 @@ static gboolean _cairo_desklet_animation_loop (GldiContainer *pContainer)
 		if (! bIconIsAnimating)
 			pDesklet->pIcon->iAnimationState = CAIRO_DOCK_STATE_REST;
 		else
+		{
 			bContinue = TRUE;
+			if (pDesklet->pIcon->pModuleInstance != NULL)
+				gldi_module_instance_add_frame (pDesklet->pIcon->pModuleInstance);
+		}
 	}
 	
 	if (bUpdateSlowAnimation)
@@ -933,7 +943,7 @@ void gldi_desklet_load_desklet_decorations (CairoDesklet *pDesklet)
 			pDeskletDecorations->cBackGroundImagePath,
 			pDesklet->container.iWidth,
 			pDesklet->container.iHeight,
-			pDeskletDecorations->iLoadingModifier,
+			pDeskletDecorations->iLoadingModifier | CAIRO_DOCK_STATIC_IMAGE,
 			pDeskletDecorations->fBackGroundAlpha);
 		fZoomX = pDesklet->backGroundImageBuffer.fZoomX;
 		fZoomY = pDesklet->backGroundImageBuffer.fZoomY;
@@ -945,7 +955,7 @@ void gldi_desklet_load_desklet_decorations (CairoDesklet *pDesklet)
 			pDeskletDecorations->cForeGroundImagePath,
 			pDesklet->container.iWidth,
 			pDesklet->container.iHeight,
-			pDeskletDecorations->iLoadingModifier,
+			pDeskletDecorations->iLoadingModifier | CAIRO_DOCK_STATIC_IMAGE,
 			pDeskletDecorations->fForeGroundAlpha);
 		fZoomX = pDesklet->foreGroundImageBuffer.fZoomX;
 		fZoomY = pDesklet->foreGroundImageBuffer.fZoomY;
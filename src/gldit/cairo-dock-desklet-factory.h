@@ -108,6 +108,13 @@ typedef void (* CairoDeskletLoadRendererDataFunc) (CairoDesklet *pDesklet);
 typedef void (* CairoDeskletUpdateRendererDataFunc) (CairoDesklet *pDesklet, CairoDeskletRendererDataPtr pNewData);
 typedef void (* CairoDeskletFreeRendererDataFunc) (CairoDesklet *pDesklet);
 typedef void (* CairoDeskletCalculateIconsFunc) (CairoDesklet *pDesklet);
+/// Bounding box of an icon, in the frame used by the render_bounding_box function (origin at the center of the desklet, Y axis going up).
+typedef struct _CairoDeskletBoundingBox {
+	Icon *pIcon;
+	gdouble x, y, z;  // center of the box
+	gdouble fWidth, fHeight;
+} CairoDeskletBoundingBox;
+typedef void (* CairoDeskletGetBoundingBoxesFunc) (CairoDesklet *pDesklet, GArray *pBoxes);
 /// Definition of a Desklet's renderer.
 struct _CairoDeskletRenderer {
 	/// rendering function with libcairo.
@@ -128,6 +135,8 @@ struct _CairoDeskletRenderer {
 	CairoDeskletGLRenderFunc 			render_bounding_box;
 	/// An optionnal list of preset configs.
 	GList *pPreDefinedConfigList;
+	/// optionnal function that appends the bounding boxes of the icons to an array of CairoDeskletBoundingBox, from the first drawn to the last one; it is used instead of render_bounding_box to pick icons without going through OpenGL.
+	CairoDeskletGetBoundingBoxesFunc 	get_bounding_boxes;
 };
 
 
@@ -461,6 +461,133 @@ static gboolean _on_update_desklet_notification (G_GNUC_UNUSED gpointer data, Ca
 	return GLDI_NOTIFICATION_LET_PASS;
 }
 
+// transforme un point du repere des bounding box en coordonnees fenetre (origine en bas a gauche), comme le font _set_desklet_matrix et la perspective du desklet.
+static gboolean _project_point_on_desklet (CairoDesklet *pDesklet, double x, double y, double z, double *wx, double *wy)
+{
+	double w = pDesklet->container.iWidth, h = pDesklet->container.iHeight;
+	double a, c, s, t;
+	
+	if (pDesklet->iLeftSurfaceOffset != 0 || pDesklet->iTopSurfaceOffset != 0 || pDesklet->iRightSurfaceOffset != 0 || pDesklet->iBottomSurfaceOffset != 0)
+	{
+		x = x * (1. - (double)(pDesklet->iLeftSurfaceOffset + pDesklet->iRightSurfaceOffset) / w) + (pDesklet->iLeftSurfaceOffset - pDesklet->iRightSurfaceOffset)/2;
+		y = y * (1. - (double)(pDesklet->iTopSurfaceOffset + pDesklet->iBottomSurfaceOffset) / h) + (pDesklet->iBottomSurfaceOffset - pDesklet->iTopSurfaceOffset)/2;
+	}
+	
+	double fDepthRotationY = (fabs (pDesklet->fDepthRotationY) > ANGLE_MIN ? pDesklet->fDepthRotationY : 0.);
+	double fDepthRotationX = (fabs (pDesklet->fDepthRotationX) > ANGLE_MIN ? pDesklet->fDepthRotationX : 0.);
+	if (fDepthRotationX != 0)  // les rotations sont appliquees dans l'ordre inverse des glRotatef.
+	{
+		a = - fDepthRotationX;
+		c = cos (a); s = sin (a);
+		t = y * c - z * s;
+		z = y * s + z * c;
+		y = t;
+	}
+	if (fDepthRotationY != 0)
+	{
+		a = - fDepthRotationY;
+		c = cos (a); s = sin (a);
+		t = x * c + z * s;
+		z = - x * s + z * c;
+		x = t;
+	}
+	if (fabs (pDesklet->fRotation) > ANGLE_MIN)
+	{
+		a = - pDesklet->fRotation;
+		c = cos (a); s = sin (a);
+		t = x * c - y * s;
+		y = x * s + y * c;
+		x = t;
+		double fZoom = _compute_zoom_for_rotation (pDesklet);
+		x *= fZoom;
+		y *= fZoom;
+	}
+	x *= pDesklet->container.fRatio;
+	y *= pDesklet->container.fRatio;
+	z -= h * sqrt(3)/2 + .45 * MAX (w * fabs (sin (fDepthRotationY)), h * fabs (sin (fDepthRotationX)));
+	
+	if (z >= 0)  // derriere la camera.
+		return FALSE;
+	double f = sqrt (3);  // 1/tan(30 deg), la perspective est de 60 deg.
+	*wx = (f * h / w * x / (-z) + 1) * w / 2;
+	*wy = (f * y / (-z) + 1) * h / 2;
+	return TRUE;
+}
+
+static gboolean _box_contains_mouse (CairoDesklet *pDesklet, CairoDeskletBoundingBox *pBox, double fMouseX, double fMouseY)
+{
+	double w = pBox->fWidth/2, h = pBox->fHeight/2;
+	double dx[4] = {-w, w, w, -w}, dy[4] = {h, h, -h, -h};
+	double px[4], py[4];
+	int i;
+	for (i = 0; i < 4; i ++)
+	{
+		if (! _project_point_on_desklet (pDesklet, pBox->x + dx[i], pBox->y + dy[i], pBox->z, &px[i], &py[i]))
+			return FALSE;
+	}
+	// le quadrilatere projete est convexe : la souris est dedans si elle est du meme cote de chaque arete.
+	int iSign = 0;
+	double d;
+	for (i = 0; i < 4; i ++)
+	{
+		d = (px[(i+1)%4] - px[i]) * (fMouseY - py[i]) - (py[(i+1)%4] - py[i]) * (fMouseX - px[i]);
+		if (d == 0)
+			continue;
+		if (iSign == 0)
+			iSign = (d > 0 ? 1 : -1);
+		else if ((d > 0 ? 1 : -1) != iSign)
+			return FALSE;
+	}
+	return (iSign != 0);
+}
+
+static void _append_icon_box (CairoDesklet *pDesklet, Icon *pIcon, GArray *pBoxes)
+{
+	if (pIcon == NULL || pIcon->image.iTexture == 0)
+		return;
+	CairoDeskletBoundingBox box;
+	box.pIcon = pIcon;
+	box.fWidth = pIcon->fWidth;
+	box.fHeight = pIcon->fHeight;
+	box.x = pIcon->fDrawX + pIcon->fWidth/2 - pDesklet->container.iWidth/2;
+	box.y = pDesklet->container.iHeight/2 - pIcon->fDrawY - pIcon->fHeight/2;
+	box.z = 0.;
+	g_array_append_val (pBoxes, box);
+}
+
+static Icon *_cairo_dock_pick_icon_on_desklet_analytic (CairoDesklet *pDesklet)
+{
+	GArray *pBoxes = g_array_sized_new (FALSE, FALSE, sizeof (CairoDeskletBoundingBox), g_list_length (pDesklet->icons) + 1);
+	if (pDesklet->pRenderer && pDesklet->pRenderer->get_bounding_boxes != NULL)
+	{
+		pDesklet->pRenderer->get_bounding_boxes (pDesklet, pBoxes);
+	}
+	else  // on le fait nous-memes a partir des coordonnees des icones.
+	{
+		_append_icon_box (pDesklet, pDesklet->pIcon, pBoxes);
+		GList *ic;
+		for (ic = pDesklet->icons; ic != NULL; ic = ic->next)
+			_append_icon_box (pDesklet, ic->data, pBoxes);
+	}
+	
+	pDesklet->iPickedObject = 0;
+	Icon *pFoundIcon = NULL;
+	double fMouseX = pDesklet->container.iMouseX, fMouseY = pDesklet->container.iHeight - pDesklet->container.iMouseY;
+	guint i;
+	for (i = 0; i < pBoxes->len; i ++)  // comme avec GL_SELECT, la premiere boite dessinee l'emporte.
+	{
+		CairoDeskletBoundingBox *pBox = &g_array_index (pBoxes, CairoDeskletBoundingBox, i);
+		if (_box_contains_mouse (pDesklet, pBox, fMouseX, fMouseY))
+		{
+			pFoundIcon = pBox->pIcon;
+			break;
+		}
+	}
+	g_array_free (pBoxes, TRUE);
+	return pFoundIcon;
+}
+
+// only used when the bounding boxes are drawn by the desklet or its renderer.
 static Icon *_cairo_dock_pick_icon_on_opengl_desklet (CairoDesklet *pDesklet)
 {
 	GLuint selectBuf[4];
@@ -505,57 +632,10 @@ static Icon *_cairo_dock_pick_icon_on_opengl_desklet (CairoDesklet *pDesklet)
 	{
 		pDesklet->render_bounding_box (pDesklet);
 	}
-	else if (pDesklet->pRenderer && pDesklet->pRenderer->render_bounding_box != NULL)
+	else
 	{
 		pDesklet->pRenderer->render_bounding_box (pDesklet);
 	}
-	else  // on le fait nous-memes a partir des coordonnees des icones.
-	{
-		glTranslatef (-pDesklet->container.iWidth/2, -pDesklet->container.iHeight/2, 0.);
-		
-		double x, y, w, h;
-		Icon *pIcon;
-		
-		pIcon = pDesklet->pIcon;
-		if (pIcon != NULL && pIcon->image.iTexture != 0)
-		{
-			w = pIcon->fWidth/2;
-			h = pIcon->fHeight/2;
-			x = pIcon->fDrawX + w;
-			y = pDesklet->container.iHeight - pIcon->fDrawY - h;
-			
-			glLoadName(pIcon->image.iTexture);
-			
-			glBegin(GL_QUADS);
-			glVertex3f(x-w, y+h, 0.);
-			glVertex3f(x+w, y+h, 0.);
-			glVertex3f(x+w, y-h, 0.);
-			glVertex3f(x-w, y-h, 0.);
-			glEnd();
-		}
-		
-		GList *ic;
-		for (ic = pDesklet->icons; ic != NULL; ic = ic->next)
-		{
-			pIcon = ic->data;
-			if (pIcon->image.iTexture == 0)
-				continue;
-			
-			w = pIcon->fWidth/2;
-			h = pIcon->fHeight/2;
-			x = pIcon->fDrawX + w;
-			y = pDesklet->container.iHeight - pIcon->fDrawY - h;
-			
-			glLoadName(pIcon->image.iTexture);
-			
-			glBegin(GL_QUADS);
-			glVertex3f(x-w, y+h, 0.);
-			glVertex3f(x+w, y+h, 0.);
-			glVertex3f(x+w, y-h, 0.);
-			glVertex3f(x-w, y-h, 0.);
-			glEnd();
-		}
-	}
 	
 	glPopName();
 	
@@ -611,7 +691,10 @@ Icon *gldi_desklet_find_clicked_icon (CairoDesklet *pDesklet)
 {
 	if (g_bUseOpenGL && pDesklet->pRenderer && pDesklet->pRenderer->render_opengl)
 	{
-		return _cairo_dock_pick_icon_on_opengl_desklet (pDesklet);
+		if (pDesklet->render_bounding_box != NULL
+		|| (pDesklet->pRenderer->render_bounding_box != NULL && pDesklet->pRenderer->get_bounding_boxes == NULL))
+			return _cairo_dock_pick_icon_on_opengl_desklet (pDesklet);
+		return _cairo_dock_pick_icon_on_desklet_analytic (pDesklet);
 	}
 	
 	int iMouseX = pDesklet->container.iMouseX, iMouseY = pDesklet->container.iMouseY;
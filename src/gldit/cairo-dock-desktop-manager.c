@@ -20,6 +20,8 @@
 #include "cairo-dock-log.h"
 #include "cairo-dock-desklet-manager.h"  // cairo_dock_foreach_desklet
 #include "cairo-dock-desklet-factory.h"
+#include "cairo-dock-dock-manager.h"  // gldi_docks_redraw_all_root
+#include "cairo-dock-task.h"
 #include "cairo-dock-draw-opengl.h"  // cairo_dock_create_texture_from_surface
 #include "cairo-dock-compiz-integration.h"
 #include "cairo-dock-kwin-integration.h"
@@ -38,6 +40,8 @@ extern GldiContainer *g_pPrimaryContainer;
 // private
 static GldiDesktopBackground *s_pDesktopBg = NULL;  // une fois alloue, le pointeur restera le meme tout le temps.
 static GldiDesktopManagerBackend s_backend;
+static GldiTask *s_pBgCaptureTask = NULL;  // capture of the desktop background in progress.
+static gboolean s_bBgWithTexture = FALSE;  // whether someone needs the background as a texture.
 
 static void _reload_desktop_background (void);
 
@@ -228,6 +232,88 @@ gboolean gldi_desktop_grab_shortkey (guint keycode, guint modifiers, gboolean gr
  /// DESKTOP BG ///
 //////////////////
 
+typedef struct {
+	cairo_surface_t* (*capture) (gpointer pCaptureData);
+	GFreeFunc free_capture;
+	gpointer pCaptureData;
+	cairo_surface_t *pSurface;
+	} GldiDesktopBgCapture;
+
+static void _capture_bg_threaded (GldiDesktopBgCapture *pCapture)
+{
+	pCapture->pSurface = pCapture->capture (pCapture->pCaptureData);
+}
+
+static gboolean _redraw_desklet (CairoDesklet *pDesklet, G_GNUC_UNUSED gpointer data)
+{
+	gtk_widget_queue_draw (pDesklet->container.pWidget);
+	return FALSE;  // continue
+}
+static void _set_desktop_bg_surface (cairo_surface_t *pSurface)
+{
+	if (s_pDesktopBg->pSurface != NULL)
+		cairo_surface_destroy (s_pDesktopBg->pSurface);
+	s_pDesktopBg->pSurface = pSurface;
+	s_pDesktopBg->iStamp ++;
+	
+	if (s_pDesktopBg->iTexture != 0 || s_bBgWithTexture)
+	{
+		if (s_pDesktopBg->iTexture != 0)
+			_cairo_dock_delete_texture (s_pDesktopBg->iTexture);
+		s_pDesktopBg->iTexture = (pSurface ? cairo_dock_create_texture_from_surface (pSurface) : 0);
+	}
+}
+
+static gboolean _on_bg_captured (GldiDesktopBgCapture *pCapture)
+{
+	gldi_task_discard (s_pBgCaptureTask);  // one-shot task, it will be freed once we return.
+	s_pBgCaptureTask = NULL;
+	if (s_pDesktopBg == NULL || s_pDesktopBg->iRefCount == 0)  // nobody needs it any more.
+		return FALSE;
+	
+	if (pCapture->pSurface == NULL)  // the backend couldn't grab it asynchronously (unusual pixmap format), do it the slow way.
+		pCapture->pSurface = _get_desktop_bg_surface ();
+	cd_debug ("desktop background captured (%p)", pCapture->pSurface);
+	_set_desktop_bg_surface (pCapture->pSurface);
+	pCapture->pSurface = NULL;  // now it belongs to the desktop background.
+	
+	gldi_docks_redraw_all_root ();
+	gldi_desklets_foreach ((GldiDeskletForeachFunc) _redraw_desklet, NULL);
+	return FALSE;
+}
+
+static void _free_bg_capture (GldiDesktopBgCapture *pCapture)
+{
+	if (pCapture->pSurface != NULL)
+		cairo_surface_destroy (pCapture->pSurface);
+	if (pCapture->pCaptureData != NULL)
+		pCapture->free_capture (pCapture->pCaptureData);
+	g_free (pCapture);
+}
+
+static gboolean _capture_desktop_bg_async (void)
+{
+	if (! s_backend.prepare_desktop_bg_capture || ! s_backend.capture_desktop_bg_surface)
+		return FALSE;
+	gpointer pCaptureData = s_backend.prepare_desktop_bg_capture ();
+	if (pCaptureData == NULL)
+		return FALSE;
+	
+	if (s_pBgCaptureTask != NULL)  // a capture is already on its way but it's outdated, let it finish in the void.
+		gldi_task_discard (s_pBgCaptureTask);
+	GldiDesktopBgCapture *pCapture = g_new0 (GldiDesktopBgCapture, 1);
+	pCapture->capture = s_backend.capture_desktop_bg_surface;
+	pCapture->free_capture = s_backend.free_desktop_bg_capture;
+	pCapture->pCaptureData = pCaptureData;
+	s_pBgCaptureTask = gldi_task_new_full (0,
+		(GldiGetDataAsyncFunc) _capture_bg_threaded,
+		(GldiUpdateSyncFunc) _on_bg_captured,
+		(GFreeFunc) _free_bg_capture,
+		pCapture);
+	gldi_task_launch (s_pBgCaptureTask);
+	return TRUE;
+}
+
 GldiDesktopBackground *gldi_desktop_background_get (gboolean bWithTextureToo)
 {
 	//g_print ("%s (%d, %d)\n", __func__, bWithTextureToo, s_pDesktopBg?s_pDesktopBg->iRefCount:-1);
@@ -235,11 +321,14 @@ GldiDesktopBackground *gldi_desktop_background_get (gboolean bWithTextureToo)
 	{
 		s_pDesktopBg = g_new0 (GldiDesktopBackground, 1);
 	}
-	if (s_pDesktopBg->pSurface == NULL)
+	if (bWithTextureToo)
+		s_bBgWithTexture = TRUE;
+	if (s_pDesktopBg->pSurface == NULL && s_pBgCaptureTask == NULL)
 	{
-		s_pDesktopBg->pSurface = _get_desktop_bg_surface ();
+		if (! _capture_desktop_bg_async ())  // the surface (and the texture) will be set once it's captured; until then, the containers are drawn without background.
+			_set_desktop_bg_surface (_get_desktop_bg_surface ());
 	}
-	if (s_pDesktopBg->iTexture == 0 && bWithTextureToo)
+	if (s_pDesktopBg->iTexture == 0 && bWithTextureToo && s_pDesktopBg->pSurface != NULL)
 	{
 		s_pDesktopBg->iTexture = cairo_dock_create_texture_from_surface (s_pDesktopBg->pSurface);
 	}
@@ -303,21 +392,11 @@ static void _reload_desktop_background (void)
 	//g_print ("%s ()\n", __func__);
 	if (s_pDesktopBg == NULL)  // rien a recharger.
 		return ;
-	if (s_pDesktopBg->pSurface == NULL && s_pDesktopBg->iTexture == 0)  // rien a recharger.
+	if (s_pDesktopBg->iRefCount == 0)  // rien a recharger.
 		return ;
 	
-	if (s_pDesktopBg->pSurface != NULL)
-	{
-		cairo_surface_destroy (s_pDesktopBg->pSurface);
-		//g_print ("--- surface destroyed\n");
-	}
-	s_pDesktopBg->pSurface = _get_desktop_bg_surface ();
-	
-	if (s_pDesktopBg->iTexture != 0)
-	{
-		_cairo_dock_delete_texture (s_pDesktopBg->iTexture);
-		s_pDesktopBg->iTexture = cairo_dock_create_texture_from_surface (s_pDesktopBg->pSurface);
-	}
+	if (! _capture_desktop_bg_async ())  // the current background is kept until the new one is ready.
+		_set_desktop_bg_surface (_get_desktop_bg_surface ());
 }
 
 
@@ -332,6 +411,12 @@ static void unload (void)
 		_cairo_dock_delete_texture (s_pDesktopBg->iTexture);
 		s_pDesktopBg->iTexture = 0;
 	}*/
+	if (s_pBgCaptureTask != NULL)
+	{
+		gldi_task_discard (s_pBgCaptureTask);
+		s_pBgCaptureTask = NULL;
+	}
+	s_bBgWithTexture = FALSE;
 	if (s_pDesktopBg)  // on decharge le desktop-bg de force.
 	{
 		if (s_pDesktopBg->iSidDestroyBg != 0)
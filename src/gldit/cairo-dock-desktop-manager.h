@@ -87,6 +87,10 @@ struct _GldiDesktopManagerBackend {
 	void (*refresh) (void);
 	void (*notify_startup) (const gchar *cClass);
 	gboolean (*grab_shortkey) (guint keycode, guint modifiers, gboolean grab);
+	// asynchronous capture of the desktop background: 'prepare' is called in the main thread and returns the data that 'capture' will use in a thread (and that 'free' will destroy).
+	gpointer (*prepare_desktop_bg_capture) (void);
+	cairo_surface_t* (*capture_desktop_bg_surface) (gpointer pCaptureData);
+	void (*free_desktop_bg_capture) (gpointer pCaptureData);
 	};
 
 /// Definition of a Desktop Background Buffer. It has a reference count so that it can be shared across all the lib.
@@ -95,6 +99,7 @@ struct _GldiDesktopBackground {
 	GLuint iTexture;
 	guint iSidDestroyBg;
 	gint iRefCount;
+	guint iStamp;  // incremented each time the surface changes, so that containers can invalidate what they cached from it.
 	} ;
 
 
@@ -295,13 +295,15 @@ static cairo_surface_t *_cairo_dock_create_dialog_icon_surface (const gchar *cIm
 	cairo_surface_t *pIconBuffer = NULL;
 	if (strcmp (cImageFilePath, "same icon") == 0)
 	{
-		if (pIcon && pIcon->image.pSurface)
+		cairo_surface_t *pIconSurface = (pIcon ? cairo_dock_image_buffer_ref_surface (&pIcon->image) : NULL);
+		if (pIconSurface)
 		{
 			int iWidth, iHeight;
 			cairo_dock_get_icon_extent (pIcon, &iWidth, &iHeight);
-			pIconBuffer = cairo_dock_duplicate_surface (pIcon->image.pSurface,
+			pIconBuffer = cairo_dock_duplicate_surface (pIconSurface,
 				iWidth, iHeight,
 				iDesiredSize, iDesiredSize);
+			cairo_surface_destroy (pIconSurface);
 		}
 		else if (pIcon && pIcon->cFileName)
 		{
@@ -36,6 +36,10 @@
 #include "cairo-dock-desktop-manager.h"  // gldi_desktop_get*
 #include "cairo-dock-data-renderer.h"  // cairo_dock_reload_data_renderer_on_icon
 #include "cairo-dock-opengl.h"  // gldi_gl_container_begin_draw
+#include "cairo-dock-module-instance-manager.h"  // gldi_module_instances_init_deferred_in_dock
+#include "cairo-dock-trace.h"  // gldi_trace
+#include "cairo-dock-profiler.h"  // gldi_profile_begin
+#include "cairo-dock-texture-manager.h"  // gldi_textures_restore_dock
 
 extern CairoDockGLConfig g_openglConfig;
 #include "cairo-dock-dock-facility.h"
@@ -288,7 +292,15 @@ static void cairo_dock_manage_mouse_position (CairoDock *pDock)
 }
 Icon *cairo_dock_calculate_dock_icons (CairoDock *pDock)
 {
+	gint64 iTraceStartTime = (G_UNLIKELY (g_bGldiTraceEnabled) ? g_get_monotonic_time () : 0);
+	gint64 iProfileTime = gldi_profile_begin ();
 	Icon *pPointedIcon = pDock->pRenderer->calculate_icons (pDock);
+	gldi_profile_end (iProfileTime, GLDI_PROFILE_LAYOUT, pDock, gldi_dock_get_name (pDock), NULL);
+	if (G_UNLIKELY (g_bGldiTraceEnabled))
+	{
+		static guint s_iLayoutEvent = 0;
+		gldi_trace (gldi_trace_get_event (&s_iLayoutEvent, "dock-layout"), pDock->iRefCount, g_get_monotonic_time () - iTraceStartTime);  // sub-dock or not, duration
+	}
 	cairo_dock_manage_mouse_position (pDock);
 	return pPointedIcon;
 	/**if (pDock->iMousePositionType == CAIRO_DOCK_MOUSE_INSIDE)
@@ -1036,6 +1048,12 @@ void cairo_dock_show_subdock (Icon *pPointedIcon, CairoDock *pParentDock)
 		return ;
 	}
 	
+	// the applets inside may not be initialized yet.
+	gldi_module_instances_init_deferred_in_dock (pSubDock);
+	
+	// and the other icons may have released their image while it was hidden.
+	gldi_textures_restore_dock (pSubDock);
+	
 	// place the sub-dock
 	pSubDock->pRenderer->set_subdock_position (pPointedIcon, pParentDock);
 	
@@ -1353,7 +1371,7 @@ static void _cairo_dock_load_default_background (CairoDockImageBuffer *pImage, i
 				myDocksParam.cBackgroundImageFile,
 				iWidth,
 				iHeight,
-				CAIRO_DOCK_FILL_SPACE,
+				CAIRO_DOCK_FILL_SPACE | CAIRO_DOCK_STATIC_IMAGE,
 				myDocksParam.fBackgroundImageAlpha);
 		}
 	}
@@ -1387,7 +1405,7 @@ void cairo_dock_load_dock_background (CairoDock *pDock)
 	}
 	else if (pDock->cBgImagePath != NULL)
 	{
-		cairo_dock_load_image_buffer (&pDock->backgroundBuffer, pDock->cBgImagePath, iWidth, iHeight, CAIRO_DOCK_FILL_SPACE);
+		cairo_dock_load_image_buffer (&pDock->backgroundBuffer, pDock->cBgImagePath, iWidth, iHeight, CAIRO_DOCK_FILL_SPACE | CAIRO_DOCK_STATIC_IMAGE);
 	}
 	if (pDock->backgroundBuffer.pSurface == NULL)
 	{
@@ -34,13 +34,14 @@
 #include "cairo-dock-module-instance-manager.h"  // pModuleInstance->
 #include "cairo-dock-icon-factory.h"
 #include "cairo-dock-icon-facility.h"
+#include "cairo-dock-icon-index.h"
 #include "cairo-dock-applications-manager.h"  // myTaskbarParam.bHideVisibleApplis
 #include "cairo-dock-stack-icon-manager.h"
 #include "cairo-dock-separator-manager.h"
 #include "cairo-dock-class-icon-manager.h"
 #include "cairo-dock-application-facility.h"
 #include "cairo-dock-launcher-manager.h"
-#include "cairo-dock-config.h"  // cairo_dock_is_loading
+#include "cairo-dock-config.h"  // cairo_dock_is_loading_main_dock
 #include "cairo-dock-dock-facility.h"
 #include "cairo-dock-log.h"
 #include "cairo-dock-menu.h"  // gldi_menu_popup
@@ -51,6 +52,8 @@
 #include "cairo-dock-class-manager.h"  // cairo_dock_check_class_subdock_is_empty
 #include "cairo-dock-desktop-manager.h"
 #include "cairo-dock-windows-manager.h"  // gldi_windows_get_active
+#include "cairo-dock-trace.h"  // gldi_trace
+#include "cairo-dock-profiler.h"  // gldi_profile_begin
 #include "cairo-dock-dock-factory.h"
 
 // dependencies
@@ -130,6 +133,8 @@ void cairo_dock_freeze_docks (gboolean bFreeze)
 
 static gboolean _on_expose (G_GNUC_UNUSED GtkWidget *pWidget, cairo_t *pCairoContext, CairoDock *pDock)
 {
+	gint64 iTraceStartTime = (G_UNLIKELY (g_bGldiTraceEnabled) ? g_get_monotonic_time () : 0);
+	gint64 iProfileTime = gldi_profile_begin ();
 	if (g_bUseOpenGL && pDock->pRenderer->render_opengl != NULL)  // OpenGL rendering
 	{
 		GdkRectangle area;
@@ -140,10 +145,14 @@ static gboolean _on_expose (G_GNUC_UNUSED GtkWidget *pWidget, cairo_t *pCairoCon
 		area.width = x2 - x1;
 		area.height = y2 - y1;
 		
-		if (! gldi_gl_container_begin_draw_full (CAIRO_CONTAINER (pDock), area.x + area.y != 0 ? &area : NULL, TRUE))
+		int iWindowWidth = (pDock->container.bIsHorizontal ? pDock->container.iWidth : pDock->container.iHeight);
+		int iWindowHeight = (pDock->container.bIsHorizontal ? pDock->container.iHeight : pDock->container.iWidth);
+		gboolean bFullRedraw = (area.x <= 0 && area.y <= 0 && area.width >= iWindowWidth && area.height >= iWindowHeight);
+		
+		if (! gldi_gl_container_begin_draw_full (CAIRO_CONTAINER (pDock), bFullRedraw ? NULL : &area, TRUE))
 			return FALSE;
 		
-		if (cairo_dock_is_loading ())
+		if (cairo_dock_is_loading_main_dock ())
 		{
 			// don't draw anything, just let it transparent
 		}
@@ -162,7 +171,7 @@ static gboolean _on_expose (G_GNUC_UNUSED GtkWidget *pWidget, cairo_t *pCairoCon
 	{
 		cairo_dock_init_drawing_context_on_container (CAIRO_CONTAINER (pDock), pCairoContext);
 		
-		if (cairo_dock_is_loading ())
+		if (cairo_dock_is_loading_main_dock ())
 		{
 			// don't draw anything, just let it transparent
 		}
@@ -175,6 +184,13 @@ static gboolean _on_expose (G_GNUC_UNUSED GtkWidget *pWidget, cairo_t *pCairoCon
 			gldi_object_notify (pDock, NOTIFICATION_RENDER, pDock, pCairoContext);
 		}
 	}
+	
+	if (G_UNLIKELY (g_bGldiTraceEnabled))
+	{
+		static guint s_iDrawEvent = 0;
+		gldi_trace (gldi_trace_get_event (&s_iDrawEvent, "dock-draw"), pDock->iRefCount, g_get_monotonic_time () - iTraceStartTime);  // sub-dock or not, duration
+	}
+	gldi_profile_end (iProfileTime, GLDI_PROFILE_FRAME, pDock, gldi_dock_get_name (pDock), "dock");
 	return FALSE;
 }
 
@@ -355,19 +371,94 @@ static void _cairo_dock_make_icon_glide (Icon *pPointedIcon, Icon *pMovingicon,
 		}
 	}
 }
+static void _on_motion_done (GtkWidget* pWidget, CairoDock *pDock, Icon *pLastPointedIcon, Icon *pPointedIcon)
+{
+	gtk_widget_queue_draw (pWidget);
+	
+	//\_______________ On gere le changement d'icone.
+	gboolean bStartAnimation = FALSE;
+	if (pPointedIcon != pLastPointedIcon)
+	{
+		_on_change_icon (pLastPointedIcon, pPointedIcon, pDock);
+		
+		if (pPointedIcon != NULL && s_pIconClicked != NULL && s_pIconClicked->iGroup == pPointedIcon->iGroup && ! myDocksParam.bLockIcons && ! myDocksParam.bLockAll && ! pDock->bPreventDraggingIcons)
+		{
+			_cairo_dock_make_icon_glide (pPointedIcon, s_pIconClicked, pDock);
+			bStartAnimation = TRUE;
+		}
+	}
+	
+	//\_______________ On notifie tout le monde.
+	gldi_object_notify (pDock, NOTIFICATION_MOUSE_MOVED, pDock, &bStartAnimation);
+	if (bStartAnimation)
+		cairo_dock_launch_animation (CAIRO_CONTAINER (pDock));
+}
+
+static void _on_pointer_moved (GtkWidget* pWidget, CairoDock *pDock)
+{
+	Icon *pLastPointedIcon = cairo_dock_get_pointed_icon (pDock->icons);
+	
+	//\_______________ On recalcule toutes les icones.
+	Icon *pPointedIcon = cairo_dock_calculate_dock_icons (pDock);
+	//g_print ("pPointedIcon: %s\n", pPointedIcon?pPointedIcon->cName:"none");
+	
+	//\_______________ On tire l'icone cliquee.
+	int x = (pDock->container.bIsHorizontal ? pDock->container.iMouseX : pDock->container.iMouseY);  // coordonnees de la fenetre, comme le clic.
+	int y = (pDock->container.bIsHorizontal ? pDock->container.iMouseY : pDock->container.iMouseX);
+	if (s_pIconClicked != NULL && s_pIconClicked->iAnimationState != CAIRO_DOCK_STATE_REMOVE_INSERT && ! myDocksParam.bLockIcons && ! myDocksParam.bLockAll && (fabs (x - s_iClickX) > CD_CLICK_ZONE || fabs (y - s_iClickY) > CD_CLICK_ZONE) && ! pDock->bPreventDraggingIcons)
+	{
+		s_bIconDragged = TRUE;
+		cairo_dock_mark_icon_as_following_mouse (s_pIconClicked);
+		//pDock->fAvoidingMouseMargin = .5;
+		pDock->iAvoidingMouseIconType = s_pIconClicked->iGroup;  // on pourrait le faire lors du clic aussi.
+		s_pIconClicked->fScale = cairo_dock_get_icon_max_scale (s_pIconClicked);
+		s_pIconClicked->fDrawX = pDock->container.iMouseX  - s_pIconClicked->fWidth * s_pIconClicked->fScale / 2;
+		s_pIconClicked->fDrawY = pDock->container.iMouseY - s_pIconClicked->fHeight * s_pIconClicked->fScale / 2 ;
+		s_pIconClicked->fAlpha = 0.75;
+	}
+	
+	_on_motion_done (pWidget, pDock, pLastPointedIcon, pPointedIcon);
+}
+
+// the layout is computed once per frame, with the last position of the mouse, whatever the rate of the motion events.
+#if GTK_CHECK_VERSION (3, 8, 0)
+static gboolean _on_motion_frame (G_GNUC_UNUSED GtkWidget* pWidget, G_GNUC_UNUSED GdkFrameClock *pFrameClock, CairoDock *pDock)
+#else
+static gboolean _on_motion_frame (CairoDock *pDock)
+#endif
+{
+	pDock->iSidMotionFrame = 0;
+	if (! s_bFrozenDock)
+		_on_pointer_moved (pDock->container.pWidget, pDock);
+	
+	if (pDock->pMotionDevice != NULL)  // the dock only receives motion hints, so ask for the next motion event now.
+		gdk_device_get_state (pDock->pMotionDevice, gldi_container_get_gdk_window (CAIRO_CONTAINER (pDock)), NULL, NULL);
+	return G_SOURCE_REMOVE;
+}
+
+static void _cancel_motion_frame (CairoDock *pDock)
+{
+	if (pDock->iSidMotionFrame == 0)
+		return;
+	#if GTK_CHECK_VERSION (3, 8, 0)
+	gtk_widget_remove_tick_callback (pDock->container.pWidget, pDock->iSidMotionFrame);
+	#else
+	g_source_remove (pDock->iSidMotionFrame);
+	#endif
+	pDock->iSidMotionFrame = 0;
+}
+
 static gboolean _on_motion_notify (GtkWidget* pWidget,
 	GdkEventMotion* pMotion,
 	CairoDock *pDock)
 {
-	static double fLastTime = 0;
 	if (s_bFrozenDock && pMotion != NULL && pMotion->time != 0)
 		return FALSE;
-	Icon *pPointedIcon=NULL, *pLastPointedIcon = cairo_dock_get_pointed_icon (pDock->icons);
 	//g_print ("%s (%.2f;%.2f, %d)\n", __func__, pMotion->x, pMotion->y, pDock->iInputState);
 	
 	if (pMotion != NULL)
 	{
-		//g_print ("%s (%d,%d) (%d, %.2fms, bAtBottom:%d; bIsShrinkingDown:%d)\n", __func__, (int) pMotion->x, (int) pMotion->y, pMotion->is_hint, pMotion->time - fLastTime, pDock->bAtBottom, pDock->bIsShrinkingDown);
+		//g_print ("%s (%d,%d) (%d, bAtBottom:%d; bIsShrinkingDown:%d)\n", __func__, (int) pMotion->x, (int) pMotion->y, pMotion->is_hint, pDock->bAtBottom, pDock->bIsShrinkingDown);
 		//\_______________ On deplace le dock si ALT est enfoncee.
 		if ((pMotion->state & GDK_MOD1_MASK) && (pMotion->state & GDK_BUTTON1_MASK))
 		{
@@ -409,67 +500,40 @@ static gboolean _on_motion_notify (GtkWidget* pWidget,
 			gldi_flying_container_drag (s_pFlyingContainer, pDock);
 		}
 		
-		//\_______________ On elague le flux des MotionNotify, sinon X en envoie autant que le permet le CPU !
-		if (pMotion->time != 0 && pMotion->time - fLastTime < myBackendsParam.fRefreshInterval && s_pIconClicked == NULL)
+		//\_______________ On elague le flux des MotionNotify, sinon X en envoie autant que le permet le CPU : on ne garde que la derniere position, qui sera traitee a la prochaine image.
+		if (pMotion->time != 0)
 		{
-			gdk_device_get_state (pMotion->device, pMotion->window, NULL, NULL);
+			pDock->pMotionDevice = pMotion->device;
+			if (pDock->iSidMotionFrame == 0)
+			{
+				#if GTK_CHECK_VERSION (3, 8, 0)
+				pDock->iSidMotionFrame = gtk_widget_add_tick_callback (pWidget, (GtkTickCallback) _on_motion_frame, pDock, NULL);
+				#else
+				pDock->iSidMotionFrame = g_timeout_add (myBackendsParam.fRefreshInterval, (GSourceFunc) _on_motion_frame, pDock);
+				#endif
+			}
 			return FALSE;
 		}
 		
-		//\_______________ On recalcule toutes les icones et on redessine.
-		pPointedIcon = cairo_dock_calculate_dock_icons (pDock);
-		//g_print ("pPointedIcon: %s\n", pPointedIcon?pPointedIcon->cName:"none");
-		gtk_widget_queue_draw (pWidget);
-		fLastTime = pMotion->time;
-		
-		//\_______________ On tire l'icone cliquee.
-		if (s_pIconClicked != NULL && s_pIconClicked->iAnimationState != CAIRO_DOCK_STATE_REMOVE_INSERT && ! myDocksParam.bLockIcons && ! myDocksParam.bLockAll && (fabs (pMotion->x - s_iClickX) > CD_CLICK_ZONE || fabs (pMotion->y - s_iClickY) > CD_CLICK_ZONE) && ! pDock->bPreventDraggingIcons)
-		{
-			s_bIconDragged = TRUE;
-			cairo_dock_mark_icon_as_following_mouse (s_pIconClicked);
-			//pDock->fAvoidingMouseMargin = .5;
-			pDock->iAvoidingMouseIconType = s_pIconClicked->iGroup;  // on pourrait le faire lors du clic aussi.
-			s_pIconClicked->fScale = cairo_dock_get_icon_max_scale (s_pIconClicked);
-			s_pIconClicked->fDrawX = pDock->container.iMouseX  - s_pIconClicked->fWidth * s_pIconClicked->fScale / 2;
-			s_pIconClicked->fDrawY = pDock->container.iMouseY - s_pIconClicked->fHeight * s_pIconClicked->fScale / 2 ;
-			s_pIconClicked->fAlpha = 0.75;
-		}
-
-		//gdk_event_request_motions (pMotion);  // ce sera pour GDK 2.12.
-		gdk_device_get_state (pMotion->device, pMotion->window, NULL, NULL);  // pour recevoir d'autres MotionNotify.
+		_on_pointer_moved (pWidget, pDock);
 	}
 	else  // cas d'un drag and drop.
 	{
 		//g_print ("motion on drag\n");
+		Icon *pLastPointedIcon = cairo_dock_get_pointed_icon (pDock->icons);
+		
 		//\_______________ On recupere la position de la souris.
 		gldi_container_update_mouse_position (CAIRO_CONTAINER (pDock));
 		
-		//\_______________ On recalcule toutes les icones et on redessine.
-		pPointedIcon = cairo_dock_calculate_dock_icons (pDock);
-		gtk_widget_queue_draw (pWidget);
+		//\_______________ On recalcule toutes les icones.
+		Icon *pPointedIcon = cairo_dock_calculate_dock_icons (pDock);
 		
 		pDock->fAvoidingMouseMargin = .25;  // on peut dropper entre 2 icones ...
 		pDock->iAvoidingMouseIconType = CAIRO_DOCK_LAUNCHER;  // ... seulement entre 2 icones du groupe "lanceurs".
-	}
-	
-	//\_______________ On gere le changement d'icone.
-	gboolean bStartAnimation = FALSE;
-	if (pPointedIcon != pLastPointedIcon)
-	{
-		_on_change_icon (pLastPointedIcon, pPointedIcon, pDock);
 		
-		if (pPointedIcon != NULL && s_pIconClicked != NULL && s_pIconClicked->iGroup == pPointedIcon->iGroup && ! myDocksParam.bLockIcons && ! myDocksParam.bLockAll && ! pDock->bPreventDraggingIcons)
-		{
-			_cairo_dock_make_icon_glide (pPointedIcon, s_pIconClicked, pDock);
-			bStartAnimation = TRUE;
-		}
+		_on_motion_done (pWidget, pDock, pLastPointedIcon, pPointedIcon);
 	}
 	
-	//\_______________ On notifie tout le monde.
-	gldi_object_notify (pDock, NOTIFICATION_MOUSE_MOVED, pDock, &bStartAnimation);
-	if (bStartAnimation)
-		cairo_dock_launch_animation (CAIRO_CONTAINER (pDock));
-	
 	return FALSE;
 }
 
@@ -540,6 +604,9 @@ static gboolean _on_leave_notify (G_GNUC_UNUSED GtkWidget* pWidget, GdkEventCros
 		return FALSE;
 	}
 	
+	//\_______________ the last motion is inside the dock, don't handle it once we're out.
+	_cancel_motion_frame (pDock);
+	
 	//\_______________ On retarde la sortie.
 	if (pEvent != NULL)  // sortie naturelle.
 	{
@@ -1831,6 +1898,8 @@ static gboolean _cairo_dock_dock_animation_loop (GldiContainer *pContainer)
 		}
 		
 		bContinue |= bIconIsAnimating;
+		if (bIconIsAnimating && icon->pModuleInstance != NULL)
+			gldi_module_instance_add_frame (icon->pModuleInstance);
 		if (! bIconIsAnimating)
 		{
 			icon->iAnimationState = CAIRO_DOCK_STATE_REST;
@@ -1960,22 +2029,14 @@ static void _detach_icon (GldiContainer *pContainer, Icon *icon)
 	cd_debug ("%s (%s)", __func__, icon->cName);
 	
 	//\___________________ On trouve l'icone et ses 2 voisins.
-	GList *prev_ic = NULL, *ic, *next_ic;
+	GList *ic;
 	Icon *pPrevIcon = NULL, *pNextIcon = NULL;
-	for (ic = pDock->icons; ic != NULL; ic = ic->next)
-	{
-		if (ic->data == icon)
-		{
-			prev_ic = ic->prev;
-			next_ic = ic->next;
-			if (prev_ic)
-				pPrevIcon = prev_ic->data;
-			if (next_ic)
-				pNextIcon = next_ic->data;
-			break;
-		}
-	}
+	ic = cairo_dock_icon_index_find (pDock, icon);
 	g_return_if_fail (ic != NULL);  // not found (shouldn't happen)
+	if (ic->prev)
+		pPrevIcon = ic->prev->data;
+	if (ic->next)
+		pNextIcon = ic->next->data;
 	
 	//\___________________ On stoppe ses animations.
 	gldi_icon_stop_animation (icon);
@@ -1988,7 +2049,7 @@ static void _detach_icon (GldiContainer *pContainer, Icon *icon)
 	}
 	
 	//\___________________ On l'enleve de la liste.
-	pDock->icons = g_list_delete_link (pDock->icons, ic);
+	cairo_dock_icon_index_remove (pDock, icon);
 	ic = NULL;
 	pDock->fFlatDockWidth -= icon->fWidth + myIconsParam.iIconGap;
 	
@@ -1997,8 +2058,7 @@ static void _detach_icon (GldiContainer *pContainer, Icon *icon)
 	{
 		if ((pPrevIcon == NULL || CAIRO_DOCK_ICON_TYPE_IS_SEPARATOR (pPrevIcon)) && CAIRO_DOCK_IS_AUTOMATIC_SEPARATOR (pNextIcon))
 		{
-			pDock->icons = g_list_delete_link (pDock->icons, next_ic);  // optimisation
-			next_ic = NULL;
+			cairo_dock_icon_index_remove (pDock, pNextIcon);
 			pDock->fFlatDockWidth -= pNextIcon->fWidth + myIconsParam.iIconGap;
 			cairo_dock_set_icon_container (pNextIcon, NULL);
 			gldi_object_unref (GLDI_OBJECT (pNextIcon));
@@ -2006,8 +2066,7 @@ static void _detach_icon (GldiContainer *pContainer, Icon *icon)
 		}
 		if ((pNextIcon == NULL || CAIRO_DOCK_ICON_TYPE_IS_SEPARATOR (pNextIcon)) && CAIRO_DOCK_IS_AUTOMATIC_SEPARATOR (pPrevIcon))
 		{
-			pDock->icons = g_list_delete_link (pDock->icons, prev_ic);  // optimisation
-			prev_ic = NULL;
+			cairo_dock_icon_index_remove (pDock, pPrevIcon);
 			pDock->fFlatDockWidth -= pPrevIcon->fWidth + myIconsParam.iIconGap;
 			cairo_dock_set_icon_container (pPrevIcon, NULL);
 			gldi_object_unref (GLDI_OBJECT (pPrevIcon));
@@ -2075,7 +2134,7 @@ static void _insert_icon (GldiContainer *pContainer, Icon *icon, gboolean bAnima
 	gboolean bSeparatorNeeded = FALSE;
 	if (! CAIRO_DOCK_ICON_TYPE_IS_SEPARATOR (icon))
 	{
-		Icon *pSameTypeIcon = cairo_dock_get_first_icon_of_group (pDock->icons, icon->iGroup);
+		Icon *pSameTypeIcon = cairo_dock_icon_index_get_first_icon_of_group (pDock, icon->iGroup);
 		if (pSameTypeIcon == NULL && pDock->icons != NULL)
 		{
 			bSeparatorNeeded = TRUE;
@@ -2085,16 +2144,14 @@ static void _insert_icon (GldiContainer *pContainer, Icon *icon, gboolean bAnima
 	//\______________ insert the icon in the list.
 	if (icon->fOrder == CAIRO_DOCK_LAST_ORDER)
 	{
-		Icon *pLastIcon = cairo_dock_get_last_icon_of_order (pDock->icons, icon->iGroup);
+		Icon *pLastIcon = cairo_dock_icon_index_get_last_icon_of_order (pDock, icon->iGroup);
 		if (pLastIcon != NULL)
 			icon->fOrder = pLastIcon->fOrder + 1;
 		else
 			icon->fOrder = 1;
 	}
 	
-	pDock->icons = g_list_insert_sorted (pDock->icons,
-		icon,
-		(GCompareFunc)cairo_dock_compare_icons_order);
+	GList *ic = cairo_dock_icon_index_insert (pDock, icon);
 	
 	//\______________ set the icon size, now that it's inside a container.
 	int wi = icon->image.iWidth, hi = icon->image.iHeight;
@@ -2112,7 +2169,7 @@ static void _insert_icon (GldiContainer *pContainer, Icon *icon, gboolean bAnima
 	if (bSeparatorNeeded)
 	{
 		// insert a separator after if needed
-		Icon *pNextIcon = cairo_dock_get_next_icon (pDock->icons, icon);
+		Icon *pNextIcon = (ic->next ? ic->next->data : NULL);
 		if (pNextIcon != NULL && ! CAIRO_DOCK_ICON_TYPE_IS_SEPARATOR (pNextIcon))
 		{
 			Icon *pSeparatorIcon = gldi_auto_separator_icon_new (icon, pNextIcon);
@@ -2120,7 +2177,7 @@ static void _insert_icon (GldiContainer *pContainer, Icon *icon, gboolean bAnima
 		}
 		
 		// insert a separator before if needed
-		Icon *pPrevIcon = cairo_dock_get_previous_icon (pDock->icons, icon);
+		Icon *pPrevIcon = (ic->prev ? ic->prev->data : NULL);  // the separator inserted after doesn't change it.
 		if (pPrevIcon != NULL && ! CAIRO_DOCK_ICON_TYPE_IS_SEPARATOR (pPrevIcon))
 		{
 			Icon *pSeparatorIcon = gldi_auto_separator_icon_new (pPrevIcon, icon);
@@ -2263,6 +2320,7 @@ void cairo_dock_remove_icons_from_dock (CairoDock *pDock, CairoDock *pReceivingD
 	g_return_if_fail (pReceivingDock != NULL);
 	GList *pIconsList = pDock->icons;
 	pDock->icons = NULL;
+	cairo_dock_icon_index_invalidate (pDock);
 	Icon *icon;
 	GList *ic;
 	for (ic = pIconsList; ic != NULL; ic = ic->next)
@@ -290,7 +290,16 @@ struct _CairoDock {
 	GLuint iRedirectedTexture;
 	GLuint iFboId;
 	
-	gpointer reserved[4];
+	//\_______________ mouse motion (see iSidMotionFrame).
+	/// device of the last motion event, to ask for the next one.
+	GdkDevice *pMotionDevice;
+	/// Source ID (or tick callback ID) for handling the last mouse motion on the next frame.
+	guint iSidMotionFrame;
+	
+	//\_______________ index of the icons (see cairo-dock-icon-index.h).
+	CairoDockIconIndex *pIconIndex;
+	
+	gpointer reserved[1];
 };
 
 
@@ -32,6 +32,7 @@
 #include "cairo-dock-config.h"
 #include "cairo-dock-icon-factory.h"
 #include "cairo-dock-icon-facility.h"
+#include "cairo-dock-icon-index.h"
 #include "cairo-dock-separator-manager.h"  // gldi_automatic_separators_add_in_list
 #include "cairo-dock-launcher-manager.h"
 #include "cairo-dock-applet-manager.h"
@@ -1661,7 +1662,7 @@ static void _load_visible_zone (const gchar *cVisibleZoneImageFile, int iVisible
 		cVisibleZoneImageFile,
 		iVisibleZoneWidth,
 		iVisibleZoneHeight,
-		CAIRO_DOCK_FILL_SPACE,
+		CAIRO_DOCK_FILL_SPACE | CAIRO_DOCK_STATIC_IMAGE,
 		fVisibleZoneAlpha);
 }
 static void load (void)
@@ -2056,10 +2057,19 @@ static void reset_object (GldiObject *obj)
 		g_source_remove (pDock->iSidTestMouseOutside);
 	if (pDock->iSidUpdateDockSize != 0)
 		g_source_remove (pDock->iSidUpdateDockSize);
+	if (pDock->iSidMotionFrame != 0)
+	{
+		#if GTK_CHECK_VERSION (3, 8, 0)
+		gtk_widget_remove_tick_callback (pDock->container.pWidget, pDock->iSidMotionFrame);
+		#else
+		g_source_remove (pDock->iSidMotionFrame);
+		#endif
+	}
 	
 	// free icons that are still present
 	GList *icons = pDock->icons;
 	pDock->icons = NULL;  // remove the icons first, to avoid any use of 'icons' in the 'destroy' callbacks.
+	cairo_dock_icon_index_invalidate (pDock);
 	GList *ic;
 	for (ic = icons; ic != NULL; ic = ic->next)
 	{
@@ -2135,6 +2145,7 @@ static gboolean delete_object (GldiObject *obj)
 	// delete all the icons
 	GList *icons = pDock->icons;
 	pDock->icons = NULL;  // remove the icons first, to avoid any use of 'icons' in the 'destroy' callbacks.
+	cairo_dock_icon_index_invalidate (pDock);
 	GList *ic;
 	for (ic = icons; ic != NULL; ic = ic->next)
 	{
@@ -18,6 +18,7 @@
 */
 
 #include <math.h>
+#include <string.h>  // memcpy
 #include <GL/gl.h>
 
 #include "cairo-dock-icon-facility.h"
@@ -32,6 +33,10 @@
 #include "cairo-dock-overlay.h"
 #include "cairo-dock-style-manager.h"
 #include "cairo-dock-opengl-path.h"
+#include "cairo-dock-icon-manager.h"  // myIconObjectMgr
+#include "cairo-dock-module-manager.h"  // pVisitCard->cModuleName
+#include "cairo-dock-module-instance-manager.h"  // pModuleInstance->pModule
+#include "cairo-dock-profiler.h"  // gldi_profile_begin
 
 #include "cairo-dock-draw-opengl.h"
 
@@ -50,6 +55,41 @@ extern CairoDockGLConfig g_openglConfig;
 
 extern gboolean g_bEasterEggs;
 
+#define CD_ICON_ATLAS_SIZE 2048
+#define CD_ICON_ATLAS_MAX_IMAGE_SIZE 256  // bigger images are drawn on their own.
+#define CD_ICON_ATLAS_PADDING 2  // let some pixels between 2 images, so that the linear filtering doesn't mix them.
+#define CD_ICON_ATLAS_MIN_SLOT_SIZE 16  // smaller pieces of a free slot are not worth being kept.
+#define CD_ICON_ATLAS_CLEAR_ROWS 64  // when the atlas can't be cleared by the GPU, it's cleared by strips of this height.
+#define CD_BATCH_VERTEX_SIZE 9  // x,y,z, u,v, r,g,b,a
+#define CD_TEXTURE_PBO_MIN_SIZE (128*128*4)  // smaller images are uploaded directly, a PBO is not worth it.
+#define CD_TEXTURE_NB_PBO 4  // uploads rotate over these PBOs, so that filling one doesn't wait for the previous transfers.
+
+typedef struct {
+	GLfloat u, v, du, dv;
+	gint iWidth, iHeight;
+	gint x, y;
+	gint iSlotWidth, iSlotHeight;  // place taken in the atlas, which can be bigger than the image when a free slot is reused.
+	} CairoDockAtlasRegion;
+
+typedef enum {
+	CD_BATCH_BLEND_ALPHA = 0,  // reflections and translucent icons
+	CD_BATCH_BLEND_PBUFFER,  // opaque icons
+	CD_BATCH_NB_BLENDS
+	} CairoDockBatchBlend;
+
+static GLuint s_iIconAtlas = 0;
+static GHashTable *s_pAtlasRegions = NULL;  // texture -> region in the atlas
+static GList *s_pAtlasFreeSlots = NULL;  // regions given back by the textures that left the atlas, to be reused.
+static gint s_iAtlasX = 0, s_iAtlasY = 0, s_iAtlasRowHeight = 0;
+static GArray *s_pBatchVertices[CD_BATCH_NB_BLENDS] = {NULL, NULL};
+static gboolean s_bBatching = FALSE;
+static guint s_iNbCoreRenderHooks = 0;  // number of callbacks on the icons' rendering notifications that are known to work with the batch.
+static gboolean s_bPluginRenderHooks = FALSE;  // whether some plug-ins draw on the icons during the current batch.
+static GLfloat s_fBatchMatrix[16];  // modelview matrix of the container, read once per batch.
+static GLfloat s_fBatchIconPosition[3];  // translation from the container to the center of the icon being drawn.
+static gboolean s_bBatchIcon = FALSE;  // whether the icon being drawn can go in the batch.
+static guint s_iNbDrawCalls = 0, s_iNbStateChanges = 0;  // statistics on the last frame.
+
 
 void cairo_dock_set_icon_scale (Icon *pIcon, GldiContainer *pContainer, double fZoomFactor)
 {
@@ -106,6 +146,76 @@ void cairo_dock_combine_argb_argb (void)  // taken from glitz 0.5.6
 	glTexEnvf (GL_TEXTURE_ENV, GL_OPERAND1_ALPHA, GL_SRC_ALPHA);
 }
 
+// get the position and the size of the reflect of the icon, from the center of the icon, and the part of the icon's texture to use.
+static void _get_icon_reflect_transform (Icon *pIcon, CairoDock *pDock, double *dx, double *dy, double *sx, double *sy, double *x0, double *y0, double *x1, double *y1)
+{
+	double fScale = ((myIconsParam.bConstantSeparatorSize && GLDI_OBJECT_IS_SEPARATOR_ICON (pIcon)) ? 1. : pIcon->fScale);
+	///double fReflectSize = MIN (myIconsParam.fReflectSize, pIcon->fHeight/pDock->container.fRatio*fScale);
+	double fReflectSize = pIcon->fHeight * myIconsParam.fReflectHeightRatio * fScale;
+	///double fReflectRatio = fReflectSize * pDock->container.fRatio / pIcon->fHeight / fScale  / pIcon->fHeightFactor;
+	double fReflectRatio = myIconsParam.fReflectHeightRatio;
+	double fOffsetY = pIcon->fHeight * fScale/2 + fReflectSize/** * pDock->container.fRatio*/ / 2 + pIcon->fDeltaYReflection;
+	if (pDock->container.bIsHorizontal)
+	{
+		if (pDock->container.bDirectionUp)
+		{
+			*dx = 0.;
+			*dy = - fOffsetY;
+			*sx = pIcon->fWidth * pIcon->fWidthFactor * fScale;
+			*sy = - fReflectSize/** * pDock->container.fRatio*/;  // taille du reflet et on se retourne.
+			*x0 = 0.;
+			*y0 = 1. - fReflectRatio;
+			*x1 = 1.;
+			*y1 = 1.;
+		}
+		else
+		{
+			*dx = 0.;
+			*dy = fOffsetY;
+			*sx = pIcon->fWidth * pIcon->fWidthFactor * fScale;
+			*sy = fReflectSize/** * pDock->container.fRatio*/;
+			*x0 = 0.;
+			*y0 = fReflectRatio;
+			*x1 = 1.;
+			*y1 = 0.;
+		}
+	}
+	else
+	{
+		if (pDock->container.bDirectionUp)
+		{
+			*dx = fOffsetY;
+			*dy = 0.;
+			*sx = - fReflectSize/** * pDock->container.fRatio*/;
+			*sy = pIcon->fWidth * pIcon->fWidthFactor * fScale;
+			*x0 = 1. - fReflectRatio;
+			*y0 = 0.;
+			*x1 = 1.;
+			*y1 = 1.;
+		}
+		else
+		{
+			*dx = - fOffsetY;
+			*dy = 0.;
+			*sx = fReflectSize/** * pDock->container.fRatio*/;
+			*sy = pIcon->fWidth * pIcon->fWidthFactor * fScale;
+			*x0 = fReflectRatio;
+			*y0 = 0.;
+			*x1 = 0.;
+			*y1 = 1.;
+		}
+	}
+}
+
+// place the current matrix on the reflect of the icon (a quad of size 1), and give the part of the icon's texture to use.
+static void _set_icon_reflect_transform (Icon *pIcon, CairoDock *pDock, double *x0, double *y0, double *x1, double *y1)
+{
+	double dx, dy, sx, sy;
+	_get_icon_reflect_transform (pIcon, pDock, &dx, &dy, &sx, &sy, x0, y0, x1, y1);
+	glTranslatef (dx, dy, 0.);
+	glScalef (sx, sy, 1.);
+}
+
 void cairo_dock_draw_icon_reflect_opengl (Icon *pIcon, CairoDock *pDock)
 {
 	if (pDock->container.bUseReflect)
@@ -118,54 +228,7 @@ void cairo_dock_draw_icon_reflect_opengl (Icon *pIcon, CairoDock *pDock)
 		}
 		glPushMatrix ();
 		double x0, y0, x1, y1;
-		double fScale = ((myIconsParam.bConstantSeparatorSize && GLDI_OBJECT_IS_SEPARATOR_ICON (pIcon)) ? 1. : pIcon->fScale);
-		///double fReflectSize = MIN (myIconsParam.fReflectSize, pIcon->fHeight/pDock->container.fRatio*fScale);
-		double fReflectSize = pIcon->fHeight * myIconsParam.fReflectHeightRatio * fScale;
-		///double fReflectRatio = fReflectSize * pDock->container.fRatio / pIcon->fHeight / fScale  / pIcon->fHeightFactor;
-		double fReflectRatio = myIconsParam.fReflectHeightRatio;
-		double fOffsetY = pIcon->fHeight * fScale/2 + fReflectSize/** * pDock->container.fRatio*/ / 2 + pIcon->fDeltaYReflection;
-		if (pDock->container.bIsHorizontal)
-		{
-			if (pDock->container.bDirectionUp)
-			{
-				glTranslatef (0., - fOffsetY, 0.);
-				glScalef (pIcon->fWidth * pIcon->fWidthFactor * fScale, - fReflectSize/** * pDock->container.fRatio*/, 1.);  // taille du reflet et on se retourne.
-				x0 = 0.;
-				y0 = 1. - fReflectRatio;
-				x1 = 1.;
-				y1 = 1.;
-			}
-			else
-			{
-				glTranslatef (0., fOffsetY, 0.);
-				glScalef (pIcon->fWidth * pIcon->fWidthFactor * fScale, fReflectSize/** * pDock->container.fRatio*/, 1.);
-				x0 = 0.;
-				y0 = fReflectRatio;
-				x1 = 1.;
-				y1 = 0.;
-			}
-		}
-		else
-		{
-			if (pDock->container.bDirectionUp)
-			{
-				glTranslatef (fOffsetY, 0., 0.);
-				glScalef (- fReflectSize/** * pDock->container.fRatio*/, pIcon->fWidth * pIcon->fWidthFactor * fScale, 1.);
-				x0 = 1. - fReflectRatio;
-				y0 = 0.;
-				x1 = 1.;
-				y1 = 1.;
-			}
-			else
-			{
-				glTranslatef (- fOffsetY, 0., 0.);
-				glScalef (fReflectSize/** * pDock->container.fRatio*/, pIcon->fWidth * pIcon->fWidthFactor * fScale, 1.);
-				x0 = fReflectRatio;
-				y0 = 0.;
-				x1 = 0.;
-				y1 = 1.;
-			}
-		}
+		_set_icon_reflect_transform (pIcon, pDock, &x0, &y0, &x1, &y1);
 		
 		glEnable(GL_TEXTURE_2D);
 		glBindTexture(GL_TEXTURE_2D, pIcon->image.iTexture);
@@ -227,12 +290,49 @@ void cairo_dock_draw_icon_reflect_opengl (Icon *pIcon, CairoDock *pDock)
 	}
 }
 
+static gboolean _add_quad_to_batch (GLuint iTexture, CairoDockBatchBlend iBlend, double x, double y, double w, double h, const GLfloat *pTexCoords, const GLfloat *pAlphas);
+static gboolean _icon_can_be_batched (Icon *pIcon);
+
+static gboolean _add_icon_to_batch (Icon *pIcon, CairoDock *pDock, double fSizeX, double fSizeY)
+{
+	if (! s_bBatchIcon  // see cairo_dock_render_one_icon_opengl()
+	|| GLDI_OBJECT_IS_SEPARATOR_ICON (pIcon)  // may use the texture matrix
+	|| (pDock->container.bUseReflect && pDock->pRenderer->bUseStencil && g_openglConfig.bStencilBufferAvailable))
+		return FALSE;
+	
+	//\_____________________ the icon.
+	const GLfloat icon_coords[8] = {0., 0.,  1., 0.,  1., 1.,  0., 1.};
+	GLfloat alphas[4] = {pIcon->fAlpha, pIcon->fAlpha, pIcon->fAlpha, pIcon->fAlpha};
+	if (! _add_quad_to_batch (pIcon->image.iTexture, pIcon->fAlpha == 1 ? CD_BATCH_BLEND_PBUFFER : CD_BATCH_BLEND_ALPHA, 0., 0., fSizeX, fSizeY, icon_coords, alphas))
+		return FALSE;
+	
+	//\_____________________ its reflect, with the same shading as cairo_dock_draw_icon_reflect_opengl.
+	if (pDock->container.bUseReflect)
+	{
+		double dx, dy, sx, sy, x0, y0, x1, y1;
+		_get_icon_reflect_transform (pIcon, pDock, &dx, &dy, &sx, &sy, &x0, &y0, &x1, &y1);
+		const GLfloat reflect_coords[8] = {x0, y0,  x1, y0,  x1, y1,  x0, y1};
+		double fReflectAlpha = myIconsParam.fAlbedo * pIcon->fAlpha;
+		alphas[0] = fReflectAlpha * pIcon->fReflectShading;
+		alphas[1] = (pDock->container.bIsHorizontal ? fReflectAlpha * pIcon->fReflectShading : fReflectAlpha);
+		alphas[2] = fReflectAlpha;
+		alphas[3] = (pDock->container.bIsHorizontal ? fReflectAlpha : fReflectAlpha * pIcon->fReflectShading);
+		_add_quad_to_batch (pIcon->image.iTexture, CD_BATCH_BLEND_ALPHA, dx, dy, sx, sy, reflect_coords, alphas);
+	}
+	return TRUE;
+}
+
 void cairo_dock_draw_icon_opengl (Icon *pIcon, CairoDock *pDock)
 {
 	//\_____________________ On dessine l'icone.
 	double fSizeX, fSizeY;
 	cairo_dock_get_current_icon_size (pIcon, CAIRO_CONTAINER (pDock), &fSizeX, &fSizeY);
 	
+	if (s_bBatching && _add_icon_to_batch (pIcon, pDock, fSizeX, fSizeY))  // it will be drawn with the other icons of the dock.
+		return;
+	s_iNbDrawCalls += (pDock->container.bUseReflect ? 2 : 1);
+	s_iNbStateChanges += 2;  // texture + blending
+	
 	_cairo_dock_enable_texture ();
 	if (pIcon->fAlpha == 1)
 		_cairo_dock_set_blend_pbuffer ();
@@ -328,11 +428,33 @@ void cairo_dock_render_one_icon_opengl (Icon *icon, CairoDock *pDock, double fDo
 	double fX=0, fY=0;
 	_compute_icon_coordinate (icon, CAIRO_CONTAINER (pDock), fDockMagnitude * pDock->fMagnitudeMax, &fX, &fY);
 	
-	glPushMatrix ();
+	double tx, ty, tz = - icon->fHeight * icon->fScale;
 	if (pDock->container.bIsHorizontal)
-		glTranslatef (fX, fY - icon->fHeight * icon->fScale * (1 - icon->fGlideScale/2), - icon->fHeight * icon->fScale);
+	{
+		tx = fX;
+		ty = fY - icon->fHeight * icon->fScale * (1 - icon->fGlideScale/2);
+	}
 	else
-		glTranslatef (fY + icon->fHeight * icon->fScale * (1 - icon->fGlideScale/2), fX, - icon->fHeight * icon->fScale);
+	{
+		tx = fY + icon->fHeight * icon->fScale * (1 - icon->fGlideScale/2);
+		ty = fX;
+	}
+	glPushMatrix ();
+	glTranslatef (tx, ty, tz);
+	
+	//\_____________________ if the icon can't be batched, the icons before it must be drawn first, so that the order of the drawings is kept.
+	if (s_bBatching)
+	{
+		s_bBatchIcon = _icon_can_be_batched (icon);
+		if (s_bBatchIcon)
+		{
+			s_fBatchIconPosition[0] = tx;
+			s_fBatchIconPosition[1] = ty;
+			s_fBatchIconPosition[2] = tz;
+		}
+		else
+			cairo_dock_flush_icons_batch ();
+	}
 	
 	//\_____________________ On positionne l'icone.
 	glPushMatrix ();
@@ -378,8 +500,14 @@ void cairo_dock_render_one_icon_opengl (Icon *icon, CairoDock *pDock, double fDo
 	
 	//\_____________________ On dessine l'icone.
 	gboolean bIconHasBeenDrawn = FALSE;
+	gint64 iProfileTime = gldi_profile_begin ();
 	gldi_object_notify (&myIconObjectMgr, NOTIFICATION_PRE_RENDER_ICON, icon, pDock, NULL);
 	gldi_object_notify (&myIconObjectMgr, NOTIFICATION_RENDER_ICON, icon, pDock, &bIconHasBeenDrawn, NULL);
+	gldi_profile_end (iProfileTime, GLDI_PROFILE_ICON_RENDER,
+		icon->pModuleInstance ? (gconstpointer)icon->pModuleInstance : (gconstpointer)pDock,  // applets on their own, other icons per dock
+		icon->pModuleInstance ? icon->pModuleInstance->pModule->pVisitCard->cModuleName : "icons",
+		gldi_dock_get_name (pDock));
+	s_bBatchIcon = FALSE;
 	
 	glPopMatrix ();  // retour juste apres la translation au milieu de l'icone.
 	
@@ -391,6 +519,8 @@ void cairo_dock_render_one_icon_opengl (Icon *icon, CairoDock *pDock, double fDo
 	}
 	
 	//\_____________________ Draw the overlays on top of that.
+	if (icon->pOverlays != NULL)
+		cairo_dock_flush_icons_batch ();  // the icon must be drawn before.
 	cairo_dock_draw_icon_overlays_opengl (icon, fRatio);
 	
 	//\_____________________ On dessine les etiquettes, avec un alpha proportionnel au facteur d'echelle de leur icone.
@@ -398,6 +528,7 @@ void cairo_dock_render_one_icon_opengl (Icon *icon, CairoDock *pDock, double fDo
 	if (bUseText && icon->label.iTexture != 0 && icon->iHideLabel == 0
 	&& (icon->bPointed || (icon->fScale > 1.01 && ! myIconsParam.bLabelForPointedIconOnly)))  // 1.01 car sin(pi) = 1+epsilon :-/  //  && icon->iAnimationState < CAIRO_DOCK_STATE_CLICKED
 	{
+		cairo_dock_flush_icons_batch ();  // the label goes over the icons.
 		glPushMatrix ();
 		glLoadIdentity ();
 		
@@ -596,7 +727,120 @@ void cairo_dock_render_hidden_dock_opengl (CairoDock *pDock)
 }
 
 
-GLuint cairo_dock_create_texture_from_surface (cairo_surface_t *pImageSurface)
+static gboolean s_bCompressTextures = FALSE;
+static GLuint s_iUploadBuffers[CD_TEXTURE_NB_PBO] = {0};  // PBOs through which the big images are uploaded
+static int s_iNextUploadBuffer = 0;
+static GLuint s_iMappedUploadBuffer = 0;  // PBO given to a drawing (see cairo_dock_begin_draw_new_texture), and its memory.
+static guchar *s_pMappedUploadData = NULL;
+static GHashTable *s_pTextureSizes = NULL;  // texture -> memory it takes, when it's not w*h*4 (mipmaps, compression)
+
+void cairo_dock_set_textures_compression (gboolean bCompress)
+{
+	s_bCompressTextures = bCompress;
+}
+
+static void _set_texture_size (GLuint iTexture, gint64 iSize, int w, int h)
+{
+	if (iSize == (gint64)w * h * 4)
+	{
+		if (s_pTextureSizes != NULL)
+			g_hash_table_remove (s_pTextureSizes, GUINT_TO_POINTER (iTexture));
+		return;
+	}
+	if (s_pTextureSizes == NULL)
+		s_pTextureSizes = g_hash_table_new (g_direct_hash, g_direct_equal);
+	g_hash_table_insert (s_pTextureSizes, GUINT_TO_POINTER (iTexture), GSIZE_TO_POINTER ((gsize)iSize));
+}
+
+gint64 cairo_dock_get_texture_size (GLuint iTexture, int iWidth, int iHeight)
+{
+	gpointer pSize = (s_pTextureSizes != NULL ? g_hash_table_lookup (s_pTextureSizes, GUINT_TO_POINTER (iTexture)) : NULL);
+	return (pSize != NULL ? (gint64)GPOINTER_TO_SIZE (pSize) : (gint64)iWidth * iHeight * 4);
+}
+
+static inline gboolean _bound_texture_has_mipmaps (void)
+{
+	GLint iMinFilter = GL_LINEAR;
+	glGetTexParameteriv (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, &iMinFilter);
+	return (iMinFilter == GL_LINEAR_MIPMAP_LINEAR);
+}
+
+gboolean cairo_dock_texture_has_mipmaps (GLuint iTexture)
+{
+	if (iTexture == 0)
+		return FALSE;
+	glBindTexture (GL_TEXTURE_2D, iTexture);
+	gboolean bMipmaps = _bound_texture_has_mipmaps ();
+	glBindTexture (GL_TEXTURE_2D, 0);
+	return bMipmaps;
+}
+
+static int _get_nb_levels (int w, int h)
+{
+	int n = 1, m = MAX (w, h);
+	while (m > 1)
+	{
+		m >>= 1;
+		n ++;
+	}
+	return n;
+}
+
+static guchar *_map_next_upload_buffer (gsize iSize, GLuint *iBuffer)  // NULL if a PBO can't be used; the PBO is left bound otherwise.
+{
+	if (! g_openglConfig.bPixelBufferAvailable || iSize < CD_TEXTURE_PBO_MIN_SIZE)
+		return NULL;
+	GLuint *pBuffer = &s_iUploadBuffers[s_iNextUploadBuffer];
+	s_iNextUploadBuffer = (s_iNextUploadBuffer + 1) % CD_TEXTURE_NB_PBO;
+	if (*pBuffer != 0 && *pBuffer == s_iMappedUploadBuffer)  // being drawn, don't touch it.
+	{
+		pBuffer = &s_iUploadBuffers[s_iNextUploadBuffer];
+		s_iNextUploadBuffer = (s_iNextUploadBuffer + 1) % CD_TEXTURE_NB_PBO;
+	}
+	if (*pBuffer == 0)
+		glGenBuffers (1, pBuffer);
+	glBindBuffer (GL_PIXEL_UNPACK_BUFFER, *pBuffer);
+	glBufferData (GL_PIXEL_UNPACK_BUFFER, iSize, NULL, GL_STREAM_DRAW);  // orphan the previous content, so that we don't wait for its transfer to be over.
+	guchar *pBufferData = glMapBuffer (GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+	if (pBufferData == NULL)
+	{
+		glBindBuffer (GL_PIXEL_UNPACK_BUFFER, 0);
+		return NULL;
+	}
+	*iBuffer = *pBuffer;
+	return pBufferData;
+}
+
+static void _upload_texture_pixels (int w, int h, int iStride, const guchar *pData)  // into the level 0 of the bound texture, which must have the same size.
+{
+	gsize iSize = (gsize)iStride * h;
+	glPixelStorei (GL_UNPACK_ROW_LENGTH, iStride / 4);
+	if (pData != NULL && pData == s_pMappedUploadData)  // the pixels have been drawn right into a PBO, just hand it over to the driver.
+	{
+		glBindBuffer (GL_PIXEL_UNPACK_BUFFER, s_iMappedUploadBuffer);
+		glUnmapBuffer (GL_PIXEL_UNPACK_BUFFER);
+		glTexSubImage2D (GL_TEXTURE_2D, 0, 0, 0, w, h, GL_BGRA, GL_UNSIGNED_BYTE, NULL);  // offset 0 in the PBO
+		glBindBuffer (GL_PIXEL_UNPACK_BUFFER, 0);
+		glPixelStorei (GL_UNPACK_ROW_LENGTH, 0);
+		s_pMappedUploadData = NULL;
+		s_iMappedUploadBuffer = 0;
+		return;
+	}
+	GLuint iBuffer = 0;
+	guchar *pBufferData = _map_next_upload_buffer (iSize, &iBuffer);
+	if (pBufferData != NULL)  // copy the pixels into a PBO: the driver transfers them to the card while we go on, instead of making a copy of its own before returning.
+	{
+		memcpy (pBufferData, pData, iSize);
+		glUnmapBuffer (GL_PIXEL_UNPACK_BUFFER);
+		glTexSubImage2D (GL_TEXTURE_2D, 0, 0, 0, w, h, GL_BGRA, GL_UNSIGNED_BYTE, NULL);  // offset 0 in the PBO
+		glBindBuffer (GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+	else
+		glTexSubImage2D (GL_TEXTURE_2D, 0, 0, 0, w, h, GL_BGRA, GL_UNSIGNED_BYTE, pData);
+	glPixelStorei (GL_UNPACK_ROW_LENGTH, 0);
+}
+
+GLuint cairo_dock_create_texture_from_surface_full (cairo_surface_t *pImageSurface, GldiTextureFlags iFlags)
 {
 	if (! g_bUseOpenGL || pImageSurface == NULL)
 		return 0;
@@ -629,29 +873,160 @@ GLuint cairo_dock_create_texture_from_surface (cairo_surface_t *pImageSurface)
 		}
 	}
 	
+	gboolean bMipmaps = ((iFlags & GLDI_TEXTURE_MIPMAPS) && g_openglConfig.bFboAvailable);  // glGenerateMipmapEXT comes with the FBO extension.
+	gboolean bStatic = (iFlags & GLDI_TEXTURE_STATIC);
+	const guchar *pData = cairo_image_surface_get_data (pPowerOfwoSurface);
+	gboolean bCompressed = (bStatic && s_bCompressTextures && g_openglConfig.bTextureCompressionAvailable && pData != s_pMappedUploadData);  // the pixels of a PBO can only be read by the driver once it's unmapped.
+	int iStride = cairo_image_surface_get_stride (pPowerOfwoSurface);
+	
 	_cairo_dock_enable_texture ();
 	_cairo_dock_set_blend_source ();
 	_cairo_dock_set_alpha (1.);  // full white
+	gint64 iProfileTime = gldi_profile_begin ();
 	glGenTextures (1, &iTexture);
 	//g_print ("+ texture %d generee (%p, %dx%d)\n", iTexture, cairo_image_surface_get_data (pImageSurface), w, h);
 	glBindTexture (GL_TEXTURE_2D, iTexture);
 	
 	glTexParameteri (GL_TEXTURE_2D,
 		GL_TEXTURE_MIN_FILTER,
-		g_bEasterEggs ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
-	if (g_bEasterEggs)
-		glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
+		bMipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 	
-	if (g_bEasterEggs)
-		gluBuild2DMipmaps (GL_TEXTURE_2D,  /// see for automatic mipmaps generation, or at least how to update the mipmaps...
-			4,
+	gint64 iSize = (gint64)w * h * 4;
+	if (bCompressed)  // the driver compresses the image as it receives it.
+	{
+		glPixelStorei (GL_UNPACK_ROW_LENGTH, iStride / 4);
+		glTexImage2D (GL_TEXTURE_2D,
+			0,
+			GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,
 			w,
 			h,
+			0,
 			GL_BGRA,
 			GL_UNSIGNED_BYTE,
-			cairo_image_surface_get_data (pPowerOfwoSurface));
+			pData);
+		glPixelStorei (GL_UNPACK_ROW_LENGTH, 0);
+		GLint iCompressedSize = 0;
+		glGetTexLevelParameteriv (GL_TEXTURE_2D, 0, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &iCompressedSize);
+		if (iCompressedSize > 0)
+			iSize = iCompressedSize;
+	}
 	else
+	{
+		if (bStatic && g_openglConfig.bTextureStorageAvailable)  // its size won't change, so let the driver allocate it once for all.
+			glTexStorage2D (GL_TEXTURE_2D, bMipmaps ? _get_nb_levels (w, h) : 1, GL_RGBA8, w, h);
+		else
+			glTexImage2D (GL_TEXTURE_2D,
+				0,
+				4,  // GL_ALPHA / GL_BGRA
+				w,
+				h,
+				0,
+				GL_BGRA,  // GL_ALPHA / GL_BGRA
+				GL_UNSIGNED_BYTE,
+				NULL);
+		_upload_texture_pixels (w, h, iStride, pData);
+	}
+	if (bMipmaps)
+	{
+		glGenerateMipmapEXT (GL_TEXTURE_2D);
+		iSize = iSize * 4 / 3;  // mipmaps take 1/3 more.
+	}
+	gldi_profile_end (iProfileTime, GLDI_PROFILE_TEXTURE_UPLOAD, (gconstpointer)cairo_dock_create_texture_from_surface_full, "new texture", NULL);
+	_set_texture_size (iTexture, iSize, w, h);
+	gldi_module_instances_track_resource (GLDI_RESOURCE_TEXTURE, GUINT_TO_POINTER (iTexture), iSize);
+	if (pPowerOfwoSurface != pImageSurface)
+		cairo_surface_destroy (pPowerOfwoSurface);
+	glBindTexture (GL_TEXTURE_2D, 0);
+	glDisable(GL_TEXTURE_2D);
+	glDisable(GL_BLEND);
+	return iTexture;
+}
+
+GLuint cairo_dock_create_texture_from_surface (cairo_surface_t *pImageSurface)
+{
+	return cairo_dock_create_texture_from_surface_full (pImageSurface, g_bEasterEggs ? GLDI_TEXTURE_MIPMAPS : 0);
+}
+
+cairo_t *cairo_dock_begin_draw_new_texture (int iWidth, int iHeight)
+{
+	g_return_val_if_fail (iWidth > 0 && iHeight > 0, NULL);
+	cairo_surface_t *pSurface = NULL;
+	if (g_bUseOpenGL && g_openglConfig.bNonPowerOfTwoAvailable && s_pMappedUploadData == NULL)  // only one drawing at a time in a PBO; the others go through a surface.
+	{
+		int iStride = cairo_format_stride_for_width (CAIRO_FORMAT_ARGB32, iWidth);
+		GLuint iBuffer = 0;
+		guchar *pBufferData = _map_next_upload_buffer ((gsize)iStride * iHeight, &iBuffer);
+		if (pBufferData != NULL)
+		{
+			glBindBuffer (GL_PIXEL_UNPACK_BUFFER, 0);  // it stays mapped, but must not be bound while the texture is allocated.
+			s_iMappedUploadBuffer = iBuffer;
+			s_pMappedUploadData = pBufferData;
+			pSurface = cairo_image_surface_create_for_data (pBufferData, CAIRO_FORMAT_ARGB32, iWidth, iHeight, iStride);
+		}
+	}
+	if (pSurface == NULL)
+		pSurface = cairo_dock_create_blank_surface (iWidth, iHeight);
+	cairo_t *pCairoContext = cairo_create (pSurface);
+	cairo_surface_destroy (pSurface);  // the context holds it.
+	if (s_pMappedUploadData != NULL && cairo_image_surface_get_data (pSurface) == s_pMappedUploadData)  // the memory of a PBO is not initialized.
+	{
+		cairo_set_operator (pCairoContext, CAIRO_OPERATOR_CLEAR);
+		cairo_paint (pCairoContext);
+		cairo_set_operator (pCairoContext, CAIRO_OPERATOR_OVER);
+	}
+	return pCairoContext;
+}
+
+GLuint cairo_dock_end_draw_new_texture (cairo_t *pCairoContext, GldiTextureFlags iFlags)
+{
+	g_return_val_if_fail (pCairoContext != NULL, 0);
+	cairo_surface_t *pSurface = cairo_surface_reference (cairo_get_target (pCairoContext));
+	cairo_destroy (pCairoContext);
+	cairo_surface_flush (pSurface);
+	GLuint iTexture = cairo_dock_create_texture_from_surface_full (pSurface, iFlags);
+	if (s_pMappedUploadData != NULL && cairo_image_surface_get_data (pSurface) == s_pMappedUploadData)  // not uploaded (no GL) -> give the PBO back.
+	{
+		glBindBuffer (GL_PIXEL_UNPACK_BUFFER, s_iMappedUploadBuffer);
+		glUnmapBuffer (GL_PIXEL_UNPACK_BUFFER);
+		glBindBuffer (GL_PIXEL_UNPACK_BUFFER, 0);
+		s_pMappedUploadData = NULL;
+		s_iMappedUploadBuffer = 0;
+	}
+	cairo_surface_destroy (pSurface);  // only the texture is left, the memory of the PBO belongs to the driver again.
+	return iTexture;
+}
+
+GLuint cairo_dock_update_texture_from_surface (GLuint iTexture, cairo_surface_t *pImageSurface)
+{
+	if (iTexture == 0)
+		return cairo_dock_create_texture_from_surface (pImageSurface);
+	if (! g_bUseOpenGL || pImageSurface == NULL)
+		return iTexture;
+	int w = cairo_image_surface_get_width (pImageSurface);
+	int h = cairo_image_surface_get_height (pImageSurface);
+	
+	_cairo_dock_enable_texture ();
+	_cairo_dock_set_blend_source ();
+	_cairo_dock_set_alpha (1.);  // full white
+	glBindTexture (GL_TEXTURE_2D, iTexture);
+	
+	GLint iTextureWidth = 0, iTextureHeight = 0, iImmutable = 0;
+	glGetTexLevelParameteriv (GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &iTextureWidth);
+	glGetTexLevelParameteriv (GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &iTextureHeight);
+	if (g_openglConfig.bTextureStorageAvailable)
+		glGetTexParameteriv (GL_TEXTURE_2D, GL_TEXTURE_IMMUTABLE_FORMAT, &iImmutable);
+	gboolean bMipmaps = _bound_texture_has_mipmaps ();
+	if (iTextureWidth != w || iTextureHeight != h)
+	{
+		if (iImmutable)  // its storage can't be changed -> replace it.
+		{
+			glBindTexture (GL_TEXTURE_2D, 0);
+			_cairo_dock_disable_texture ();
+			cd_debug ("the image of texture %d has been resized (%dx%d -> %dx%d)", iTexture, iTextureWidth, iTextureHeight, w, h);
+			cairo_dock_delete_texture (iTexture);
+			return cairo_dock_create_texture_from_surface_full (pImageSurface, bMipmaps ? GLDI_TEXTURE_MIPMAPS : 0);
+		}
 		glTexImage2D (GL_TEXTURE_2D,
 			0,
 			4,  // GL_ALPHA / GL_BGRA
@@ -660,14 +1035,49 @@ GLuint cairo_dock_create_texture_from_surface (cairo_surface_t *pImageSurface)
 			0,
 			GL_BGRA,  // GL_ALPHA / GL_BGRA
 			GL_UNSIGNED_BYTE,
-			cairo_image_surface_get_data (pPowerOfwoSurface));
-	if (pPowerOfwoSurface != pImageSurface)
-		cairo_surface_destroy (pPowerOfwoSurface);
-	glDisable(GL_TEXTURE_2D);
-	glDisable(GL_BLEND);
+			NULL);
+	}
+	_upload_texture_pixels (w, h, cairo_image_surface_get_stride (pImageSurface), cairo_image_surface_get_data (pImageSurface));
+	if (bMipmaps)
+		glGenerateMipmapEXT (GL_TEXTURE_2D);
+	glBindTexture (GL_TEXTURE_2D, 0);
+	_cairo_dock_disable_texture ();
 	return iTexture;
 }
 
+void cairo_dock_build_texture_mipmaps (GLuint iTexture, int iWidth, int iHeight)
+{
+	if (iTexture == 0 || ! g_openglConfig.bFboAvailable)
+		return;
+	glBindTexture (GL_TEXTURE_2D, iTexture);
+	if (! _bound_texture_has_mipmaps ())
+	{
+		GLint iImmutable = 0;
+		if (g_openglConfig.bTextureStorageAvailable)
+			glGetTexParameteriv (GL_TEXTURE_2D, GL_TEXTURE_IMMUTABLE_FORMAT, &iImmutable);
+		if (iImmutable)  // it has been allocated without mipmaps, and can't get some any more.
+		{
+			glBindTexture (GL_TEXTURE_2D, 0);
+			return;
+		}
+		glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		gint64 iSize = cairo_dock_get_texture_size (iTexture, iWidth, iHeight) * 4 / 3;
+		_set_texture_size (iTexture, iSize, iWidth, iHeight);
+	}
+	glGenerateMipmapEXT (GL_TEXTURE_2D);
+	glBindTexture (GL_TEXTURE_2D, 0);
+}
+
+void cairo_dock_update_texture_mipmaps (GLuint iTexture)
+{
+	if (iTexture == 0 || ! g_openglConfig.bFboAvailable)
+		return;
+	glBindTexture (GL_TEXTURE_2D, iTexture);
+	if (_bound_texture_has_mipmaps ())
+		glGenerateMipmapEXT (GL_TEXTURE_2D);
+	glBindTexture (GL_TEXTURE_2D, 0);
+}
+
 GLuint cairo_dock_create_texture_from_raw_data (const guchar *pTextureRaw, int iWidth, int iHeight)
 {
 	/*cd_debug ("%dx%d", iWidth, iHeight);
@@ -699,23 +1109,16 @@ GLuint cairo_dock_create_texture_from_raw_data (const guchar *pTextureRaw, int i
 	glGenTextures(1, &iTexture);
 	glBindTexture(GL_TEXTURE_2D, iTexture);
 	
+	gboolean bMipmaps = (g_bEasterEggs && pTextureRaw && g_openglConfig.bFboAvailable);
 	glTexParameteri (GL_TEXTURE_2D,
 		GL_TEXTURE_MIN_FILTER,
-		g_bEasterEggs ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
-	if (g_bEasterEggs)
-		glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
+		bMipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 	
-	if (g_bEasterEggs && pTextureRaw)
-		gluBuild2DMipmaps (GL_TEXTURE_2D,
-			4,
-			iWidth,
-			iHeight,
-			GL_RGBA,
-			GL_UNSIGNED_BYTE,
-			pTextureRaw);
-	else
-		glTexImage2D (GL_TEXTURE_2D, 0, GL_RGBA, iWidth, iHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, pTextureRaw);
+	glTexImage2D (GL_TEXTURE_2D, 0, GL_RGBA, iWidth, iHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, pTextureRaw);
+	if (bMipmaps)
+		glGenerateMipmapEXT (GL_TEXTURE_2D);
+	_set_texture_size (iTexture, (gint64)iWidth * iHeight * 4 * (bMipmaps ? 4 : 3) / 3, iWidth, iHeight);
 	glBindTexture (GL_TEXTURE_2D, 0);
 	glDisable(GL_TEXTURE_2D);
 	return iTexture;
@@ -758,42 +1161,8 @@ void cairo_dock_update_icon_texture (Icon *pIcon)
 {
 	if (pIcon != NULL && pIcon->image.pSurface != NULL)
 	{
-		_cairo_dock_enable_texture ();
-		_cairo_dock_set_blend_source ();
-		_cairo_dock_set_alpha (1.);  // full white
-		
-		if (pIcon->image.iTexture == 0)
-			glGenTextures (1, &pIcon->image.iTexture);
-		int w = cairo_image_surface_get_width (pIcon->image.pSurface);
-		int h = cairo_image_surface_get_height (pIcon->image.pSurface);
-		glBindTexture (GL_TEXTURE_2D, pIcon->image.iTexture);
-		
-		glTexParameteri (GL_TEXTURE_2D,
-			GL_TEXTURE_MIN_FILTER,
-			g_bEasterEggs ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
-		if (g_bEasterEggs)
-			glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-		
-		if (g_bEasterEggs)
-			gluBuild2DMipmaps (GL_TEXTURE_2D,
-				4,
-				w,
-				h,
-				GL_BGRA,
-				GL_UNSIGNED_BYTE,
-				cairo_image_surface_get_data (pIcon->image.pSurface));
-		else
-			glTexImage2D (GL_TEXTURE_2D,
-				0,
-				4,  // GL_ALPHA / GL_BGRA
-				w,
-				h,
-				0,
-				GL_BGRA,  // GL_ALPHA / GL_BGRA
-				GL_UNSIGNED_BYTE,
-				cairo_image_surface_get_data (pIcon->image.pSurface));
-		glDisable (GL_TEXTURE_2D);
+		pIcon->image.iTexture = cairo_dock_update_texture_from_surface (pIcon->image.iTexture, pIcon->image.pSurface);
+		cairo_dock_update_texture_in_icon_atlas (pIcon->image.iTexture, pIcon->image.pSurface);
 	}
 }
 
@@ -887,10 +1256,11 @@ void cairo_dock_draw_hidden_appli_icon (Icon *pIcon, GldiContainer *pContainer,
 		cairo_dock_remove_transition_on_icon (pIcon);
 		
 		GLuint iOriginalTexture;
+		cairo_surface_t *pSurface = cairo_dock_image_buffer_ref_surface (&pIcon->image);  // in GL-only mode, it's read back for this copy only.
 		if (pIcon->pAppli->bIsHidden)
 		{
 			iOriginalTexture = pIcon->image.iTexture;
-			pIcon->image.iTexture = cairo_dock_create_texture_from_surface (pIcon->image.pSurface);
+			pIcon->image.iTexture = cairo_dock_create_texture_from_surface (pSurface);
 			/// Using FBOs copies the texture data (pixels) within VRAM only:
 			/// - setup & bind FBO
 			/// - setup destination texture (using glTexImage() w/ pixels = 0)
@@ -900,8 +1270,10 @@ void cairo_dock_draw_hidden_appli_icon (Icon *pIcon, GldiContainer *pContainer,
 		}
 		else
 		{
-			iOriginalTexture = cairo_dock_create_texture_from_surface (pIcon->image.pSurface);
+			iOriginalTexture = cairo_dock_create_texture_from_surface (pSurface);
 		}
+		if (pSurface != NULL)
+			cairo_surface_destroy (pSurface);
 		
 		cairo_dock_set_transition_on_icon (pIcon, pContainer,
 			(CairoDockTransitionRenderFunc) NULL,
@@ -920,3 +1292,366 @@ void cairo_dock_draw_hidden_appli_icon (Icon *pIcon, GldiContainer *pContainer,
 		cairo_dock_end_draw_icon (pIcon);
 	}
 }
+
+
+  //////////////////
+ /// ICON ATLAS ///
+//////////////////
+
+static gboolean _create_icon_atlas (void)
+{
+	GLint iMaxTextureSize = 0;
+	glGetIntegerv (GL_MAX_TEXTURE_SIZE, &iMaxTextureSize);
+	if (iMaxTextureSize < CD_ICON_ATLAS_SIZE)
+	{
+		cd_debug ("textures are limited to %dpx, no icon atlas", iMaxTextureSize);
+		return FALSE;
+	}
+	
+	_cairo_dock_enable_texture ();
+	glGenTextures (1, &s_iIconAtlas);
+	glBindTexture (GL_TEXTURE_2D, s_iIconAtlas);
+	glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexImage2D (GL_TEXTURE_2D, 0, 4, CD_ICON_ATLAS_SIZE, CD_ICON_ATLAS_SIZE, 0, GL_BGRA, GL_UNSIGNED_BYTE, NULL);
+	
+	//\_____________ the gaps between the images must be transparent.
+	if (g_openglConfig.bFboAvailable)  // let the GPU clear it.
+	{
+		GLint iCurrentFbo = 0;
+		glGetIntegerv (GL_FRAMEBUFFER_BINDING_EXT, &iCurrentFbo);  // we can be called while drawing into a FBO.
+		GLuint iFbo = 0;
+		glGenFramebuffersEXT (1, &iFbo);
+		glBindFramebufferEXT (GL_FRAMEBUFFER_EXT, iFbo);
+		glFramebufferTexture2DEXT (GL_FRAMEBUFFER_EXT, GL_COLOR_ATTACHMENT0_EXT, GL_TEXTURE_2D, s_iIconAtlas, 0);
+		glPushAttrib (GL_SCISSOR_BIT);
+		glDisable (GL_SCISSOR_TEST);
+		glClear (GL_COLOR_BUFFER_BIT);  // the clear color is always transparent.
+		glPopAttrib ();
+		glBindFramebufferEXT (GL_FRAMEBUFFER_EXT, iCurrentFbo);
+		glDeleteFramebuffersEXT (1, &iFbo);
+		glBindTexture (GL_TEXTURE_2D, s_iIconAtlas);
+	}
+	else  // clear it by strips, rather than building a blank image of the whole atlas.
+	{
+		guchar *pBlank = g_new0 (guchar, 4 * CD_ICON_ATLAS_SIZE * CD_ICON_ATLAS_CLEAR_ROWS);
+		int y;
+		for (y = 0; y < CD_ICON_ATLAS_SIZE; y += CD_ICON_ATLAS_CLEAR_ROWS)
+			glTexSubImage2D (GL_TEXTURE_2D, 0, 0, y, CD_ICON_ATLAS_SIZE, CD_ICON_ATLAS_CLEAR_ROWS, GL_BGRA, GL_UNSIGNED_BYTE, pBlank);
+		g_free (pBlank);
+	}
+	_cairo_dock_disable_texture ();
+	
+	s_pAtlasRegions = g_hash_table_new (g_direct_hash, g_direct_equal);
+	return TRUE;
+}
+
+static void _upload_atlas_region (CairoDockAtlasRegion *pRegion, cairo_surface_t *pSurface)
+{
+	gint64 iProfileTime = gldi_profile_begin ();
+	_cairo_dock_enable_texture ();
+	glBindTexture (GL_TEXTURE_2D, s_iIconAtlas);
+	glPixelStorei (GL_UNPACK_ROW_LENGTH, cairo_image_surface_get_stride (pSurface) / 4);
+	glTexSubImage2D (GL_TEXTURE_2D, 0,
+		pRegion->x, pRegion->y,
+		pRegion->iWidth, pRegion->iHeight,
+		GL_BGRA, GL_UNSIGNED_BYTE,
+		cairo_image_surface_get_data (pSurface));
+	glPixelStorei (GL_UNPACK_ROW_LENGTH, 0);
+	_cairo_dock_disable_texture ();
+	gldi_profile_end (iProfileTime, GLDI_PROFILE_TEXTURE_UPLOAD, (gconstpointer)_upload_atlas_region, "icon atlas", NULL);
+}
+
+static void _clear_atlas_area (int x, int y, int w, int h)
+{
+	if (w <= 0 || h <= 0)
+		return;
+	guchar *pBlank = g_new0 (guchar, 4 * w * h);
+	_cairo_dock_enable_texture ();
+	glBindTexture (GL_TEXTURE_2D, s_iIconAtlas);
+	glTexSubImage2D (GL_TEXTURE_2D, 0, x, y, w, h, GL_BGRA, GL_UNSIGNED_BYTE, pBlank);
+	_cairo_dock_disable_texture ();
+	g_free (pBlank);
+}
+
+static void _add_atlas_free_slot (int x, int y, int w, int h)
+{
+	if (w < CD_ICON_ATLAS_MIN_SLOT_SIZE || h < CD_ICON_ATLAS_MIN_SLOT_SIZE)
+		return;
+	CairoDockAtlasRegion *pSlot = g_new0 (CairoDockAtlasRegion, 1);
+	pSlot->x = x;
+	pSlot->y = y;
+	pSlot->iSlotWidth = w;
+	pSlot->iSlotHeight = h;
+	s_pAtlasFreeSlots = g_list_prepend (s_pAtlasFreeSlots, pSlot);
+}
+
+static CairoDockAtlasRegion *_take_atlas_free_slot (int w, int h)
+{
+	// take the smallest free slot that can hold the image.
+	CairoDockAtlasRegion *pSlot, *pBestSlot = NULL;
+	GList *s;
+	for (s = s_pAtlasFreeSlots; s != NULL; s = s->next)
+	{
+		pSlot = s->data;
+		if (pSlot->iSlotWidth >= w && pSlot->iSlotHeight >= h
+		&& (pBestSlot == NULL || pSlot->iSlotWidth * pSlot->iSlotHeight < pBestSlot->iSlotWidth * pBestSlot->iSlotHeight))
+			pBestSlot = pSlot;
+	}
+	if (pBestSlot == NULL)
+		return NULL;
+	s_pAtlasFreeSlots = g_list_remove (s_pAtlasFreeSlots, pBestSlot);
+	
+	// the old image can be bigger than the new one: clear the gap around the new one, so that the filtering doesn't catch the old pixels.
+	_clear_atlas_area (pBestSlot->x + w, pBestSlot->y, MIN (CD_ICON_ATLAS_PADDING, pBestSlot->iSlotWidth - w), MIN (h + CD_ICON_ATLAS_PADDING, pBestSlot->iSlotHeight));
+	_clear_atlas_area (pBestSlot->x, pBestSlot->y + h, w, MIN (CD_ICON_ATLAS_PADDING, pBestSlot->iSlotHeight - h));
+	
+	// give back what the image doesn't use: the part on its right, and the part below it.
+	_add_atlas_free_slot (pBestSlot->x + w + CD_ICON_ATLAS_PADDING, pBestSlot->y, pBestSlot->iSlotWidth - w - CD_ICON_ATLAS_PADDING, pBestSlot->iSlotHeight);
+	_add_atlas_free_slot (pBestSlot->x, pBestSlot->y + h + CD_ICON_ATLAS_PADDING, w, pBestSlot->iSlotHeight - h - CD_ICON_ATLAS_PADDING);
+	pBestSlot->iSlotWidth = w;
+	pBestSlot->iSlotHeight = h;
+	return pBestSlot;
+}
+
+static void _release_atlas_region (GLuint iTexture, CairoDockAtlasRegion *pRegion)
+{
+	g_hash_table_remove (s_pAtlasRegions, GUINT_TO_POINTER (iTexture));
+	if (g_hash_table_size (s_pAtlasRegions) == 0)  // no more image, we can start again from the beginning.
+	{
+		g_free (pRegion);
+		g_list_free_full (s_pAtlasFreeSlots, g_free);
+		s_pAtlasFreeSlots = NULL;
+		s_iAtlasX = s_iAtlasY = s_iAtlasRowHeight = 0;
+	}
+	else  // its place can be used by another image (the old pixels will be overwritten, and the gap around is still transparent).
+	{
+		s_pAtlasFreeSlots = g_list_prepend (s_pAtlasFreeSlots, pRegion);
+	}
+}
+
+void cairo_dock_add_texture_to_icon_atlas (GLuint iTexture, cairo_surface_t *pSurface)
+{
+	if (! g_bUseOpenGL || g_bEasterEggs || iTexture == 0 || pSurface == NULL)  // with mipmaps, the icons must keep their own texture.
+		return;
+	int w = cairo_image_surface_get_width (pSurface);
+	int h = cairo_image_surface_get_height (pSurface);
+	if (w > CD_ICON_ATLAS_MAX_IMAGE_SIZE || h > CD_ICON_ATLAS_MAX_IMAGE_SIZE)
+		return;
+	if (s_iIconAtlas == 0 && ! _create_icon_atlas ())
+		return;
+	
+	//\_____________ find a place in the atlas: first a slot freed by another image, else at the end of the rows of images; when it's full, the next icons are simply drawn on their own.
+	CairoDockAtlasRegion *pRegion = _take_atlas_free_slot (w, h);
+	if (pRegion == NULL)
+	{
+		if (s_iAtlasX + w > CD_ICON_ATLAS_SIZE)
+		{
+			s_iAtlasX = 0;
+			s_iAtlasY += s_iAtlasRowHeight + CD_ICON_ATLAS_PADDING;
+			s_iAtlasRowHeight = 0;
+		}
+		if (s_iAtlasY + h > CD_ICON_ATLAS_SIZE)
+		{
+			cd_debug ("the icon atlas is full");
+			return;
+		}
+		pRegion = g_new0 (CairoDockAtlasRegion, 1);
+		pRegion->x = s_iAtlasX;
+		pRegion->y = s_iAtlasY;
+		pRegion->iSlotWidth = w;
+		pRegion->iSlotHeight = h;
+		s_iAtlasX += w + CD_ICON_ATLAS_PADDING;
+		s_iAtlasRowHeight = MAX (s_iAtlasRowHeight, h);
+	}
+	
+	pRegion->iWidth = w;
+	pRegion->iHeight = h;
+	pRegion->u = (GLfloat) pRegion->x / CD_ICON_ATLAS_SIZE;
+	pRegion->v = (GLfloat) pRegion->y / CD_ICON_ATLAS_SIZE;
+	pRegion->du = (GLfloat) w / CD_ICON_ATLAS_SIZE;
+	pRegion->dv = (GLfloat) h / CD_ICON_ATLAS_SIZE;
+	_upload_atlas_region (pRegion, pSurface);
+	g_hash_table_insert (s_pAtlasRegions, GUINT_TO_POINTER (iTexture), pRegion);
+}
+
+void cairo_dock_update_texture_in_icon_atlas (GLuint iTexture, cairo_surface_t *pSurface)
+{
+	if (s_pAtlasRegions == NULL || iTexture == 0)
+		return;
+	CairoDockAtlasRegion *pRegion = g_hash_table_lookup (s_pAtlasRegions, GUINT_TO_POINTER (iTexture));
+	if (pRegion == NULL)
+		return;
+	if (pSurface != NULL
+	&& cairo_image_surface_get_width (pSurface) == pRegion->iWidth
+	&& cairo_image_surface_get_height (pSurface) == pRegion->iHeight)
+		_upload_atlas_region (pRegion, pSurface);
+	else
+		_release_atlas_region (iTexture, pRegion);
+}
+
+void cairo_dock_remove_texture_from_icon_atlas (GLuint iTexture)
+{
+	if (s_pAtlasRegions == NULL || iTexture == 0)
+		return;
+	CairoDockAtlasRegion *pRegion = g_hash_table_lookup (s_pAtlasRegions, GUINT_TO_POINTER (iTexture));
+	if (pRegion != NULL)
+		_release_atlas_region (iTexture, pRegion);
+}
+
+void cairo_dock_delete_texture (GLuint iTexture)
+{
+	gldi_module_instances_untrack_resource (GLDI_RESOURCE_TEXTURE, GUINT_TO_POINTER (iTexture));
+	cairo_dock_remove_texture_from_icon_atlas (iTexture);
+	if (s_pTextureSizes != NULL)
+		g_hash_table_remove (s_pTextureSizes, GUINT_TO_POINTER (iTexture));
+	glDeleteTextures (1, &iTexture);
+}
+
+
+  ////////////////////
+ /// ICONS BATCH ///
+////////////////////
+
+static guint _count_render_hooks (GldiObject *pObject)
+{
+	GPtrArray *pNotificationsTab = pObject->pNotificationsTab;
+	guint n = 0;
+	if (pNotificationsTab != NULL && NOTIFICATION_PRE_RENDER_ICON < pNotificationsTab->len)
+		n += g_slist_length (g_ptr_array_index (pNotificationsTab, NOTIFICATION_PRE_RENDER_ICON));
+	if (pNotificationsTab != NULL && NOTIFICATION_RENDER_ICON < pNotificationsTab->len)
+		n += g_slist_length (g_ptr_array_index (pNotificationsTab, NOTIFICATION_RENDER_ICON));
+	return n;
+}
+
+void cairo_dock_init_icons_batch (void)
+{
+	s_iNbCoreRenderHooks = _count_render_hooks (GLDI_OBJECT (&myIconObjectMgr));
+}
+
+static gboolean _icon_can_be_batched (Icon *pIcon)
+{
+	// the batch only knows the position of the icon, not the other transformations.
+	if (pIcon->fOrientation != 0 || pIcon->iRotationX != 0 || pIcon->iRotationY != 0)
+		return FALSE;
+	
+	// something registered on the icon or one of its managers may draw over it, so the icon must be drawn right now.
+	GldiObject *obj;
+	for (obj = GLDI_OBJECT (pIcon); obj != NULL && obj != GLDI_OBJECT (&myIconObjectMgr); obj = GLDI_OBJECT (obj->mgr))
+	{
+		if (_count_render_hooks (obj) != 0)
+			return FALSE;
+	}
+	
+	// the plug-ins that draw on all the icons only do it on the icons they animate or hold some data for.
+	if (s_bPluginRenderHooks)
+	{
+		if (pIcon->iAnimationState != CAIRO_DOCK_STATE_REST || pIcon->bIsDemandingAttention || pIcon->bPointed)
+			return FALSE;
+		int i;
+		for (i = 0; i < CAIRO_DOCK_NB_DATA_SLOT; i ++)
+		{
+			if (pIcon->pDataSlot[i] != NULL)
+				return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+void cairo_dock_begin_icons_batch (void)
+{
+	s_iNbDrawCalls = s_iNbStateChanges = 0;
+	s_bBatching = (s_pAtlasRegions != NULL);
+	if (! s_bBatching)
+		return;
+	// if a plug-in draws on the icons, its drawings could be covered by the batched icons; it's decided for each icon.
+	s_bPluginRenderHooks = (_count_render_hooks (GLDI_OBJECT (&myIconObjectMgr)) != s_iNbCoreRenderHooks);
+	// the icons are only translated from the container (see cairo_dock_render_one_icon_opengl), so its matrix is read once, and the quads are placed on the CPU.
+	glGetFloatv (GL_MODELVIEW_MATRIX, s_fBatchMatrix);
+}
+
+static gboolean _add_quad_to_batch (GLuint iTexture, CairoDockBatchBlend iBlend, double x, double y, double w, double h, const GLfloat *pTexCoords, const GLfloat *pAlphas)
+{
+	CairoDockAtlasRegion *pRegion = g_hash_table_lookup (s_pAtlasRegions, GUINT_TO_POINTER (iTexture));
+	if (pRegion == NULL)
+		return FALSE;
+	if (s_pBatchVertices[iBlend] == NULL)
+		s_pBatchVertices[iBlend] = g_array_sized_new (FALSE, FALSE, sizeof (GLfloat), 64 * 4 * CD_BATCH_VERTEX_SIZE);
+	
+	// the quad is put in the window's coordinates, so that all of them can be drawn with the same matrix.
+	const GLfloat *m = s_fBatchMatrix;
+	const GLfloat *t = s_fBatchIconPosition;
+	const GLfloat corners[8] = {-.5*w, .5*h,  .5*w, .5*h,  .5*w, -.5*h,  -.5*w, -.5*h};
+	GLfloat vertex[CD_BATCH_VERTEX_SIZE];
+	int i;
+	for (i = 0; i < 4; i ++)
+	{
+		GLfloat vx = t[0] + x + corners[2*i], vy = t[1] + y + corners[2*i+1], vz = t[2];
+		vertex[0] = m[0] * vx + m[4] * vy + m[8] * vz + m[12];
+		vertex[1] = m[1] * vx + m[5] * vy + m[9] * vz + m[13];
+		vertex[2] = m[2] * vx + m[6] * vy + m[10] * vz + m[14];
+		vertex[3] = pRegion->u + pTexCoords[2*i] * pRegion->du;
+		vertex[4] = pRegion->v + pTexCoords[2*i+1] * pRegion->dv;
+		vertex[5] = vertex[6] = vertex[7] = 1.;
+		vertex[8] = pAlphas[i];
+		g_array_append_vals (s_pBatchVertices[iBlend], vertex, CD_BATCH_VERTEX_SIZE);
+	}
+	return TRUE;
+}
+
+void cairo_dock_flush_icons_batch (void)
+{
+	if ((s_pBatchVertices[0] == NULL || s_pBatchVertices[0]->len == 0)
+	&& (s_pBatchVertices[1] == NULL || s_pBatchVertices[1]->len == 0))
+		return;
+	glPushMatrix ();
+	glLoadIdentity ();
+	_cairo_dock_enable_texture ();
+	glBindTexture (GL_TEXTURE_2D, s_iIconAtlas);
+	s_iNbStateChanges ++;
+	glEnableClientState (GL_VERTEX_ARRAY);
+	glEnableClientState (GL_TEXTURE_COORD_ARRAY);
+	glEnableClientState (GL_COLOR_ARRAY);
+	
+	int i;
+	GArray *a;
+	for (i = 0; i < CD_BATCH_NB_BLENDS; i ++)  // the icons don't overlap each other, so the order between the 2 layers doesn't matter.
+	{
+		a = s_pBatchVertices[i];
+		if (a == NULL || a->len == 0)
+			continue;
+		if (i == CD_BATCH_BLEND_ALPHA)
+			_cairo_dock_set_blend_alpha ();
+		else
+			_cairo_dock_set_blend_pbuffer ();
+		s_iNbStateChanges ++;
+		GLfloat *v = (GLfloat *) a->data;
+		glVertexPointer (3, GL_FLOAT, CD_BATCH_VERTEX_SIZE * sizeof (GLfloat), v);
+		glTexCoordPointer (2, GL_FLOAT, CD_BATCH_VERTEX_SIZE * sizeof (GLfloat), v + 3);
+		glColorPointer (4, GL_FLOAT, CD_BATCH_VERTEX_SIZE * sizeof (GLfloat), v + 5);
+		glDrawArrays (GL_QUADS, 0, a->len / CD_BATCH_VERTEX_SIZE);
+		s_iNbDrawCalls ++;
+		g_array_set_size (a, 0);
+	}
+	
+	glDisableClientState (GL_COLOR_ARRAY);
+	glDisableClientState (GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState (GL_VERTEX_ARRAY);
+	_cairo_dock_set_alpha (1.);  // the color array left the current color undefined.
+	_cairo_dock_disable_texture ();
+	glPopMatrix ();
+}
+
+void cairo_dock_end_icons_batch (void)
+{
+	cairo_dock_flush_icons_batch ();
+	s_bBatching = FALSE;
+	gldi_profile_count (GLDI_PROFILE_DRAW_CALLS, s_iNbDrawCalls);
+	gldi_profile_count (GLDI_PROFILE_STATE_CHANGES, s_iNbStateChanges);
+}
+
+void cairo_dock_get_icons_batch_stats (guint *iNbDrawCalls, guint *iNbStateChanges)
+{
+	*iNbDrawCalls = s_iNbDrawCalls;
+	*iNbStateChanges = s_iNbStateChanges;
+}
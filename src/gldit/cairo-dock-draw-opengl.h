@@ -58,12 +58,79 @@ void cairo_dock_render_hidden_dock_opengl (CairoDock *pDock);
   //////////////////
  // LOAD TEXTURE //
 //////////////////
+/// Options of a texture.
+typedef enum {
+	/// build the mipmaps of the image, for images that are drawn much smaller than their size.
+	GLDI_TEXTURE_MIPMAPS = 1<<0,
+	/// the image won't be modified (except by drawing on it): its storage is immutable, and compressed if it's allowed (see \ref cairo_dock_set_textures_compression).
+	GLDI_TEXTURE_STATIC = 1<<1
+	} GldiTextureFlags;
+
+/** Load a cairo surface into an OpenGL texture. The surface can be destroyed after that if you don't need it. The texture will have the same size as the surface. Big images are streamed to the graphic card through a pixel buffer when it's possible.
+*@param pImageSurface the surface, created with one of the 'cairo_dock_create_surface_xxx' functions.
+*@param iFlags options of the texture.
+*@return the newly allocated texture, to be destroyed with _cairo_dock_delete_texture.
+*/
+GLuint cairo_dock_create_texture_from_surface_full (cairo_surface_t *pImageSurface, GldiTextureFlags iFlags);
+
 /** Load a cairo surface into an OpenGL texture. The surface can be destroyed after that if you don't need it. The texture will have the same size as the surface.
 *@param pImageSurface the surface, created with one of the 'cairo_dock_create_surface_xxx' functions.
 *@return the newly allocated texture, to be destroyed with _cairo_dock_delete_texture.
 */
 GLuint cairo_dock_create_texture_from_surface (cairo_surface_t *pImageSurface);
 
+/** Start drawing the content of a new texture with Cairo. When it's possible, the drawing is done right into a pixel buffer that is then handed over to the driver, which saves the copy of the pixels that \ref cairo_dock_create_texture_from_surface_full makes. Use it for images that are only drawn to be put into a texture.
+*@param iWidth width of the texture
+*@param iHeight height of the texture
+*@return a cleared drawing context, to be given to \ref cairo_dock_end_draw_new_texture. Don't destroy it, nor keep its surface.
+*/
+cairo_t *cairo_dock_begin_draw_new_texture (int iWidth, int iHeight);
+
+/** Finish the drawing started with \ref cairo_dock_begin_draw_new_texture and make the texture.
+*@param pCairoContext the drawing context; it's destroyed.
+*@param iFlags options of the texture.
+*@return the newly allocated texture, to be destroyed with _cairo_dock_delete_texture.
+*/
+GLuint cairo_dock_end_draw_new_texture (cairo_t *pCairoContext, GldiTextureFlags iFlags);
+
+/** Copy the content of a surface into an existing texture, and update its mipmaps if it has some. If the size of the surface has changed and the texture is immutable, the texture is replaced by a new one.
+*@param iTexture the texture, or 0 to create a new one.
+*@param pImageSurface the surface.
+*@return the texture (the same as iTexture, unless it had to be replaced).
+*/
+GLuint cairo_dock_update_texture_from_surface (GLuint iTexture, cairo_surface_t *pImageSurface);
+
+/** Build the mipmaps of a texture, so that it looks fine when drawn much smaller than its size. Does nothing if the card can't generate them, or if the texture is immutable and has been allocated without mipmaps.
+*@param iTexture the texture.
+*@param iWidth width of the texture.
+*@param iHeight height of the texture.
+*/
+void cairo_dock_build_texture_mipmaps (GLuint iTexture, int iWidth, int iHeight);
+
+/** Generate again the mipmaps of a texture after it has been drawn with OpenGL. Does nothing if it has no mipmaps.
+*@param iTexture the texture.
+*/
+void cairo_dock_update_texture_mipmaps (GLuint iTexture);
+
+/** Tell if a texture has mipmaps.
+*@param iTexture the texture.
+*@return TRUE if it has some.
+*/
+gboolean cairo_dock_texture_has_mipmaps (GLuint iTexture);
+
+/** Get the memory taken by a texture on the graphic card, mipmaps included.
+*@param iTexture the texture.
+*@param iWidth width of the texture.
+*@param iHeight height of the texture.
+*@return the size in bytes.
+*/
+gint64 cairo_dock_get_texture_size (GLuint iTexture, int iWidth, int iHeight);
+
+/** Let the textures of the static images (GLDI_TEXTURE_STATIC) be compressed by the graphic card (S3TC). It takes 4 times less memory, at the cost of some artefacts.
+*@param bCompress TRUE to compress them.
+*/
+void cairo_dock_set_textures_compression (gboolean bCompress);
+
 /** Load a pixels buffer representing an image into an OpenGL texture.
 *@param pTextureRaw a buffer of pixels.
 *@param iWidth width of the image.
@@ -89,7 +156,8 @@ GLuint cairo_dock_create_texture_from_image_full (const gchar *cImagePath, doubl
 /** Delete an OpenGL texture from the Graphic Card.
 *@param iTexture variable containing the ID of a texture.
 */
-#define _cairo_dock_delete_texture(iTexture) glDeleteTextures (1, &iTexture)
+#define _cairo_dock_delete_texture(iTexture) cairo_dock_delete_texture (iTexture)
+void cairo_dock_delete_texture (GLuint iTexture);
 
 /** Update the icon's texture with its current cairo surface. This allows you to draw an icon with libcairo, and just copy the result to the OpenGL texture to be able to draw the icon in OpenGL too.
 *@param pIcon the icon.
@@ -98,6 +166,46 @@ void cairo_dock_update_icon_texture (Icon *pIcon);
 
 void cairo_dock_draw_hidden_appli_icon (Icon *pIcon, GldiContainer *pContainer, gboolean bStateChanged);
 
+  ////////////////
+ // ICON BATCH //
+////////////////
+/** Copy the image of an icon into the icons atlas, a texture shared by all the icons, so that the icon can be drawn together with the others. Small images only are copied, in the place left by a removed image if possible, and nothing happens if the atlas is full.
+*@param iTexture the icon's texture.
+*@param pSurface the surface the texture has been made from.
+*/
+void cairo_dock_add_texture_to_icon_atlas (GLuint iTexture, cairo_surface_t *pSurface);
+
+/** Update the copy of a texture in the icons atlas, after the texture has been modified. If the texture has been modified by OpenGL, pass a NULL surface: it will be removed from the atlas.
+*@param iTexture the texture.
+*@param pSurface the new content of the texture, or NULL.
+*/
+void cairo_dock_update_texture_in_icon_atlas (GLuint iTexture, cairo_surface_t *pSurface);
+
+/** Remove a texture from the icons atlas. It is done automatically when the texture is deleted.
+*@param iTexture the texture.
+*/
+void cairo_dock_remove_texture_from_icon_atlas (GLuint iTexture);
+
+/** Start batching the icons of a container: until \ref cairo_dock_end_icons_batch, the icons that are in the atlas are not drawn immediately by \ref cairo_dock_draw_icon_opengl, but are gathered and drawn together in a couple of draw calls. The icons a plug-in may draw on are drawn immediately.
+*/
+void cairo_dock_begin_icons_batch (void);
+
+/** Draw the icons gathered so far. It must be called before drawing something over an icon (overlay, label, etc).
+*/
+void cairo_dock_flush_icons_batch (void);
+
+/** Draw the remaining icons and stop batching.
+*/
+void cairo_dock_end_icons_batch (void);
+
+/** Get the number of draw calls and state changes (texture binding and blending) used to draw the icons during the last batch.
+*@param iNbDrawCalls filled with the number of draw calls.
+*@param iNbStateChanges filled with the number of state changes.
+*/
+void cairo_dock_get_icons_batch_stats (guint *iNbDrawCalls, guint *iNbStateChanges);
+
+void cairo_dock_init_icons_batch (void);
+
   //////////////////
  // DRAW TEXTURE //
 //////////////////
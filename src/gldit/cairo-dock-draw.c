@@ -36,6 +36,9 @@
 #include "cairo-dock-style-manager.h"
 #include "cairo-dock-draw-opengl.h"  // pour cairo_dock_render_one_icon
 #include "cairo-dock-overlay.h"  // cairo_dock_draw_icon_overlays_cairo
+#include "cairo-dock-module-manager.h"  // pVisitCard->cModuleName
+#include "cairo-dock-module-instance-manager.h"  // pModuleInstance->pModule
+#include "cairo-dock-profiler.h"  // gldi_profile_begin
 #include "cairo-dock-draw.h"
 
 extern CairoDockImageBuffer g_pVisibleZoneBuffer;
@@ -59,16 +62,77 @@ cairo_t *cairo_dock_create_drawing_context_on_container (GldiContainer *pContain
 	return pCairoContext;
 }
 
-void cairo_dock_init_drawing_context_on_container (GldiContainer *pContainer, cairo_t *pCairoContext)
+// part of the desktop background behind a container, kept on the container's widget so that we don't sample the whole screen at each frame.
+typedef struct {
+	cairo_surface_t *pSurface;
+	gint x, y, iWidth, iHeight;
+	guint iBgStamp;
+	} CairoDockBgRegion;
+
+static void _free_bg_region (CairoDockBgRegion *pRegion)
+{
+	if (pRegion->pSurface != NULL)
+		cairo_surface_destroy (pRegion->pSurface);
+	g_free (pRegion);
+}
+
+static gboolean _set_source_desktop_bg (GldiContainer *pContainer, cairo_t *pCairoContext)
 {
-	if (g_pFakeTransparencyDesktopBg && g_pFakeTransparencyDesktopBg->pSurface)
+	GldiDesktopBackground *pDesktopBg = g_pFakeTransparencyDesktopBg;
+	if (! pDesktopBg || ! pDesktopBg->pSurface)
+		return FALSE;
+	
+	int x, y, w, h;  // position and size of the window on the screen.
+	if (pContainer->bIsHorizontal)
 	{
-		if (pContainer->bIsHorizontal)
-			cairo_set_source_surface (pCairoContext, g_pFakeTransparencyDesktopBg->pSurface, - pContainer->iWindowPositionX, - pContainer->iWindowPositionY);
-		else
-			cairo_set_source_surface (pCairoContext, g_pFakeTransparencyDesktopBg->pSurface, - pContainer->iWindowPositionY, - pContainer->iWindowPositionX);
+		x = pContainer->iWindowPositionX;
+		y = pContainer->iWindowPositionY;
+		w = pContainer->iWidth;
+		h = pContainer->iHeight;
 	}
 	else
+	{
+		x = pContainer->iWindowPositionY;
+		y = pContainer->iWindowPositionX;
+		w = pContainer->iHeight;
+		h = pContainer->iWidth;
+	}
+	if (w <= 0 || h <= 0 || pContainer->pWidget == NULL)
+	{
+		cairo_set_source_surface (pCairoContext, pDesktopBg->pSurface, -x, -y);
+		return TRUE;
+	}
+	
+	CairoDockBgRegion *pRegion = g_object_get_data (G_OBJECT (pContainer->pWidget), "cd-bg-region");
+	if (pRegion == NULL)
+	{
+		pRegion = g_new0 (CairoDockBgRegion, 1);
+		g_object_set_data_full (G_OBJECT (pContainer->pWidget), "cd-bg-region", pRegion, (GDestroyNotify) _free_bg_region);
+	}
+	if (pRegion->pSurface == NULL || pRegion->iBgStamp != pDesktopBg->iStamp
+	|| pRegion->x != x || pRegion->y != y || pRegion->iWidth != w || pRegion->iHeight != h)  // the background or the window has changed -> copy the new region.
+	{
+		if (pRegion->pSurface != NULL)
+			cairo_surface_destroy (pRegion->pSurface);
+		pRegion->pSurface = cairo_surface_create_similar (cairo_get_target (pCairoContext), CAIRO_CONTENT_COLOR, w, h);  // same backend as the window, so that painting it is a mere copy.
+		cairo_t *ctx = cairo_create (pRegion->pSurface);
+		cairo_set_source_surface (ctx, pDesktopBg->pSurface, -x, -y);
+		cairo_set_operator (ctx, CAIRO_OPERATOR_SOURCE);
+		cairo_paint (ctx);
+		cairo_destroy (ctx);
+		pRegion->x = x;
+		pRegion->y = y;
+		pRegion->iWidth = w;
+		pRegion->iHeight = h;
+		pRegion->iBgStamp = pDesktopBg->iStamp;
+	}
+	cairo_set_source_surface (pCairoContext, pRegion->pSurface, 0., 0.);
+	return TRUE;
+}
+
+void cairo_dock_init_drawing_context_on_container (GldiContainer *pContainer, cairo_t *pCairoContext)
+{
+	if (! _set_source_desktop_bg (pContainer, pCairoContext))
 		cairo_set_source_rgba (pCairoContext, 0.0, 0.0, 0.0, 0.0);
 	cairo_set_operator (pCairoContext, CAIRO_OPERATOR_SOURCE);
 	cairo_paint (pCairoContext);
@@ -91,22 +155,13 @@ cairo_t *cairo_dock_create_drawing_context_on_area (GldiContainer *pContainer, G
 		cairo_clip (pCairoContext);
 	}
 	
-	///if (myContainersParam.bUseFakeTransparency)
-	///{
-		if (g_pFakeTransparencyDesktopBg && g_pFakeTransparencyDesktopBg->pSurface)
-		{
-			if (pContainer->bIsHorizontal)
-				cairo_set_source_surface (pCairoContext, g_pFakeTransparencyDesktopBg->pSurface, - pContainer->iWindowPositionX, - pContainer->iWindowPositionY);
-			else
-				cairo_set_source_surface (pCairoContext, g_pFakeTransparencyDesktopBg->pSurface, - pContainer->iWindowPositionY, - pContainer->iWindowPositionX);
-		}
-		/**else
-			cairo_set_source_rgba (pCairoContext, 0.8, 0.8, 0.8, 0.0);
-	}*/
-	else if (fBgColor != NULL)
-		cairo_set_source_rgba (pCairoContext, fBgColor[0], fBgColor[1], fBgColor[2], fBgColor[3]);
-	else
-		cairo_set_source_rgba (pCairoContext, 0.0, 0.0, 0.0, 0.0);
+	if (! _set_source_desktop_bg (pContainer, pCairoContext))  // no fake transparency
+	{
+		if (fBgColor != NULL)
+			cairo_set_source_rgba (pCairoContext, fBgColor[0], fBgColor[1], fBgColor[2], fBgColor[3]);
+		else
+			cairo_set_source_rgba (pCairoContext, 0.0, 0.0, 0.0, 0.0);
+	}
 	cairo_set_operator (pCairoContext, CAIRO_OPERATOR_SOURCE);
 	cairo_paint (pCairoContext);
 	
@@ -580,8 +635,13 @@ void cairo_dock_render_one_icon (Icon *icon, CairoDock *pDock, cairo_t *pCairoCo
 	
 	//\_____________________ On dessine l'icone.
 	gboolean bIconHasBeenDrawn = FALSE;
+	gint64 iProfileTime = gldi_profile_begin ();
 	gldi_object_notify (&myIconObjectMgr, NOTIFICATION_PRE_RENDER_ICON, icon, pDock, pCairoContext);
 	gldi_object_notify (&myIconObjectMgr, NOTIFICATION_RENDER_ICON, icon, pDock, &bIconHasBeenDrawn, pCairoContext);
+	gldi_profile_end (iProfileTime, GLDI_PROFILE_ICON_RENDER,
+		icon->pModuleInstance ? (gconstpointer)icon->pModuleInstance : (gconstpointer)pDock,  // applets on their own, other icons per dock
+		icon->pModuleInstance ? icon->pModuleInstance->pModule->pVisitCard->cModuleName : "icons",
+		gldi_dock_get_name (pDock));
 	
 	cairo_restore (pCairoContext);  // retour juste apres la translation (fDrawX, fDrawY).
 	
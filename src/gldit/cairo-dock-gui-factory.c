@@ -286,8 +286,14 @@ static const gchar* _cairo_dock_gui_get_package_state (gint iState)
 	return cState;
 }
 
-static GdkPixbuf* _cairo_dock_gui_get_package_state_icon (gint iState)
+static GdkPixbuf* _cairo_dock_gui_get_package_state_icon (gint iState)  // the pixbuf is not referenced
 {
+	static GdkPixbuf *s_pStateIcons[CAIRO_DOCK_NB_TYPE_PACKAGE] = {NULL};  // there are only a few states, no need to load an svg for each theme.
+	if (iState < 0 || iState >= CAIRO_DOCK_NB_TYPE_PACKAGE)
+		return NULL;
+	if (s_pStateIcons[iState] != NULL)
+		return s_pStateIcons[iState];
+	
 	const gchar *cType;
 	switch (iState)
 	{
@@ -299,9 +305,9 @@ static GdkPixbuf* _cairo_dock_gui_get_package_state_icon (gint iState)
 		default: 							cType = NULL; break;
 	}
 	gchar *cStateIcon = g_strconcat (GLDI_SHARE_DATA_DIR"/", cType, NULL);
-	GdkPixbuf *pixbuf = gdk_pixbuf_new_from_file_at_size (cStateIcon, 24, 24, NULL);
+	s_pStateIcons[iState] = gdk_pixbuf_new_from_file_at_size (cStateIcon, 24, 24, NULL);
 	g_free (cStateIcon);
-	return pixbuf;
+	return s_pStateIcons[iState];
 }
 
 static gboolean on_delete_async_widget (GtkWidget *pWidget, G_GNUC_UNUSED GdkEvent *event, G_GNUC_UNUSED gpointer data)
@@ -353,7 +359,7 @@ static inline void _set_preview_image (const gchar *cPreviewFilePath, GtkImage *
 
 static void _on_got_readme (const gchar *cDescription, GtkWidget *pDescriptionLabel)
 {
-	if (cDescription && strncmp (cDescription, "<!DOCTYPE", 9) == 0)  // message received when file is not found: <!DOCTYPE HTML PUBLIC "-//IETF//DTD HTML 2.0//EN"><html><head><title>404 Not Found</title></head><body><h1>Not Found</h1><p>The requested URL /dustbin/Metal//readme was not found on this server.</p><hr><address>Apache/2.2.3 (Debian) mod_ssl/2.2.3 OpenSSL/0.9.8c Server at themes.glx-dock.org Port 80</address></body></html>
+	if (cDescription == NULL || strncmp (cDescription, "<!DOCTYPE", 9) == 0)  // message received when file is not found: <!DOCTYPE HTML PUBLIC "-//IETF//DTD HTML 2.0//EN"><html><head><title>404 Not Found</title></head><body><h1>Not Found</h1><p>The requested URL /dustbin/Metal//readme was not found on this server.</p><hr><address>Apache/2.2.3 (Debian) mod_ssl/2.2.3 OpenSSL/0.9.8c Server at themes.glx-dock.org Port 80</address></body></html>
 		gtk_label_set_markup (GTK_LABEL (pDescriptionLabel), "");
 	else
 		gtk_label_set_markup (GTK_LABEL (pDescriptionLabel), cDescription);
@@ -374,8 +380,7 @@ static void _on_got_preview_file (const gchar *cPreviewFilePath, gpointer *data)
 	
 	if (cPreviewFilePath != NULL)
 	{
-		_set_preview_image (cPreviewFilePath, GTK_IMAGE (pPreviewImage), pImageFrame);
-		g_remove (cPreviewFilePath);
+		_set_preview_image (cPreviewFilePath, GTK_IMAGE (pPreviewImage), pImageFrame);  // the file belongs to the cache.
 	}
 	GldiTask *pTask = g_object_get_data (G_OBJECT (pPreviewImage), "cd-task");
 	if (pTask != NULL)
@@ -485,7 +490,7 @@ static void _cairo_dock_selection_changed (GtkTreeModel *model, GtkTreeIter iter
 			cd_debug ("fichier readme distant (%s)", cDescriptionFilePath);
 			
 			gtk_label_set_markup (pDescriptionLabel, "loading...");
-			pTask = cairo_dock_get_url_data_async (cDescriptionFilePath, (GFunc) _on_got_readme, pDescriptionLabel);
+			pTask = cairo_dock_get_cached_url_data_async (cDescriptionFilePath, (GFunc) _on_got_readme, pDescriptionLabel);
 			g_object_set_data (G_OBJECT (pDescriptionLabel), "cd-task", pTask);
 			//g_print ("new task : %x\n", pTask);
 		}
@@ -529,7 +534,7 @@ static void _cairo_dock_selection_changed (GtkTreeModel *model, GtkTreeIter iter
 			cd_debug ("fichier preview distant (%s)", cPreviewFilePath);
 			gtk_image_set_from_pixbuf (pPreviewImage, NULL);  // set blank image while downloading.
 			
-			pTask = cairo_dock_download_file_async (cPreviewFilePath, NULL, (GFunc) _on_got_preview_file, data);  // NULL <=> as a temporary file
+			pTask = cairo_dock_get_cached_url_file_async (cPreviewFilePath, (GFunc) _on_got_preview_file, data);
 			g_object_set_data (G_OBJECT (pPreviewImage), "cd-task", pTask);
 		}
 		else  // fichier local ou rien.
@@ -1918,9 +1923,165 @@ const gchar *cairo_dock_parse_key_comment (gchar *cKeyComment, char *iElementTyp
 	return cUsefulComment;
 }
 
-GtkWidget *cairo_dock_build_group_widget (GKeyFile *pKeyFile, const gchar *cGroupName, const gchar *cGettextDomain, GtkWidget *pMainWindow, GSList **pWidgetList, GPtrArray *pDataGarbage, const gchar *cOriginalConfFilePath)
+  //////////////
+ /// SCHEMA ///
+//////////////
+
+// Schema d'un fichier de conf : le commentaire de chaque cle est parse une seule fois, puis reutilise tant que le fichier ne change pas de version.
+typedef struct {
+	gchar *cComment;  // commentaire brut, pour savoir si la cle a ete modifiee entre-temps.
+	gchar *cParsedComment;  // copie parsee du commentaire, dans laquelle pointent les chaines suivantes.
+	const gchar *cUsefulComment;  // NULL si la cle n'a pas de widget.
+	const gchar *cTipString;
+	gchar **pAuthorizedValuesList;
+	guint iNbElements;
+	char iElementType;
+	gboolean bAligned;
+	} CairoDockKeySchema;
+
+typedef struct {
+	gchar *cComment;
+	gchar *cParsedComment;
+	const gchar *cIcon;
+	const gchar *cDisplayedName;
+	GHashTable *pKeys;  // cle -> CairoDockKeySchema
+	} CairoDockGroupSchema;
+
+typedef struct {
+	gchar *cVersion;
+	GHashTable *pGroups;  // groupe -> CairoDockGroupSchema
+	} CairoDockConfSchema;
+
+static GHashTable *s_pConfSchemas = NULL;  // chemin du fichier de conf original -> CairoDockConfSchema
+
+static void _free_key_schema (CairoDockKeySchema *pKeySchema)
+{
+	g_free (pKeySchema->cComment);
+	g_free (pKeySchema->cParsedComment);
+	g_strfreev (pKeySchema->pAuthorizedValuesList);
+	g_free (pKeySchema);
+}
+
+static void _free_group_schema (CairoDockGroupSchema *pGroupSchema)
+{
+	g_free (pGroupSchema->cComment);
+	g_free (pGroupSchema->cParsedComment);
+	g_hash_table_destroy (pGroupSchema->pKeys);
+	g_free (pGroupSchema);
+}
+
+static void _free_conf_schema (CairoDockConfSchema *pSchema)
+{
+	if (pSchema == NULL)
+		return;
+	g_free (pSchema->cVersion);
+	g_hash_table_destroy (pSchema->pGroups);
+	g_free (pSchema);
+}
+
+static CairoDockConfSchema *_conf_schema_new (gchar *cVersion)
+{
+	CairoDockConfSchema *pSchema = g_new0 (CairoDockConfSchema, 1);
+	pSchema->cVersion = cVersion;
+	pSchema->pGroups = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify)_free_group_schema);
+	return pSchema;
+}
+
+// renvoie le schema du fichier de conf, ou NULL si on ne peut pas le garder en cache (pas de fichier original, ou pas de version); dans ce cas on utilise un schema temporaire.
+static CairoDockConfSchema *_get_conf_schema (GKeyFile *pKeyFile, const gchar *cSchemaId)
+{
+	if (cSchemaId == NULL)
+		return NULL;
+	gchar *cVersion = NULL;
+	cairo_dock_get_conf_file_version (pKeyFile, &cVersion);
+	if (cVersion == NULL)
+		return NULL;
+	
+	if (s_pConfSchemas == NULL)
+		s_pConfSchemas = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify)_free_conf_schema);
+	
+	CairoDockConfSchema *pSchema = g_hash_table_lookup (s_pConfSchemas, cSchemaId);
+	if (pSchema != NULL && strcmp (pSchema->cVersion, cVersion) == 0)
+	{
+		g_free (cVersion);
+		return pSchema;
+	}
+	cd_debug ("new schema for %s (%s)", cSchemaId, cVersion);
+	pSchema = _conf_schema_new (cVersion);
+	g_hash_table_insert (s_pConfSchemas, g_strdup (cSchemaId), pSchema);  // remplace l'eventuelle ancienne version.
+	return pSchema;
+}
+
+static CairoDockGroupSchema *_get_group_schema (CairoDockConfSchema *pSchema, GKeyFile *pKeyFile, const gchar *cGroupName)
+{
+	gchar *cGroupComment = g_key_file_get_comment (pKeyFile, cGroupName, NULL, NULL);
+	CairoDockGroupSchema *pGroupSchema = g_hash_table_lookup (pSchema->pGroups, cGroupName);
+	if (pGroupSchema == NULL)
+	{
+		pGroupSchema = g_new0 (CairoDockGroupSchema, 1);
+		pGroupSchema->pKeys = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify)_free_key_schema);
+		g_hash_table_insert (pSchema->pGroups, g_strdup (cGroupName), pGroupSchema);
+	}
+	else if (g_strcmp0 (pGroupSchema->cComment, cGroupComment) == 0)
+	{
+		g_free (cGroupComment);
+		return pGroupSchema;
+	}
+	else  // le commentaire a change, on le re-parse.
+	{
+		g_free (pGroupSchema->cComment);
+		g_free (pGroupSchema->cParsedComment);
+	}
+	
+	pGroupSchema->cComment = cGroupComment;
+	pGroupSchema->cParsedComment = g_strdup (cGroupComment);
+	pGroupSchema->cIcon = NULL;
+	pGroupSchema->cDisplayedName = NULL;
+	gchar *cComment = pGroupSchema->cParsedComment;
+	if (cComment != NULL && *cComment != '\0')  // extract the icon name/path, inside brackets [].
+	{
+		gchar *str = strrchr (cComment, '[');
+		if (str != NULL)
+		{
+			gchar *cIcon = str+1;
+			str = strrchr (cIcon, ']');
+			if (str != NULL)
+				*str = '\0';
+			str = strrchr (cIcon, ';');
+			if (str != NULL)
+			{
+				*str = '\0';
+				pGroupSchema->cDisplayedName = str + 1;
+			}
+			pGroupSchema->cIcon = cIcon;
+		}
+	}
+	return pGroupSchema;
+}
+
+static CairoDockKeySchema *_get_key_schema (CairoDockGroupSchema *pGroupSchema, GKeyFile *pKeyFile, const gchar *cGroupName, const gchar *cKeyName)
+{
+	gchar *cKeyComment = g_key_file_get_comment (pKeyFile, cGroupName, cKeyName, NULL);
+	CairoDockKeySchema *pKeySchema = g_hash_table_lookup (pGroupSchema->pKeys, cKeyName);
+	if (pKeySchema != NULL && g_strcmp0 (pKeySchema->cComment, cKeyComment) == 0)  // cas courant : la cle n'a pas change depuis la derniere fois.
+	{
+		g_free (cKeyComment);
+		return pKeySchema;
+	}
+	
+	// cle nouvelle ou modifiee (par exemple ajoutee par une applet a la volee), on parse son commentaire.
+	pKeySchema = g_new0 (CairoDockKeySchema, 1);
+	pKeySchema->cComment = cKeyComment;
+	pKeySchema->cParsedComment = g_strdup (cKeyComment);
+	pKeySchema->cUsefulComment = cairo_dock_parse_key_comment (pKeySchema->cParsedComment, &pKeySchema->iElementType, &pKeySchema->iNbElements, &pKeySchema->pAuthorizedValuesList, &pKeySchema->bAligned, &pKeySchema->cTipString);
+	if (pKeySchema->iElementType == '[')  // on gere le bug de la Glib, qui rajoute les nouvelles cles apres le commentaire du groupe suivant !
+		pKeySchema->cUsefulComment = NULL;
+	g_hash_table_insert (pGroupSchema->pKeys, g_strdup (cKeyName), pKeySchema);
+	return pKeySchema;
+}
+
+static GtkWidget *_build_group_widget (GKeyFile *pKeyFile, const gchar *cGroupName, CairoDockGroupSchema *pGroupSchema, const gchar *cGettextDomain, GtkWidget *pMainWindow, GSList **pWidgetList, GPtrArray *pDataGarbage, const gchar *cOriginalConfFilePath)
 {
-	g_return_val_if_fail (pKeyFile != NULL && cGroupName != NULL, NULL);
 	//GPtrArray *pDataGarbage = g_ptr_array_new ();
 	//GPtrArray *pModelGarbage = g_ptr_array_new ();
 	
@@ -1946,8 +2107,9 @@ GtkWidget *cairo_dock_build_group_widget (GKeyFile *pKeyFile, const gchar *cGrou
 	GtkWidget *pBackButton;
 	GList *pControlWidgets = NULL;
 	int iFirstSensitiveWidget = 0, iNbControlledWidgets = 0, iNbSensitiveWidgets = 0;
-	gchar *cKeyName, *cKeyComment, **pAuthorizedValuesList;
+	gchar *cKeyName, **pAuthorizedValuesList;
 	const gchar *cUsefulComment, *cTipString;
+	CairoDockKeySchema *pKeySchema;
 	CairoDockGroupKeyWidget *pGroupKeyWidget;
 	int j;
 	guint k, iNbElements;
@@ -1976,22 +2138,19 @@ GtkWidget *cairo_dock_build_group_widget (GKeyFile *pKeyFile, const gchar *cGrou
 	{
 		cKeyName = pKeyList[j];
 		
-		//\______________ On parse le commentaire.
-		pAuthorizedValuesList = NULL;
-		cTipString = NULL;
-		iNbElements = 0;
-		cKeyComment =  g_key_file_get_comment (pKeyFile, cGroupName, cKeyName, NULL);
-		cUsefulComment = cairo_dock_parse_key_comment (cKeyComment, &iElementType, &iNbElements, &pAuthorizedValuesList, &bIsAligned, &cTipString);
-		if (cUsefulComment == NULL)
-		{
-			g_free (cKeyComment);
-			continue;
-		}
-		if (iElementType == '[')  // on gere le bug de la Glib, qui rajoute les nouvelles cles apres le commentaire du groupe suivant !
+		//\______________ On recupere la description de la cle (son commentaire deja parse).
+		pKeySchema = _get_key_schema (pGroupSchema, pKeyFile, cGroupName, cKeyName);
+		if (pKeySchema->cUsefulComment == NULL)
 		{
-			g_free (cKeyComment);
+			g_free (cKeyName);
 			continue;
 		}
+		cUsefulComment = pKeySchema->cUsefulComment;
+		cTipString = pKeySchema->cTipString;
+		pAuthorizedValuesList = pKeySchema->pAuthorizedValuesList;  // partagee avec le schema, a ne pas modifier.
+		iNbElements = pKeySchema->iNbElements;
+		iElementType = pKeySchema->iElementType;
+		bIsAligned = pKeySchema->bAligned;
 		
 		//\______________ On cree la boite du groupe si c'est la 1ere cle valide.
 		if (pGroupBox == NULL)  // maintenant qu'on a au moins un element dans ce groupe, on cree sa page dans le notebook.
@@ -2752,11 +2911,8 @@ GtkWidget *cairo_dock_build_group_widget (GKeyFile *pKeyFile, const gchar *cGrou
 							iOrder1 = atoi (pAuthorizedValuesList[k+1]);
 							gchar *str = strchr (pAuthorizedValuesList[k+2], ',');
 							if (str)  // Note: this mechanism is an addition to the original {first widget, number of widgets}; it's not very generic nor beautiful, but until we need more, it's well enough (currently, only the Dock background needs it).
-							{
-								*str = '\0';
 								iExcept = atoi (str+1);
-							}
-							iOrder2 = atoi (pAuthorizedValuesList[k+2]);
+							iOrder2 = atoi (pAuthorizedValuesList[k+2]);  // s'arrete a la virgule.
 							iNbControlledWidgets = MAX (iNbControlledWidgets, iOrder1 + iOrder2 - 1);
 							//g_print ("iSelectedItem:%d ; k/dk:%d\n", iSelectedItem , k/dk);
 							if (iSelectedItem == (int)k/dk)
@@ -3297,6 +3453,7 @@ GtkWidget *cairo_dock_build_group_widget (GKeyFile *pKeyFile, const gchar *cGrou
 			pGroupKeyWidget = g_new0 (CairoDockGroupKeyWidget, 1);
 			pGroupKeyWidget->cGroupName = g_strdup (cGroupName);  // car on ne pourra pas le liberer s'il est partage entre plusieurs 'data'.
 			pGroupKeyWidget->cKeyName = cKeyName;
+			pGroupKeyWidget->iElementType = iElementType;
 			pGroupKeyWidget->pSubWidgetList = pSubWidgetList;
 			pGroupKeyWidget->cOriginalConfFilePath = (gchar *)cOriginalConfFilePath;
 			pGroupKeyWidget->pLabel = pLabel;
@@ -3313,10 +3470,6 @@ GtkWidget *cairo_dock_build_group_widget (GKeyFile *pKeyFile, const gchar *cGrou
 		}
 		else
 			g_free (cKeyName);
-		
-		if (pAuthorizedValuesList != NULL)
-			g_strfreev (pAuthorizedValuesList);
-		g_free (cKeyComment);
 	}
 	g_free (pKeyList);  // les chaines a l'interieur sont dans les group-key widgets.
 	
@@ -3326,13 +3479,82 @@ GtkWidget *cairo_dock_build_group_widget (GKeyFile *pKeyFile, const gchar *cGrou
 	return pGroupBox;
 }
 
+GtkWidget *cairo_dock_build_group_widget (GKeyFile *pKeyFile, const gchar *cGroupName, const gchar *cGettextDomain, GtkWidget *pMainWindow, GSList **pWidgetList, GPtrArray *pDataGarbage, const gchar *cOriginalConfFilePath)
+{
+	g_return_val_if_fail (pKeyFile != NULL && cGroupName != NULL, NULL);
+	CairoDockConfSchema *pSchema = _get_conf_schema (pKeyFile, cOriginalConfFilePath);
+	CairoDockConfSchema *pTmpSchema = (pSchema == NULL ? _conf_schema_new (NULL) : NULL);
+	
+	CairoDockGroupSchema *pGroupSchema = _get_group_schema (pSchema ? pSchema : pTmpSchema, pKeyFile, cGroupName);
+	GtkWidget *pGroupWidget = _build_group_widget (pKeyFile, cGroupName, pGroupSchema, cGettextDomain, pMainWindow, pWidgetList, pDataGarbage, cOriginalConfFilePath);
+	
+	_free_conf_schema (pTmpSchema);
+	return pGroupWidget;
+}
 
-GtkWidget *cairo_dock_build_key_file_widget_full (GKeyFile* pKeyFile, const gchar *cGettextDomain, GtkWidget *pMainWindow, GSList **pWidgetList, GPtrArray *pDataGarbage, const gchar *cOriginalConfFilePath, GtkWidget *pCurrentNoteBook)
+
+// Pages construites a la 1ere fois qu'on les affiche.
+typedef struct {
+	GKeyFile *pKeyFile;  // copie, l'appelant libere le sien des que le notebook est construit.
+	gchar *cSchemaId;
+	gchar *cGettextDomain;
+	GtkWidget *pMainWindow;
+	GSList **pWidgetList;
+	GPtrArray *pDataGarbage;
+	const gchar *cOriginalConfFilePath;
+	} CairoDockLazyPages;
+
+static void _free_lazy_pages (CairoDockLazyPages *pLazyPages)
+{
+	g_key_file_free (pLazyPages->pKeyFile);
+	g_free (pLazyPages->cSchemaId);
+	g_free (pLazyPages->cGettextDomain);
+	g_free (pLazyPages);
+}
+
+static void _fill_group_page (GtkWidget *pScrolledWindow, GtkWidget *pGroupWidget)
+{
+	if (pGroupWidget == NULL)  // aucune cle affichable dans ce groupe.
+		return;
+	#if GTK_CHECK_VERSION (3, 8, 0)
+	gtk_container_add (GTK_CONTAINER (pScrolledWindow), pGroupWidget);
+	#else
+	gtk_scrolled_window_add_with_viewport (GTK_SCROLLED_WINDOW (pScrolledWindow), pGroupWidget);
+	#endif
+}
+
+static void _on_switch_lazy_page (GtkNotebook *pNoteBook, GtkWidget *pPage, G_GNUC_UNUSED guint iNumPage, CairoDockLazyPages *pLazyPages)
+{
+	if (gtk_widget_in_destruction (GTK_WIDGET (pNoteBook)))  // le notebook enleve ses pages une a une, la liste de widgets n'existe peut-etre deja plus.
+		return;
+	const gchar *cGroupName = g_object_get_data (G_OBJECT (pPage), "cd-lazy-group");
+	if (cGroupName == NULL)  // deja construite.
+		return;
+	cd_debug ("build page '%s'", cGroupName);
+	
+	CairoDockConfSchema *pSchema = _get_conf_schema (pLazyPages->pKeyFile, pLazyPages->cSchemaId);
+	CairoDockConfSchema *pTmpSchema = (pSchema == NULL ? _conf_schema_new (NULL) : NULL);
+	CairoDockGroupSchema *pGroupSchema = _get_group_schema (pSchema ? pSchema : pTmpSchema, pLazyPages->pKeyFile, cGroupName);
+	
+	GtkWidget *pGroupWidget = _build_group_widget (pLazyPages->pKeyFile, cGroupName, pGroupSchema, pLazyPages->cGettextDomain, pLazyPages->pMainWindow, pLazyPages->pWidgetList, pLazyPages->pDataGarbage, pLazyPages->cOriginalConfFilePath);
+	_fill_group_page (pPage, pGroupWidget);
+	gtk_widget_show_all (pPage);
+	
+	_free_conf_schema (pTmpSchema);
+	g_object_set_data (G_OBJECT (pPage), "cd-lazy-group", NULL);
+}
+
+static GtkWidget *_build_key_file_widget (GKeyFile* pKeyFile, const gchar *cSchemaId, const gchar *cGettextDomain, GtkWidget *pMainWindow, GSList **pWidgetList, GPtrArray *pDataGarbage, const gchar *cOriginalConfFilePath, GtkWidget *pCurrentNoteBook, gboolean bLazy)
 {
 	gsize length = 0;
 	gchar **pGroupList = g_key_file_get_groups (pKeyFile, &length);
 	g_return_val_if_fail (pGroupList != NULL, NULL);
 	
+	CairoDockConfSchema *pSchema = _get_conf_schema (pKeyFile, cSchemaId);
+	CairoDockConfSchema *pTmpSchema = (pSchema == NULL ? _conf_schema_new (NULL) : NULL);  // pas de cache possible, on parse dans un schema jetable.
+	if (pSchema == NULL)
+		pSchema = pTmpSchema;
+	
 	GtkWidget *pNoteBook = pCurrentNoteBook;
 	if (! pNoteBook)
 	{
@@ -3342,34 +3564,39 @@ GtkWidget *cairo_dock_build_key_file_widget_full (GKeyFile* pKeyFile, const gcha
 		g_object_set (G_OBJECT (pNoteBook), "tab-pos", GTK_POS_TOP, NULL);
 	}
 	
+	if (bLazy && length > 1)
+	{
+		CairoDockLazyPages *pLazyPages = g_new0 (CairoDockLazyPages, 1);
+		pLazyPages->pKeyFile = g_key_file_new ();
+		gsize iDataLength = 0;
+		gchar *cData = g_key_file_to_data (pKeyFile, &iDataLength, NULL);
+		g_key_file_load_from_data (pLazyPages->pKeyFile, cData, iDataLength, G_KEY_FILE_KEEP_COMMENTS | G_KEY_FILE_KEEP_TRANSLATIONS, NULL);
+		g_free (cData);
+		pLazyPages->cSchemaId = g_strdup (cSchemaId);
+		pLazyPages->cGettextDomain = g_strdup (cGettextDomain);
+		pLazyPages->pMainWindow = pMainWindow;
+		pLazyPages->pWidgetList = pWidgetList;
+		pLazyPages->pDataGarbage = pDataGarbage;
+		pLazyPages->cOriginalConfFilePath = cOriginalConfFilePath;
+		g_object_set_data_full (G_OBJECT (pNoteBook), "cd-lazy-pages", pLazyPages, (GDestroyNotify) _free_lazy_pages);
+		g_signal_connect (pNoteBook, "switch-page", G_CALLBACK (_on_switch_lazy_page), pLazyPages);
+	}
+	else
+		bLazy = FALSE;
+	
 	GtkWidget *pGroupWidget, *pLabel, *pLabelContainer, *pAlign;
-	gchar *cGroupName, *cGroupComment, *cIcon, *cDisplayedGroupName;
+	gchar *cGroupName;
+	const gchar *cIcon, *cDisplayedGroupName;
+	CairoDockGroupSchema *pGroupSchema;
 	int i;
 	for (i = 0; pGroupList[i] != NULL; i++)
 	{
 		cGroupName = pGroupList[i];
 		
 		//\____________ On recupere les caracteristiques du groupe.
-		cGroupComment = g_key_file_get_comment (pKeyFile, cGroupName, NULL, NULL);
-		cIcon = NULL;
-		cDisplayedGroupName = NULL;
-		if (cGroupComment != NULL && *cGroupComment != '\0')  // extract the icon name/path, inside brackets [].
-		{
-			gchar *str = strrchr (cGroupComment, '[');
-			if (str != NULL)
-			{
-				cIcon = str+1;
-				str = strrchr (cIcon, ']');
-				if (str != NULL)
-					*str = '\0';
-				str = strrchr (cIcon, ';');
-				if (str != NULL)
-				{
-					*str = '\0';
-					cDisplayedGroupName = str + 1;
-				}
-			}
-		}
+		pGroupSchema = _get_group_schema (pSchema, pKeyFile, cGroupName);
+		cIcon = pGroupSchema->cIcon;
+		cDisplayedGroupName = pGroupSchema->cDisplayedName;
 		
 		//\____________ On construit son widget.
 		pLabel = gtk_label_new (dgettext (cGettextDomain, cDisplayedGroupName ? cDisplayedGroupName : cGroupName));
@@ -3387,25 +3614,37 @@ GtkWidget *cairo_dock_build_key_file_widget_full (GKeyFile* pKeyFile, const gcha
 			gtk_container_add (GTK_CONTAINER (pLabelContainer), pLabel);
 			gtk_widget_show_all (pLabelContainer);
 		}
-		g_free (cGroupComment);
-		
-		pGroupWidget = cairo_dock_build_group_widget (pKeyFile, cGroupName, cGettextDomain, pMainWindow, pWidgetList, pDataGarbage, cOriginalConfFilePath);
 		
 		GtkWidget *pScrolledWindow = gtk_scrolled_window_new (NULL, NULL);
 		gtk_scrolled_window_set_policy (GTK_SCROLLED_WINDOW (pScrolledWindow), GTK_POLICY_AUTOMATIC, GTK_POLICY_AUTOMATIC);
-		#if GTK_CHECK_VERSION (3, 8, 0)
-		gtk_container_add (GTK_CONTAINER (pScrolledWindow), pGroupWidget);
-		#else
-		gtk_scrolled_window_add_with_viewport (GTK_SCROLLED_WINDOW (pScrolledWindow), pGroupWidget);
-		#endif
+		if (bLazy && i != 0)  // seule la 1ere page est visible, les autres seront construites quand on les affichera.
+		{
+			g_object_set_data_full (G_OBJECT (pScrolledWindow), "cd-lazy-group", g_strdup (cGroupName), g_free);
+		}
+		else
+		{
+			pGroupWidget = _build_group_widget (pKeyFile, cGroupName, pGroupSchema, cGettextDomain, pMainWindow, pWidgetList, pDataGarbage, cOriginalConfFilePath);
+			_fill_group_page (pScrolledWindow, pGroupWidget);
+		}
 		
 		gtk_notebook_append_page (GTK_NOTEBOOK (pNoteBook), pScrolledWindow, (pAlign != NULL ? pAlign : pLabel));
 	}
 	
 	g_strfreev (pGroupList);
+	_free_conf_schema (pTmpSchema);
 	return pNoteBook;
 }
 
+GtkWidget *cairo_dock_build_key_file_widget_full (GKeyFile* pKeyFile, const gchar *cGettextDomain, GtkWidget *pMainWindow, GSList **pWidgetList, GPtrArray *pDataGarbage, const gchar *cOriginalConfFilePath, GtkWidget *pCurrentNoteBook)
+{
+	return _build_key_file_widget (pKeyFile, cOriginalConfFilePath, cGettextDomain, pMainWindow, pWidgetList, pDataGarbage, cOriginalConfFilePath, pCurrentNoteBook, FALSE);
+}
+
+GtkWidget *cairo_dock_build_key_file_widget_lazy (GKeyFile* pKeyFile, const gchar *cGettextDomain, GtkWidget *pMainWindow, GSList **pWidgetList, GPtrArray *pDataGarbage, const gchar *cOriginalConfFilePath)
+{
+	return _build_key_file_widget (pKeyFile, cOriginalConfFilePath, cGettextDomain, pMainWindow, pWidgetList, pDataGarbage, cOriginalConfFilePath, NULL, TRUE);
+}
+
 GtkWidget *cairo_dock_build_conf_file_widget (const gchar *cConfFilePath, const gchar *cGettextDomain, GtkWidget *pMainWindow, GSList **pWidgetList, GPtrArray *pDataGarbage, const gchar *cOriginalConfFilePath)
 {
 	//\_____________ On recupere les groupes du fichier.
@@ -3414,140 +3653,243 @@ GtkWidget *cairo_dock_build_conf_file_widget (const gchar *cConfFilePath, const
 		return NULL;
 	
 	//\_____________ On construit le widget.
-	GtkWidget *pNoteBook = cairo_dock_build_key_file_widget (pKeyFile, cGettextDomain, pMainWindow, pWidgetList, pDataGarbage, cOriginalConfFilePath);
+	GtkWidget *pNoteBook = _build_key_file_widget (pKeyFile, cOriginalConfFilePath ? cOriginalConfFilePath : cConfFilePath, cGettextDomain, pMainWindow, pWidgetList, pDataGarbage, cOriginalConfFilePath, NULL, FALSE);
 
 	g_key_file_free (pKeyFile);
 	return pNoteBook;
 }
 
 
-static void _cairo_dock_get_each_widget_value (CairoDockGroupKeyWidget *pGroupKeyWidget, GKeyFile *pKeyFile)
+static void _set_boolean_values (GKeyFile *pKeyFile, const gchar *cGroupName, const gchar *cKeyName, GSList *pSubWidgetList)
 {
-	gchar *cGroupName = pGroupKeyWidget->cGroupName;
-	gchar *cKeyName = pGroupKeyWidget->cKeyName;
-	GSList *pSubWidgetList = pGroupKeyWidget->pSubWidgetList;
-	if (pSubWidgetList == NULL)
-		return ;
+	gsize i = 0, iNbElements = g_slist_length (pSubWidgetList);
+	gboolean *tBooleanValues = g_new0 (gboolean, iNbElements);
 	GSList *pList;
+	for (pList = pSubWidgetList; pList != NULL; pList = pList->next)
+	{
+		tBooleanValues[i] = gtk_toggle_button_get_active (GTK_TOGGLE_BUTTON (pList->data));
+		i ++;
+	}
+	if (iNbElements > 1)
+		g_key_file_set_boolean_list (pKeyFile, cGroupName, cKeyName, tBooleanValues, iNbElements);
+	else
+		g_key_file_set_boolean (pKeyFile, cGroupName, cKeyName, tBooleanValues[0]);
+	g_free (tBooleanValues);
+}
+
+static void _set_number_values (GKeyFile *pKeyFile, const gchar *cGroupName, const gchar *cKeyName, GSList *pSubWidgetList)
+{
 	gsize i = 0, iNbElements = g_slist_length (pSubWidgetList);
 	GtkWidget *pOneWidget = pSubWidgetList->data;
-
-	if (GTK_IS_CHECK_BUTTON (pOneWidget))
+	GSList *pList;
+	gboolean bIsSpin = GTK_IS_SPIN_BUTTON (pOneWidget);
+	
+	if ((bIsSpin && gtk_spin_button_get_digits (GTK_SPIN_BUTTON (pOneWidget)) == 0) || (! bIsSpin && gtk_scale_get_digits (GTK_SCALE (pOneWidget)) == 0))
 	{
-		gboolean *tBooleanValues = g_new0 (gboolean, iNbElements);
+		int *tIntegerValues = g_new0 (int, iNbElements);
 		for (pList = pSubWidgetList; pList != NULL; pList = pList->next)
 		{
 			pOneWidget = pList->data;
-			tBooleanValues[i] = gtk_toggle_button_get_active (GTK_TOGGLE_BUTTON (pOneWidget));
+			tIntegerValues[i] = (bIsSpin ? gtk_spin_button_get_value_as_int (GTK_SPIN_BUTTON (pOneWidget)) : gtk_range_get_value (GTK_RANGE (pOneWidget)));
 			i ++;
 		}
 		if (iNbElements > 1)
-			g_key_file_set_boolean_list (pKeyFile, cGroupName, cKeyName, tBooleanValues, iNbElements);
+			g_key_file_set_integer_list (pKeyFile, cGroupName, cKeyName, tIntegerValues, iNbElements);
 		else
-			g_key_file_set_boolean (pKeyFile, cGroupName, cKeyName, tBooleanValues[0]);
-		g_free (tBooleanValues);
+			g_key_file_set_integer (pKeyFile, cGroupName, cKeyName, tIntegerValues[0]);
+		g_free (tIntegerValues);
 	}
-	else if (GTK_IS_SPIN_BUTTON (pOneWidget) || GTK_IS_SCALE (pOneWidget))
-	{
-		gboolean bIsSpin = GTK_IS_SPIN_BUTTON (pOneWidget);
-		
-		if ((bIsSpin && gtk_spin_button_get_digits (GTK_SPIN_BUTTON (pOneWidget)) == 0) || (! bIsSpin && gtk_scale_get_digits (GTK_SCALE (pOneWidget)) == 0))
-		{
-			int *tIntegerValues = g_new0 (int, iNbElements);
-			for (pList = pSubWidgetList; pList != NULL; pList = pList->next)
-			{
-				pOneWidget = pList->data;
-				tIntegerValues[i] = (bIsSpin ? gtk_spin_button_get_value_as_int (GTK_SPIN_BUTTON (pOneWidget)) : gtk_range_get_value (GTK_RANGE (pOneWidget)));
-				i ++;
-			}
-			if (iNbElements > 1)
-				g_key_file_set_integer_list (pKeyFile, cGroupName, cKeyName, tIntegerValues, iNbElements);
-			else
-				g_key_file_set_integer (pKeyFile, cGroupName, cKeyName, tIntegerValues[0]);
-			g_free (tIntegerValues);
-		}
-		else
-		{
-			double *tDoubleValues = g_new0 (double, iNbElements);
-			for (pList = pSubWidgetList; pList != NULL; pList = pList->next)
-			{
-				pOneWidget = pList->data;
-				tDoubleValues[i] = (bIsSpin ? gtk_spin_button_get_value (GTK_SPIN_BUTTON (pOneWidget)) : gtk_range_get_value (GTK_RANGE (pOneWidget)));
-				i ++;
-			}
-			if (iNbElements > 1)
-				g_key_file_set_double_list (pKeyFile, cGroupName, cKeyName, tDoubleValues, iNbElements);
-			else
-				g_key_file_set_double (pKeyFile, cGroupName, cKeyName, tDoubleValues[0]);
-			g_free (tDoubleValues);
-		}
-	}
-	else if (GTK_IS_COMBO_BOX (pOneWidget))
+	else
 	{
-		gchar **tValues = g_new0 (gchar*, iNbElements+1);
-		gchar *cValue;
+		double *tDoubleValues = g_new0 (double, iNbElements);
 		for (pList = pSubWidgetList; pList != NULL; pList = pList->next)
 		{
 			pOneWidget = pList->data;
-			cValue = _cairo_dock_gui_get_active_row_in_combo (pOneWidget);
-			tValues[i] = (cValue ? cValue : g_strdup(""));
+			tDoubleValues[i] = (bIsSpin ? gtk_spin_button_get_value (GTK_SPIN_BUTTON (pOneWidget)) : gtk_range_get_value (GTK_RANGE (pOneWidget)));
 			i ++;
 		}
 		if (iNbElements > 1)
-			g_key_file_set_string_list (pKeyFile, cGroupName, cKeyName, (const gchar * const *)tValues, iNbElements);
+			g_key_file_set_double_list (pKeyFile, cGroupName, cKeyName, tDoubleValues, iNbElements);
 		else
-			g_key_file_set_string (pKeyFile, cGroupName, cKeyName, tValues[0]);
-		g_strfreev (tValues);
+			g_key_file_set_double (pKeyFile, cGroupName, cKeyName, tDoubleValues[0]);
+		g_free (tDoubleValues);
 	}
-	else if (GTK_IS_FONT_BUTTON (pOneWidget))
+}
+
+static void _set_combo_values (GKeyFile *pKeyFile, const gchar *cGroupName, const gchar *cKeyName, GSList *pSubWidgetList)
+{
+	gsize i = 0, iNbElements = g_slist_length (pSubWidgetList);
+	gchar **tValues = g_new0 (gchar*, iNbElements+1);
+	gchar *cValue;
+	GSList *pList;
+	for (pList = pSubWidgetList; pList != NULL; pList = pList->next)
 	{
-		const gchar *cFontName = gtk_font_button_get_font_name (GTK_FONT_BUTTON (pOneWidget));
-		g_key_file_set_string (pKeyFile, cGroupName, cKeyName, cFontName);
+		cValue = _cairo_dock_gui_get_active_row_in_combo (pList->data);
+		tValues[i] = (cValue ? cValue : g_strdup(""));
+		i ++;
 	}
-	else if (GTK_IS_COLOR_BUTTON (pOneWidget))
-	{
-		double col[4];
-		int iNbColors;
+	if (iNbElements > 1)
+		g_key_file_set_string_list (pKeyFile, cGroupName, cKeyName, (const gchar * const *)tValues, iNbElements);
+	else
+		g_key_file_set_string (pKeyFile, cGroupName, cKeyName, tValues[0]);
+	g_strfreev (tValues);
+}
+
+static void _set_font_value (GKeyFile *pKeyFile, const gchar *cGroupName, const gchar *cKeyName, GtkWidget *pOneWidget)
+{
+	const gchar *cFontName = gtk_font_button_get_font_name (GTK_FONT_BUTTON (pOneWidget));
+	g_key_file_set_string (pKeyFile, cGroupName, cKeyName, cFontName);
+}
 
-		GdkRGBA gdkColor;
-		gtk_color_chooser_get_rgba (GTK_COLOR_CHOOSER (pOneWidget), &gdkColor);
-		iNbColors = 4;
-		col[0] = gdkColor.red;
-		col[1] = gdkColor.green;
-		col[2] = gdkColor.blue;
-		col[3] = gdkColor.alpha;
+static void _set_color_value (GKeyFile *pKeyFile, const gchar *cGroupName, const gchar *cKeyName, GtkWidget *pOneWidget)
+{
+	double col[4];
+	int iNbColors;
 
-		g_key_file_set_double_list (pKeyFile, cGroupName, cKeyName, col, iNbColors);
-	}
-	else if (GTK_IS_ENTRY (pOneWidget))
+	GdkRGBA gdkColor;
+	gtk_color_chooser_get_rgba (GTK_COLOR_CHOOSER (pOneWidget), &gdkColor);
+	iNbColors = 4;
+	col[0] = gdkColor.red;
+	col[1] = gdkColor.green;
+	col[2] = gdkColor.blue;
+	col[3] = gdkColor.alpha;
+
+	g_key_file_set_double_list (pKeyFile, cGroupName, cKeyName, col, iNbColors);
+}
+
+static void _set_entry_value (GKeyFile *pKeyFile, const gchar *cGroupName, const gchar *cKeyName, GtkWidget *pOneWidget)
+{
+	gchar *cValue = NULL;
+	if (g_object_get_data (G_OBJECT (pOneWidget), "ignore-value") == NULL)
 	{
-		gchar *cValue = NULL;
-		if (g_object_get_data (G_OBJECT (pOneWidget), "ignore-value") == NULL)
+		const gchar *cWidgetValue = gtk_entry_get_text (GTK_ENTRY (pOneWidget));
+		if( !gtk_entry_get_visibility(GTK_ENTRY (pOneWidget)) )
 		{
-			const gchar *cWidgetValue = gtk_entry_get_text (GTK_ENTRY (pOneWidget));
-			if( !gtk_entry_get_visibility(GTK_ENTRY (pOneWidget)) )
-			{
-				cairo_dock_encrypt_string( cWidgetValue,  &cValue );
-			}
-			else
-			{
-				cValue = g_strdup (cWidgetValue);
-			}
+			cairo_dock_encrypt_string( cWidgetValue,  &cValue );
+		}
+		else
+		{
+			cValue = g_strdup (cWidgetValue);
 		}
-		g_key_file_set_string (pKeyFile, cGroupName, cKeyName, cValue?cValue:"");
-
-		g_free( cValue );
 	}
-	else if (GTK_IS_TREE_VIEW (pOneWidget))
+	g_key_file_set_string (pKeyFile, cGroupName, cKeyName, cValue?cValue:"");
+
+	g_free( cValue );
+}
+
+static void _set_tree_view_values (GKeyFile *pKeyFile, const gchar *cGroupName, const gchar *cKeyName, GtkWidget *pOneWidget)
+{
+	gsize iNbElements = 0;
+	gboolean bGetActiveOnly = GPOINTER_TO_INT (g_object_get_data (G_OBJECT (pOneWidget), "get-selected-line-only"));
+	gchar **tStringValues = cairo_dock_gui_get_active_rows_in_tree_view (pOneWidget, bGetActiveOnly, &iNbElements);
+	if (iNbElements > 1)
+		g_key_file_set_string_list (pKeyFile, cGroupName, cKeyName, (const gchar * const *)tStringValues, iNbElements);
+	else
+		g_key_file_set_string (pKeyFile, cGroupName, cKeyName, (tStringValues[0] != NULL ? tStringValues[0] : ""));
+	g_strfreev (tStringValues);
+}
+
+static void _cairo_dock_get_each_widget_value (CairoDockGroupKeyWidget *pGroupKeyWidget, GKeyFile *pKeyFile)
+{
+	gchar *cGroupName = pGroupKeyWidget->cGroupName;
+	gchar *cKeyName = pGroupKeyWidget->cKeyName;
+	GSList *pSubWidgetList = pGroupKeyWidget->pSubWidgetList;
+	if (pSubWidgetList == NULL)
+		return ;
+	GtkWidget *pOneWidget = pSubWidgetList->data;
+	
+	//\______________ On connait le type de la cle, on va directement au bon widget.
+	switch (pGroupKeyWidget->iElementType)
 	{
-		gboolean bGetActiveOnly = GPOINTER_TO_INT (g_object_get_data (G_OBJECT (pOneWidget), "get-selected-line-only"));
-		gchar **tStringValues = cairo_dock_gui_get_active_rows_in_tree_view (pOneWidget, bGetActiveOnly, &iNbElements);
-		if (iNbElements > 1)
-			g_key_file_set_string_list (pKeyFile, cGroupName, cKeyName, (const gchar * const *)tStringValues, iNbElements);
-		else
-			g_key_file_set_string (pKeyFile, cGroupName, cKeyName, (tStringValues[0] != NULL ? tStringValues[0] : ""));
-		g_strfreev (tStringValues);
+		case CAIRO_DOCK_WIDGET_CHECK_BUTTON :
+		case CAIRO_DOCK_WIDGET_CHECK_CONTROL_BUTTON :
+			if (! GTK_IS_CHECK_BUTTON (pOneWidget))
+				break;
+			_set_boolean_values (pKeyFile, cGroupName, cKeyName, pSubWidgetList);
+		return;
+		
+		case CAIRO_DOCK_WIDGET_SPIN_INTEGER :
+		case CAIRO_DOCK_WIDGET_HSCALE_INTEGER :
+		case CAIRO_DOCK_WIDGET_SIZE_INTEGER :
+		case CAIRO_DOCK_WIDGET_SPIN_DOUBLE :
+		case CAIRO_DOCK_WIDGET_HSCALE_DOUBLE :
+			if (! GTK_IS_SPIN_BUTTON (pOneWidget) && ! GTK_IS_SCALE (pOneWidget))
+				break;
+			_set_number_values (pKeyFile, cGroupName, cKeyName, pSubWidgetList);
+		return;
+		
+		case CAIRO_DOCK_WIDGET_COLOR_SELECTOR_RGB :
+		case CAIRO_DOCK_WIDGET_COLOR_SELECTOR_RGBA :
+			if (! GTK_IS_COLOR_BUTTON (pOneWidget))
+				break;
+			_set_color_value (pKeyFile, cGroupName, cKeyName, pOneWidget);
+		return;
+		
+		case CAIRO_DOCK_WIDGET_FONT_SELECTOR :
+			if (! GTK_IS_FONT_BUTTON (pOneWidget))
+				break;
+			_set_font_value (pKeyFile, cGroupName, cKeyName, pOneWidget);
+		return;
+		
+		case CAIRO_DOCK_WIDGET_STRING_ENTRY :
+		case CAIRO_DOCK_WIDGET_PASSWORD_ENTRY :
+		case CAIRO_DOCK_WIDGET_FILE_SELECTOR :
+		case CAIRO_DOCK_WIDGET_FOLDER_SELECTOR :
+		case CAIRO_DOCK_WIDGET_SOUND_SELECTOR :
+		case CAIRO_DOCK_WIDGET_SHORTKEY_SELECTOR :
+		case CAIRO_DOCK_WIDGET_CLASS_SELECTOR :
+		case CAIRO_DOCK_WIDGET_IMAGE_SELECTOR :
+			if (! GTK_IS_ENTRY (pOneWidget))
+				break;
+			_set_entry_value (pKeyFile, cGroupName, cKeyName, pOneWidget);
+		return;
+		
+		case CAIRO_DOCK_WIDGET_TREE_VIEW_SORT :
+		case CAIRO_DOCK_WIDGET_TREE_VIEW_SORT_AND_MODIFY :
+		case CAIRO_DOCK_WIDGET_TREE_VIEW_MULTI_CHOICE :
+			if (! GTK_IS_TREE_VIEW (pOneWidget))
+				break;
+			_set_tree_view_values (pKeyFile, cGroupName, cKeyName, pOneWidget);
+		return;
+		
+		case CAIRO_DOCK_WIDGET_LIST :
+		case CAIRO_DOCK_WIDGET_LIST_WITH_ENTRY :
+		case CAIRO_DOCK_WIDGET_NUMBERED_LIST :
+		case CAIRO_DOCK_WIDGET_NUMBERED_CONTROL_LIST :
+		case CAIRO_DOCK_WIDGET_NUMBERED_CONTROL_LIST_SELECTIVE :
+		case CAIRO_DOCK_WIDGET_VIEW_LIST :
+		case CAIRO_DOCK_WIDGET_THEME_LIST :
+		case CAIRO_DOCK_WIDGET_ANIMATION_LIST :
+		case CAIRO_DOCK_WIDGET_DIALOG_DECORATOR_LIST :
+		case CAIRO_DOCK_WIDGET_DESKLET_DECORATION_LIST :
+		case CAIRO_DOCK_WIDGET_DESKLET_DECORATION_LIST_WITH_DEFAULT :
+		case CAIRO_DOCK_WIDGET_DOCK_LIST :
+		case CAIRO_DOCK_WIDGET_ICON_THEME_LIST :
+		case CAIRO_DOCK_WIDGET_SCREENS_LIST :
+			if (! GTK_IS_COMBO_BOX (pOneWidget))
+				break;
+			_set_combo_values (pKeyFile, cGroupName, cKeyName, pSubWidgetList);
+		return;
+		
+		default:
+		break;
 	}
+	
+	//\______________ Type inconnu (widget ajoute par une applet), on le devine d'apres le widget.
+	if (GTK_IS_CHECK_BUTTON (pOneWidget))
+		_set_boolean_values (pKeyFile, cGroupName, cKeyName, pSubWidgetList);
+	else if (GTK_IS_SPIN_BUTTON (pOneWidget) || GTK_IS_SCALE (pOneWidget))
+		_set_number_values (pKeyFile, cGroupName, cKeyName, pSubWidgetList);
+	else if (GTK_IS_COMBO_BOX (pOneWidget))
+		_set_combo_values (pKeyFile, cGroupName, cKeyName, pSubWidgetList);
+	else if (GTK_IS_FONT_BUTTON (pOneWidget))
+		_set_font_value (pKeyFile, cGroupName, cKeyName, pOneWidget);
+	else if (GTK_IS_COLOR_BUTTON (pOneWidget))
+		_set_color_value (pKeyFile, cGroupName, cKeyName, pOneWidget);
+	else if (GTK_IS_ENTRY (pOneWidget))
+		_set_entry_value (pKeyFile, cGroupName, cKeyName, pOneWidget);
+	else if (GTK_IS_TREE_VIEW (pOneWidget))
+		_set_tree_view_values (pKeyFile, cGroupName, cKeyName, pOneWidget);
 }
 void cairo_dock_update_keyfile_from_widget_list (GKeyFile *pKeyFile, GSList *pWidgetList)
 {
@@ -3606,7 +3948,6 @@ static void _fill_model_with_one_theme (const gchar *cThemeName, CairoDockPackag
 		g_free (cReadmePath);
 		g_free (cPreviewPath);
 		g_free (cResult);
-		g_object_unref (pixbuf);
 	}
 }
 void cairo_dock_fill_model_with_themes (GtkListStore *pModel, GHashTable *pThemeTable, const gchar *cHint)
@@ -3658,6 +3999,29 @@ GtkWidget *cairo_dock_gui_make_tree_view (gboolean bGetActiveOnly)
 	return pOneWidget;
 }
 
+void cairo_dock_gui_set_column_fixed_width (GtkWidget *pTreeView, GtkTreeViewColumn *col, int iMinWidth, const gchar *cSampleText)
+{
+	int iWidth = iMinWidth, w;
+	PangoLayout *pLayout = gtk_widget_create_pango_layout (pTreeView, NULL);
+	if (cSampleText != NULL)
+	{
+		pango_layout_set_text (pLayout, cSampleText, -1);
+		pango_layout_get_pixel_size (pLayout, &w, NULL);
+		iWidth = MAX (iWidth, w);
+	}
+	const gchar *cTitle = gtk_tree_view_column_get_title (col);
+	if (cTitle != NULL)
+	{
+		pango_layout_set_text (pLayout, cTitle, -1);
+		pango_layout_get_pixel_size (pLayout, &w, NULL);
+		iWidth = MAX (iWidth, w + 16);  // room for the sort arrow.
+	}
+	g_object_unref (pLayout);
+	
+	gtk_tree_view_column_set_sizing (col, GTK_TREE_VIEW_COLUMN_FIXED);
+	gtk_tree_view_column_set_fixed_width (col, iWidth + 2 * CAIRO_DOCK_GUI_MARGIN);  // cells padding.
+}
+
 GtkWidget *cairo_dock_gui_make_combo (gboolean bWithEntry)
 {
 	GtkListStore *modele = _cairo_dock_gui_allocate_new_model ();
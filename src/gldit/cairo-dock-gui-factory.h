@@ -186,6 +186,7 @@ struct _CairoDockGroupKeyWidget {
 	gchar *cOriginalConfFilePath;
 	GtkWidget *pLabel;
 	GtkWidget *pKeyBox;
+	gchar iElementType;  // type of widget (CairoDockGUIWidgetType), or 0 if unknown.
 	};
 
 
@@ -205,6 +206,12 @@ GtkWidget *cairo_dock_build_key_file_widget_full (GKeyFile* pKeyFile, const gcha
 
 #define cairo_dock_build_key_file_widget(pKeyFile, cGettextDomain, pMainWindow, pWidgetList, pDataGarbage, cOriginalConfFilePath) cairo_dock_build_key_file_widget_full (pKeyFile, cGettextDomain, pMainWindow, pWidgetList, pDataGarbage, cOriginalConfFilePath, NULL)
 
+/** Same as \ref cairo_dock_build_key_file_widget, except that only the first page is built; the other pages are built the first time they are displayed, and their widgets are then added to the list.
+* Therefore pWidgetList, pDataGarbage and cOriginalConfFilePath must stay valid as long as the notebook, and the widgets of the other pages can't be looked for just after the notebook is built (for instance to add custom widgets inside).
+*@return the notebook.
+*/
+GtkWidget *cairo_dock_build_key_file_widget_lazy (GKeyFile* pKeyFile, const gchar *cGettextDomain, GtkWidget *pMainWindow, GSList **pWidgetList, GPtrArray *pDataGarbage, const gchar *cOriginalConfFilePath);
+
 GtkWidget *cairo_dock_build_conf_file_widget (const gchar *cConfFilePath, const gchar *cGettextDomain, GtkWidget *pMainWindow, GSList **pWidgetList, GPtrArray *pDataGarbage, const gchar *cOriginalConfFilePath);
 
 
@@ -224,6 +231,14 @@ void cairo_dock_fill_combo_with_list (GtkWidget *pCombo, GList *pElementList, co
 
 GtkWidget *cairo_dock_gui_make_tree_view (gboolean bGetActiveOnly);
 
+/** Give a fixed width to a column of a tree-view. Once all its columns have a fixed width, a tree-view can be set in fixed-height mode, where only the visible rows are measured, which keeps it fast with long lists.
+*@param pTreeView the tree-view
+*@param col one of its columns
+*@param iMinWidth minimum width of the content of the column (for instance the size of its icons)
+*@param cSampleText the largest text the column will display, or NULL
+*/
+void cairo_dock_gui_set_column_fixed_width (GtkWidget *pTreeView, GtkTreeViewColumn *col, int iMinWidth, const gchar *cSampleText);
+
 GtkWidget *cairo_dock_gui_make_combo (gboolean bWithEntry);
 
 void cairo_dock_gui_select_in_combo_full (GtkWidget *pOneWidget, const gchar *cValue, gboolean bIsTheme);
@@ -45,6 +45,8 @@
 #include "cairo-dock-draw-opengl.h"
 #include "cairo-dock-draw.h"
 #include "cairo-dock-animations.h"  // CairoDockHidingEffect
+#include "cairo-dock-icon-index.h"
+#include "cairo-dock-texture-manager.h"  // gldi_textures_restore_dock
 #include "cairo-dock-icon-facility.h"
 
 extern gchar *g_cCurrentLaunchersPath;
@@ -504,7 +506,8 @@ void cairo_dock_move_icon_after_icon (CairoDock *pDock, Icon *icon1, Icon *icon2
 	gboolean bForceUpdate = FALSE;
 	if (icon2 != NULL)
 	{
-		Icon *pNextIcon = cairo_dock_get_next_icon (pDock->icons, icon2);
+		GList *ic2 = cairo_dock_icon_index_find (pDock, icon2);
+		Icon *pNextIcon = (ic2 && ic2->next ? ic2->next->data : NULL);
 		if (pNextIcon != NULL && fabs (pNextIcon->fOrder - icon2->fOrder) < 1e-2)
 		{
 			bForceUpdate = TRUE;
@@ -528,10 +531,8 @@ void cairo_dock_move_icon_after_icon (CairoDock *pDock, Icon *icon1, Icon *icon2
 	gldi_theme_icon_write_order_in_conf_file (icon1, icon1->fOrder);
 	
 	//\_________________ On change sa place dans la liste.
-	pDock->icons = g_list_remove (pDock->icons, icon1);
-	pDock->icons = g_list_insert_sorted (pDock->icons,
-		icon1,
-		(GCompareFunc) cairo_dock_compare_icons_order);
+	cairo_dock_icon_index_remove (pDock, icon1);
+	cairo_dock_icon_index_insert (pDock, icon1);
 
 	//\_________________ On recalcule la largeur max, qui peut avoir ete influencee par le changement d'ordre.
 	cairo_dock_trigger_update_dock_size (pDock);
@@ -619,6 +620,8 @@ GdkPixbuf *cairo_dock_icon_buffer_to_pixbuf (Icon *icon)
 {
 	g_return_val_if_fail (icon != NULL, NULL);
 	
+	if (icon->image.pSurface == NULL && icon->image.iTexture == 0 && CAIRO_DOCK_IS_DOCK (icon->pContainer))  // its sub-dock may have released it.
+		gldi_textures_restore_dock (CAIRO_DOCK (icon->pContainer));
 	return cairo_dock_image_buffer_to_pixbuf (&icon->image, 24, 24);
 }
 
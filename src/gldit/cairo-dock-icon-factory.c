@@ -37,8 +37,11 @@
 #include "cairo-dock-icon-facility.h"
 #include "cairo-dock-data-renderer.h"
 #include "cairo-dock-overlay.h"
+#include "cairo-dock-texture-manager.h"  // gldi_textures_restore_dock
 #include "cairo-dock-icon-factory.h"
 
+#define CAIRO_DOCK_MIPMAPS_MIN_SCALE 2.  // beyond a minification of 2, the linear filtering skips some pixels.
+
 extern CairoDockImageBuffer g_pIconBackgroundBuffer;
 //extern gboolean g_bUseOpenGL;
 
@@ -162,6 +165,18 @@ void cairo_dock_load_icon_image (Icon *icon, G_GNUC_UNUSED GldiContainer *pConta
 		}
 	}
 	
+	//\______________ build the mipmaps of the icons that are drawn much smaller at rest than their size (they are loaded at their maximum zoom), so that they don't look grainy.
+	gboolean bMipmaps = FALSE;
+	if (icon->image.iTexture != 0 && pInstance == NULL && icon->pDataRenderer == NULL && cairo_dock_get_icon_max_scale (icon) >= CAIRO_DOCK_MIPMAPS_MIN_SCALE)
+	{
+		cairo_dock_build_texture_mipmaps (icon->image.iTexture, icon->image.iWidth, icon->image.iHeight);
+		bMipmaps = cairo_dock_texture_has_mipmaps (icon->image.iTexture);
+	}
+	
+	//\______________ share the image with the other icons, so that they can be drawn together (not if the background has been drawn on the texture only, nor if it has mipmaps).
+	if (icon->image.iTexture != 0 && ! bMipmaps && (g_pIconBackgroundBuffer.pSurface == NULL || GLDI_OBJECT_IS_SEPARATOR_ICON (icon)))
+		cairo_dock_add_texture_to_icon_atlas (icon->image.iTexture, icon->image.pSurface);
+	
 	//\______________ free the previous buffers.
 	if (pPrevSurface != NULL)
 		cairo_surface_destroy (pPrevSurface);
@@ -177,6 +192,20 @@ void cairo_dock_load_icon_image (Icon *icon, G_GNUC_UNUSED GldiContainer *pConta
 			pInstance->pDrawContext = NULL;
 		}
 	}
+	else if (pInstance == NULL && icon->pDataRenderer == NULL)  // the applets and the data-renderers draw on the surface, the other icons only need the texture from now on.
+	{
+		cairo_dock_image_buffer_release_surface (&icon->image);
+	}
+}
+
+static inline gchar *_get_truncated_name (Icon *icon)  // NULL if the name doesn't need to be truncated
+{
+	gchar *cTruncatedName = NULL;
+	if (CAIRO_DOCK_IS_APPLI (icon) && myTaskbarParam.iAppliMaxNameLength > 0)
+	{
+		cTruncatedName = cairo_dock_cut_string (icon->cName, myTaskbarParam.iAppliMaxNameLength);
+	}
+	return cTruncatedName;
 }
 
 void cairo_dock_load_icon_text (Icon *icon)
@@ -186,21 +215,70 @@ void cairo_dock_load_icon_text (Icon *icon)
 	if (icon->cName == NULL || (myIconsParam.iconTextDescription.iSize == 0))
 		return ;
 
-	gchar *cTruncatedName = NULL;
-	if (CAIRO_DOCK_IS_APPLI (icon) && myTaskbarParam.iAppliMaxNameLength > 0)
-	{
-		cTruncatedName = cairo_dock_cut_string (icon->cName, myTaskbarParam.iAppliMaxNameLength);
-	}
+	gchar *cTruncatedName = _get_truncated_name (icon);
 	
 	int iWidth, iHeight;
-	cairo_surface_t *pSurface = cairo_dock_create_surface_from_text ((cTruncatedName != NULL ? cTruncatedName : icon->cName),
+	cairo_surface_t *pSurface = cairo_dock_create_surface_from_text_cached ((cTruncatedName != NULL ? cTruncatedName : icon->cName),
 		&myIconsParam.iconTextDescription,
+		1.,
+		0,
 		&iWidth,
-		&iHeight);
-	cairo_dock_load_image_buffer_from_surface (&icon->label, pSurface, iWidth, iHeight);
+		&iHeight);  // identical labels (class sub-docks, applis with the same title) share the same surface.
+	cairo_dock_load_image_buffer_from_surface (&icon->label, pSurface, iWidth, iHeight);  // the label surfaces are kept: the text cache holds them anyway.
 	g_free (cTruncatedName);
 }
 
+void cairo_dock_load_icons_text (GList *pIconsList)
+{
+	int n = g_list_length (pIconsList);
+	if (n == 0)
+		return;
+	Icon **pIcons = g_new0 (Icon*, n);
+	const gchar **cTexts = g_new0 (const gchar*, n);
+	gchar **cTruncatedNames = g_new0 (gchar*, n);
+	cairo_surface_t **pSurfaces = g_new0 (cairo_surface_t*, n);
+	int *iWidths = g_new0 (int, n), *iHeights = g_new0 (int, n);
+	
+	//\_____________ collect the texts.
+	Icon *icon;
+	GList *ic;
+	int i = 0;
+	for (ic = pIconsList; ic != NULL; ic = ic->next, i ++)
+	{
+		icon = ic->data;
+		pIcons[i] = icon;
+		cairo_dock_unload_image_buffer (&icon->label);
+		if (icon->cName == NULL || (myIconsParam.iconTextDescription.iSize == 0))
+			continue;
+		cTruncatedNames[i] = _get_truncated_name (icon);
+		cTexts[i] = (cTruncatedNames[i] != NULL ? cTruncatedNames[i] : icon->cName);
+	}
+	
+	//\_____________ render them all with the same layout.
+	cairo_dock_create_surfaces_from_texts (cTexts, n,
+		&myIconsParam.iconTextDescription,
+		1.,
+		0,
+		pSurfaces,
+		iWidths,
+		iHeights);
+	
+	//\_____________ load the buffers.
+	for (i = 0; i < n; i ++)
+	{
+		if (pSurfaces[i] != NULL)
+			cairo_dock_load_image_buffer_from_surface (&pIcons[i]->label, pSurfaces[i], iWidths[i], iHeights[i]);
+		g_free (cTruncatedNames[i]);
+	}
+	
+	g_free (pIcons);
+	g_free (cTexts);
+	g_free (cTruncatedNames);
+	g_free (pSurfaces);
+	g_free (iWidths);
+	g_free (iHeights);
+}
+
 void cairo_dock_load_icon_quickinfo (Icon *icon)
 {
 	if (icon->cQuickInfo == NULL)  // no more quick-info -> remove any previous one
@@ -215,14 +293,14 @@ void cairo_dock_load_icon_quickinfo (Icon *icon)
 		if (iHeight / (myIconsParam.quickInfoTextDescription.iSize * fMaxScale) > 5)  // if the icon is very height (the text occupies less than 20% of the icon)
 			fMaxScale = MIN ((double)iHeight / (myIconsParam.quickInfoTextDescription.iSize * 5), MAX (1., 16./myIconsParam.quickInfoTextDescription.iSize) * fMaxScale);  // let's make it use 20% of the icon's height, limited to 16px
 		int w, h;
-		cairo_surface_t *pSurface = cairo_dock_create_surface_from_text_full (icon->cQuickInfo,
+		cairo_surface_t *pSurface = cairo_dock_create_surface_from_text_cached (icon->cQuickInfo,
 			&myIconsParam.quickInfoTextDescription,
 			fMaxScale,
 			iWidth,  // limit the text to the width of the icon
 			&w, &h);
 		CairoOverlay *pOverlay = cairo_dock_add_overlay_from_surface (icon, pSurface, w, h, CAIRO_OVERLAY_BOTTOM, (gpointer)"quick-info");  // the constant string "quick-info" is used as a unique identifier for all quick-infos; the surface is taken by the overlay.
 		if (pOverlay)
-			cairo_dock_set_overlay_scale (pOverlay, 0);
+			cairo_dock_set_overlay_scale (pOverlay, 0);  // its surface is shared with the cache of texts, so it's kept.
 	}
 }
 
@@ -292,6 +370,7 @@ void cairo_dock_draw_subdock_content_on_icon (Icon *pIcon, CairoDock *pDock)
 	CairoIconContainerRenderer *pRenderer = cairo_dock_get_icon_container_renderer (pIcon->cClass != NULL ? "Stack" : s_cRendererNames[pIcon->iSubdockViewType]);
 	if (pRenderer == NULL)
 		return;
+	gldi_textures_restore_dock (pIcon->pSubDock);  // we draw the images of its icons.
 	cd_debug ("%s (%s)", __func__, pIcon->cName);
 	
 	int w, h;
@@ -329,6 +408,59 @@ void cairo_dock_draw_subdock_content_on_icon (Icon *pIcon, CairoDock *pDock)
 	}
 }
 
+cairo_surface_t *cairo_dock_get_subdock_tile (Icon *pIcon, int iTile, Icon *pChild, int iWidth, int iHeight)
+{
+	g_return_val_if_fail (iTile >= 0 && iTile < CAIRO_DOCK_NB_SUBDOCK_TILES && pChild != NULL, NULL);
+	if (! cairo_dock_image_buffer_has_surface (&pChild->image) || iWidth <= 0 || iHeight <= 0)
+		return NULL;
+	if (pIcon->pSubdockTiles == NULL)
+		pIcon->pSubdockTiles = g_new0 (CairoDockSubdockTile, CAIRO_DOCK_NB_SUBDOCK_TILES);
+	
+	CairoDockSubdockTile *pTile = &pIcon->pSubdockTiles[iTile];
+	if (pTile->pSurface != NULL && pTile->pIcon == pChild && pTile->iStamp == cairo_dock_image_buffer_get_stamp (&pChild->image) && pTile->iWidth == iWidth && pTile->iHeight == iHeight)
+		return pTile->pSurface;  // up-to-date, nothing to redraw.
+	
+	cairo_surface_t *pChildSurface = cairo_dock_image_buffer_ref_surface (&pChild->image);  // in GL-only mode, it's read back for this tile only.
+	if (pChildSurface == NULL)
+		return NULL;
+	if (pTile->pSurface == NULL || pTile->iWidth != iWidth || pTile->iHeight != iHeight)
+	{
+		if (pTile->pSurface != NULL)
+			cairo_surface_destroy (pTile->pSurface);
+		pTile->pSurface = cairo_dock_create_blank_surface (iWidth, iHeight);
+		pTile->iWidth = iWidth;
+		pTile->iHeight = iHeight;
+	}
+	
+	int wi, hi;
+	cairo_dock_get_icon_extent (pChild, &wi, &hi);
+	cairo_t *pCairoContext = cairo_create (pTile->pSurface);
+	cairo_dock_erase_cairo_context (pCairoContext);
+	cairo_scale (pCairoContext, (double) iWidth / wi, (double) iHeight / hi);
+	cairo_set_source_surface (pCairoContext, pChildSurface, 0, 0);
+	cairo_paint (pCairoContext);
+	cairo_destroy (pCairoContext);
+	cairo_surface_destroy (pChildSurface);
+	
+	pTile->pIcon = pChild;
+	pTile->iStamp = cairo_dock_image_buffer_get_stamp (&pChild->image);
+	return pTile->pSurface;
+}
+
+void cairo_dock_free_subdock_tiles (Icon *pIcon)
+{
+	if (pIcon->pSubdockTiles == NULL)
+		return;
+	int i;
+	for (i = 0; i < CAIRO_DOCK_NB_SUBDOCK_TILES; i ++)
+	{
+		if (pIcon->pSubdockTiles[i].pSurface != NULL)
+			cairo_surface_destroy (pIcon->pSubdockTiles[i].pSurface);
+	}
+	g_free (pIcon->pSubdockTiles);
+	pIcon->pSubdockTiles = NULL;
+}
+
 
 void gldi_icon_detach (Icon *pIcon)
 {
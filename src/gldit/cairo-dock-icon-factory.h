@@ -61,6 +61,15 @@ typedef enum {
 	CAIRO_DOCK_NB_STATES
 	} CairoDockAnimationState;
 
+#define CAIRO_DOCK_NB_SUBDOCK_TILES 4
+/// A tile of the content of a sub-dock, that is to say the image of one of its icons, scaled at the size it's drawn on the icon pointing on the sub-dock.
+typedef struct _CairoDockSubdockTile {
+	Icon *pIcon;  // icon drawn in the tile (not referenced; the tile is only reused for the same icon and image stamp).
+	guint iStamp;  // stamp of the icon's image when the tile was drawn.
+	cairo_surface_t *pSurface;
+	gint iWidth, iHeight;
+	} CairoDockSubdockTile;
+
 /// Icon's interface
 struct _IconInterface {
 	/// function that loads the icon surface (and optionnally texture).
@@ -175,7 +184,8 @@ struct _Icon {
 	gint iThumbnailWidth, iThumbnailHeight;
 	
 	gboolean bIsLaunching;  // a mere recopy of gldi_class_is_starting()
-	gpointer reserved[4];
+	CairoDockSubdockTile *pSubdockTiles;  // images of the icons of the sub-dock drawn on the icon, see cairo_dock_get_subdock_tile()
+	gpointer reserved[3];
 };
 
 typedef void (*CairoIconContainerLoadFunc) (void);
@@ -282,6 +292,11 @@ void cairo_dock_load_icon_image (Icon *icon, GldiContainer *pContainer);
 */
 void cairo_dock_load_icon_text (Icon *icon);
 
+/**Fill the label buffers of several icons at once, rendering all their texts in one pass.
+*@param pIconsList a list of icons.
+*/
+void cairo_dock_load_icons_text (GList *pIconsList);
+
 /**Fill the quick-info buffer (surface & texture) of a given icon, according to a text description.
 *@param icon the icon.
 */
@@ -298,6 +313,18 @@ void cairo_dock_trigger_load_icon_buffers (Icon *pIcon);
 
 void cairo_dock_draw_subdock_content_on_icon (Icon *pIcon, CairoDock *pDock);
 
+/** Get the image of an icon of a sub-dock, scaled to a given size, to draw it on the icon pointing on the sub-dock. Tiles are kept on the icon, and only redrawn when the icon they show, its image or their size change, so that a change in one icon of the sub-dock doesn't rescale the others. To be used by the icon-container renderers.
+*@param pIcon the icon pointing on the sub-dock.
+*@param iTile index of the tile, < CAIRO_DOCK_NB_SUBDOCK_TILES.
+*@param pChild the icon of the sub-dock that is drawn in this tile.
+*@param iWidth width of the tile
+*@param iHeight height of the tile
+*@return the surface of the tile, or NULL if the icon has no surface. It belongs to the icon.
+*/
+cairo_surface_t *cairo_dock_get_subdock_tile (Icon *pIcon, int iTile, Icon *pChild, int iWidth, int iHeight);
+
+void cairo_dock_free_subdock_tiles (Icon *pIcon);
+
 #define cairo_dock_set_subdock_content_renderer(pIcon, view) (pIcon)->iSubdockViewType = view
 
 
@@ -0,0 +1,187 @@
+/**
+* This file is a part of the Cairo-Dock project
+*
+* Copyright : (C) see the 'copyright' file.
+* E-mail    : see the 'copyright' file.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 3
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cairo-dock-log.h"
+#include "cairo-dock-icon-factory.h"
+#include "cairo-dock-icon-facility.h"  // cairo_dock_compare_icons_order
+#include "cairo-dock-dock-factory.h"
+#include "cairo-dock-icon-index.h"
+
+typedef struct {
+	gint iOrder;
+	gboolean bAfter;  // TRUE to find the end of the order, FALSE for its beginning.
+	} CairoDockOrderBound;
+
+static int _compare_links (GList *ic1, GList *ic2, G_GNUC_UNUSED gpointer data)
+{
+	return cairo_dock_compare_icons_order (ic1->data, ic2->data);
+}
+
+// never returns 0, so that g_sequence_search() stops on the bound.
+static int _compare_link_to_order (GList *ic, G_GNUC_UNUSED gpointer key, CairoDockOrderBound *pBound)
+{
+	int iOrder = cairo_dock_get_icon_order ((Icon*)ic->data);
+	if (iOrder < pBound->iOrder || (pBound->bAfter && iOrder == pBound->iOrder))
+		return -1;
+	return 1;
+}
+
+static CairoDockIconIndex *_build_index (CairoDock *pDock)
+{
+	CairoDockIconIndex *pIndex = pDock->pIconIndex;
+	if (pIndex == NULL)
+	{
+		pIndex = g_new0 (CairoDockIconIndex, 1);
+		pIndex->pIters = g_hash_table_new (g_direct_hash, g_direct_equal);
+		pDock->pIconIndex = pIndex;
+	}
+	else
+	{
+		g_sequence_free (pIndex->pSequence);
+		g_hash_table_remove_all (pIndex->pIters);
+	}
+	pIndex->pSequence = g_sequence_new (NULL);
+	
+	GList *ic;
+	for (ic = pDock->icons; ic != NULL; ic = ic->next)  // the list is already sorted.
+	{
+		g_hash_table_insert (pIndex->pIters, ic->data, g_sequence_append (pIndex->pSequence, ic));
+	}
+	return pIndex;
+}
+
+static inline CairoDockIconIndex *_get_index (CairoDock *pDock)
+{
+	CairoDockIconIndex *pIndex = pDock->pIconIndex;
+	if (pIndex != NULL)  // kept up-to-date by the functions below, and dropped whenever the list is modified elsewhere.
+		return pIndex;
+	return _build_index (pDock);
+}
+
+static GSequenceIter *_get_iter (CairoDock *pDock, Icon *icon)
+{
+	CairoDockIconIndex *pIndex = _get_index (pDock);
+	GSequenceIter *iter = g_hash_table_lookup (pIndex->pIters, icon);
+	if (iter != NULL && ((GList*)g_sequence_get (iter))->data != icon)  // the list was modified without us.
+	{
+		pIndex = _build_index (pDock);
+		iter = g_hash_table_lookup (pIndex->pIters, icon);
+	}
+	return iter;
+}
+
+
+GList *cairo_dock_icon_index_insert (CairoDock *pDock, Icon *icon)
+{
+	g_return_val_if_fail (pDock != NULL && icon != NULL, NULL);
+	CairoDockIconIndex *pIndex = _get_index (pDock);
+	GList key = {icon, NULL, NULL};
+	GSequenceIter *iter;
+	GList *prev_ic, *next_ic;
+	int i;
+	for (i = 0; i < 2; i ++)
+	{
+		iter = g_sequence_search (pIndex->pSequence, &key, (GCompareDataFunc)_compare_links, NULL);
+		next_ic = (g_sequence_iter_is_end (iter) ? NULL : g_sequence_get (iter));
+		prev_ic = (g_sequence_iter_is_begin (iter) ? NULL : g_sequence_get (g_sequence_iter_prev (iter)));
+		if ((prev_ic != NULL ? prev_ic->next : pDock->icons) == next_ic)
+			break;
+		cd_debug ("the icons of %s were modified outside of the index, rebuild it", pDock->cDockName);  // should not happen, but we can't trust the list if it happens
+		pIndex = _build_index (pDock);
+	}
+	
+	GList *ic = g_list_alloc ();
+	ic->data = icon;
+	ic->prev = prev_ic;
+	ic->next = next_ic;
+	if (prev_ic != NULL)
+		prev_ic->next = ic;
+	else
+		pDock->icons = ic;
+	if (next_ic != NULL)
+		next_ic->prev = ic;
+	
+	g_hash_table_insert (pIndex->pIters, icon, g_sequence_insert_before (iter, ic));
+	return ic;
+}
+
+gboolean cairo_dock_icon_index_remove (CairoDock *pDock, Icon *icon)
+{
+	g_return_val_if_fail (pDock != NULL, FALSE);
+	GSequenceIter *iter = _get_iter (pDock, icon);
+	if (iter == NULL)
+		return FALSE;
+	CairoDockIconIndex *pIndex = pDock->pIconIndex;
+	GList *ic = g_sequence_get (iter);
+	g_sequence_remove (iter);
+	g_hash_table_remove (pIndex->pIters, icon);
+	pDock->icons = g_list_delete_link (pDock->icons, ic);
+	return TRUE;
+}
+
+GList *cairo_dock_icon_index_find (CairoDock *pDock, Icon *icon)
+{
+	g_return_val_if_fail (pDock != NULL, NULL);
+	GSequenceIter *iter = _get_iter (pDock, icon);
+	return (iter != NULL ? g_sequence_get (iter) : NULL);
+}
+
+Icon *cairo_dock_icon_index_get_first_icon_of_group (CairoDock *pDock, CairoDockIconGroup iGroup)
+{
+	g_return_val_if_fail (pDock != NULL, NULL);
+	CairoDockIconIndex *pIndex = _get_index (pDock);
+	CairoDockOrderBound bound = {cairo_dock_get_group_order (iGroup), FALSE};
+	GSequenceIter *iter = g_sequence_search (pIndex->pSequence, NULL, (GCompareDataFunc)_compare_link_to_order, &bound);
+	
+	// several groups can share the same order, so look for the group among the icons of this order.
+	GList *ic;
+	Icon *icon;
+	for (ic = (g_sequence_iter_is_end (iter) ? NULL : g_sequence_get (iter)); ic != NULL; ic = ic->next)
+	{
+		icon = ic->data;
+		if (cairo_dock_get_icon_order (icon) != bound.iOrder)
+			break;
+		if (icon->iGroup == iGroup)
+			return icon;
+	}
+	return NULL;
+}
+
+Icon *cairo_dock_icon_index_get_last_icon_of_order (CairoDock *pDock, CairoDockIconGroup iGroup)
+{
+	g_return_val_if_fail (pDock != NULL, NULL);
+	CairoDockIconIndex *pIndex = _get_index (pDock);
+	CairoDockOrderBound bound = {cairo_dock_get_group_order (iGroup), TRUE};
+	GSequenceIter *iter = g_sequence_search (pIndex->pSequence, NULL, (GCompareDataFunc)_compare_link_to_order, &bound);
+	if (g_sequence_iter_is_begin (iter))
+		return NULL;
+	Icon *icon = ((GList*)g_sequence_get (g_sequence_iter_prev (iter)))->data;
+	return (cairo_dock_get_icon_order (icon) == bound.iOrder ? icon : NULL);
+}
+
+void cairo_dock_icon_index_invalidate (CairoDock *pDock)
+{
+	CairoDockIconIndex *pIndex = pDock->pIconIndex;
+	if (pIndex == NULL)
+		return;
+	g_sequence_free (pIndex->pSequence);
+	g_hash_table_destroy (pIndex->pIters);
+	g_free (pIndex);
+	pDock->pIconIndex = NULL;
+}
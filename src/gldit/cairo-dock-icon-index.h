@@ -0,0 +1,77 @@
+/*
+* This file is a part of the Cairo-Dock project
+*
+* Copyright : (C) see the 'copyright' file.
+* E-mail    : see the 'copyright' file.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 3
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __CAIRO_DOCK_ICON_INDEX__
+#define  __CAIRO_DOCK_ICON_INDEX__
+
+#include <glib.h>
+
+#include "cairo-dock-struct.h"
+
+G_BEGIN_DECLS
+
+/**
+*@file cairo-dock-icon-index.h This file provides an index on the icons of a dock, to insert, remove and find icons in O(log n).
+* The index is a balanced tree over the links of the dock's icon list, sorted like the list (by group and order), so the list itself stays the view used by the renderers and the applets.
+* The index is built when needed and kept in step by the functions below; the list should therefore only be modified with \ref gldi_icon_insert_in_container and \ref gldi_icon_detach, as usual, and \ref cairo_dock_icon_index_invalidate must be called by any code that changes it directly.
+*/
+
+struct _CairoDockIconIndex {
+	// GList links of the dock's icons, in the same order as the list.
+	GSequence *pSequence;
+	// icon -> GSequenceIter
+	GHashTable *pIters;
+};
+
+/** Insert an icon in the list of icons of a dock, at the place given by its group and order.
+*@param pDock the dock
+*@param icon the icon
+*@return the new link of the list.
+*/
+GList *cairo_dock_icon_index_insert (CairoDock *pDock, Icon *icon);
+
+/** Remove an icon from the list of icons of a dock.
+*@param pDock the dock
+*@param icon the icon
+*@return TRUE if the icon was in the dock.
+*/
+gboolean cairo_dock_icon_index_remove (CairoDock *pDock, Icon *icon);
+
+/** Get the link of an icon in the list of icons of a dock.
+*@param pDock the dock
+*@param icon the icon
+*@return the link, or NULL if the icon is not in the dock.
+*/
+GList *cairo_dock_icon_index_find (CairoDock *pDock, Icon *icon);
+
+/** Same as \ref cairo_dock_get_first_icon_of_group, on the icons of a dock.
+*/
+Icon *cairo_dock_icon_index_get_first_icon_of_group (CairoDock *pDock, CairoDockIconGroup iGroup);
+
+/** Same as \ref cairo_dock_get_last_icon_of_order, on the icons of a dock.
+*/
+Icon *cairo_dock_icon_index_get_last_icon_of_order (CairoDock *pDock, CairoDockIconGroup iGroup);
+
+/** Drop the index of a dock; it will be rebuilt from the list the next time it's needed. Call it whenever the list of icons is modified or replaced without the functions above.
+*@param pDock the dock
+*/
+void cairo_dock_icon_index_invalidate (CairoDock *pDock);
+
+G_END_DECLS
+#endif
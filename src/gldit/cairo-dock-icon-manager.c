@@ -49,6 +49,7 @@
 #include "cairo-dock-applet-manager.h"  // GLDI_OBJECT_IS_APPLET_ICON
 #include "cairo-dock-backends-manager.h"  // cairo_dock_foreach_icon_container_renderer
 #include "cairo-dock-style-manager.h"
+#include "cairo-dock-surface-factory.h"  // cairo_dock_reset_text_surfaces_cache
 #define _MANAGER_DEF_
 #include "cairo-dock-icon-manager.h"
 
@@ -641,7 +642,7 @@ static void _cairo_dock_load_icons_background_surface (const gchar *cImagePath)
 		cImagePath,
 		iSizeWidth,
 		iSizeHeight,
-		CAIRO_DOCK_FILL_SPACE);
+		CAIRO_DOCK_FILL_SPACE | CAIRO_DOCK_STATIC_IMAGE);
 }
 
 static void _load_renderer (G_GNUC_UNUSED const gchar *cRenderername, CairoIconContainerRenderer *pRenderer, G_GNUC_UNUSED gpointer data)
@@ -750,9 +751,9 @@ static void _cairo_dock_resize_one_dock (G_GNUC_UNUSED const gchar *cDockName, C
 	cairo_dock_update_dock_size (pDock);
 }
 
-static void _reload_one_label (Icon *pIcon, G_GNUC_UNUSED gpointer data)
+static void _reload_one_label (Icon *pIcon, GList **pIconsList)
 {
-	cairo_dock_load_icon_text (pIcon);
+	*pIconsList = g_list_prepend (*pIconsList, pIcon);
 	cairo_dock_load_icon_quickinfo (pIcon);
 }
 
@@ -824,7 +825,11 @@ static void reload (CairoIconsParam *pPrevIcons, CairoIconsParam *pIcons)
 	// labels
 	CairoIconsParam *pLabels = pIcons;
 	CairoIconsParam *pPrevLabels = pPrevIcons;
-	gldi_icons_foreach ((GldiIconFunc) _reload_one_label, NULL);
+	cairo_dock_reset_text_surfaces_cache ();  // no need to keep the texts rendered with the previous parameters.
+	GList *pIconsList = NULL;
+	gldi_icons_foreach ((GldiIconFunc) _reload_one_label, &pIconsList);
+	cairo_dock_load_icons_text (pIconsList);  // all the labels in one pass.
+	g_list_free (pIconsList);
 	
 	if (pPrevLabels->iLabelSize != pLabels->iLabelSize)
 	{
@@ -864,6 +869,8 @@ static void unload (void)
 	
 	_cairo_dock_delete_floating_icons ();
 	
+	cairo_dock_reset_text_surfaces_cache ();
+	
 	if (g_pGradationTexture[0] != 0)
 	{
 		_cairo_dock_delete_texture (g_pGradationTexture[0]);
@@ -896,7 +903,10 @@ static gboolean on_style_changed (G_GNUC_UNUSED gpointer data)
 	if (myIconsParam.iconTextDescription.bUseDefaultColors || myIconsParam.iconTextDescription.cFont == NULL)  // reload labels and quick-info
 	{
 		cd_debug ("reload labels...");
-		gldi_icons_foreach ((GldiIconFunc) _reload_one_label, NULL);
+		GList *pIconsList = NULL;
+		gldi_icons_foreach ((GldiIconFunc) _reload_one_label, &pIconsList);
+		cairo_dock_load_icons_text (pIconsList);  // all the labels in one pass.
+		g_list_free (pIconsList);
 	}
 	
 	// if label size changed, reload docks views
@@ -1014,6 +1024,8 @@ static void reset_object (GldiObject *obj)
 	cairo_dock_unload_image_buffer (&icon->label);
 	
 	cairo_dock_destroy_icon_overlays (icon);
+	
+	cairo_dock_free_subdock_tiles (icon);
 }
 
 void gldi_register_icons_manager (void)
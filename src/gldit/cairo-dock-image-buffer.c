@@ -27,6 +27,8 @@
 #include "cairo-dock-draw.h"
 #include "cairo-dock-draw-opengl.h"
 #include "cairo-dock-opengl.h"  // gldi_gl_container_make_current
+#include "cairo-dock-profiler.h"  // gldi_profile_begin
+#include "cairo-dock-module-instance-manager.h"  // gldi_module_instances_track_resource
 #include "cairo-dock-image-buffer.h"
 
 extern gchar *g_cCurrentThemePath;
@@ -39,6 +41,60 @@ extern GldiContainer *g_pPrimaryContainer;
 extern gboolean g_bEasterEggs;
 
 
+typedef struct {
+	guint iStamp;  // changes each time the image is loaded or drawn.
+	gboolean bSurfaceReleased;  // the surface was dropped once the texture was made (GL-only residency); it's read back from the texture when needed.
+} CairoDockImageBufferState;
+
+static guint s_iImageStamp = 0;
+static GHashTable *s_pImageStates = NULL;  // image buffer -> its state; kept out of the structure, which is embedded in Icon, CairoOverlay and CairoDock.
+
+static CairoDockImageBufferState *_get_state (const CairoDockImageBuffer *pImage, gboolean bCreate)
+{
+	if (s_pImageStates == NULL)
+	{
+		if (! bCreate)
+			return NULL;
+		s_pImageStates = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
+	}
+	CairoDockImageBufferState *pState = g_hash_table_lookup (s_pImageStates, pImage);
+	if (pState == NULL && bCreate)
+	{
+		pState = g_new0 (CairoDockImageBufferState, 1);
+		g_hash_table_insert (s_pImageStates, (gpointer)pImage, pState);
+	}
+	return pState;
+}
+
+#define _update_stamp(pImage) _get_state (pImage, TRUE)->iStamp = ++ s_iImageStamp
+
+guint cairo_dock_image_buffer_get_stamp (const CairoDockImageBuffer *pImage)
+{
+	CairoDockImageBufferState *pState = _get_state (pImage, FALSE);
+	return (pState ? pState->iStamp : 0);
+}
+
+static inline gboolean _surface_is_released (const CairoDockImageBuffer *pImage)
+{
+	CairoDockImageBufferState *pState = _get_state (pImage, FALSE);
+	return (pState && pState->bSurfaceReleased);
+}
+
+static inline void _set_surface_released (CairoDockImageBuffer *pImage, gboolean bReleased)
+{
+	CairoDockImageBufferState *pState = _get_state (pImage, bReleased);
+	if (pState)
+		pState->bSurfaceReleased = bReleased;
+}
+
+static void _track_image (CairoDockImageBuffer *pImage)  // attribute the memory of the image to the current applet, if any.
+{
+	if (pImage->pSurface != NULL && cairo_surface_get_type (pImage->pSurface) == CAIRO_SURFACE_TYPE_IMAGE)
+		gldi_module_instances_track_resource (GLDI_RESOURCE_IMAGE, pImage, (gint64)cairo_image_surface_get_stride (pImage->pSurface) * cairo_image_surface_get_height (pImage->pSurface));
+	else
+		gldi_module_instances_untrack_resource (GLDI_RESOURCE_IMAGE, pImage);
+}
+
 gchar *cairo_dock_search_image_s_path (const gchar *cImageFile)
 {
 	g_return_val_if_fail (cImageFile != NULL, NULL);
@@ -150,7 +206,11 @@ void cairo_dock_load_image_buffer_full (CairoDockImageBuffer *pImage, const gcha
 	}
 	
 	if (g_bUseOpenGL)
-		pImage->iTexture = cairo_dock_create_texture_from_surface (pImage->pSurface);
+		pImage->iTexture = cairo_dock_create_texture_from_surface_full (pImage->pSurface,
+			((iLoadModifier & CAIRO_DOCK_STATIC_IMAGE) ? GLDI_TEXTURE_STATIC : 0) | (g_bEasterEggs ? GLDI_TEXTURE_MIPMAPS : 0));
+	_set_surface_released (pImage, FALSE);
+	_track_image (pImage);
+	_update_stamp (pImage);
 	
 	g_free (cImagePath);
 }
@@ -169,6 +229,9 @@ void cairo_dock_load_image_buffer_from_surface (CairoDockImageBuffer *pImage, ca
 	pImage->fZoomY = 1.;
 	if (g_bUseOpenGL)
 		pImage->iTexture = cairo_dock_create_texture_from_surface (pImage->pSurface);
+	_set_surface_released (pImage, FALSE);
+	_track_image (pImage);
+	_update_stamp (pImage);
 }
 
 void cairo_dock_load_image_buffer_from_texture (CairoDockImageBuffer *pImage, GLuint iTexture, int iWidth, int iHeight)
@@ -178,6 +241,8 @@ void cairo_dock_load_image_buffer_from_texture (CairoDockImageBuffer *pImage, GL
 	pImage->iHeight = iHeight;
 	pImage->fZoomX = 1.;
 	pImage->fZoomY = 1.;
+	_set_surface_released (pImage, FALSE);
+	_update_stamp (pImage);
 }
 
 CairoDockImageBuffer *cairo_dock_create_image_buffer (const gchar *cImageFile, int iWidth, int iHeight, CairoDockLoadImageModifier iLoadModifier)
@@ -199,6 +264,9 @@ void cairo_dock_unload_image_buffer (CairoDockImageBuffer *pImage)
 	{
 		_cairo_dock_delete_texture (pImage->iTexture);
 	}
+	gldi_module_instances_untrack_resource (GLDI_RESOURCE_IMAGE, pImage);
+	if (s_pImageStates != NULL)
+		g_hash_table_remove (s_pImageStates, pImage);
 	memset (pImage, 0, sizeof (CairoDockImageBuffer));
 }
 
@@ -210,6 +278,93 @@ void cairo_dock_free_image_buffer (CairoDockImageBuffer *pImage)
 	g_free (pImage);
 }
 
+  /////////////////////////
+ /// GL-ONLY RESIDENCY ///
+/////////////////////////
+
+static gboolean s_bGLOnly = FALSE;
+
+void cairo_dock_set_image_buffers_gl_only (gboolean bGLOnly)
+{
+	s_bGLOnly = bGLOnly;
+}
+
+gboolean cairo_dock_image_buffer_has_surface (const CairoDockImageBuffer *pImage)
+{
+	return (pImage->pSurface != NULL || (_surface_is_released (pImage) && pImage->iTexture != 0));
+}
+
+void cairo_dock_image_buffer_release_surface (CairoDockImageBuffer *pImage)
+{
+	if (! s_bGLOnly || ! g_bUseOpenGL || pImage->pSurface == NULL || pImage->iTexture == 0)
+		return;
+	cairo_surface_destroy (pImage->pSurface);
+	pImage->pSurface = NULL;
+	_set_surface_released (pImage, TRUE);
+	gldi_module_instances_untrack_resource (GLDI_RESOURCE_IMAGE, pImage);  // only its texture is left.
+}
+
+static cairo_surface_t *_read_back_texture (GLuint iTexture, int iWidth, int iHeight)
+{
+	gint64 iProfileTime = gldi_profile_begin ();
+	GLint w = 0, h = 0;
+	glBindTexture (GL_TEXTURE_2D, iTexture);
+	glGetTexLevelParameteriv (GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &w);
+	glGetTexLevelParameteriv (GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &h);
+	if (w <= 0 || h <= 0)
+	{
+		glBindTexture (GL_TEXTURE_2D, 0);
+		return NULL;
+	}
+	
+	cairo_surface_t *pSurface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, w, h);
+	cairo_surface_flush (pSurface);
+	glPixelStorei (GL_PACK_ALIGNMENT, 4);
+	glPixelStorei (GL_PACK_ROW_LENGTH, cairo_image_surface_get_stride (pSurface) / 4);
+	glGetTexImage (GL_TEXTURE_2D, 0, GL_BGRA, GL_UNSIGNED_BYTE, cairo_image_surface_get_data (pSurface));  // same layout as the upload, so no conversion.
+	glPixelStorei (GL_PACK_ROW_LENGTH, 0);
+	glBindTexture (GL_TEXTURE_2D, 0);
+	cairo_surface_mark_dirty (pSurface);
+	
+	if (w != iWidth || h != iHeight)  // the texture was enlarged to a power of 2 (old cards) -> get back to the size of the image.
+	{
+		cairo_surface_t *pScaledSurface = cairo_dock_create_blank_surface (iWidth, iHeight);
+		cairo_t *pCairoContext = cairo_create (pScaledSurface);
+		cairo_scale (pCairoContext, (double)iWidth / w, (double)iHeight / h);
+		cairo_set_source_surface (pCairoContext, pSurface, 0., 0.);
+		cairo_paint (pCairoContext);
+		cairo_destroy (pCairoContext);
+		cairo_surface_destroy (pSurface);
+		pSurface = pScaledSurface;
+	}
+	gldi_profile_end (iProfileTime, GLDI_PROFILE_TEXTURE_UPLOAD, (gconstpointer)_read_back_texture, "texture read-back", NULL);
+	return pSurface;
+}
+
+cairo_surface_t *cairo_dock_image_buffer_get_surface (CairoDockImageBuffer *pImage)
+{
+	if (pImage->pSurface == NULL && _surface_is_released (pImage) && pImage->iTexture != 0 && pImage->iWidth > 0 && pImage->iHeight > 0)
+	{
+		cd_debug ("read back a %dx%d image", pImage->iWidth, pImage->iHeight);
+		pImage->pSurface = _read_back_texture (pImage->iTexture, pImage->iWidth, pImage->iHeight);
+		_set_surface_released (pImage, FALSE);
+		_track_image (pImage);
+	}
+	return pImage->pSurface;
+}
+
+cairo_surface_t *cairo_dock_image_buffer_ref_surface (const CairoDockImageBuffer *pImage)
+{
+	if (pImage->pSurface != NULL)
+		return cairo_surface_reference (pImage->pSurface);
+	if (_surface_is_released (pImage) && pImage->iTexture != 0 && pImage->iWidth > 0 && pImage->iHeight > 0)
+	{
+		cd_debug ("read back a %dx%d image for a single use", pImage->iWidth, pImage->iHeight);
+		return _read_back_texture (pImage->iTexture, pImage->iWidth, pImage->iHeight);  // not kept, the caller drops it once done.
+	}
+	return NULL;
+}
+
 void cairo_dock_image_buffer_next_frame (CairoDockImageBuffer *pImage)
 {
 	if (pImage->iNbFrames == 0)
@@ -245,6 +400,9 @@ gboolean cairo_dock_image_buffer_next_frame_no_loop (CairoDockImageBuffer *pImag
 
 void cairo_dock_apply_image_buffer_surface_with_offset (const CairoDockImageBuffer *pImage, cairo_t *pCairoContext, double x, double y, double fAlpha)
 {
+	cairo_surface_t *pSurface = cairo_dock_image_buffer_ref_surface (pImage);
+	if (pSurface == NULL)
+		return;
 	if (cairo_dock_image_buffer_is_animated (pImage))
 	{
 		int iFrameWidth = pImage->iWidth / pImage->iNbFrames;
@@ -257,22 +415,23 @@ void cairo_dock_apply_image_buffer_surface_with_offset (const CairoDockImageBuff
 		int n = (int) pImage->iCurrentFrame;
 		double dn = pImage->iCurrentFrame - n;
 		
-		cairo_set_source_surface (pCairoContext, pImage->pSurface, - n * iFrameWidth, 0.);
+		cairo_set_source_surface (pCairoContext, pSurface, - n * iFrameWidth, 0.);
 		cairo_paint_with_alpha (pCairoContext, fAlpha * (1 - dn));
 		
 		int n2 = n + 1;
 		if (n2 >= pImage->iNbFrames)
 			n2  = 0;
-		cairo_set_source_surface (pCairoContext, pImage->pSurface, - n2 * iFrameWidth, 0.);
+		cairo_set_source_surface (pCairoContext, pSurface, - n2 * iFrameWidth, 0.);
 		cairo_paint_with_alpha (pCairoContext, fAlpha * dn);
 		
 		cairo_restore (pCairoContext);
 	}
 	else
 	{
-		cairo_set_source_surface (pCairoContext, pImage->pSurface, x, y);
+		cairo_set_source_surface (pCairoContext, pSurface, x, y);
 		cairo_paint_with_alpha (pCairoContext, fAlpha);
 	}
+	cairo_surface_destroy (pSurface);
 }
 
 void cairo_dock_apply_image_buffer_texture_with_offset (const CairoDockImageBuffer *pImage, double x, double y)
@@ -310,6 +469,9 @@ void cairo_dock_apply_image_buffer_texture_with_offset (const CairoDockImageBuff
 
 void cairo_dock_apply_image_buffer_surface_at_size (const CairoDockImageBuffer *pImage, cairo_t *pCairoContext, int w, int h, double x, double y, double fAlpha)
 {
+	cairo_surface_t *pSurface = cairo_dock_image_buffer_ref_surface (pImage);
+	if (pSurface == NULL)
+		return;
 	if (cairo_dock_image_buffer_is_animated (pImage))
 	{
 		int iFrameWidth = pImage->iWidth / pImage->iNbFrames;
@@ -325,13 +487,13 @@ void cairo_dock_apply_image_buffer_surface_at_size (const CairoDockImageBuffer *
 		int n = (int) pImage->iCurrentFrame;
 		double dn = pImage->iCurrentFrame - n;
 		
-		cairo_set_source_surface (pCairoContext, pImage->pSurface, - n * iFrameWidth, 0.);
+		cairo_set_source_surface (pCairoContext, pSurface, - n * iFrameWidth, 0.);
 		cairo_paint_with_alpha (pCairoContext, fAlpha * (1 - dn));
 		
 		int n2 = n + 1;
 		if (n2 >= pImage->iNbFrames)
 			n2  = 0;
-		cairo_set_source_surface (pCairoContext, pImage->pSurface, - n2 * iFrameWidth, 0.);
+		cairo_set_source_surface (pCairoContext, pSurface, - n2 * iFrameWidth, 0.);
 		cairo_paint_with_alpha (pCairoContext, fAlpha * dn);
 		
 		cairo_restore (pCairoContext);
@@ -343,11 +505,12 @@ void cairo_dock_apply_image_buffer_surface_at_size (const CairoDockImageBuffer *
 		
 		cairo_scale (pCairoContext, (double) w/pImage->iWidth, (double) h/pImage->iHeight);
 		
-		cairo_set_source_surface (pCairoContext, pImage->pSurface, 0, 0);
+		cairo_set_source_surface (pCairoContext, pSurface, 0, 0);
 		cairo_paint_with_alpha (pCairoContext, fAlpha);
 		
 		cairo_restore (pCairoContext);
 	}
+	cairo_surface_destroy (pSurface);
 }
 
 void cairo_dock_apply_image_buffer_texture_at_size (const CairoDockImageBuffer *pImage, int w, int h, double x, double y)
@@ -384,8 +547,11 @@ void cairo_dock_apply_image_buffer_texture_at_size (const CairoDockImageBuffer *
 
 void cairo_dock_apply_image_buffer_surface_with_offset_and_limit (const CairoDockImageBuffer *pImage, cairo_t *pCairoContext, double x, double y, double fAlpha, int iMaxWidth)
 {
+	cairo_surface_t *pSurface = cairo_dock_image_buffer_ref_surface (pImage);
+	if (pSurface == NULL)
+		return;
 	cairo_set_source_surface (pCairoContext,
-		pImage->pSurface,
+		pSurface,
 		x,
 		y);
 	
@@ -415,6 +581,7 @@ void cairo_dock_apply_image_buffer_surface_with_offset_and_limit (const CairoDoc
 		0.);
 	cairo_mask (pCairoContext, pGradationPattern);
 	cairo_pattern_destroy (pGradationPattern);
+	cairo_surface_destroy (pSurface);
 }
 
 void cairo_dock_apply_image_buffer_texture_with_limit (const CairoDockImageBuffer *pImage, double fAlpha, int iMaxWidth)
@@ -479,7 +646,7 @@ void cairo_dock_destroy_icon_fbo (void)
 
 cairo_t *cairo_dock_begin_draw_image_buffer_cairo (CairoDockImageBuffer *pImage, gint iRenderingMode, cairo_t *pCairoContext)
 {
-	g_return_val_if_fail (pImage->pSurface != NULL, NULL);
+	g_return_val_if_fail (cairo_dock_image_buffer_get_surface (pImage) != NULL, NULL);  // it stays in memory from now on, since it's drawn with Cairo.
 	cairo_t *ctx = pCairoContext;
 	if (! ctx)
 	{
@@ -494,6 +661,7 @@ cairo_t *cairo_dock_begin_draw_image_buffer_cairo (CairoDockImageBuffer *pImage,
 
 void cairo_dock_end_draw_image_buffer_cairo (CairoDockImageBuffer *pImage)
 {
+	_update_stamp (pImage);
 	if (g_bUseOpenGL)
 		cairo_dock_image_buffer_update_texture (pImage);
 }
@@ -587,6 +755,7 @@ gboolean cairo_dock_begin_draw_image_buffer_opengl (CairoDockImageBuffer *pImage
 void cairo_dock_end_draw_image_buffer_opengl (CairoDockImageBuffer *pImage, GldiContainer *pContainer)
 {
 	g_return_if_fail (pContainer != NULL && pImage->iTexture != 0);
+	_update_stamp (pImage);
 	
 	if (CAIRO_DOCK_IS_DESKLET (pContainer))
 	{
@@ -600,9 +769,11 @@ void cairo_dock_end_draw_image_buffer_opengl (CairoDockImageBuffer *pImage, Gldi
 		iWidth = pImage->iWidth, iHeight = pImage->iHeight;
 		int x = (pContainer->iWidth - iWidth)/2;
 		int y = (pContainer->iHeight - iHeight)/2;
-		glCopyTexImage2D (GL_TEXTURE_2D, 0, GL_RGBA, x, y, iWidth, iHeight, 0);  // target, num mipmap, format, x,y, w,h, border.
+		glCopyTexSubImage2D (GL_TEXTURE_2D, 0, 0, 0, x, y, iWidth, iHeight);  // target, num mipmap, offset in the texture, x,y, w,h; the texture keeps its storage (it can be immutable).
 		
 		_cairo_dock_disable_texture ();
+		cairo_dock_update_texture_mipmaps (pImage->iTexture);
+		cairo_dock_update_texture_in_icon_atlas (pImage->iTexture, NULL);  // the copy in the atlas is obsolete.
 	}
 	else if (s_iFboId != 0)
 	{
@@ -632,7 +803,8 @@ void cairo_dock_end_draw_image_buffer_opengl (CairoDockImageBuffer *pImage, Gldi
 			GL_TEXTURE_2D,
 			0,
 			0);  // we detach the texture (precaution).
-		//glGenerateMipmapEXT(GL_TEXTURE_2D);  // if we use mipmaps, we need to explicitely generate them when using FBO.
+		cairo_dock_update_texture_mipmaps (pImage->iTexture);  // if it has mipmaps, they must be generated explicitely when using a FBO.
+		cairo_dock_update_texture_in_icon_atlas (pImage->iTexture, NULL);  // the copy in the atlas is obsolete.
 	}
 	
 	if (pContainer && s_bSetPerspective)
@@ -644,46 +816,19 @@ void cairo_dock_end_draw_image_buffer_opengl (CairoDockImageBuffer *pImage, Gldi
 
 void cairo_dock_image_buffer_update_texture (CairoDockImageBuffer *pImage)
 {
+	_update_stamp (pImage);
+	if (pImage->pSurface == NULL)  // released, so the texture is already up-to-date.
+		return;
 	if (pImage->iTexture == 0)
 	{
 		pImage->iTexture = cairo_dock_create_texture_from_surface (pImage->pSurface);
 	}
 	else
 	{
-		_cairo_dock_enable_texture ();
-		_cairo_dock_set_blend_source ();
-		_cairo_dock_set_alpha (1.);  // full white
-		
-		int w = cairo_image_surface_get_width (pImage->pSurface);  // extra caution
-		int h = cairo_image_surface_get_height (pImage->pSurface);
-		glBindTexture (GL_TEXTURE_2D, pImage->iTexture);
-		
-		glTexParameteri (GL_TEXTURE_2D,
-			GL_TEXTURE_MIN_FILTER,
-			g_bEasterEggs ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
-		if (g_bEasterEggs)
-			glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-		
-		if (g_bEasterEggs)
-			gluBuild2DMipmaps (GL_TEXTURE_2D,
-				4,
-				w,
-				h,
-				GL_BGRA,
-				GL_UNSIGNED_BYTE,
-				cairo_image_surface_get_data (pImage->pSurface));
-		else
-			glTexImage2D (GL_TEXTURE_2D,
-				0,
-				4,  // GL_ALPHA / GL_BGRA
-				w,
-				h,
-				0,
-				GL_BGRA,  // GL_ALPHA / GL_BGRA
-				GL_UNSIGNED_BYTE,
-				cairo_image_surface_get_data (pImage->pSurface));
-		_cairo_dock_disable_texture ();
+		gint64 iProfileTime = gldi_profile_begin ();
+		pImage->iTexture = cairo_dock_update_texture_from_surface (pImage->iTexture, pImage->pSurface);
+		gldi_profile_end (iProfileTime, GLDI_PROFILE_TEXTURE_UPLOAD, (gconstpointer)cairo_dock_image_buffer_update_texture, "texture update", NULL);
+		cairo_dock_update_texture_in_icon_atlas (pImage->iTexture, pImage->pSurface);
 	}
 }
 
@@ -692,16 +837,18 @@ GdkPixbuf *cairo_dock_image_buffer_to_pixbuf (CairoDockImageBuffer *pImage, int
 {
 	GdkPixbuf *pixbuf = NULL;
 	int w = iWidth, h = iHeight;
-	if (pImage->iWidth > 0 && pImage->iHeight > 0 && pImage->pSurface != NULL)
+	cairo_surface_t *pSurface = (pImage->iWidth > 0 && pImage->iHeight > 0 ? cairo_dock_image_buffer_ref_surface (pImage) : NULL);
+	if (pSurface != NULL)
 	{
 		cairo_surface_t *surface = cairo_image_surface_create (CAIRO_FORMAT_RGB24,
 			w,
 			h);
 		cairo_t *pCairoContext = cairo_create (surface);
 		cairo_scale (pCairoContext, (double)w/pImage->iWidth, (double)h/pImage->iHeight);
-		cairo_set_source_surface (pCairoContext, pImage->pSurface, 0., 0.);
+		cairo_set_source_surface (pCairoContext, pSurface, 0., 0.);
 		cairo_paint (pCairoContext);
 		cairo_destroy (pCairoContext);
+		cairo_surface_destroy (pSurface);
 		guchar *d, *data = cairo_image_surface_get_data (surface);
 		int r = cairo_image_surface_get_stride (surface);
 		
@@ -37,6 +37,8 @@ G_BEGIN_DECLS
 * Use \ref cairo_dock_free_image_buffer to destroy it or \ref cairo_dock_unload_image_buffer to unload and reset it to 0.
 * 
 * Use \ref cairo_dock_apply_image_buffer_surface or \ref cairo_dock_apply_image_buffer_texture to display the image.
+* 
+* In OpenGL, the image buffers can be made to keep their texture only (see \ref cairo_dock_set_image_buffers_gl_only): their owner drops the surface with \ref cairo_dock_image_buffer_release_surface once it doesn't need it any more, and \ref cairo_dock_image_buffer_ref_surface gives it back, read from the texture, to those who need to draw it with Cairo; only those who draw on it keep it (\ref cairo_dock_image_buffer_get_surface).
 */
 
 
@@ -109,6 +111,40 @@ gboolean cairo_dock_image_buffer_next_frame_no_loop (CairoDockImageBuffer *pImag
 
 #define cairo_dock_image_buffer_rewind(pImage) gettimeofday (&pImage->time, NULL)
 
+/** Get the stamp of an ImageBuffer. It changes each time the image is loaded or drawn, so that copies of it can know they are outdated.
+*@param pImage an ImageBuffer.
+*@return the stamp, 0 if the image was never loaded.
+*/
+guint cairo_dock_image_buffer_get_stamp (const CairoDockImageBuffer *pImage);
+
+/** Get the surface of an ImageBuffer, to draw on it. If it was released, it is read back from the texture and kept until the next load.
+*@param pImage an ImageBuffer.
+*@return the surface, or NULL if there is none.
+*/
+cairo_surface_t *cairo_dock_image_buffer_get_surface (CairoDockImageBuffer *pImage);
+
+/** Get a reference on the surface of an ImageBuffer, to draw it somewhere else. If it was released, it is read back from the texture for this use only. Drop it with cairo_surface_destroy() once done.
+*@param pImage an ImageBuffer.
+*@return a new reference on the surface, or NULL if there is none.
+*/
+cairo_surface_t *cairo_dock_image_buffer_ref_surface (const CairoDockImageBuffer *pImage);
+
+/** Say if an ImageBuffer has a surface, possibly released (it can then be got back with \ref cairo_dock_image_buffer_ref_surface).
+*@param pImage an ImageBuffer.
+*@return TRUE if it has a surface.
+*/
+gboolean cairo_dock_image_buffer_has_surface (const CairoDockImageBuffer *pImage);
+
+/** Drop the surface of an ImageBuffer if the GL-only residency is enabled and it has a texture. Call it once the surface is not needed any more (the texture and the atlas have been made, the background drawn, ...).
+*@param pImage an ImageBuffer.
+*/
+void cairo_dock_image_buffer_release_surface (CairoDockImageBuffer *pImage);
+
+/** Enable the GL-only residency of the image buffers: in OpenGL, the surfaces released with \ref cairo_dock_image_buffer_release_surface are dropped, and only the textures stay in memory. It should be set before the images are loaded.
+*@param bGLOnly TRUE to enable it
+*/
+void cairo_dock_set_image_buffers_gl_only (gboolean bGLOnly);
+
 /** Reset an ImageBuffer's ressources. It can be used to load another image then.
 *@param pImage an ImageBuffer.
 */
@@ -321,6 +321,7 @@ static gboolean cairo_dock_render_indicator_notification (G_GNUC_UNUSED gpointer
 	{
 		if (icon->bHasIndicator && myIndicatorsParam.bIndicatorAbove)
 		{
+			cairo_dock_flush_icons_batch ();  // the icon must be drawn before.
 			glPushMatrix ();
 			glLoadIdentity();
 			cairo_dock_translate_on_icon_opengl (icon, CAIRO_CONTAINER (pDock), 1.);
@@ -329,10 +330,12 @@ static gboolean cairo_dock_render_indicator_notification (G_GNUC_UNUSED gpointer
 		}
 		if (bIsActive)
 		{
+			cairo_dock_flush_icons_batch ();
 			_cairo_dock_draw_active_window_indicator_opengl (icon, pDock, pDock->container.fRatio);
 		}
 		if (icon->pSubDock != NULL && icon->cClass != NULL && s_classIndicatorBuffer.iTexture != 0 && icon->pAppli == NULL)  // le dernier test est de la paranoia.
 		{
+			cairo_dock_flush_icons_batch ();
 			_cairo_dock_draw_class_indicator_opengl (icon, pDock->container.bIsHorizontal, pDock->container.fRatio, pDock->container.bDirectionUp);
 		}
 	}
@@ -546,7 +549,7 @@ static inline void _load_task_indicator (const gchar *cIndicatorImagePath, doubl
 		cIndicatorImagePath,
 		fLauncherWidth * fScale,
 		fLauncherHeight * fScale,
-		CAIRO_DOCK_KEEP_RATIO);
+		CAIRO_DOCK_KEEP_RATIO | CAIRO_DOCK_STATIC_IMAGE);
 }
 static inline void _load_active_window_indicator (const gchar *cImagePath, double fMaxScale, double fCornerRadius, double fLineWidth, GldiColor *fActiveColor, gboolean bDefaultValues, gboolean bFillFrame)
 {
@@ -563,7 +566,7 @@ static inline void _load_active_window_indicator (const gchar *cImagePath, doubl
 			cImagePath,
 			iWidth,
 			iHeight,
-			CAIRO_DOCK_FILL_SPACE);
+			CAIRO_DOCK_FILL_SPACE | CAIRO_DOCK_STATIC_IMAGE);
 	}
 	else
 	{
@@ -627,7 +630,7 @@ static inline void _load_class_indicator (const gchar *cIndicatorImagePath)
 		cIndicatorImagePath,
 		iLauncherWidth/3,  // will be drawn at 1/3 of the icon, with no zoom.
 		iLauncherHeight/3,
-		CAIRO_DOCK_KEEP_RATIO);
+		CAIRO_DOCK_KEEP_RATIO | CAIRO_DOCK_STATIC_IMAGE);
 }
 static void load (void)
 {
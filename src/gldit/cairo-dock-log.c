@@ -32,7 +32,7 @@
 #include "cairo-dock-log.h"
 
 static char s_iLogColor = '0';
-static GLogLevelFlags s_gLogLevel = G_LOG_LEVEL_WARNING;
+GLogLevelFlags cd_log_level = G_LOG_LEVEL_WARNING;
 static gboolean s_bUseColors = TRUE;
 gboolean bForceColors = FALSE;
 
@@ -106,7 +106,7 @@ void cd_log_location(const GLogLevelFlags loglevel,
 {
   va_list args;
 
-  if (loglevel > s_gLogLevel)
+  if (loglevel > cd_log_level)
     return;
   g_print("%s", _cd_log_level_to_string (loglevel));
   if (s_bUseColors)
@@ -123,7 +123,7 @@ static void cairo_dock_log_handler(G_GNUC_UNUSED const gchar *log_domain,
                                    const gchar *message,
                                    G_GNUC_UNUSED gpointer user_data)
 {
-  if (log_level > s_gLogLevel)
+  if (log_level > cd_log_level)
     return;
   g_print("%s\n", message);
 }
@@ -138,7 +138,7 @@ void cd_log_init (gboolean bBlackTerminal)
 
 void cd_log_set_level (GLogLevelFlags loglevel)
 {
-	s_gLogLevel = loglevel;
+	cd_log_level = loglevel;
 }
 
 void cd_log_set_level_from_name (const gchar *cVerbosity)
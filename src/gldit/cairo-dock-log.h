@@ -30,6 +30,11 @@
 # include <glib.h>
 G_BEGIN_DECLS
 
+/*
+ * current verbosity level; use cd_log_is_enabled() to read it, and cd_log_set_level() to modify it.
+ */
+extern GLogLevelFlags cd_log_level;
+
 /*
  * internal function
  */
@@ -61,35 +66,46 @@ void cd_log_set_level_from_name (const gchar *cVerbosity);
 void cd_log_force_use_color (void);
 
 
+/** Tell if messages of a given level are currently displayed. Use it to skip some expensive work that is only done to be logged.
+*@param loglevel the level of the messages.
+*/
+#define cd_log_is_enabled(loglevel) ((loglevel) <= cd_log_level)
+
+// the arguments of the messages are not evaluated if their level is disabled.
+#define _cd_log_if_enabled(loglevel, ...) do {\
+	if (G_UNLIKELY (cd_log_is_enabled (loglevel)))\
+		cd_log_location(loglevel, __FILE__, __PRETTY_FUNCTION__, __LINE__,__VA_ARGS__);\
+	} while (0)
+
 /* Write an error message on the terminal. Error messages are used to indicate the cause of the program stop.
 *@param ... the message format and parameters, in a 'printf' style.
 */
 #define cd_error(...)                                                  \
-  cd_log_location(G_LOG_LEVEL_ERROR, __FILE__, __PRETTY_FUNCTION__, __LINE__,__VA_ARGS__)
+  _cd_log_if_enabled(G_LOG_LEVEL_ERROR, __VA_ARGS__)
 
 /* Write a critical message on the terminal. Critical messages should be as clear as possible to be useful for end-users.
 *@param ... the message format and parameters, in a 'printf' style.
 */
 #define cd_critical(...)                                               \
-  cd_log_location(G_LOG_LEVEL_CRITICAL, __FILE__, __PRETTY_FUNCTION__, __LINE__,__VA_ARGS__)
+  _cd_log_if_enabled(G_LOG_LEVEL_CRITICAL, __VA_ARGS__)
 
 /* Write a warning message on the terminal. Warnings should be as clear as possible to be useful for end-users.
 *@param ... the message format and parameters, in a 'printf' style.
 */
 #define cd_warning(...)                                                \
-  cd_log_location(G_LOG_LEVEL_WARNING, __FILE__, __PRETTY_FUNCTION__, __LINE__,__VA_ARGS__)
+  _cd_log_if_enabled(G_LOG_LEVEL_WARNING, __VA_ARGS__)
 
 /* Write a message on the terminal. Messages are used to trace the sequence of functions, and may be used by users for a quick debug.
 *@param ... the message format and parameters, in a 'printf' style.
 */
 #define cd_message(...)                                                \
-  cd_log_location(G_LOG_LEVEL_MESSAGE, __FILE__, __PRETTY_FUNCTION__, __LINE__,__VA_ARGS__)
+  _cd_log_if_enabled(G_LOG_LEVEL_MESSAGE, __VA_ARGS__)
 
 /* Write a debug message on the terminal. Debug message are only useful for developpers.
 *@param ... the message format and parameters, in a 'printf' style.
 */
 #define cd_debug(...)                                                  \
-  cd_log_location(G_LOG_LEVEL_DEBUG, __FILE__, __PRETTY_FUNCTION__, __LINE__,__VA_ARGS__)
+  _cd_log_if_enabled(G_LOG_LEVEL_DEBUG, __VA_ARGS__)
 
 G_END_DECLS
 #endif 	    /* !CAIRO_DOCK_LOG_H_ */
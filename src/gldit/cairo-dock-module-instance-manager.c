@@ -17,6 +17,7 @@
 * along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <string.h>  // strstr
 
 #include "gldi-config.h"
 #include "cairo-dock-dock-manager.h"
@@ -34,6 +35,8 @@
 #include "cairo-dock-data-renderer.h"
 #include "cairo-dock-themes-manager.h"  // cairo_dock_update_conf_file
 #include "cairo-dock-module-manager.h"
+#include "cairo-dock-desktop-manager.h"  // g_desktopGeometry
+#include "cairo-dock-profiler.h"  // gldi_profiler_append_json_string
 #define _MANAGER_DEF_
 #include "cairo-dock-module-instance-manager.h"
 
@@ -45,8 +48,15 @@ extern CairoDock *g_pMainDock;
 extern gchar *g_cCurrentThemePath;
 
 // private
+static gboolean s_bDeferredActivation = FALSE;
+static GList *s_pDeferredInstances = NULL;  // instances that are not initialized yet.
+static gboolean s_bWatchingDesktop = FALSE;
 static int s_iNbUsedSlots = 0;
 static GldiModuleInstance *s_pUsedSlots[CAIRO_DOCK_NB_DATA_SLOT+1];
+static GldiModuleInstance *s_pCurrentInstance = NULL;  // instance on behalf of which the dock is running.
+static GHashTable *s_pAccounts = NULL;  // instance -> its account
+static GHashTable *s_pTrackedResources[GLDI_NB_RESOURCE_TYPES];  // key -> tracked resource
+static GHashTable *s_pBudgets = NULL;  // module name -> budget
 
 
 GldiModuleInstance *gldi_module_instance_new (GldiModule *pModule, gchar *cConfFilePah)  // The module-instance takes ownership of the path
@@ -367,6 +377,392 @@ void gldi_module_instance_release_data_slot (GldiModuleInstance *pInstance)
 }
 
 
+  ///////////////////////////
+ /// DEFERRED ACTIVATION ///
+///////////////////////////
+
+void gldi_module_instances_set_deferred_activation (gboolean bDeferred)
+{
+	s_bDeferredActivation = bDeferred;
+}
+
+static gboolean _has_shortkey (GKeyFile *pKeyFile)
+{
+	gboolean bHasShortkey = FALSE;
+	gchar **pGroupList = g_key_file_get_groups (pKeyFile, NULL);
+	gchar **pKeyList;
+	gchar *cValue;
+	int i, j;
+	for (i = 0; pGroupList[i] != NULL && ! bHasShortkey; i ++)
+	{
+		pKeyList = g_key_file_get_keys (pKeyFile, pGroupList[i], NULL, NULL);
+		for (j = 0; pKeyList != NULL && pKeyList[j] != NULL && ! bHasShortkey; j ++)
+		{
+			if (strstr (pKeyList[j], "shortkey") == NULL)
+				continue;
+			cValue = g_key_file_get_string (pKeyFile, pGroupList[i], pKeyList[j], NULL);
+			bHasShortkey = (cValue != NULL && *cValue != '\0');
+			g_free (cValue);
+		}
+		g_strfreev (pKeyList);
+	}
+	g_strfreev (pGroupList);
+	return bHasShortkey;
+}
+
+static gboolean _desklet_is_on_current_desktop (CairoDeskletAttr *pAttribute)
+{
+	if (pAttribute->bOnAllDesktops)
+		return TRUE;
+	int iNbViewports = g_desktopGeometry.iNbViewportX * g_desktopGeometry.iNbViewportY;
+	if (iNbViewports <= 0)
+		return TRUE;
+	int iCurrentIndex = g_desktopGeometry.iCurrentDesktop * iNbViewports
+		+ g_desktopGeometry.iCurrentViewportX * g_desktopGeometry.iNbViewportY
+		+ g_desktopGeometry.iCurrentViewportY;  // same indexation as the 'num desktop' of desklets.
+	return (pAttribute->iNumDesktop == iCurrentIndex);
+}
+
+static gboolean _can_defer_instance (GldiModuleInstance *pInstance, GKeyFile *pKeyFile, CairoDockMinimalAppletConfig *pMinimalConfig)
+{
+	if (! s_bDeferredActivation || ! cairo_dock_is_loading () || pInstance->pIcon == NULL)  // only during the loading of a theme; plug-ins are always activated.
+		return FALSE;
+	if (pInstance->pDock != NULL)
+	{
+		if (pInstance->pDock->iRefCount == 0)  // root dock -> will be shown right away.
+			return FALSE;
+	}
+	else if (pInstance->pDesklet != NULL)
+	{
+		if (_desklet_is_on_current_desktop (&pMinimalConfig->deskletAttribute))
+			return FALSE;
+	}
+	else
+		return FALSE;
+	return (pKeyFile == NULL || ! _has_shortkey (pKeyFile));  // a shortkey must work even if the applet has never been shown.
+}
+
+void gldi_module_instance_init_deferred (GldiModuleInstance *pInstance)
+{
+	if (pInstance == NULL || ! pInstance->bDeferred)
+		return;
+	cd_debug ("%s (%s)", __func__, pInstance->pModule->pVisitCard->cModuleName);
+	pInstance->bDeferred = FALSE;
+	s_pDeferredInstances = g_list_remove (s_pDeferredInstances, pInstance);
+	
+	GldiModule *pModule = pInstance->pModule;
+	GKeyFile *pKeyFile = NULL;
+	if (pInstance->cConfFilePath != NULL)
+	{
+		pKeyFile = cairo_dock_open_key_file (pInstance->cConfFilePath);
+		if (pKeyFile)
+			_read_module_config (pKeyFile, pInstance);
+	}
+	
+	GldiModuleInstance *pPrevInstance = gldi_module_instance_set_current (pInstance);
+	if (pModule->pInterface->initModule)
+		pModule->pInterface->initModule (pInstance, pKeyFile);
+	gldi_module_instance_set_current (pPrevInstance);
+	
+	if (pKeyFile != NULL)
+		g_key_file_free (pKeyFile);
+	
+	if (pInstance->pDock != NULL && pInstance->pDock->iRefCount != 0)  // the applet may have changed its image
+		cairo_dock_redraw_subdock_content (pInstance->pDock);
+}
+
+void gldi_module_instances_init_deferred_in_dock (CairoDock *pDock)
+{
+	GldiModuleInstance *pInstance;
+	GList *m = s_pDeferredInstances, *next_m;
+	while (m != NULL)
+	{
+		next_m = m->next;  // the link is removed when the instance is initialized.
+		pInstance = m->data;
+		if (pInstance->pDock == pDock)
+			gldi_module_instance_init_deferred (pInstance);
+		m = next_m;
+	}
+}
+
+int gldi_module_instances_get_nb_deferred (void)
+{
+	return g_list_length (s_pDeferredInstances);
+}
+
+static gboolean _on_desktop_changed (G_GNUC_UNUSED gpointer data)
+{
+	GldiModuleInstance *pInstance;
+	CairoDeskletAttr attr;
+	GList *m = s_pDeferredInstances, *next_m;
+	while (m != NULL)
+	{
+		next_m = m->next;
+		pInstance = m->data;
+		if (pInstance->pDesklet != NULL)
+		{
+			memset (&attr, 0, sizeof (CairoDeskletAttr));
+			attr.bOnAllDesktops = gldi_desklet_is_sticky (pInstance->pDesklet);
+			attr.iNumDesktop = gldi_container_get_current_desktop_index (CAIRO_CONTAINER (pInstance->pDesklet));
+			if (_desklet_is_on_current_desktop (&attr))
+				gldi_module_instance_init_deferred (pInstance);
+		}
+		m = next_m;
+	}
+	return GLDI_NOTIFICATION_LET_PASS;
+}
+
+
+  /////////////////
+ /// RESOURCES ///
+/////////////////
+
+#define GLDI_RESOURCE_CPU_WINDOW 10000000  // the CPU load is averaged over 10s
+
+typedef struct {
+	double fCpuLoad;  // in % of a core
+	gint64 iMemory;  // in bytes
+} GldiResourceBudget;
+
+typedef struct {
+	const gchar *cModuleName;  // belongs to the module, which outlives its instances.
+	gint64 iCpuTime;  // total CPU time of its Tasks (threads and updates), in us
+	guint iNbTaskIterations;
+	gint64 iWindowStart;
+	gint64 iWindowCpuTime;
+	double fCpuLoad;  // over the last complete window
+	gint iNbResources[GLDI_NB_RESOURCE_TYPES];
+	gint64 iMemory[GLDI_NB_RESOURCE_TYPES];
+	guint iNbFrames;
+	gboolean bMemoryWarning;  // to warn only once
+} GldiResourceAccount;
+
+typedef struct {
+	GldiModuleInstance *pInstance;
+	gint64 iSize;
+} GldiTrackedResource;
+
+static const gchar *s_cResourceNames[GLDI_NB_RESOURCE_TYPES] = {"textures", "images"};
+
+GldiModuleInstance *gldi_module_instance_set_current (GldiModuleInstance *pInstance)
+{
+	GldiModuleInstance *pPrevInstance = s_pCurrentInstance;
+	s_pCurrentInstance = pInstance;
+	return pPrevInstance;
+}
+
+GldiModuleInstance *gldi_module_instance_get_current (void)
+{
+	return s_pCurrentInstance;
+}
+
+static inline GldiResourceAccount *_get_account (GldiModuleInstance *pInstance)
+{
+	return (s_pAccounts != NULL && pInstance != NULL ? g_hash_table_lookup (s_pAccounts, pInstance) : NULL);  // look it up rather than dereferencing the instance, which may be gone (a Task that outlives its applet).
+}
+
+static GldiResourceBudget *_get_budget (GldiResourceAccount *pAccount)
+{
+	return (s_pBudgets != NULL ? g_hash_table_lookup (s_pBudgets, pAccount->cModuleName) : NULL);
+}
+
+static double _get_cpu_load (GldiResourceAccount *pAccount)
+{
+	double fCurrentLoad = 100. * pAccount->iWindowCpuTime / GLDI_RESOURCE_CPU_WINDOW;  // the current window is not complete, so it can only be underestimated.
+	return MAX (pAccount->fCpuLoad, fCurrentLoad);
+}
+
+void gldi_module_instance_add_cpu_time (GldiModuleInstance *pInstance, gint64 iCpuTime)
+{
+	GldiResourceAccount *pAccount = _get_account (pInstance);
+	if (pAccount == NULL)
+		return;
+	pAccount->iCpuTime += iCpuTime;
+	pAccount->iNbTaskIterations ++;
+	
+	gint64 t = g_get_monotonic_time ();
+	if (t - pAccount->iWindowStart > GLDI_RESOURCE_CPU_WINDOW)  // start a new window.
+	{
+		pAccount->fCpuLoad = (pAccount->iWindowStart != 0 ? 100. * pAccount->iWindowCpuTime / (t - pAccount->iWindowStart) : 0.);
+		pAccount->iWindowStart = t;
+		pAccount->iWindowCpuTime = 0;
+	}
+	pAccount->iWindowCpuTime += iCpuTime;
+}
+
+void gldi_module_instance_add_frame (GldiModuleInstance *pInstance)
+{
+	GldiResourceAccount *pAccount = _get_account (pInstance);
+	if (pAccount != NULL)
+		pAccount->iNbFrames ++;
+}
+
+static void _check_memory_budget (GldiResourceAccount *pAccount)
+{
+	GldiResourceBudget *pBudget = _get_budget (pAccount);
+	if (pBudget == NULL || pBudget->iMemory == 0 || pAccount->bMemoryWarning)
+		return;
+	gint64 iMemory = pAccount->iMemory[GLDI_RESOURCE_TEXTURE] + pAccount->iMemory[GLDI_RESOURCE_IMAGE];
+	if (iMemory > pBudget->iMemory)
+	{
+		cd_warning ("the applet %s uses %" G_GINT64_FORMAT " kB of images, more than its budget (%" G_GINT64_FORMAT " kB)", pAccount->cModuleName, iMemory / 1024, pBudget->iMemory / 1024);
+		pAccount->bMemoryWarning = TRUE;
+	}
+}
+
+void gldi_module_instances_untrack_resource (GldiResourceType iType, gconstpointer pKey)
+{
+	if (s_pTrackedResources[iType] == NULL)
+		return;
+	GldiTrackedResource *pResource = g_hash_table_lookup (s_pTrackedResources[iType], pKey);
+	if (pResource == NULL)
+		return;
+	GldiResourceAccount *pAccount = _get_account (pResource->pInstance);
+	if (pAccount != NULL)
+	{
+		pAccount->iNbResources[iType] --;
+		pAccount->iMemory[iType] -= pResource->iSize;
+	}
+	g_hash_table_remove (s_pTrackedResources[iType], pKey);
+}
+
+void gldi_module_instances_track_resource (GldiResourceType iType, gconstpointer pKey, gint64 iSize)
+{
+	gldi_module_instances_untrack_resource (iType, pKey);  // an image buffer can be loaded again without being unloaded.
+	GldiResourceAccount *pAccount = _get_account (s_pCurrentInstance);
+	if (pAccount == NULL)
+		return;
+	if (s_pTrackedResources[iType] == NULL)
+		s_pTrackedResources[iType] = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
+	GldiTrackedResource *pResource = g_new (GldiTrackedResource, 1);
+	pResource->pInstance = s_pCurrentInstance;
+	pResource->iSize = iSize;
+	g_hash_table_insert (s_pTrackedResources[iType], (gpointer)pKey, pResource);
+	pAccount->iNbResources[iType] ++;
+	pAccount->iMemory[iType] += iSize;
+	_check_memory_budget (pAccount);
+}
+
+void gldi_module_instances_set_budget (const gchar *cModuleName, double fCpuLoad, gint64 iMemory)
+{
+	g_return_if_fail (cModuleName != NULL);
+	if (s_pBudgets == NULL)
+		s_pBudgets = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+	if (fCpuLoad <= 0 && iMemory <= 0)
+	{
+		g_hash_table_remove (s_pBudgets, cModuleName);
+		return;
+	}
+	GldiResourceBudget *pBudget = g_new (GldiResourceBudget, 1);
+	pBudget->fCpuLoad = MAX (0, fCpuLoad);
+	pBudget->iMemory = MAX (0, iMemory);
+	g_hash_table_insert (s_pBudgets, g_strdup (cModuleName), pBudget);
+	
+	if (s_pAccounts != NULL)  // let the instances warn again against the new budget.
+	{
+		GHashTableIter iter;
+		gpointer key, value;
+		g_hash_table_iter_init (&iter, s_pAccounts);
+		while (g_hash_table_iter_next (&iter, &key, &value))
+		{
+			GldiResourceAccount *pAccount = value;
+			if (strcmp (pAccount->cModuleName, cModuleName) == 0)
+			{
+				pAccount->bMemoryWarning = FALSE;
+				_check_memory_budget (pAccount);
+			}
+		}
+	}
+}
+
+gboolean gldi_module_instance_is_over_cpu_budget (GldiModuleInstance *pInstance)
+{
+	GldiResourceAccount *pAccount = _get_account (pInstance);
+	if (pAccount == NULL)
+		return FALSE;
+	GldiResourceBudget *pBudget = _get_budget (pAccount);
+	return (pBudget != NULL && pBudget->fCpuLoad > 0 && _get_cpu_load (pAccount) > pBudget->fCpuLoad);
+}
+
+static void _open_account (GldiModuleInstance *pInstance)
+{
+	if (s_pAccounts == NULL)
+		s_pAccounts = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
+	GldiResourceAccount *pAccount = g_new0 (GldiResourceAccount, 1);
+	pAccount->cModuleName = pInstance->pModule->pVisitCard->cModuleName;
+	g_hash_table_insert (s_pAccounts, pInstance, pAccount);
+}
+
+static gboolean _is_tracked_by (G_GNUC_UNUSED gpointer key, GldiTrackedResource *pResource, GldiModuleInstance *pInstance)
+{
+	return (pResource->pInstance == pInstance);
+}
+static void _close_account (GldiModuleInstance *pInstance)
+{
+	int i;
+	for (i = 0; i < GLDI_NB_RESOURCE_TYPES; i ++)  // resources it didn't destroy (or that are destroyed later) are not its own any more.
+	{
+		if (s_pTrackedResources[i] != NULL)
+			g_hash_table_foreach_remove (s_pTrackedResources[i], (GHRFunc) _is_tracked_by, pInstance);
+	}
+	if (s_pAccounts != NULL)
+		g_hash_table_remove (s_pAccounts, pInstance);
+	if (s_pCurrentInstance == pInstance)
+		s_pCurrentInstance = NULL;
+}
+
+static gint _compare_accounts (GldiModuleInstance *pInstance1, GldiModuleInstance *pInstance2)
+{
+	GldiResourceAccount *pAccount1 = _get_account (pInstance1);
+	GldiResourceAccount *pAccount2 = _get_account (pInstance2);
+	return (pAccount1->iCpuTime < pAccount2->iCpuTime ? 1 : pAccount1->iCpuTime > pAccount2->iCpuTime ? -1 : 0);  // heaviest first
+}
+
+gchar *gldi_module_instances_get_resources_report (void)
+{
+	GString *sJson = g_string_new ("[");
+	GList *pInstancesList = (s_pAccounts ? g_hash_table_get_keys (s_pAccounts) : NULL);
+	pInstancesList = g_list_sort (pInstancesList, (GCompareFunc)_compare_accounts);
+	GldiModuleInstance *pInstance;
+	GldiResourceAccount *pAccount;
+	GldiResourceBudget *pBudget;
+	GList *m;
+	int i;
+	for (m = pInstancesList; m != NULL; m = m->next)
+	{
+		pInstance = m->data;
+		pAccount = _get_account (pInstance);
+		g_string_append_printf (sJson, "%s\n {\"module\": ", m == pInstancesList ? "" : ",");
+		gldi_profiler_append_json_string (sJson, pAccount->cModuleName);
+		g_string_append (sJson, ", \"conf\": ");
+		gldi_profiler_append_json_string (sJson, pInstance->cConfFilePath);
+		g_string_append_printf (sJson, ", \"deferred\": %s, \"cpu_us\": %" G_GINT64_FORMAT ", \"cpu_load\": %.2f, \"task_iterations\": %u, \"frames\": %u",
+			pInstance->bDeferred ? "true" : "false",
+			pAccount->iCpuTime,
+			_get_cpu_load (pAccount),
+			pAccount->iNbTaskIterations,
+			pAccount->iNbFrames);
+		for (i = 0; i < GLDI_NB_RESOURCE_TYPES; i ++)
+		{
+			g_string_append_printf (sJson, ", \"%s\": {\"count\": %d, \"kb\": %" G_GINT64_FORMAT "}",
+				s_cResourceNames[i],
+				pAccount->iNbResources[i],
+				pAccount->iMemory[i] / 1024);
+		}
+		pBudget = _get_budget (pAccount);
+		if (pBudget != NULL)
+			g_string_append_printf (sJson, ", \"budget\": {\"cpu_load\": %.2f, \"kb\": %" G_GINT64_FORMAT ", \"over_cpu\": %s}",
+				pBudget->fCpuLoad,
+				pBudget->iMemory / 1024,
+				gldi_module_instance_is_over_cpu_budget (pInstance) ? "true" : "false");
+		g_string_append_c (sJson, '}');
+	}
+	g_list_free (pInstancesList);
+	g_string_append (sJson, "]");
+	return g_string_free (sJson, FALSE);
+}
+
+
   ///////////////
  /// MANAGER ///
 ///////////////
@@ -393,6 +789,8 @@ static void init_object (GldiObject *obj, gpointer attr)
 		g_free (pMinimalConfig);
 		return;
 	}
+	_open_account (pInstance);
+	GldiModuleInstance *pPrevInstance = gldi_module_instance_set_current (pInstance);  // the icon and whatever the init creates belong to the instance.
 	
 	//\____________________ create the icon and its container.
 	GldiContainer *pContainer = NULL;
@@ -442,12 +840,30 @@ static void init_object (GldiObject *obj, gpointer attr)
 		pInstance->pContainer = pContainer;
 	}
 	
-	//\____________________ initialise the instance.
-	if (pKeyFile)
-		_read_module_config (pKeyFile, pInstance);
-	
-	if (pModule->pInterface->initModule)
-		pModule->pInterface->initModule (pInstance, pKeyFile);
+	//\____________________ initialise the instance, unless it's hidden and can wait.
+	if (_can_defer_instance (pInstance, pKeyFile, pMinimalConfig))
+	{
+		cd_debug ("the activation of %s is deferred", pModule->pVisitCard->cModuleName);
+		pInstance->bDeferred = TRUE;
+		s_pDeferredInstances = g_list_prepend (s_pDeferredInstances, pInstance);
+		if (! s_bWatchingDesktop)  // the desktop manager is registered after us, so we can't listen to it before.
+		{
+			gldi_object_register_notification (&myDesktopMgr,
+				NOTIFICATION_DESKTOP_CHANGED,
+				(GldiNotificationFunc) _on_desktop_changed,
+				GLDI_RUN_AFTER, NULL);
+			s_bWatchingDesktop = TRUE;
+		}
+	}
+	else
+	{
+		if (pKeyFile)
+			_read_module_config (pKeyFile, pInstance);
+		
+		if (pModule->pInterface->initModule)
+			pModule->pInterface->initModule (pInstance, pKeyFile);
+	}
+	gldi_module_instance_set_current (pPrevInstance);
 	
 	if (pDesklet && pDesklet->iDesiredWidth == 0 && pDesklet->iDesiredHeight == 0)  // can happen if the desklet has already resized itself before the init.
 		gtk_widget_queue_draw (pDesklet->container.pWidget);
@@ -471,14 +887,22 @@ static void reset_object (GldiObject *obj)
 	GldiModuleInstance *pInstance = (GldiModuleInstance*)obj;
 	
 	// stop the instance
-	if (pInstance->pModule->pInterface->stopModule != NULL)
-		pInstance->pModule->pInterface->stopModule (pInstance);
-	
-	if (pInstance->pModule->pInterface->reset_data != NULL)
-		pInstance->pModule->pInterface->reset_data (pInstance);
-	
-	if (pInstance->pModule->pInterface->reset_config != NULL)
-		pInstance->pModule->pInterface->reset_config (pInstance);
+	if (pInstance->bDeferred)  // never initialized, nothing to stop.
+	{
+		s_pDeferredInstances = g_list_remove (s_pDeferredInstances, pInstance);
+		pInstance->bDeferred = FALSE;
+	}
+	else
+	{
+		if (pInstance->pModule->pInterface->stopModule != NULL)
+			pInstance->pModule->pInterface->stopModule (pInstance);
+		
+		if (pInstance->pModule->pInterface->reset_data != NULL)
+			pInstance->pModule->pInterface->reset_data (pInstance);
+		
+		if (pInstance->pModule->pInterface->reset_config != NULL)
+			pInstance->pModule->pInterface->reset_config (pInstance);
+	}
 	
 	// destroy icon/container
 	if (pInstance->pDesklet)
@@ -519,6 +943,8 @@ static void reset_object (GldiObject *obj)
 			gldi_modules_write_active ();
 		}
 	}
+	
+	_close_account (pInstance);
 }
 
 static gboolean delete_object (GldiObject *obj)
@@ -556,6 +982,9 @@ static GKeyFile* reload_object (GldiObject *obj, gboolean bReadConfig, GKeyFile
 	GldiModule *module = pInstance->pModule;
 	cd_message ("%s (%s, %d)", __func__, module->pVisitCard->cModuleName, bReadConfig);
 	
+	gldi_module_instance_init_deferred (pInstance);  // a deferred instance must be initialized before it can be reloaded.
+	GldiModuleInstance *pPrevInstance = gldi_module_instance_set_current (pInstance);
+	
 	GldiContainer *pCurrentContainer = pInstance->pContainer;
 	pInstance->pContainer = NULL;
 	CairoDock *pCurrentDock = pInstance->pDock;
@@ -724,6 +1153,7 @@ static GKeyFile* reload_object (GldiObject *obj, gboolean bReadConfig, GKeyFile
 	if (! bReadConfig && cairo_dock_get_icon_data_renderer (pIcon) != NULL)  // reload the data-renderer at the new size
 		cairo_dock_reload_data_renderer_on_icon (pIcon, pNewContainer);
 	
+	gldi_module_instance_set_current (pPrevInstance);
 	return pKeyFile;
 }
 
@@ -73,7 +73,9 @@ struct _GldiModuleInstance {
 	gpointer pConfig;
 	/// pointer to a structure containing the data of the applet.
 	gpointer pData;
-	gpointer reserved[2];
+	/// TRUE if the instance has not been initialized yet, because its container has never been shown.
+	gboolean bDeferred;
+	gpointer reserved[1];
 };
 
 struct _GldiModuleInstanceAttr {
@@ -103,6 +105,88 @@ void gldi_module_instance_detach_at_position (GldiModuleInstance *pInstance, int
 void gldi_module_instance_popup_description (GldiModuleInstance *pModuleInstance);
 
 
+/** Enable or disable the deferred activation. When it's enabled, the instances created while a theme is loaded that are inside a closed sub-dock or in a desklet on another desktop only get their icon; they are fully initialized when their container is first shown (sub-dock opened, desktop of the desklet reached), when they are reloaded or configured, or when \ref gldi_module_instance_init_deferred is called. Until then they don't poll nor notify anything. Instances that have a shortkey are never deferred, since their shortkey is only registered by their init. It is disabled by default.
+*@param bDeferred TRUE to enable the deferred activation.
+*/
+void gldi_module_instances_set_deferred_activation (gboolean bDeferred);
+
+/** Complete the initialization of an instance whose activation has been deferred; does nothing if the instance is already initialized. The dock doesn't do it by itself when an instance is reached from outside (for instance through the D-Bus interface of a plug-in), so the caller has to.
+*@param pInstance the instance.
+*/
+void gldi_module_instance_init_deferred (GldiModuleInstance *pInstance);
+
+/** Complete the initialization of all the deferred instances inside a dock. It's called when a sub-dock is shown.
+*@param pDock the dock.
+*/
+void gldi_module_instances_init_deferred_in_dock (CairoDock *pDock);
+
+/** Get the number of instances whose activation is currently deferred.
+*@return the number of deferred instances.
+*/
+int gldi_module_instances_get_nb_deferred (void);
+
+
+/// Kinds of memory attributed to the instances.
+typedef enum {
+	GLDI_RESOURCE_TEXTURE = 0,  // textures, in video memory
+	GLDI_RESOURCE_IMAGE,  // image buffers, in memory
+	GLDI_NB_RESOURCE_TYPES
+} GldiResourceType;
+
+/** Tell on behalf of which instance the dock is running from now on (main thread only): the textures and images created meanwhile are attributed to this instance. It's set during the init and the reload of an instance, and during the update of its Tasks.
+*@param pInstance the instance, or NULL for the dock itself.
+*@return the previous instance, to be restored afterwards.
+*/
+GldiModuleInstance *gldi_module_instance_set_current (GldiModuleInstance *pInstance);
+
+/** Get the instance on behalf of which the dock is currently running.
+*@return the instance, or NULL.
+*/
+GldiModuleInstance *gldi_module_instance_get_current (void);
+
+/** Attribute some CPU time to an instance (main thread only). It's done by the Tasks, for their thread and their update.
+*@param pInstance the instance (it may have been destroyed already, in which case nothing happens).
+*@param iCpuTime CPU time in us.
+*/
+void gldi_module_instance_add_cpu_time (GldiModuleInstance *pInstance, gint64 iCpuTime);
+
+/** Count an animation frame of an instance's icon.
+*@param pInstance the instance.
+*/
+void gldi_module_instance_add_frame (GldiModuleInstance *pInstance);
+
+/** Attribute a resource to the current instance (see \ref gldi_module_instance_set_current); does nothing if there is none. If the resource was already attributed, it's replaced.
+*@param iType type of resource
+*@param pKey what identifies the resource (the texture ID, the image buffer)
+*@param iSize its size in bytes
+*/
+void gldi_module_instances_track_resource (GldiResourceType iType, gconstpointer pKey, gint64 iSize);
+
+/** Forget a resource attributed with \ref gldi_module_instances_track_resource, when it's destroyed.
+*@param iType type of resource
+*@param pKey what identifies the resource
+*/
+void gldi_module_instances_untrack_resource (GldiResourceType iType, gconstpointer pKey);
+
+/** Set the budget of the instances of a module. An instance that uses more CPU than its budget gets its periodic Tasks slowed down until it goes back under it; an instance that uses more memory only gets a warning.
+*@param cModuleName name of the module
+*@param fCpuLoad maximum CPU load, in percent of a core (averaged over 10s), or 0 for no limit
+*@param iMemory maximum memory (textures + images) in bytes, or 0 for no limit
+*/
+void gldi_module_instances_set_budget (const gchar *cModuleName, double fCpuLoad, gint64 iMemory);
+
+/** Tell if an instance uses more CPU than its budget.
+*@param pInstance the instance (it may have been destroyed already, in which case FALSE is returned).
+*@return TRUE if it's over its budget.
+*/
+gboolean gldi_module_instance_is_over_cpu_budget (GldiModuleInstance *pInstance);
+
+/** Get the resources used by each instance, as JSON: CPU time and load of its Tasks, textures, images, animation frames, and budget. The heaviest ones come first.
+*@return the report, to be freed with g_free.
+*/
+gchar *gldi_module_instances_get_resources_report (void);
+
+
 gboolean gldi_module_instance_reserve_data_slot (GldiModuleInstance *pInstance);
 void gldi_module_instance_release_data_slot (GldiModuleInstance *pInstance);
 
@@ -54,6 +54,8 @@ extern gboolean g_bEasterEggs;
 static GHashTable *s_hModuleTable = NULL;
 static GList *s_AutoLoadedModules = NULL;
 static guint s_iSidWriteModules = 0;
+static GThread *s_pCacheWriterThread = NULL;
+static GHashTable *s_hCustomWidgetsModules = NULL;  // modules registered from the cache whose interface has custom widgets.
 
 
   ///////////////
@@ -146,11 +148,30 @@ GldiModule *gldi_module_new (GldiVisitCard *pVisitCard, GldiModuleInterface *pIn
 	return (GldiModule*)gldi_object_new (&myModuleObjectMgr, &attr);
 }
 
-GldiModule *gldi_module_new_from_so_file (const gchar *cSoFilePath)
+typedef struct {
+	gchar *cSoFilePath;
+	gint64 iMTime;
+	gint64 iSize;
+	gpointer handle;
+	GldiModulePreInit pre_init;
+	GldiVisitCard *pVisitCard;
+	GldiModuleInterface *pInterface;
+} CDModuleFile;
+
+static GThread *_new_thread (const gchar *cName, GThreadFunc func, gpointer data)  // joinable
 {
-	g_return_val_if_fail (cSoFilePath != NULL, NULL);
-	GldiVisitCard *pVisitCard = NULL;
-	GldiModuleInterface *pInterface = NULL;
+	#ifndef GLIB_VERSION_2_32
+	(void)cName;
+	return g_thread_create (func, data, TRUE, NULL);  // TRUE <=> joinable
+	#else
+	return g_thread_try_new (cName, func, data, NULL);
+	#endif
+}
+
+// open the library and find its pre-init.
+static void _dlopen_module_file (CDModuleFile *pFile)
+{
+	const gchar *cSoFilePath = pFile->cSoFilePath;
 	
 	// open the .so file
 	///GModule *module = g_module_open (pGldiModule->cSoFilePath, G_MODULE_BIND_LAZY | G_MODULE_BIND_LOCAL);
@@ -158,7 +179,7 @@ GldiModule *gldi_module_new_from_so_file (const gchar *cSoFilePath)
 	if (! handle)
 	{
 		cd_warning ("while opening module '%s' : (%s)", cSoFilePath, dlerror());
-		return NULL;
+		return;
 	}
 	
 	// find the pre-init entry point
@@ -169,49 +190,370 @@ GldiModule *gldi_module_new_from_so_file (const gchar *cSoFilePath)
 	if (function_pre_init == NULL)
 	{
 		cd_warning ("this module ('%s') does not have the common entry point 'pre_init', it may be broken or icompatible with cairo-dock", cSoFilePath);
-		goto discard;
+		dlclose (handle);
+		return;
 	}
 	
-	// run the pre-init entry point to get the necessary info about the module
-	pVisitCard = g_new0 (GldiVisitCard, 1);
-	pInterface = g_new0 (GldiModuleInterface, 1);
-	gboolean bModuleLoaded = function_pre_init (pVisitCard, pInterface);
+	pFile->handle = handle;
+	pFile->pre_init = function_pre_init;
+}
+
+// run the pre-init of a library opened by _dlopen_module_file, to get the necessary info about the module; the module's code can do anything there (gettext, GTK, its own globals), so it must be called from the main thread.
+static void _pre_init_module_file (CDModuleFile *pFile)
+{
+	if (pFile->handle == NULL)
+		return;
+	GldiVisitCard *pVisitCard = g_new0 (GldiVisitCard, 1);
+	GldiModuleInterface *pInterface = g_new0 (GldiModuleInterface, 1);
+	gboolean bModuleLoaded = pFile->pre_init (pVisitCard, pInterface);
 	if (! bModuleLoaded)
 	{
-		cd_debug ("module '%s' has not been loaded", cSoFilePath);  // can happen to xxx-integration or icon-effect for instance.
-		goto discard;
+		cd_debug ("module '%s' has not been loaded", pFile->cSoFilePath);  // can happen to xxx-integration or icon-effect for instance.
+		dlclose (pFile->handle);
+		pFile->handle = NULL;
+		cairo_dock_free_visit_card (pVisitCard);
+		g_free (pInterface);
+		return;
 	}
-	
-	// check module compatibility
+	pFile->pVisitCard = pVisitCard;
+	pFile->pInterface = pInterface;
+}
+
+static void _open_module_file (CDModuleFile *pFile)
+{
+	_dlopen_module_file (pFile);
+	_pre_init_module_file (pFile);
+}
+
+static gboolean _module_is_compatible (GldiVisitCard *pVisitCard, const gchar *cSoFilePath)
+{
 	if (! g_bEasterEggs &&
 		(pVisitCard->iMajorVersionNeeded > g_iMajorVersion
 		|| (pVisitCard->iMajorVersionNeeded == g_iMajorVersion && pVisitCard->iMinorVersionNeeded > g_iMinorVersion)
 		|| (pVisitCard->iMajorVersionNeeded == g_iMajorVersion && pVisitCard->iMinorVersionNeeded == g_iMinorVersion && pVisitCard->iMicroVersionNeeded > g_iMicroVersion)))
 	{
 		cd_warning ("this module ('%s') needs at least Cairo-Dock v%d.%d.%d, but Cairo-Dock is in v%d.%d.%d (%s)\n  It will be ignored", cSoFilePath, pVisitCard->iMajorVersionNeeded, pVisitCard->iMinorVersionNeeded, pVisitCard->iMicroVersionNeeded, g_iMajorVersion, g_iMinorVersion, g_iMicroVersion, GLDI_VERSION);
-		goto discard;
+		return FALSE;
 	}
 	if (! g_bEasterEggs
 	&& pVisitCard->cDockVersionOnCompilation != NULL && strcmp (pVisitCard->cDockVersionOnCompilation, GLDI_VERSION) != 0)  // separation des versions en easter egg.
 	{
 		cd_warning ("this module ('%s') was compiled with Cairo-Dock v%s, but Cairo-Dock is in v%s\n  It will be ignored", cSoFilePath, pVisitCard->cDockVersionOnCompilation, GLDI_VERSION);
-		goto discard;
+		return FALSE;
+	}
+	return TRUE;
+}
+
+// check the module opened by _open_module_file (or _dlopen_module_file + _pre_init_module_file) and register it; must be called from the main thread.
+static GldiModule *_register_module_file (CDModuleFile *pFile)
+{
+	if (pFile->handle == NULL)
+		return NULL;
+	
+	// check module compatibility
+	if (! _module_is_compatible (pFile->pVisitCard, pFile->cSoFilePath))
+	{
+		///g_module_close (pModule);
+		dlclose (pFile->handle);
+		cairo_dock_free_visit_card (pFile->pVisitCard);
+		g_free (pFile->pInterface);
+		pFile->handle = NULL;
+		pFile->pVisitCard = NULL;
+		pFile->pInterface = NULL;
+		return NULL;
 	}
 	
 	// create a new module with these info
-	GldiModule *pModule = gldi_module_new (pVisitCard, pInterface);  // takes ownership of pVisitCard and pInterface
+	GldiModule *pModule = gldi_module_new (pFile->pVisitCard, pFile->pInterface);  // takes ownership of pVisitCard and pInterface
 	if (pModule)
-		pModule->handle = handle;
+	{
+		pModule->handle = pFile->handle;
+		pModule->cSoFilePath = g_strdup (pFile->cSoFilePath);
+	}
+	pFile->handle = NULL;
+	pFile->pVisitCard = NULL;
+	pFile->pInterface = NULL;
 	return pModule;
+}
+
+GldiModule *gldi_module_new_from_so_file (const gchar *cSoFilePath)
+{
+	g_return_val_if_fail (cSoFilePath != NULL, NULL);
 	
-discard:
-	///g_module_close (pModule);
-	dlclose (handle);
-	cairo_dock_free_visit_card (pVisitCard);
-	g_free (pInterface);
+	CDModuleFile file;
+	memset (&file, 0, sizeof (CDModuleFile));
+	file.cSoFilePath = (gchar*)cSoFilePath;
+	_open_module_file (&file);
+	
+	return _register_module_file (&file);
+}
+
+  /////////////////////////
+ /// VISIT CARDS CACHE ///
+/////////////////////////
+
+// Les cartes de visite des modules qui ne sont ni auto-charges ni refuses par leur pre-init sont gardees dans un fichier, avec la date et la taille de leur .so ; au demarrage on cree ces modules a partir du cache, et on ne charge leur librairie qu'au moment de les activer.
+
+static gchar *_get_modules_cache_path (void)
+{
+	return g_strdup_printf ("%s/cairo-dock/plug-ins.cache", g_get_user_cache_dir ());
+}
+
+static gchar *_get_cache_languages (void)
+{
+	return g_strjoinv (":", (gchar**)g_get_language_names ());  // the title of the modules is translated by their pre-init.
+}
+
+static GKeyFile *_load_modules_cache (void)
+{
+	GKeyFile *pKeyFile = g_key_file_new ();
+	gchar *cCachePath = _get_modules_cache_path ();
+	gboolean bValid = g_key_file_load_from_file (pKeyFile, cCachePath, G_KEY_FILE_NONE, NULL);
+	g_free (cCachePath);
+	if (bValid)
+	{
+		gchar *cVersion = g_key_file_get_string (pKeyFile, "Cache", "version", NULL);
+		gchar *cLanguages = g_key_file_get_string (pKeyFile, "Cache", "languages", NULL);
+		gchar *cCurrentLanguages = _get_cache_languages ();
+		bValid = (g_strcmp0 (cVersion, GLDI_VERSION) == 0 && g_strcmp0 (cLanguages, cCurrentLanguages) == 0);
+		g_free (cVersion);
+		g_free (cLanguages);
+		g_free (cCurrentLanguages);
+	}
+	if (! bValid)  // no cache yet, or it was made by another version of the dock or in another language -> start from scratch.
+	{
+		g_key_file_free (pKeyFile);
+		pKeyFile = g_key_file_new ();
+	}
+	return pKeyFile;
+}
+
+static gpointer _load_modules_cache_threaded (G_GNUC_UNUSED gpointer data)
+{
+	return _load_modules_cache ();
+}
+
+static gpointer _write_modules_cache_threaded (gchar *cContent)
+{
+	gchar *cCachePath = _get_modules_cache_path ();
+	gchar *cCacheDir = g_path_get_dirname (cCachePath);
+	if (g_mkdir_with_parents (cCacheDir, 7*8*8+5*8+5) != 0)
+	{
+		cd_debug ("couldn't create %s", cCacheDir);
+	}
+	else
+	{
+		GError *erreur = NULL;
+		g_file_set_contents (cCachePath, cContent, -1, &erreur);
+		if (erreur != NULL)
+		{
+			cd_debug ("couldn't write the modules cache: %s", erreur->message);
+			g_error_free (erreur);
+		}
+	}
+	g_free (cCacheDir);
+	g_free (cCachePath);
+	g_free (cContent);
 	return NULL;
 }
 
+static void _wait_modules_cache_written (void)
+{
+	if (s_pCacheWriterThread != NULL)
+	{
+		g_thread_join (s_pCacheWriterThread);
+		s_pCacheWriterThread = NULL;
+	}
+}
+
+static void _save_modules_cache (GKeyFile *pKeyFile)
+{
+	gchar *cLanguages = _get_cache_languages ();
+	g_key_file_set_string (pKeyFile, "Cache", "version", GLDI_VERSION);
+	g_key_file_set_string (pKeyFile, "Cache", "languages", cLanguages);
+	g_free (cLanguages);
+	
+	// the key-file is serialized here, and the file is written in a thread (the next load waits for it).
+	gchar *cContent = g_key_file_to_data (pKeyFile, NULL, NULL);
+	_wait_modules_cache_written ();
+	s_pCacheWriterThread = _new_thread ("Cairo-Dock Modules Cache", (GThreadFunc) _write_modules_cache_threaded, cContent);
+	if (s_pCacheWriterThread == NULL)
+		_write_modules_cache_threaded (cContent);
+}
+
+static void _set_cached_string (GKeyFile *pKeyFile, const gchar *cGroup, const gchar *cKey, const gchar *cValue)
+{
+	if (cValue != NULL)
+		g_key_file_set_string (pKeyFile, cGroup, cKey, cValue);
+}
+static const gchar *_get_cached_string (GKeyFile *pKeyFile, const gchar *cGroup, const gchar *cKey)
+{
+	gchar *cValue = g_key_file_get_string (pKeyFile, cGroup, cKey, NULL);
+	if (cValue == NULL)
+		return NULL;
+	const gchar *cStaticValue = g_intern_string (cValue);  // the strings of a visit card are static.
+	g_free (cValue);
+	return cStaticValue;
+}
+
+static void _cache_visit_card (GKeyFile *pKeyFile, CDModuleFile *pFile, GldiVisitCard *pVisitCard)
+{
+	const gchar *cGroup = pFile->cSoFilePath;
+	g_key_file_remove_group (pKeyFile, cGroup, NULL);
+	
+	gchar *cNumber = g_strdup_printf ("%" G_GINT64_FORMAT, pFile->iMTime);
+	g_key_file_set_string (pKeyFile, cGroup, "mtime", cNumber);
+	g_free (cNumber);
+	cNumber = g_strdup_printf ("%" G_GINT64_FORMAT, pFile->iSize);
+	g_key_file_set_string (pKeyFile, cGroup, "size", cNumber);
+	g_free (cNumber);
+	
+	_set_cached_string (pKeyFile, cGroup, "name", pVisitCard->cModuleName);
+	g_key_file_set_integer (pKeyFile, cGroup, "major", pVisitCard->iMajorVersionNeeded);
+	g_key_file_set_integer (pKeyFile, cGroup, "minor", pVisitCard->iMinorVersionNeeded);
+	g_key_file_set_integer (pKeyFile, cGroup, "micro", pVisitCard->iMicroVersionNeeded);
+	_set_cached_string (pKeyFile, cGroup, "preview", pVisitCard->cPreviewFilePath);
+	_set_cached_string (pKeyFile, cGroup, "gettext domain", pVisitCard->cGettextDomain);
+	_set_cached_string (pKeyFile, cGroup, "dock version", pVisitCard->cDockVersionOnCompilation);
+	_set_cached_string (pKeyFile, cGroup, "version", pVisitCard->cModuleVersion);
+	_set_cached_string (pKeyFile, cGroup, "user dir", pVisitCard->cUserDataDir);
+	_set_cached_string (pKeyFile, cGroup, "share dir", pVisitCard->cShareDataDir);
+	_set_cached_string (pKeyFile, cGroup, "conf file", pVisitCard->cConfFileName);
+	g_key_file_set_integer (pKeyFile, cGroup, "category", pVisitCard->iCategory);
+	_set_cached_string (pKeyFile, cGroup, "icon", pVisitCard->cIconFilePath);
+	g_key_file_set_integer (pKeyFile, cGroup, "size of config", pVisitCard->iSizeOfConfig);
+	g_key_file_set_integer (pKeyFile, cGroup, "size of data", pVisitCard->iSizeOfData);
+	g_key_file_set_boolean (pKeyFile, cGroup, "multi-instance", pVisitCard->bMultiInstance);
+	_set_cached_string (pKeyFile, cGroup, "description", pVisitCard->cDescription);
+	_set_cached_string (pKeyFile, cGroup, "author", pVisitCard->cAuthor);
+	_set_cached_string (pKeyFile, cGroup, "title", pVisitCard->cTitle);
+	g_key_file_set_integer (pKeyFile, cGroup, "container type", pVisitCard->iContainerType);
+	g_key_file_set_boolean (pKeyFile, cGroup, "static desklet size", pVisitCard->bStaticDeskletSize);
+	g_key_file_set_boolean (pKeyFile, cGroup, "allow empty title", pVisitCard->bAllowEmptyTitle);
+	g_key_file_set_boolean (pKeyFile, cGroup, "act as launcher", pVisitCard->bActAsLauncher);
+	g_key_file_set_boolean (pKeyFile, cGroup, "custom widgets", pFile->pInterface->load_custom_widget != NULL || pFile->pInterface->save_custom_widget != NULL);
+}
+
+static gboolean _cache_entry_is_valid (GKeyFile *pKeyFile, CDModuleFile *pFile)
+{
+	const gchar *cGroup = pFile->cSoFilePath;
+	if (! g_key_file_has_group (pKeyFile, cGroup))
+		return FALSE;
+	gchar *cMTime = g_key_file_get_string (pKeyFile, cGroup, "mtime", NULL);
+	gchar *cSize = g_key_file_get_string (pKeyFile, cGroup, "size", NULL);
+	gboolean bValid = (cMTime != NULL && cSize != NULL
+		&& g_ascii_strtoll (cMTime, NULL, 10) == pFile->iMTime
+		&& g_ascii_strtoll (cSize, NULL, 10) == pFile->iSize
+		&& g_key_file_has_key (pKeyFile, cGroup, "name", NULL)
+		&& g_key_file_has_key (pKeyFile, cGroup, "custom widgets", NULL));  // entries made before this key existed are refreshed.
+	g_free (cMTime);
+	g_free (cSize);
+	return bValid;
+}
+
+static GldiVisitCard *_visit_card_from_cache (GKeyFile *pKeyFile, const gchar *cGroup)
+{
+	GldiVisitCard *pVisitCard = g_new0 (GldiVisitCard, 1);
+	pVisitCard->cModuleName = _get_cached_string (pKeyFile, cGroup, "name");
+	pVisitCard->iMajorVersionNeeded = g_key_file_get_integer (pKeyFile, cGroup, "major", NULL);
+	pVisitCard->iMinorVersionNeeded = g_key_file_get_integer (pKeyFile, cGroup, "minor", NULL);
+	pVisitCard->iMicroVersionNeeded = g_key_file_get_integer (pKeyFile, cGroup, "micro", NULL);
+	pVisitCard->cPreviewFilePath = _get_cached_string (pKeyFile, cGroup, "preview");
+	pVisitCard->cGettextDomain = _get_cached_string (pKeyFile, cGroup, "gettext domain");
+	pVisitCard->cDockVersionOnCompilation = _get_cached_string (pKeyFile, cGroup, "dock version");
+	pVisitCard->cModuleVersion = _get_cached_string (pKeyFile, cGroup, "version");
+	pVisitCard->cUserDataDir = _get_cached_string (pKeyFile, cGroup, "user dir");
+	pVisitCard->cShareDataDir = _get_cached_string (pKeyFile, cGroup, "share dir");
+	pVisitCard->cConfFileName = _get_cached_string (pKeyFile, cGroup, "conf file");
+	pVisitCard->iCategory = g_key_file_get_integer (pKeyFile, cGroup, "category", NULL);
+	pVisitCard->cIconFilePath = _get_cached_string (pKeyFile, cGroup, "icon");
+	pVisitCard->iSizeOfConfig = g_key_file_get_integer (pKeyFile, cGroup, "size of config", NULL);
+	pVisitCard->iSizeOfData = g_key_file_get_integer (pKeyFile, cGroup, "size of data", NULL);
+	pVisitCard->bMultiInstance = g_key_file_get_boolean (pKeyFile, cGroup, "multi-instance", NULL);
+	pVisitCard->cDescription = _get_cached_string (pKeyFile, cGroup, "description");
+	pVisitCard->cAuthor = _get_cached_string (pKeyFile, cGroup, "author");
+	pVisitCard->cTitle = _get_cached_string (pKeyFile, cGroup, "title");
+	pVisitCard->iContainerType = g_key_file_get_integer (pKeyFile, cGroup, "container type", NULL);
+	pVisitCard->bStaticDeskletSize = g_key_file_get_boolean (pKeyFile, cGroup, "static desklet size", NULL);
+	pVisitCard->bAllowEmptyTitle = g_key_file_get_boolean (pKeyFile, cGroup, "allow empty title", NULL);
+	pVisitCard->bActAsLauncher = g_key_file_get_boolean (pKeyFile, cGroup, "act as launcher", NULL);
+	return pVisitCard;
+}
+
+// place-holders for the interface of a module whose library is not loaded yet; they make it look like a normal applet (not auto-loaded, can be stopped).
+static void _lazy_init_module (GldiModuleInstance *pInstance, G_GNUC_UNUSED GKeyFile *pKeyFile)
+{
+	cd_warning ("the library of the module '%s' has not been loaded", pInstance->pModule->pVisitCard->cModuleName);
+}
+static void _lazy_stop_module (G_GNUC_UNUSED GldiModuleInstance *pInstance)
+{
+}
+
+static GldiModule *_new_module_from_cache (GKeyFile *pKeyFile, CDModuleFile *pFile)
+{
+	GldiVisitCard *pVisitCard = _visit_card_from_cache (pKeyFile, pFile->cSoFilePath);
+	if (! _module_is_compatible (pVisitCard, pFile->cSoFilePath))
+	{
+		cairo_dock_free_visit_card (pVisitCard);
+		return NULL;
+	}
+	GldiModuleInterface *pInterface = g_new0 (GldiModuleInterface, 1);
+	pInterface->initModule = _lazy_init_module;
+	pInterface->stopModule = _lazy_stop_module;
+	
+	GldiModule *pModule = gldi_module_new (pVisitCard, pInterface);  // takes ownership of pVisitCard and pInterface
+	if (pModule)
+	{
+		pModule->cSoFilePath = g_strdup (pFile->cSoFilePath);
+		if (g_key_file_get_boolean (pKeyFile, pFile->cSoFilePath, "custom widgets", NULL))
+		{
+			if (s_hCustomWidgetsModules == NULL)
+				s_hCustomWidgetsModules = g_hash_table_new (g_direct_hash, g_direct_equal);
+			g_hash_table_insert (s_hCustomWidgetsModules, pModule, pModule);
+		}
+	}
+	return pModule;
+}
+
+gboolean gldi_module_has_custom_widgets (GldiModule *pModule)
+{
+	g_return_val_if_fail (pModule != NULL, FALSE);
+	if (pModule->handle == NULL && pModule->cSoFilePath != NULL)  // registered from the cache, its interface is not known yet.
+		return (s_hCustomWidgetsModules != NULL && g_hash_table_lookup (s_hCustomWidgetsModules, pModule) != NULL);
+	return (pModule->pInterface->load_custom_widget != NULL || pModule->pInterface->save_custom_widget != NULL);
+}
+
+gboolean gldi_module_load_interface (GldiModule *pModule)
+{
+	g_return_val_if_fail (pModule != NULL, FALSE);
+	if (pModule->handle != NULL || pModule->cSoFilePath == NULL)  // already loaded, or not provided by a library.
+		return TRUE;
+	cd_debug ("%s (%s)", __func__, pModule->cSoFilePath);
+	
+	CDModuleFile file;
+	memset (&file, 0, sizeof (CDModuleFile));
+	file.cSoFilePath = pModule->cSoFilePath;
+	_open_module_file (&file);
+	if (file.handle == NULL)
+		return FALSE;
+	
+	if (g_strcmp0 (file.pVisitCard->cModuleName, pModule->pVisitCard->cModuleName) != 0)  // the library has been replaced by another module in the meantime.
+	{
+		cd_warning ("the library '%s' doesn't provide the module '%s' any more", pModule->cSoFilePath, pModule->pVisitCard->cModuleName);
+		dlclose (file.handle);
+		cairo_dock_free_visit_card (file.pVisitCard);
+		g_free (file.pInterface);
+		return FALSE;
+	}
+	
+	// keep the visit card we already have (it's referenced by the modules table and possibly by the GUI), take the real interface.
+	cairo_dock_free_visit_card (file.pVisitCard);
+	g_free (pModule->pInterface);
+	pModule->pInterface = file.pInterface;
+	pModule->handle = file.handle;
+	return TRUE;
+}
+
 void gldi_modules_new_from_directory (const gchar *cModuleDirPath, GError **erreur)
 {
 	if (cModuleDirPath == NULL)
@@ -225,9 +567,17 @@ void gldi_modules_new_from_directory (const gchar *cModuleDirPath, GError **erre
 		g_propagate_error (erreur, tmp_erreur);
 		return ;
 	}
-
+	
+	//\_______________ read the cache while we list the folder.
+	_wait_modules_cache_written ();
+	GThread *pCacheReaderThread = _new_thread ("Cairo-Dock Modules Cache", (GThreadFunc) _load_modules_cache_threaded, NULL);
+	
+	//\_______________ list the libraries.
+	GPtrArray *pAllFiles = g_ptr_array_new ();
+	GHashTable *pPresentFiles = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+	CDModuleFile *pFile;
+	GStatBuf st;
 	const gchar *cFileName;
-	GString *sFilePath = g_string_new ("");
 	do
 	{
 		cFileName = g_dir_read_name (dir);
@@ -236,13 +586,89 @@ void gldi_modules_new_from_directory (const gchar *cModuleDirPath, GError **erre
 		
 		if (g_str_has_suffix (cFileName, ".so"))
 		{
-			g_string_printf (sFilePath, "%s/%s", cModuleDirPath, cFileName);
-			(void)gldi_module_new_from_so_file (sFilePath->str);
+			pFile = g_new0 (CDModuleFile, 1);
+			pFile->cSoFilePath = g_strdup_printf ("%s/%s", cModuleDirPath, cFileName);
+			if (g_stat (pFile->cSoFilePath, &st) == 0)
+			{
+				pFile->iMTime = st.st_mtime;
+				pFile->iSize = st.st_size;
+			}
+			g_hash_table_insert (pPresentFiles, g_strdup (pFile->cSoFilePath), GINT_TO_POINTER (1));
+			g_ptr_array_add (pAllFiles, pFile);
 		}
 	}
 	while (1);
-	g_string_free (sFilePath, TRUE);
 	g_dir_close (dir);
+	
+	GKeyFile *pCache = (pCacheReaderThread != NULL ? g_thread_join (pCacheReaderThread) : _load_modules_cache ());
+	gboolean bCacheChanged = FALSE;
+	
+	//\_______________ register right away the ones that are in the cache.
+	GPtrArray *pFiles = g_ptr_array_new ();  // libraries to open
+	int iNbCached = 0;
+	guint i;
+	for (i = 0; i < pAllFiles->len; i ++)
+	{
+		pFile = g_ptr_array_index (pAllFiles, i);
+		if (_cache_entry_is_valid (pCache, pFile))
+		{
+			(void)_new_module_from_cache (pCache, pFile);
+			iNbCached ++;
+			g_free (pFile->cSoFilePath);
+			g_free (pFile);
+		}
+		else
+		{
+			g_ptr_array_add (pFiles, pFile);
+		}
+	}
+	g_ptr_array_free (pAllFiles, TRUE);
+	
+	//\_______________ open the other ones (new or modified, auto-loaded or refused by their pre-init), register them in the order of the folder, and update the cache.
+	GldiModule *pModule;
+	for (i = 0; i < pFiles->len; i ++)
+	{
+		pFile = g_ptr_array_index (pFiles, i);
+		_open_module_file (pFile);
+		GldiVisitCard *pVisitCard = pFile->pVisitCard;
+		pModule = _register_module_file (pFile);
+		if (pModule != NULL && pModule->pVisitCard == pVisitCard && ! gldi_module_is_auto_loaded (pModule))  // a regular applet -> its visit card can be cached.
+		{
+			_cache_visit_card (pCache, pFile, pVisitCard);
+			bCacheChanged = TRUE;
+		}
+		else if (g_key_file_has_group (pCache, pFile->cSoFilePath))
+		{
+			g_key_file_remove_group (pCache, pFile->cSoFilePath, NULL);
+			bCacheChanged = TRUE;
+		}
+		g_free (pFile->cSoFilePath);
+		g_free (pFile);
+	}
+	
+	//\_______________ forget the libraries of this folder that have been removed.
+	gchar **pGroups = g_key_file_get_groups (pCache, NULL);
+	gchar *cDirPrefix = g_strdup_printf ("%s/", cModuleDirPath);
+	for (i = 0; pGroups[i] != NULL; i ++)
+	{
+		if (g_str_has_prefix (pGroups[i], cDirPrefix)
+		&& strchr (pGroups[i] + strlen (cDirPrefix), '/') == NULL
+		&& g_hash_table_lookup (pPresentFiles, pGroups[i]) == NULL)
+		{
+			g_key_file_remove_group (pCache, pGroups[i], NULL);
+			bCacheChanged = TRUE;
+		}
+	}
+	g_free (cDirPrefix);
+	g_strfreev (pGroups);
+	
+	cd_message ("  %d modules from the cache, %u libraries opened", iNbCached, pFiles->len);
+	if (bCacheChanged)
+		_save_modules_cache (pCache);
+	
+	g_hash_table_destroy (pPresentFiles);
+	g_ptr_array_free (pFiles, TRUE);
+	g_key_file_free (pCache);
 }
 
 gchar *gldi_module_get_config_dir (GldiModule *pModule)
@@ -256,11 +682,7 @@ gchar *gldi_module_get_config_dir (GldiModule *pModule)
 	{
 		cd_message ("directory %s doesn't exist, it will be added.", cUserDataDirPath);
 		
-		gchar *command = g_strdup_printf ("mkdir -p \"%s\"", cUserDataDirPath);
-		int r = system (command);
-		g_free (command);
-		
-		if (r != 0)
+		if (g_mkdir_with_parents (cUserDataDirPath, 7*8*8+7*8+5) != 0)
 		{
 			cd_warning ("couldn't create a directory for applet '%s' in '%s/plug-ins'\n check writing permissions", pVisitCard->cModuleName, g_cCurrentThemePath);
 			g_free (cUserDataDirPath);
@@ -294,6 +716,12 @@ void gldi_module_activate (GldiModule *module)
 		return ;
 	}
 	
+	if (! gldi_module_load_interface (module))  // the library may not have been opened yet (see the modules cache).
+	{
+		cd_warning ("Unable to load the module %s", module->pVisitCard->cModuleName);
+		return;
+	}
+	
 	if (module->pVisitCard->cConfFileName != NULL)  // the module has a conf file -> create an instance for each of them.
 	{
 		// check that the module's config dir exists or create it.
@@ -577,6 +1005,11 @@ static void init (void)
 		NULL);  // module
 }
 
+static void unload (void)
+{
+	_wait_modules_cache_written ();  // don't leave the writer thread behind.
+}
+
   ///////////////
  /// MANAGER ///
 ///////////////
@@ -629,8 +1062,11 @@ static void reset_object (GldiObject *obj)
 	gldi_object_notify (&myModuleObjectMgr, NOTIFICATION_MODULE_REGISTERED, pModule->pVisitCard->cModuleName, FALSE);
 	
 	// free data
+	if (s_hCustomWidgetsModules != NULL)
+		g_hash_table_remove (s_hCustomWidgetsModules, pModule);
 	if (pModule->handle)
 		dlclose (pModule->handle);
+	g_free (pModule->cSoFilePath);
 	g_free (pModule->pInterface);
 	cairo_dock_free_visit_card (pModule->pVisitCard);
 }
@@ -657,7 +1093,7 @@ void gldi_register_modules_manager (void)
 	// interface
 	myModulesMgr.init          = init;
 	myModulesMgr.load          = NULL;
-	myModulesMgr.unload        = NULL;
+	myModulesMgr.unload        = unload;
 	myModulesMgr.reload        = (GldiManagerReloadFunc)NULL;
 	myModulesMgr.get_config    = (GldiManagerGetConfigFunc)get_config;
 	myModulesMgr.reset_config  = (GldiManagerResetConfigFunc)reset_config;
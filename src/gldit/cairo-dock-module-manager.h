@@ -166,6 +166,8 @@ struct _GldiModule {
 	gpointer handle;
 	/// list of instances of the module.
 	GList *pInstancesList;
+	/// path to the library providing the module, or NULL if it's not provided by a library.
+	gchar *cSoFilePath;
 	gpointer reserved[2];
 };
 
@@ -214,6 +216,18 @@ GldiModule *gldi_module_new_from_so_file (const gchar *cSoFilePath);
 */
 void gldi_modules_new_from_directory (const gchar *cModuleDirPath, GError **erreur);
 
+/** Make sure the library of a module is loaded. Modules found in the visit cards cache are registered without opening their library, which is done when they're activated; call this function before using their interface on an inactive module.
+* @param pModule the module
+* @return TRUE if the interface of the module is available.
+*/
+gboolean gldi_module_load_interface (GldiModule *pModule);
+
+/** Say if a module has custom widgets in its config panel, without loading its library (the modules cache knows it).
+* @param pModule the module
+* @return TRUE if its interface has a load_custom_widget or save_custom_widget function.
+*/
+gboolean gldi_module_has_custom_widgets (GldiModule *pModule);
+
 /** Get the path to the folder containing the config files of a module (one file per instance). The folder is created if needed.
 * If the module is not configurable, or if the folder couldn't be created, NULL is returned.
 * @param pModule the module
@@ -22,6 +22,7 @@
 
 #include <glib.h>
 #include "cairo-dock-struct.h"
+#include "cairo-dock-profiler.h"  // gldi_profile_begin
 
 G_BEGIN_DECLS
 
@@ -163,7 +164,10 @@ void gldi_object_remove_notification (gpointer pObject, GldiNotificationType iNo
 	while (pElement != NULL && ! bStop) {\
 		pNotificationRecord = pElement->data;\
 		pNextElement = pElement->next;\
-		bStop = pNotificationRecord->pFunction (pNotificationRecord->pUserData, ##__VA_ARGS__);\
+		GldiNotificationFunc _pNotifFunc = pNotificationRecord->pFunction;  /* the record may be removed by the callback */\
+		gint64 _iNotifTime = gldi_profile_begin ();\
+		bStop = _pNotifFunc (pNotificationRecord->pUserData, ##__VA_ARGS__);\
+		gldi_profile_end (_iNotifTime, GLDI_PROFILE_NOTIFICATION, (gconstpointer)_pNotifFunc, NULL, NULL);\
 		pElement = pNextElement; }\
 	} while (0)
 
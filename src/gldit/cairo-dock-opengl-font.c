@@ -35,6 +35,27 @@
 extern GldiContainer *g_pPrimaryContainer;
 
 extern CairoDockGLConfig g_openglConfig;
+extern gboolean g_bEasterEggs;
+
+#define CD_GL_FONT_ATLAS_SIZE 512  // 512x512 is enough for a few hundreds of glyphs of a usual size.
+#define CD_GL_FONT_NB_CACHED_STRINGS 64
+#define CD_GL_FONT_VERTEX_BUFFER_SIZE (64 * 1024)  // 1024 glyphs, shared by all the texts of the font.
+
+typedef struct {
+	GLfloat u, v, du, dv;
+	gint iWidth, iHeight;  // 0 for a blank glyph.
+	gint iOffsetX, iOffsetY;  // position of the image from the origin of the glyph.
+	} CairoDockGLGlyph;
+
+typedef struct {
+	gchar *cText;
+	GList *pLink;  // link in the LRU queue.
+	GLfloat *pVertices;  // x,y,u,v
+	gint iNbVertices;
+	gint iWidth, iHeight;
+	gint iBufferOffset;  // where the vertices are in the vertex buffer of the font,
+	gint iBufferGeneration;  // if it's still the same buffer (0 = never uploaded).
+	} CairoDockGLShapedString;
 
 
 GLuint cairo_dock_create_texture_from_text_simple (const gchar *cText, const gchar *cFontDescription, cairo_t* pSourceContext, int *iWidth, int *iHeight)
@@ -50,29 +71,21 @@ GLuint cairo_dock_create_texture_from_text_simple (const gchar *cText, const gch
 	
 	pango_layout_set_text (pLayout, cText, -1);
 	
-	//\_________________ On cree une surface aux dimensions du texte.
+	//\_________________ On dessine le texte directement dans la future texture.
 	PangoRectangle log;
 	pango_layout_get_pixel_extents (pLayout, NULL, &log);
-	cairo_surface_t* pNewSurface = cairo_dock_create_blank_surface (
-		log.width,
-		log.height);
 	*iWidth = log.width;
 	*iHeight = log.height;
-	
-	//\_________________ On dessine le texte.
-	cairo_t* pCairoContext = cairo_create (pNewSurface);
+	cairo_t* pCairoContext = cairo_dock_begin_draw_new_texture (MAX (1, log.width), MAX (1, log.height));
 	cairo_translate (pCairoContext, -log.x, -log.y);
 	cairo_set_source_rgb (pCairoContext, 1., 1., 1.);
 	cairo_move_to (pCairoContext, 0, 0);
 	pango_cairo_show_layout (pCairoContext, pLayout);
-	cairo_destroy (pCairoContext);
 	
 	g_object_unref (pLayout);
 	
 	//\_________________ On cree la texture.
-	GLuint iTexture = cairo_dock_create_texture_from_surface (pNewSurface);
-	cairo_surface_destroy (pNewSurface);
-	return iTexture;
+	return cairo_dock_end_draw_new_texture (pCairoContext, g_bEasterEggs ? GLDI_TEXTURE_MIPMAPS : 0);
 }
 
 
@@ -254,10 +267,353 @@ CairoDockGLFont *cairo_dock_load_textured_font_from_image (const gchar *cImagePa
 	return pFont;
 }
 
+
+  //////////////////
+ /// GLYPH ATLAS ///
+//////////////////
+
+static PangoLayout *_create_atlas_layout (const gchar *cFontDescription, cairo_surface_t **pSurface, cairo_t **pCairoContext)
+{
+	*pSurface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, 1, 1);
+	*pCairoContext = cairo_create (*pSurface);
+	PangoLayout *pLayout = pango_cairo_create_layout (*pCairoContext);
+	
+	PangoFontDescription *fd = pango_font_description_from_string (cFontDescription);
+	pango_layout_set_font_description (pLayout, fd);
+	pango_font_description_free (fd);
+	return pLayout;
+}
+
+static void _free_shaped_string (CairoDockGLShapedString *pString)
+{
+	g_free (pString->pVertices);
+	g_free (pString->cText);
+	g_free (pString);
+}
+
+static void _reset_glyph_atlas (CairoDockGLFont *pFont)
+{
+	// the glyphs' places change, so all the cached strings become invalid.
+	g_hash_table_remove_all (pFont->pShapedStrings);
+	g_queue_clear (pFont->pShapedStringsQueue);
+	g_hash_table_remove_all (pFont->pGlyphs);
+	pFont->iAtlasX = 0;
+	pFont->iAtlasY = 0;
+	pFont->iAtlasRowHeight = 0;
+	pFont->iAtlasGeneration ++;
+}
+
+static void _create_atlas_texture (CairoDockGLFont *pFont)
+{
+	int n = pFont->iAtlasSize;
+	guchar *pBlank = g_new0 (guchar, 4 * n * n);  // the glyphs are not contiguous, so the gaps must be transparent.
+	glGenTextures (1, &pFont->iTexture);
+	glBindTexture (GL_TEXTURE_2D, pFont->iTexture);
+	glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexImage2D (GL_TEXTURE_2D, 0, 4, n, n, 0, GL_BGRA, GL_UNSIGNED_BYTE, pBlank);
+	g_free (pBlank);
+}
+
+static CairoDockGLGlyph *_get_glyph (CairoDockGLFont *pFont, PangoFont *pPangoFont, PangoGlyph iGlyphIndex)
+{
+	// the glyphs are those of the shaped text, so they are indexed by font (the text can fall back on other fonts) and by glyph index.
+	GHashTable *pFontGlyphs = g_hash_table_lookup (pFont->pGlyphs, pPangoFont);
+	CairoDockGLGlyph *pGlyph = (pFontGlyphs ? g_hash_table_lookup (pFontGlyphs, GUINT_TO_POINTER (iGlyphIndex)) : NULL);
+	if (pGlyph != NULL)
+		return pGlyph;
+	
+	//\_________________ On mesure le glyphe (1 pixel de marge de chaque cote pour l'antialiasing).
+	PangoRectangle ink;
+	pango_font_get_glyph_extents (pPangoFont, iGlyphIndex, &ink, NULL);
+	pango_extents_to_pixels (&ink, NULL);
+	pGlyph = g_new0 (CairoDockGLGlyph, 1);
+	if (ink.width > 0 && ink.height > 0)  // else it's a blank (space, etc), there is nothing to draw.
+	{
+		int w = ink.width + 2, h = ink.height + 2;
+		
+		//\_________________ On lui trouve une place dans l'atlas (on laisse 1 pixel entre 2 glyphes pour eviter qu'ils ne bavent l'un sur l'autre).
+		if (w + 1 > pFont->iAtlasSize || h + 1 > pFont->iAtlasSize)
+		{
+			cd_warning ("the glyph %u is too big for the atlas", iGlyphIndex);
+			g_free (pGlyph);
+			return NULL;
+		}
+		if (pFont->iAtlasX + w + 1 > pFont->iAtlasSize)  // next row
+		{
+			pFont->iAtlasX = 0;
+			pFont->iAtlasY += pFont->iAtlasRowHeight + 1;
+			pFont->iAtlasRowHeight = 0;
+		}
+		if (pFont->iAtlasY + h + 1 > pFont->iAtlasSize)  // the atlas is full, start again from scratch.
+		{
+			cd_debug ("the glyph atlas of '%s' is full, it is emptied", pFont->cFontDescription);
+			_reset_glyph_atlas (pFont);
+			pFontGlyphs = NULL;  // destroyed with the atlas.
+		}
+		
+		//\_________________ On dessine le glyphe et on le place dans l'atlas.
+		cairo_surface_t *pSurface = cairo_dock_create_blank_surface (w, h);
+		cairo_t *pCairoContext = cairo_create (pSurface);
+		cairo_translate (pCairoContext, 1 - ink.x, 1 - ink.y);
+		cairo_set_source_rgb (pCairoContext, 1., 1., 1.);
+		cairo_move_to (pCairoContext, 0, 0);  // origin of the glyph, on the baseline.
+		PangoGlyphString *pGlyphString = pango_glyph_string_new ();
+		pango_glyph_string_set_size (pGlyphString, 1);
+		memset (&pGlyphString->glyphs[0], 0, sizeof (PangoGlyphInfo));
+		pGlyphString->glyphs[0].glyph = iGlyphIndex;
+		pango_cairo_show_glyph_string (pCairoContext, pPangoFont, pGlyphString);
+		pango_glyph_string_free (pGlyphString);
+		cairo_destroy (pCairoContext);
+		cairo_surface_flush (pSurface);
+		
+		if (pFont->iTexture == 0)
+			_create_atlas_texture (pFont);
+		glBindTexture (GL_TEXTURE_2D, pFont->iTexture);
+		glPixelStorei (GL_UNPACK_ROW_LENGTH, cairo_image_surface_get_stride (pSurface) / 4);
+		glTexSubImage2D (GL_TEXTURE_2D, 0,
+			pFont->iAtlasX, pFont->iAtlasY,
+			w, h,
+			GL_BGRA, GL_UNSIGNED_BYTE,
+			cairo_image_surface_get_data (pSurface));
+		glPixelStorei (GL_UNPACK_ROW_LENGTH, 0);
+		cairo_surface_destroy (pSurface);
+		
+		pGlyph->u = (GLfloat) pFont->iAtlasX / pFont->iAtlasSize;
+		pGlyph->v = (GLfloat) pFont->iAtlasY / pFont->iAtlasSize;
+		pGlyph->du = (GLfloat) w / pFont->iAtlasSize;
+		pGlyph->dv = (GLfloat) h / pFont->iAtlasSize;
+		pGlyph->iWidth = w;
+		pGlyph->iHeight = h;
+		pGlyph->iOffsetX = ink.x - 1;
+		pGlyph->iOffsetY = ink.y - 1;
+		
+		pFont->iAtlasX += w + 1;
+		pFont->iAtlasRowHeight = MAX (pFont->iAtlasRowHeight, h);
+	}
+	
+	if (pFontGlyphs == NULL)
+	{
+		pFontGlyphs = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
+		g_hash_table_insert (pFont->pGlyphs, g_object_ref (pPangoFont), pFontGlyphs);
+	}
+	g_hash_table_insert (pFontGlyphs, GUINT_TO_POINTER (iGlyphIndex), pGlyph);
+	return pGlyph;
+}
+
+static inline void _set_vertex (GLfloat *pVertex, GLfloat x, GLfloat y, GLfloat u, GLfloat v)
+{
+	pVertex[0] = x;
+	pVertex[1] = y;
+	pVertex[2] = u;
+	pVertex[3] = v;
+}
+
+static CairoDockGLShapedString *_shape_string (CairoDockGLFont *pFont, const gchar *cText)
+{
+	//\_________________ On cherche dans le cache.
+	CairoDockGLShapedString *pString = g_hash_table_lookup (pFont->pShapedStrings, cText);
+	if (pString != NULL)
+	{
+		pFont->iNbCacheHits ++;
+		g_queue_unlink (pFont->pShapedStringsQueue, pString->pLink);
+		g_queue_push_head_link (pFont->pShapedStringsQueue, pString->pLink);
+		return pString;
+	}
+	pFont->iNbCacheMisses ++;
+	
+	if (! g_utf8_validate (cText, -1, NULL))
+	{
+		cd_warning ("invalid UTF-8 text: '%s'", cText);
+		return NULL;
+	}
+	
+	//\_________________ On laisse Pango mettre en forme le texte (crenage, ligatures, ecritures complexes, bidi), on n'en garde que la position des glyphes.
+	cairo_surface_t *pDummySurface;
+	cairo_t *pDummyContext;
+	PangoLayout *pLayout = _create_atlas_layout (pFont->cFontDescription, &pDummySurface, &pDummyContext);
+	pango_layout_set_text (pLayout, cText, -1);
+	PangoRectangle log;
+	pango_layout_get_pixel_extents (pLayout, NULL, &log);
+	int iWidth = log.width, iHeight = log.height;
+	
+	int iNbGlyphs = 0;
+	GSList *l, *r;
+	for (l = pango_layout_get_lines_readonly (pLayout); l != NULL; l = l->next)
+	{
+		for (r = ((PangoLayoutLine*)l->data)->runs; r != NULL; r = r->next)
+			iNbGlyphs += ((PangoGlyphItem*)r->data)->glyphs->num_glyphs;
+	}
+	
+	//\_________________ On place tous les glyphes dans un seul tableau de quads, la 1ere ligne en haut.
+	GLfloat *pVertices = g_new (GLfloat, 4 * 4 * MAX (1, iNbGlyphs));
+	int iNbVertices, iGeneration, iNbTries = 0, i, xpos, iBaseline;
+	GLfloat x, y;
+	PangoLayoutIter *pIter;
+	PangoLayoutRun *pRun;
+	PangoGlyphInfo *pInfo;
+	PangoRectangle run;
+	CairoDockGLGlyph *pGlyph;
+	do  // if the atlas gets emptied while we add the glyphs, the first ones are not valid any more, so we start again.
+	{
+		iGeneration = pFont->iAtlasGeneration;
+		iNbVertices = 0;
+		pIter = pango_layout_get_iter (pLayout);
+		do
+		{
+			pRun = pango_layout_iter_get_run_readonly (pIter);
+			if (pRun == NULL)  // end of a line.
+				continue;
+			pango_layout_iter_get_run_extents (pIter, NULL, &run);
+			iBaseline = pango_layout_iter_get_baseline (pIter);
+			xpos = run.x;
+			for (i = 0; i < pRun->glyphs->num_glyphs; i ++)  // the glyphs of a run are in visual order.
+			{
+				pInfo = &pRun->glyphs->glyphs[i];
+				pGlyph = (pInfo->glyph != PANGO_GLYPH_EMPTY ? _get_glyph (pFont, pRun->item->analysis.font, pInfo->glyph) : NULL);
+				if (pGlyph != NULL && pGlyph->iWidth != 0)
+				{
+					x = PANGO_PIXELS (xpos + pInfo->geometry.x_offset) + pGlyph->iOffsetX - log.x;
+					y = iHeight - (PANGO_PIXELS (iBaseline + pInfo->geometry.y_offset) + pGlyph->iOffsetY - log.y);  // Pango goes down, we go up.
+					GLfloat *v = &pVertices[4*iNbVertices];
+					_set_vertex (v,    x,                  y,                   pGlyph->u,              pGlyph->v);
+					_set_vertex (v+4,  x + pGlyph->iWidth, y,                   pGlyph->u + pGlyph->du, pGlyph->v);
+					_set_vertex (v+8,  x + pGlyph->iWidth, y - pGlyph->iHeight, pGlyph->u + pGlyph->du, pGlyph->v + pGlyph->dv);
+					_set_vertex (v+12, x,                  y - pGlyph->iHeight, pGlyph->u,              pGlyph->v + pGlyph->dv);
+					iNbVertices += 4;
+				}
+				xpos += pInfo->geometry.width;
+			}
+		} while (pango_layout_iter_next_run (pIter));
+		pango_layout_iter_free (pIter);
+		iNbTries ++;
+	} while (iGeneration != pFont->iAtlasGeneration && iNbTries < 2);  // a text with more glyphs than an empty atlas can hold would loop forever.
+	
+	g_object_unref (pLayout);
+	cairo_destroy (pDummyContext);
+	cairo_surface_destroy (pDummySurface);
+	
+	pString = g_new0 (CairoDockGLShapedString, 1);
+	pString->cText = g_strdup (cText);
+	pString->pVertices = pVertices;
+	pString->iNbVertices = iNbVertices;
+	pString->iWidth = iWidth;
+	pString->iHeight = iHeight;
+	
+	//\_________________ On l'insere dans le cache, en oubliant le texte le moins recemment utilise.
+	g_queue_push_head (pFont->pShapedStringsQueue, pString);
+	pString->pLink = g_queue_peek_head_link (pFont->pShapedStringsQueue);
+	g_hash_table_insert (pFont->pShapedStrings, pString->cText, pString);
+	if (g_queue_get_length (pFont->pShapedStringsQueue) > CD_GL_FONT_NB_CACHED_STRINGS)
+	{
+		CairoDockGLShapedString *pOldString = g_queue_pop_tail (pFont->pShapedStringsQueue);
+		g_hash_table_remove (pFont->pShapedStrings, pOldString->cText);  // frees it.
+	}
+	return pString;
+}
+
+static gboolean _stream_shaped_string (CairoDockGLFont *pFont, CairoDockGLShapedString *pString)  // leaves the vertex buffer bound if TRUE.
+{
+	int iSize = 4 * pString->iNbVertices * sizeof (GLfloat);
+	if (! g_openglConfig.bVertexBufferAvailable || iSize > CD_GL_FONT_VERTEX_BUFFER_SIZE)
+		return FALSE;
+	if (pFont->iVertexBuffer == 0)
+	{
+		glGenBuffers (1, &pFont->iVertexBuffer);
+		glBindBuffer (GL_ARRAY_BUFFER, pFont->iVertexBuffer);
+		glBufferData (GL_ARRAY_BUFFER, CD_GL_FONT_VERTEX_BUFFER_SIZE, NULL, GL_STREAM_DRAW);
+		pFont->iVertexBufferOffset = 0;
+		pFont->iVertexBufferGeneration = 1;
+	}
+	else
+		glBindBuffer (GL_ARRAY_BUFFER, pFont->iVertexBuffer);
+	
+	if (pString->iBufferGeneration == pFont->iVertexBufferGeneration)  // still in the buffer since the last time.
+		return TRUE;
+	if (pFont->iVertexBufferOffset + iSize > CD_GL_FONT_VERTEX_BUFFER_SIZE)  // full -> orphan it: the driver gives us a new storage, and the draws still pending keep the old one.
+	{
+		glBufferData (GL_ARRAY_BUFFER, CD_GL_FONT_VERTEX_BUFFER_SIZE, NULL, GL_STREAM_DRAW);
+		pFont->iVertexBufferOffset = 0;
+		pFont->iVertexBufferGeneration ++;
+	}
+	glBufferSubData (GL_ARRAY_BUFFER, pFont->iVertexBufferOffset, iSize, pString->pVertices);
+	pString->iBufferOffset = pFont->iVertexBufferOffset;
+	pString->iBufferGeneration = pFont->iVertexBufferGeneration;
+	pFont->iVertexBufferOffset += iSize;
+	return TRUE;
+}
+
+static void _draw_shaped_string (CairoDockGLFont *pFont, CairoDockGLShapedString *pString)
+{
+	if (pString->iNbVertices == 0 || pFont->iTexture == 0)
+		return;
+	_cairo_dock_enable_texture ();
+	_cairo_dock_set_blend_pbuffer ();  // rend mieux pour les textes
+	glBindTexture (GL_TEXTURE_2D, pFont->iTexture);
+	
+	glEnableClientState (GL_VERTEX_ARRAY);
+	glEnableClientState (GL_TEXTURE_COORD_ARRAY);
+	gboolean bStreamed = _stream_shaped_string (pFont, pString);
+	if (bStreamed)
+	{
+		glVertexPointer (2, GL_FLOAT, 4 * sizeof (GLfloat), (GLvoid*) (gintptr) pString->iBufferOffset);
+		glTexCoordPointer (2, GL_FLOAT, 4 * sizeof (GLfloat), (GLvoid*) (gintptr) (pString->iBufferOffset + 2 * sizeof (GLfloat)));
+	}
+	else
+	{
+		glVertexPointer (2, GL_FLOAT, 4 * sizeof (GLfloat), pString->pVertices);
+		glTexCoordPointer (2, GL_FLOAT, 4 * sizeof (GLfloat), pString->pVertices + 2);
+	}
+	glDrawArrays (GL_QUADS, 0, pString->iNbVertices);
+	if (bStreamed)
+		glBindBuffer (GL_ARRAY_BUFFER, 0);
+	glDisableClientState (GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState (GL_VERTEX_ARRAY);
+	
+	_cairo_dock_disable_texture ();
+}
+
+CairoDockGLFont *cairo_dock_load_glyph_atlas_font (const gchar *cFontDescription)
+{
+	g_return_val_if_fail (cFontDescription != NULL, NULL);
+	
+	CairoDockGLFont *pFont = g_new0 (CairoDockGLFont, 1);
+	pFont->cFontDescription = g_strdup (cFontDescription);
+	pFont->iAtlasSize = CD_GL_FONT_ATLAS_SIZE;
+	pFont->pGlyphs = g_hash_table_new_full (g_direct_hash, g_direct_equal, g_object_unref, (GDestroyNotify) g_hash_table_destroy);
+	pFont->pShapedStrings = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, (GDestroyNotify) _free_shaped_string);
+	pFont->pShapedStringsQueue = g_queue_new ();
+	
+	// the texture is created when the first glyph is drawn, so that we are sure to be inside an opengl context.
+	cairo_surface_t *pDummySurface;
+	cairo_t *pDummyContext;
+	PangoLayout *pLayout = _create_atlas_layout (cFontDescription, &pDummySurface, &pDummyContext);
+	pango_layout_set_text (pLayout, "0", -1);
+	PangoRectangle log;
+	pango_layout_get_pixel_extents (pLayout, NULL, &log);
+	pFont->iCharWidth = log.width;
+	pFont->iCharHeight = log.height;
+	g_object_unref (pLayout);
+	cairo_destroy (pDummyContext);
+	cairo_surface_destroy (pDummySurface);
+	
+	return pFont;
+}
+
 void cairo_dock_free_gl_font (CairoDockGLFont *pFont)
 {
 	if (pFont == NULL)
 		return ;
+	if (pFont->pGlyphs != NULL)
+	{
+		cd_debug ("font '%s': %d faces, %u/%u cached texts", pFont->cFontDescription, g_hash_table_size (pFont->pGlyphs), pFont->iNbCacheHits, pFont->iNbCacheHits + pFont->iNbCacheMisses);
+		g_queue_free (pFont->pShapedStringsQueue);
+		g_hash_table_destroy (pFont->pShapedStrings);
+		g_hash_table_destroy (pFont->pGlyphs);
+		g_free (pFont->cFontDescription);
+	}
+	if (pFont->iVertexBuffer != 0)
+		glDeleteBuffers (1, &pFont->iVertexBuffer);
 	if (pFont->iListBase != 0)
 		glDeleteLists (pFont->iListBase, pFont->iNbChars);
 	if (pFont->iTexture != 0)
@@ -274,6 +630,13 @@ void cairo_dock_get_gl_text_extent (const gchar *cText, CairoDockGLFont *pFont,
 		*iHeight = 0;
 		return ;
 	}
+	if (pFont->pGlyphs != NULL)
+	{
+		CairoDockGLShapedString *pString = _shape_string (pFont, cText);
+		*iWidth = (pString ? pString->iWidth : 0);
+		*iHeight = (pString ? pString->iHeight : 0);
+		return ;
+	}
 	int i, w=0, wmax=0, h=pFont->iCharHeight;
 	for (i = 0; cText[i] != '\0'; i ++)
 	{
@@ -295,7 +658,13 @@ void cairo_dock_get_gl_text_extent (const gchar *cText, CairoDockGLFont *pFont,
 void cairo_dock_draw_gl_text (const guchar *cText, CairoDockGLFont *pFont)
 {
 	int n = strlen ((char *) cText);
-	if (pFont->iListBase != 0)
+	if (pFont->pGlyphs != NULL)
+	{
+		CairoDockGLShapedString *pString = _shape_string (pFont, (const gchar *) cText);
+		if (pString != NULL)
+			_draw_shaped_string (pFont, pString);
+	}
+	else if (pFont->iListBase != 0)
 	{
 		if (pFont->iCharBase == 0 && strchr ((char *) cText, '\n') == NULL)  // version optimisee ou on a charge tous les caracteres.
 		{
@@ -34,6 +34,7 @@ G_BEGIN_DECLS
 * \ref cairo_dock_create_texture_from_text_simple lets you draw any text in any font, by creating a texture from a Pango font description. This is a convenient function but not very fast.
 * For a more efficient way, you load a font into a CairoDockGLFont with either :
 * \ref cairo_dock_load_textured_font to load a subset of a Mono font into textures.
+* \ref cairo_dock_load_glyph_atlas_font to load any font, with any UTF-8 character.
 * You then use \ref cairo_dock_draw_gl_text_at_position to draw the text.
 */
 
@@ -57,6 +58,18 @@ struct _CairoDockGLFont {
 	gint iNbChars;
 	gdouble iCharWidth;
 	gdouble iCharHeight;
+	// glyph atlas.
+	gchar *cFontDescription;
+	GHashTable *pGlyphs;  // Pango font -> (glyph index -> glyph in the atlas texture), rendered on demand.
+	gint iAtlasSize;
+	gint iAtlasX, iAtlasY, iAtlasRowHeight;  // where the next glyph will be placed.
+	gint iAtlasGeneration;  // incremented each time the atlas is full and is emptied.
+	GHashTable *pShapedStrings;  // text -> vertices of the text, for the last drawn texts.
+	GQueue *pShapedStringsQueue;  // same texts, most recently used first.
+	guint iNbCacheHits, iNbCacheMisses;
+	GLuint iVertexBuffer;  // the vertices of the texts are streamed into it.
+	gint iVertexBufferOffset;  // where the next text will be written.
+	gint iVertexBufferGeneration;  // incremented each time the buffer is full and is orphaned.
 };
 
 /* Load a font into bitmaps. You can load any characters of font with this function. The drawback is that each character is a bitmap, that is to say you can't zoom them.
@@ -81,6 +94,12 @@ CairoDockGLFont *cairo_dock_load_textured_font (const gchar *cFontDescription, i
 */
 CairoDockGLFont *cairo_dock_load_textured_font_from_image (const gchar *cImagePath);
 
+/** Load a font into a glyph atlas: glyphs are rendered into a texture the first time they are drawn, so any UTF-8 text can be drawn. A text is laid out by Pango (kerning, ligatures, complex scripts) into a single vertex array, streamed into a vertex buffer shared by all the texts of the font and drawn in one call, and the last drawn texts are cached, which makes it suitable for texts that are redrawn often, like values or quick-info.
+*@param cFontDescription a description of the font, for instance "Monospace Bold 12"
+*@return a newly allocated opengl font.
+*/
+CairoDockGLFont *cairo_dock_load_glyph_atlas_font (const gchar *cFontDescription);
+
 /** Free an opengl font.
 *@param pFont the font.
 */
@@ -209,6 +209,45 @@ static void _apply_desktop_background (GldiContainer *pContainer)
 	glPopMatrix ();
 }
 
+static GdkRectangle *_get_repaint_area (GldiContainer *pContainer, GdkRectangle *pArea)
+{
+	GdkRectangle full = {0, 0, pContainer->iWidth, pContainer->iHeight};
+	if (! pContainer->bIsHorizontal)
+	{
+		full.width = pContainer->iHeight;
+		full.height = pContainer->iWidth;
+	}
+	
+	//\_________________ add the damage accumulated since the last frame.
+	GldiContainerRepaint *pRepaint = pContainer->pRepaint;
+	GdkRectangle *pDamage = &pRepaint->damageArea;
+	if (pArea != NULL && pDamage->width > 0 && pDamage->height > 0)
+		gdk_rectangle_union (pArea, pDamage, pArea);
+	pDamage->width = pDamage->height = 0;
+	
+	//\_________________ the back buffer may be several frames old, so add what has been repainted since then.
+	if (pArea != NULL)
+	{
+		int iAge = (s_backend.container_get_buffer_age ? s_backend.container_get_buffer_age (pContainer) : 1);  // without buffer-age, we consider that the back buffer is preserved, as we always did.
+		if (iAge <= 0 || iAge > GLDI_CONTAINER_REPAINT_HISTORY + 1)  // undefined content, repaint everything.
+			pArea = NULL;
+		else
+		{
+			int i;
+			for (i = 1; i < iAge; i ++)
+				gdk_rectangle_union (pArea, &pRepaint->pRepaintHistory[(pRepaint->iRepaintHistoryIndex - i + GLDI_CONTAINER_REPAINT_HISTORY) % GLDI_CONTAINER_REPAINT_HISTORY], pArea);
+			if (! gdk_rectangle_intersect (pArea, &full, pArea))
+				pArea->width = pArea->height = 0;
+		}
+	}
+	
+	//\_________________ remember it for the next frames.
+	pRepaint->repaintArea = (pArea != NULL ? *pArea : full);
+	pRepaint->pRepaintHistory[pRepaint->iRepaintHistoryIndex] = pRepaint->repaintArea;
+	pRepaint->iRepaintHistoryIndex = (pRepaint->iRepaintHistoryIndex + 1) % GLDI_CONTAINER_REPAINT_HISTORY;
+	return pArea;
+}
+
 gboolean gldi_gl_container_begin_draw_full (GldiContainer *pContainer, GdkRectangle *pArea, gboolean bClear)
 {
 	if (! gldi_gl_container_make_current (pContainer))
@@ -216,6 +255,13 @@ gboolean gldi_gl_container_begin_draw_full (GldiContainer *pContainer, GdkRectan
 	
 	glLoadIdentity ();
 	
+	GdkRectangle area;
+	if (pArea != NULL)
+	{
+		area = *pArea;
+		pArea = &area;
+	}
+	pArea = _get_repaint_area (pContainer, pArea);
 	if (pArea != NULL)
 	{
 		glEnable (GL_SCISSOR_TEST);  // ou comment diviser par 4 l'occupation CPU !
@@ -264,9 +310,7 @@ static void _init_opengl_context (G_GNUC_UNUSED GtkWidget* pWidget, GldiContaine
 	glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 	glTexParameteri (GL_TEXTURE_2D,
 		GL_TEXTURE_MIN_FILTER,
-		g_bEasterEggs ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
-	if (g_bEasterEggs)
-		glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
+		GL_LINEAR);  // the textures that have mipmaps set it themselves.
 	glTexParameteri (GL_TEXTURE_2D,
 		GL_TEXTURE_MAG_FILTER,
 		GL_LINEAR);
@@ -308,6 +352,10 @@ static void _post_initialize_opengl_backend (G_GNUC_UNUSED GtkWidget *pWidget, G
 	
 	g_openglConfig.bNonPowerOfTwoAvailable = _check_gl_extension ("GL_ARB_texture_non_power_of_two");
 	g_openglConfig.bAccumBufferAvailable = _check_gl_extension ("GL_SUN_slice_accum");
+	g_openglConfig.bVertexBufferAvailable = _check_gl_extension ("GL_ARB_vertex_buffer_object");
+	g_openglConfig.bPixelBufferAvailable = _check_gl_extension ("GL_ARB_pixel_buffer_object");
+	g_openglConfig.bTextureStorageAvailable = _check_gl_extension ("GL_ARB_texture_storage");
+	g_openglConfig.bTextureCompressionAvailable = _check_gl_extension ("GL_EXT_texture_compression_s3tc");
 	
 	GLfloat fMaximumAnistropy = 0.;
 	if (_check_gl_extension ("GL_EXT_texture_filter_anisotropic"))
@@ -320,12 +368,16 @@ static void _post_initialize_opengl_backend (G_GNUC_UNUSED GtkWidget *pWidget, G
 	const gchar *cVendor   = (const gchar *) glGetString (GL_VENDOR);
 	const gchar *cRenderer = (const gchar *) glGetString (GL_RENDERER);
 
-	cd_message ("OpenGL config summary :\n - bNonPowerOfTwoAvailable : %d\n - bFboAvailable : %d\n - direct rendering : %d\n - bTextureFromPixmapAvailable : %d\n - bAccumBufferAvailable : %d\n - Anisotroy filtering level max : %.1f\n - OpenGL version: %s\n - OpenGL vendor: %s\n - OpenGL renderer: %s\n\n",
+	cd_message ("OpenGL config summary :\n - bNonPowerOfTwoAvailable : %d\n - bFboAvailable : %d\n - direct rendering : %d\n - bTextureFromPixmapAvailable : %d\n - bAccumBufferAvailable : %d\n - bVertexBufferAvailable : %d\n - bPixelBufferAvailable : %d\n - bTextureStorageAvailable : %d\n - bTextureCompressionAvailable : %d\n - Anisotroy filtering level max : %.1f\n - OpenGL version: %s\n - OpenGL vendor: %s\n - OpenGL renderer: %s\n\n",
 		g_openglConfig.bNonPowerOfTwoAvailable,
 		g_openglConfig.bFboAvailable,
 		!g_openglConfig.bIndirectRendering,
 		g_openglConfig.bTextureFromPixmapAvailable,
 		g_openglConfig.bAccumBufferAvailable,
+		g_openglConfig.bVertexBufferAvailable,
+		g_openglConfig.bPixelBufferAvailable,
+		g_openglConfig.bTextureStorageAvailable,
+		g_openglConfig.bTextureCompressionAvailable,
 		fMaximumAnistropy,
 		cVersion,
 		cVendor,
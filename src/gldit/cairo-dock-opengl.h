@@ -41,6 +41,10 @@ struct _CairoDockGLConfig {
 	gboolean bFboAvailable;
 	gboolean bNonPowerOfTwoAvailable;
 	gboolean bTextureFromPixmapAvailable;
+	gboolean bVertexBufferAvailable;
+	gboolean bPixelBufferAvailable;  // uploads can be streamed through a PBO
+	gboolean bTextureStorageAvailable;  // immutable textures (glTexStorage2D)
+	gboolean bTextureCompressionAvailable;  // S3TC compressed textures
 	#ifdef HAVE_GLX
 	void (*bindTexImage) (Display *display, GLXDrawable drawable, int buffer, int *attribList);  // texture from pixmap
 	void (*releaseTexImage) (Display *display, GLXDrawable drawable, int buffer);  // texture from pixmap
@@ -57,6 +61,7 @@ struct _GldiGLManagerBackend {
 	void (*container_end_draw) (GldiContainer *pContainer);
 	void (*container_init) (GldiContainer *pContainer);
 	void (*container_finish) (GldiContainer *pContainer);
+	gint (*container_get_buffer_age) (GldiContainer *pContainer);  // number of frames since the back buffer was drawn, or 0 if its content is undefined.
 };
 	
 
@@ -90,6 +95,7 @@ void gldi_gl_backend_force_indirect_rendering (void);
 gboolean gldi_gl_container_make_current (GldiContainer *pContainer);
 
 /** Start drawing on a Container's OpenGL context.
+The area is enlarged with the damage accumulated since the last frame and, depending on the age of the back buffer, with the areas repainted at the previous frames; the resulting area is stored in the Container's pRepaint->repaintArea, so that the renderer can skip what is outside.
 *@param pContainer the container
 *@param pArea optional area to clip the drawing (NULL to draw on the whole Container)
 *@param bClear whether to clear the color buffer or not
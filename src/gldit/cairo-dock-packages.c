@@ -122,10 +122,56 @@ gchar *cairo_dock_uncompress_file (const gchar *cArchivePath, const gchar *cExtr
 	return cResultPath;
 }
 
+// all the transfers share the same DNS cache, SSL sessions and connections (keep-alive), so that listing the packages, then getting their readme, their preview and their archive doesn't open a new connection each time.
+static CURLSH *s_pCurlShare = NULL;
+static GMutex *s_pCurlShareMutex[CURL_LOCK_DATA_LAST];
+
+static void _lock_curl_share (G_GNUC_UNUSED CURL *handle, curl_lock_data data, G_GNUC_UNUSED curl_lock_access access, G_GNUC_UNUSED void *userptr)
+{
+	g_mutex_lock (s_pCurlShareMutex[data]);
+}
+static void _unlock_curl_share (G_GNUC_UNUSED CURL *handle, curl_lock_data data, G_GNUC_UNUSED void *userptr)
+{
+	g_mutex_unlock (s_pCurlShareMutex[data]);
+}
+static CURLSH *_get_curl_share (void)
+{
+	static gsize s_bShareInit = 0;
+	if (g_once_init_enter (&s_bShareInit))  // the transfers are made from the Tasks' threads.
+	{
+		int i;
+		for (i = 0; i < CURL_LOCK_DATA_LAST; i ++)
+		{
+			#ifndef GLIB_VERSION_2_32
+			s_pCurlShareMutex[i] = g_mutex_new ();
+			#else
+			s_pCurlShareMutex[i] = g_new (GMutex, 1);
+			g_mutex_init (s_pCurlShareMutex[i]);
+			#endif
+		}
+		s_pCurlShare = curl_share_init ();
+		if (s_pCurlShare != NULL)
+		{
+			curl_share_setopt (s_pCurlShare, CURLSHOPT_LOCKFUNC, _lock_curl_share);
+			curl_share_setopt (s_pCurlShare, CURLSHOPT_UNLOCKFUNC, _unlock_curl_share);
+			curl_share_setopt (s_pCurlShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+			curl_share_setopt (s_pCurlShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+			#if LIBCURL_VERSION_NUM >= 0x073900  // connections can be shared from libcurl 7.57
+			curl_share_setopt (s_pCurlShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+			#endif
+		}
+		g_once_init_leave (&s_bShareInit, 1);
+	}
+	return s_pCurlShare;
+}
+
 static inline CURL *_init_curl_connection (const gchar *cURL)
 {
 	CURL *handle = curl_easy_init ();
 	curl_easy_setopt (handle, CURLOPT_URL, cURL);
+	CURLSH *pShare = _get_curl_share ();
+	if (pShare != NULL)
+		curl_easy_setopt (handle, CURLOPT_SHARE, pShare);
 	if (myConnectionParam.cConnectionProxy != NULL)
 	{
 		curl_easy_setopt (handle, CURLOPT_PROXY, myConnectionParam.cConnectionProxy);
@@ -399,6 +445,353 @@ GldiTask *cairo_dock_get_url_data_async (const gchar *cURL, GFunc pCallback, gpo
 }
 
 
+  //////////////////
+ /// HTTP CACHE ///
+//////////////////
+// The files of the server (lists of packages, readme, previews, archives) are kept in ~/.cache/cairo-dock/http, and revalidated with the server (ETag/Last-Modified) each time they're requested; most of the time the server just answers "304 Not Modified".
+// The files are stored under the SHA-1 of their content, so that a file served under several URLs, or that came back to a previous version, is stored once. An index maps each URL to its file and its validators.
+#define CAIRO_DOCK_URL_CACHE_MAX_SIZE (64 * 1024 * 1024)  // beyond, the least recently used files are removed.
+G_LOCK_DEFINE_STATIC (s_urlCache);
+static GKeyFile *s_pUrlCacheIndex = NULL;
+static gchar *s_cUrlCacheDir = NULL;
+
+typedef struct {
+	FILE *f;
+	GChecksum *pChecksum;
+	gsize iSize;
+	gchar *cETag;
+	gchar *cLastModified;
+	} CairoDockUrlTransfer;
+
+static GKeyFile *_get_url_cache_index (void)  // cache must be locked
+{
+	if (s_pUrlCacheIndex == NULL)
+	{
+		s_cUrlCacheDir = g_strdup_printf ("%s/cairo-dock/http", g_get_user_cache_dir ());
+		gchar *cObjectsDir = g_strdup_printf ("%s/objects", s_cUrlCacheDir);
+		if (g_mkdir_with_parents (cObjectsDir, 7*8*8+7*8+5) != 0)
+			cd_warning ("couldn't create directory %s", cObjectsDir);
+		g_free (cObjectsDir);
+		
+		s_pUrlCacheIndex = g_key_file_new ();
+		gchar *cIndexPath = g_strdup_printf ("%s/index", s_cUrlCacheDir);
+		g_key_file_load_from_file (s_pUrlCacheIndex, cIndexPath, G_KEY_FILE_NONE, NULL);  // no index yet is not an error.
+		g_free (cIndexPath);
+	}
+	return s_pUrlCacheIndex;
+}
+
+static void _save_url_cache_index (void)  // cache must be locked
+{
+	gchar *cIndexPath = g_strdup_printf ("%s/index", s_cUrlCacheDir);
+	cairo_dock_write_keys_to_file (s_pUrlCacheIndex, cIndexPath);
+	g_free (cIndexPath);
+}
+
+static inline gchar *_get_url_cache_object_path (const gchar *cObject)
+{
+	return g_strdup_printf ("%s/objects/%s", s_cUrlCacheDir, cObject);
+}
+
+static gboolean _url_cache_object_is_used (const gchar *cObject, const gchar *cExceptGroup)  // cache must be locked
+{
+	gboolean bUsed = FALSE;
+	gchar **pGroupList = g_key_file_get_groups (s_pUrlCacheIndex, NULL);
+	gchar *cOtherObject;
+	int i;
+	for (i = 0; pGroupList[i] != NULL && ! bUsed; i ++)
+	{
+		if (cExceptGroup && strcmp (pGroupList[i], cExceptGroup) == 0)
+			continue;
+		cOtherObject = g_key_file_get_string (s_pUrlCacheIndex, pGroupList[i], "object", NULL);
+		bUsed = (cOtherObject != NULL && strcmp (cOtherObject, cObject) == 0);
+		g_free (cOtherObject);
+	}
+	g_strfreev (pGroupList);
+	return bUsed;
+}
+
+static void _remove_url_cache_object (const gchar *cObject, const gchar *cExceptGroup)  // cache must be locked
+{
+	if (cObject == NULL || _url_cache_object_is_used (cObject, cExceptGroup))
+		return;
+	gchar *cObjectPath = _get_url_cache_object_path (cObject);
+	g_remove (cObjectPath);
+	g_free (cObjectPath);
+}
+
+static gint _compare_last_use (const gchar **cGroup1, const gchar **cGroup2)
+{
+	gint64 t1 = g_key_file_get_int64 (s_pUrlCacheIndex, *cGroup1, "last use", NULL);
+	gint64 t2 = g_key_file_get_int64 (s_pUrlCacheIndex, *cGroup2, "last use", NULL);
+	return (t1 < t2 ? -1 : t1 > t2 ? 1 : 0);
+}
+static void _prune_url_cache (const gchar *cKeepGroup)  // cache must be locked
+{
+	gsize iNbGroups = 0;
+	gchar **pGroupList = g_key_file_get_groups (s_pUrlCacheIndex, &iNbGroups);
+	gint64 iTotalSize = 0;  // files shared by several URLs are counted several times, it doesn't matter much.
+	gsize i;
+	for (i = 0; i < iNbGroups; i ++)
+		iTotalSize += g_key_file_get_int64 (s_pUrlCacheIndex, pGroupList[i], "size", NULL);
+	
+	if (iTotalSize > CAIRO_DOCK_URL_CACHE_MAX_SIZE)
+	{
+		qsort (pGroupList, iNbGroups, sizeof (gchar *), (GCompareFunc) _compare_last_use);
+		gchar *cObject;
+		for (i = 0; i < iNbGroups && iTotalSize > CAIRO_DOCK_URL_CACHE_MAX_SIZE; i ++)
+		{
+			if (cKeepGroup && strcmp (pGroupList[i], cKeepGroup) == 0)
+				continue;
+			cd_debug ("removing %s from the cache", pGroupList[i]);
+			iTotalSize -= g_key_file_get_int64 (s_pUrlCacheIndex, pGroupList[i], "size", NULL);
+			cObject = g_key_file_get_string (s_pUrlCacheIndex, pGroupList[i], "object", NULL);
+			g_key_file_remove_group (s_pUrlCacheIndex, pGroupList[i], NULL);
+			_remove_url_cache_object (cObject, NULL);
+			g_free (cObject);
+		}
+	}
+	g_strfreev (pGroupList);
+}
+
+static void _set_url_cache_validators (const gchar *cGroup, CairoDockUrlTransfer *pTransfer)  // cache must be locked
+{
+	if (pTransfer->cETag != NULL)
+		g_key_file_set_string (s_pUrlCacheIndex, cGroup, "etag", pTransfer->cETag);
+	if (pTransfer->cLastModified != NULL)
+		g_key_file_set_string (s_pUrlCacheIndex, cGroup, "last modified", pTransfer->cLastModified);
+	g_key_file_set_int64 (s_pUrlCacheIndex, cGroup, "last use", (gint64) time (NULL));
+}
+
+static gchar *_get_header_value (const char *str, size_t n)
+{
+	gchar *cValue = g_strndup (str, n);
+	return g_strstrip (cValue);
+}
+static size_t _get_cache_headers (char *buffer, size_t size, size_t nitems, CairoDockUrlTransfer *pTransfer)
+{
+	size_t n = size * nitems;
+	if (n > 5 && g_ascii_strncasecmp (buffer, "HTTP/", 5) == 0)  // a new response begins (after a redirection), forget the previous headers.
+	{
+		g_free (pTransfer->cETag);
+		pTransfer->cETag = NULL;
+		g_free (pTransfer->cLastModified);
+		pTransfer->cLastModified = NULL;
+	}
+	else if (n > 5 && g_ascii_strncasecmp (buffer, "ETag:", 5) == 0)
+	{
+		g_free (pTransfer->cETag);
+		pTransfer->cETag = _get_header_value (buffer + 5, n - 5);
+	}
+	else if (n > 14 && g_ascii_strncasecmp (buffer, "Last-Modified:", 14) == 0)
+	{
+		g_free (pTransfer->cLastModified);
+		pTransfer->cLastModified = _get_header_value (buffer + 14, n - 14);
+	}
+	return n;
+}
+static size_t _write_data_to_cache (gpointer buffer, size_t size, size_t nmemb, CairoDockUrlTransfer *pTransfer)
+{
+	size_t n = fwrite (buffer, size, nmemb, pTransfer->f);
+	g_checksum_update (pTransfer->pChecksum, buffer, n * size);
+	pTransfer->iSize += n * size;
+	return n;
+}
+
+gchar *cairo_dock_get_cached_url_file (const gchar *cURL, GError **erreur)
+{
+	g_return_val_if_fail (cURL != NULL, NULL);
+	cd_debug ("getting '%s' through the cache ...", cURL);
+	gchar *cGroup = g_compute_checksum_for_string (G_CHECKSUM_SHA1, cURL, -1);  // a group name can't contain any character.
+	
+	//\_______________ get what we already have.
+	G_LOCK (s_urlCache);
+	_get_url_cache_index ();
+	gchar *cCachedPath = NULL, *cETag = NULL, *cLastModified = NULL;
+	gchar *cObject = g_key_file_get_string (s_pUrlCacheIndex, cGroup, "object", NULL);
+	if (cObject != NULL)
+	{
+		cCachedPath = _get_url_cache_object_path (cObject);
+		if (g_file_test (cCachedPath, G_FILE_TEST_EXISTS))
+		{
+			cETag = g_key_file_get_string (s_pUrlCacheIndex, cGroup, "etag", NULL);
+			cLastModified = g_key_file_get_string (s_pUrlCacheIndex, cGroup, "last modified", NULL);
+		}
+		else  // removed behind our back.
+		{
+			g_free (cCachedPath);
+			cCachedPath = NULL;
+		}
+	}
+	gchar *cTmpPath = g_strdup_printf ("%s/objects/.download-XXXXXX", s_cUrlCacheDir);
+	G_UNLOCK (s_urlCache);
+	
+	gchar *cPath = NULL;
+	FILE *f = NULL;
+	int fds = g_mkstemp (cTmpPath);
+	if (fds != -1)
+		f = fdopen (fds, "wb");
+	if (f == NULL)
+	{
+		g_set_error (erreur, 1, 1, "Couldn't create a temporary file in the cache (%s)", cTmpPath);
+		if (fds != -1)
+			close (fds);
+		goto end;
+	}
+	
+	//\_______________ ask the server, with the validators of our copy.
+	CairoDockUrlTransfer transfer;
+	memset (&transfer, 0, sizeof (CairoDockUrlTransfer));
+	transfer.f = f;
+	transfer.pChecksum = g_checksum_new (G_CHECKSUM_SHA1);
+	
+	CURL *handle = _init_curl_connection (cURL);
+	curl_easy_setopt (handle, CURLOPT_WRITEFUNCTION, (curl_write_callback)_write_data_to_cache);
+	curl_easy_setopt (handle, CURLOPT_WRITEDATA, &transfer);
+	curl_easy_setopt (handle, CURLOPT_HEADERFUNCTION, (curl_write_callback)_get_cache_headers);
+	curl_easy_setopt (handle, CURLOPT_HEADERDATA, &transfer);
+	struct curl_slist *pHeaders = NULL;
+	gchar *cHeader;
+	if (cETag != NULL)
+	{
+		cHeader = g_strdup_printf ("If-None-Match: %s", cETag);
+		pHeaders = curl_slist_append (pHeaders, cHeader);
+		g_free (cHeader);
+	}
+	if (cLastModified != NULL)
+	{
+		cHeader = g_strdup_printf ("If-Modified-Since: %s", cLastModified);
+		pHeaders = curl_slist_append (pHeaders, cHeader);
+		g_free (cHeader);
+	}
+	if (pHeaders != NULL)
+		curl_easy_setopt (handle, CURLOPT_HTTPHEADER, pHeaders);
+	
+	CURLcode r = curl_easy_perform (handle);
+	long iCode = 0;  // stays at 0 for file:// or ftp:// URLs.
+	curl_easy_getinfo (handle, CURLINFO_RESPONSE_CODE, &iCode);
+	curl_easy_cleanup (handle);
+	curl_slist_free_all (pHeaders);
+	fclose (f);
+	
+	//\_______________ use the answer.
+	if (r != CURLE_OK || iCode >= 500)  // the server can't be reached, use our copy if any.
+	{
+		if (cCachedPath != NULL)
+		{
+			cd_message ("couldn't reach '%s', using the cached copy", cURL);
+			cPath = cCachedPath;
+			cCachedPath = NULL;
+		}
+		else if (r != CURLE_OK)
+			g_set_error (erreur, 1, 1, "Couldn't download file '%s' (%s)", cURL, curl_easy_strerror (r));
+		else
+			g_set_error (erreur, 1, 1, "Couldn't download file '%s' (HTTP error %ld)", cURL, iCode);
+	}
+	else if (iCode == 304 && cCachedPath != NULL)  // our copy is still valid.
+	{
+		cd_debug (" not modified");
+		G_LOCK (s_urlCache);
+		_set_url_cache_validators (cGroup, &transfer);
+		_save_url_cache_index ();
+		G_UNLOCK (s_urlCache);
+		cPath = cCachedPath;
+		cCachedPath = NULL;
+	}
+	else if (iCode >= 300)
+	{
+		g_set_error (erreur, 1, 1, "Couldn't download file '%s' (HTTP error %ld)", cURL, iCode);
+	}
+	else if (transfer.iSize == 0)
+	{
+		g_set_error (erreur, 1, 1, "Empty file from '%s'", cURL);
+	}
+	else  // new content, store it under its checksum.
+	{
+		const gchar *cNewObject = g_checksum_get_string (transfer.pChecksum);
+		gchar *cNewPath = _get_url_cache_object_path (cNewObject);
+		cd_debug (" new content (%s)", cNewObject);
+		
+		G_LOCK (s_urlCache);
+		if (g_rename (cTmpPath, cNewPath) == 0)
+		{
+			if (cObject != NULL && strcmp (cObject, cNewObject) != 0)
+				_remove_url_cache_object (cObject, cGroup);
+			g_key_file_remove_group (s_pUrlCacheIndex, cGroup, NULL);  // drop the validators of the previous content.
+			g_key_file_set_string (s_pUrlCacheIndex, cGroup, "url", cURL);
+			g_key_file_set_string (s_pUrlCacheIndex, cGroup, "object", cNewObject);
+			g_key_file_set_int64 (s_pUrlCacheIndex, cGroup, "size", transfer.iSize);
+			_set_url_cache_validators (cGroup, &transfer);
+			_prune_url_cache (cGroup);
+			_save_url_cache_index ();
+			cPath = cNewPath;
+			cNewPath = NULL;
+		}
+		else
+			g_set_error (erreur, 1, 1, "Couldn't store '%s' in the cache (%s)", cURL, cNewPath);
+		G_UNLOCK (s_urlCache);
+		g_free (cNewPath);
+	}
+	g_remove (cTmpPath);  // if it has not been moved into the cache.
+	g_checksum_free (transfer.pChecksum);
+	g_free (transfer.cETag);
+	g_free (transfer.cLastModified);
+	
+end:
+	g_free (cTmpPath);
+	g_free (cCachedPath);
+	g_free (cETag);
+	g_free (cLastModified);
+	g_free (cObject);
+	g_free (cGroup);
+	return cPath;
+}
+
+gchar *cairo_dock_get_cached_url_data (const gchar *cURL, GError **erreur)
+{
+	gchar *cPath = cairo_dock_get_cached_url_file (cURL, erreur);
+	if (cPath == NULL)
+		return NULL;
+	gchar *cContent = NULL;
+	g_file_get_contents (cPath, &cContent, NULL, erreur);
+	g_free (cPath);
+	return cContent;
+}
+
+static void _get_cached_url (gpointer *pSharedMemory)
+{
+	GError *erreur = NULL;
+	if (GPOINTER_TO_INT (pSharedMemory[4]))
+		pSharedMemory[3] = cairo_dock_get_cached_url_data (pSharedMemory[0], &erreur);
+	else
+		pSharedMemory[3] = cairo_dock_get_cached_url_file (pSharedMemory[0], &erreur);
+	if (erreur != NULL)
+	{
+		cd_warning (erreur->message);
+		g_error_free (erreur);
+	}
+}
+static GldiTask *_get_cached_url_async (const gchar *cURL, gboolean bGetContent, GFunc pCallback, gpointer data)
+{
+	gpointer *pSharedMemory = g_new0 (gpointer, 5);
+	pSharedMemory[0] = g_strdup (cURL);
+	pSharedMemory[1] = pCallback;
+	pSharedMemory[2] = data;
+	pSharedMemory[4] = GINT_TO_POINTER (bGetContent);
+	GldiTask *pTask = gldi_task_new_full (0, (GldiGetDataAsyncFunc) _get_cached_url, (GldiUpdateSyncFunc) _finish_dl_content, (GFreeFunc) _free_dl_content, pSharedMemory);
+	gldi_task_launch (pTask);
+	return pTask;
+}
+GldiTask *cairo_dock_get_cached_url_file_async (const gchar *cURL, GFunc pCallback, gpointer data)
+{
+	return _get_cached_url_async (cURL, FALSE, pCallback, data);
+}
+GldiTask *cairo_dock_get_cached_url_data_async (const gchar *cURL, GFunc pCallback, gpointer data)
+{
+	return _get_cached_url_async (cURL, TRUE, pCallback, data);
+}
+
+
   ////////////////////
  /// PACKAGES API ///
 ////////////////////
@@ -633,7 +1026,7 @@ GHashTable *cairo_dock_list_net_packages (const gchar *cServerAdress, const gcha
 	// On recupere la liste des packages distants.
 	GError *tmp_erreur = NULL;
 	gchar *cURL = g_strdup_printf ("%s/%s/%s", cServerAdress, cDirectory, cListFileName);
-	gchar *cContent = cairo_dock_get_url_data (cURL, &tmp_erreur);
+	gchar *cContent = cairo_dock_get_cached_url_data (cURL, &tmp_erreur);
 	g_free (cURL);
 	if (tmp_erreur != NULL)
 	{
@@ -790,7 +1183,24 @@ gchar *cairo_dock_get_package_path (const gchar *cPackageName, const gchar *cSha
 	if (cDistantPackagesDir != NULL && s_cPackageServerAdress)
 	{
 		gchar *cDistantFileName = g_strdup_printf ("%s/%s/%s/%s.tar.gz", s_cPackageServerAdress, cDistantPackagesDir, cPackageName, cPackageName);
-		cPackagePath = cairo_dock_download_archive (cDistantFileName, cUserPackagesDir);
+		GError *erreur = NULL;
+		gchar *cArchivePath = cairo_dock_get_cached_url_file (cDistantFileName, &erreur);  // the archive stays in the cache.
+		if (erreur != NULL)
+		{
+			cd_warning (erreur->message);
+			g_error_free (erreur);
+		}
+		if (cArchivePath != NULL)
+		{
+			if (cUserPackagesDir != NULL)
+			{
+				cd_debug ("uncompressing archive...");
+				cPackagePath = cairo_dock_uncompress_file (cArchivePath, cUserPackagesDir, cDistantFileName);
+				g_free (cArchivePath);
+			}
+			else
+				cPackagePath = cArchivePath;
+		}
 		g_free (cDistantFileName);
 		
 		if (cPackagePath != NULL)  // on se souvient de la date a laquelle on a mis a jour le package pour la derniere fois.
@@ -882,6 +1292,7 @@ static void reset_config (CairoConnectionParam *pSystem)
 static void init (void)
 {
 	curl_global_init (CURL_GLOBAL_DEFAULT);
+	_get_curl_share ();  // create it now, from the main thread.
 }
 
 
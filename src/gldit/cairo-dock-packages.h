@@ -31,7 +31,7 @@ G_BEGIN_DECLS
 * Packages are listed on the server in a file named "list.conf". It's a group-key file starting with "#!CD" on the first line; each package is described in its own group. Packages are stored on the server in a folder that has the same name, and contains the tarball, a "readme" file, and a "preview" file.
 *
 * The class offers a high level of abstraction that allows to manipulate packages without having to care their location, version, etc.
-* It also provides convenient utility functions to download a file or make a request to a server.
+* It also provides convenient utility functions to download a file or make a request to a server. The files of the server are kept in a cache on the disk, and all the transfers share their connections.
 *
 * To get the list of available packages, use \ref cairo_dock_list_packages, or its asynchronous version \ref cairo_dock_list_packages_async.
 * To access a package, use \ref cairo_dock_get_package_path.
@@ -163,6 +163,36 @@ gchar *cairo_dock_get_url_data_with_post (const gchar *cURL, gboolean bGetOutput
 */
 GldiTask *cairo_dock_get_url_data_async (const gchar *cURL, GFunc pCallback, gpointer data);
 
+/** Get a distant file through the cache of the dock (~/.cache/cairo-dock/http). If the file is already in the cache, the server is only asked whether it has changed (ETag/Last-Modified), and the cached copy is used if the server can't be reached.
+*@param cURL adress of the file.
+*@param erreur an error.
+*@return the local path of the file on success, else NULL. The file belongs to the cache, so don't modify or remove it; free the string after using it.
+*/
+gchar *cairo_dock_get_cached_url_file (const gchar *cURL, GError **erreur);
+
+/** Same as \ref cairo_dock_get_cached_url_file, but returns the content of the file.
+*@param cURL adress of the file.
+*@param erreur an error.
+*@return the data (NULL if failed). Free it after using.
+*/
+gchar *cairo_dock_get_cached_url_data (const gchar *cURL, GError **erreur);
+
+/** Asynchronous version of \ref cairo_dock_get_cached_url_file.
+*@param cURL adress of the file.
+*@param pCallback function called when the file is available. It takes the local path of the file (it belongs to the task so don't free it, and it belongs to the cache so don't remove it), or NULL if it failed, and the data you've set here.
+*@param data data to be passed to the callback.
+*@return the Task that is doing the job. Keep it and use \ref cairo_dock_discard_task whenever you want to discard the download, or \ref cairo_dock_free_task inside your callback.
+*/
+GldiTask *cairo_dock_get_cached_url_file_async (const gchar *cURL, GFunc pCallback, gpointer data);
+
+/** Asynchronous version of \ref cairo_dock_get_cached_url_data.
+*@param cURL adress of the file.
+*@param pCallback function called when the content is available. It takes the content of the file (it belongs to the task so don't free it), or NULL if it failed, and the data you've set here.
+*@param data data to be passed to the callback.
+*@return the Task that is doing the job. Keep it and use \ref cairo_dock_discard_task whenever you want to discard the download, or \ref cairo_dock_free_task inside your callback.
+*/
+GldiTask *cairo_dock_get_cached_url_data_async (const gchar *cURL, GFunc pCallback, gpointer data);
+
 
   ////////////////
  // THEMES API //
@@ -0,0 +1,465 @@
+/**
+* This file is a part of the Cairo-Dock project
+*
+* Copyright : (C) see the 'copyright' file.
+* E-mail    : see the 'copyright' file.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 3
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#define _GNU_SOURCE  // dladdr
+#include <string.h>
+#include <dlfcn.h>
+#include <dbus/dbus.h>
+#include <dbus/dbus-glib-lowlevel.h>  // dbus_g_connection_get_connection
+
+#include "cairo-dock-log.h"
+#include "cairo-dock-dbus.h"  // cairo_dock_get_session_connection
+#include "cairo-dock-module-instance-manager.h"  // gldi_module_instances_get_resources_report
+#include "cairo-dock-texture-manager.h"  // gldi_textures_get_report
+#include "cairo-dock-surface-factory.h"  // cairo_dock_get_text_surfaces_cache_stats
+#include "cairo-dock-profiler.h"
+
+#define GLDI_PROFILE_NB_BUCKETS 32  // bucket i holds the durations in [2^(i-1), 2^i[ us; the last one holds everything above 35mn.
+
+typedef struct {
+	GldiProfileCategory iCategory;
+	gconstpointer pSource;
+	gchar *cName;
+	gchar *cContext;
+	const gchar *cNameRef;  // names given on the last sample, to notice cheaply when they change (a new object at the same address).
+	const gchar *cContextRef;
+	guint iCount;
+	gint64 iTotal;
+	gint64 iMax;
+	guint iHistogram[GLDI_PROFILE_NB_BUCKETS];
+} GldiProfileEntry;
+
+typedef struct {
+	guint iCount;
+	guint64 iTotal;
+	guint iMax;
+} GldiProfileCount;
+
+gboolean g_bGldiProfilerEnabled = FALSE;
+
+static const gchar *s_cCategoryNames[GLDI_NB_PROFILE_CATEGORIES] = {"frame", "layout", "icon-render", "notification", "texture-upload", "task-update", "x-events"};
+static const gchar *s_cCounterNames[GLDI_NB_PROFILE_COUNTERS] = {"draw-calls", "state-changes"};
+static GHashTable *s_pEntries = NULL;  // entry -> entry
+static GldiProfileCount s_counts[GLDI_NB_PROFILE_COUNTERS];
+static gint64 s_iStartTime = 0;  // time of the last reset
+static gint64 s_iEnabledTime = 0;  // time spent with the profiler enabled since the last reset, excluding the current period
+static gint64 s_iEnableTime = 0;  // beginning of the current period
+G_LOCK_DEFINE_STATIC (s_entries);  // samples mostly come from the main thread, but nothing prevents a notification from a thread.
+
+  ///////////////
+ /// SAMPLES ///
+///////////////
+
+static guint _entry_hash (const GldiProfileEntry *pEntry)
+{
+	return g_direct_hash (pEntry->pSource) * 31 + pEntry->iCategory;
+}
+
+static gboolean _entry_equal (const GldiProfileEntry *pEntry1, const GldiProfileEntry *pEntry2)
+{
+	return (pEntry1->pSource == pEntry2->pSource && pEntry1->iCategory == pEntry2->iCategory);
+}
+
+static void _free_entry (GldiProfileEntry *pEntry)
+{
+	g_free (pEntry->cName);
+	g_free (pEntry->cContext);
+	g_free (pEntry);
+}
+
+static gchar *_get_symbol_name (gconstpointer pFunction)
+{
+	Dl_info info;
+	if (dladdr ((void*)pFunction, &info) != 0)
+	{
+		const gchar *cLib = (info.dli_fname ? strrchr (info.dli_fname, '/') : NULL);
+		cLib = (cLib ? cLib + 1 : info.dli_fname);
+		if (info.dli_sname != NULL)
+			return g_strdup_printf ("%s (%s)", info.dli_sname, cLib ? cLib : "?");
+		else  // static function: we only know its library.
+			return g_strdup_printf ("%p (%s)", pFunction, cLib ? cLib : "?");
+	}
+	return g_strdup_printf ("%p", pFunction);
+}
+
+static inline void _update_name (gchar **cName, const gchar **cNameRef, const gchar *cNewName)
+{
+	if (*cNameRef == cNewName)
+		return;
+	*cNameRef = cNewName;
+	if (cNewName && g_strcmp0 (*cName, cNewName) != 0)
+	{
+		g_free (*cName);
+		*cName = g_strdup (cNewName);
+	}
+}
+
+void gldi_profiler_add_sample (GldiProfileCategory iCategory, gconstpointer pSource, const gchar *cName, const gchar *cContext, gint64 iDuration)
+{
+	if (iDuration < 0)
+		iDuration = 0;
+	G_LOCK (s_entries);
+	if (s_pEntries == NULL)
+		s_pEntries = g_hash_table_new_full ((GHashFunc)_entry_hash, (GEqualFunc)_entry_equal, NULL, (GDestroyNotify)_free_entry);
+
+	GldiProfileEntry key;
+	key.iCategory = iCategory;
+	key.pSource = pSource;
+	GldiProfileEntry *pEntry = g_hash_table_lookup (s_pEntries, &key);
+	if (pEntry == NULL)
+	{
+		pEntry = g_new0 (GldiProfileEntry, 1);
+		pEntry->iCategory = iCategory;
+		pEntry->pSource = pSource;
+		if (cName == NULL)
+			pEntry->cName = _get_symbol_name (pSource);  // only once per source, dladdr is not that cheap.
+		g_hash_table_insert (s_pEntries, pEntry, pEntry);
+	}
+	_update_name (&pEntry->cName, &pEntry->cNameRef, cName);
+	_update_name (&pEntry->cContext, &pEntry->cContextRef, cContext);
+
+	pEntry->iCount ++;
+	pEntry->iTotal += iDuration;
+	if (iDuration > pEntry->iMax)
+		pEntry->iMax = iDuration;
+	guint i = MIN (g_bit_storage ((gulong)iDuration), GLDI_PROFILE_NB_BUCKETS - 1);  // 0 -> 0, 1 -> 1, 2-3 -> 2, 4-7 -> 3, ...
+	if (iDuration == 0)
+		i = 0;
+	pEntry->iHistogram[i] ++;
+	G_UNLOCK (s_entries);
+}
+
+void gldi_profiler_add_count (GldiProfileCounter iCounter, guint iValue)
+{
+	G_LOCK (s_entries);
+	GldiProfileCount *pCount = &s_counts[iCounter];
+	pCount->iCount ++;
+	pCount->iTotal += iValue;
+	if (iValue > pCount->iMax)
+		pCount->iMax = iValue;
+	G_UNLOCK (s_entries);
+}
+
+void gldi_profiler_enable (gboolean bEnable)
+{
+	if (bEnable == g_bGldiProfilerEnabled)
+		return;
+	gint64 t = g_get_monotonic_time ();
+	if (s_iStartTime == 0)
+		s_iStartTime = t;
+	if (bEnable)
+		s_iEnableTime = t;
+	else
+		s_iEnabledTime += t - s_iEnableTime;
+	g_bGldiProfilerEnabled = bEnable;
+	cd_message ("profiler %s", bEnable ? "enabled" : "disabled");
+}
+
+void gldi_profiler_reset (void)
+{
+	G_LOCK (s_entries);
+	if (s_pEntries != NULL)
+		g_hash_table_remove_all (s_pEntries);
+	memset (s_counts, 0, sizeof (s_counts));
+	G_UNLOCK (s_entries);
+	s_iStartTime = s_iEnableTime = g_get_monotonic_time ();
+	s_iEnabledTime = 0;
+}
+
+  //////////////
+ /// REPORT ///
+//////////////
+
+void gldi_profiler_append_json_string (GString *sJson, const gchar *str)
+{
+	g_string_append_c (sJson, '"');
+	const gchar *c;
+	for (c = (str ? str : ""); *c != '\0'; c ++)
+	{
+		switch (*c)
+		{
+			case '"': g_string_append (sJson, "\\\""); break;
+			case '\\': g_string_append (sJson, "\\\\"); break;
+			case '\n': g_string_append (sJson, "\\n"); break;
+			case '\t': g_string_append (sJson, "\\t"); break;
+			default:
+				if ((guchar)*c < 0x20)
+					g_string_append_printf (sJson, "\\u%04x", (guchar)*c);
+				else
+					g_string_append_c (sJson, *c);
+		}
+	}
+	g_string_append_c (sJson, '"');
+}
+
+static gint64 _get_percentile (GldiProfileEntry *pEntry, double p)
+{
+	guint iRank = (guint) (p * pEntry->iCount);
+	guint n = 0, i;
+	for (i = 0; i < GLDI_PROFILE_NB_BUCKETS; i ++)
+	{
+		n += pEntry->iHistogram[i];
+		if (n > iRank)
+			return MIN ((i == 0 ? 0 : ((gint64)1 << i) - 1), pEntry->iMax);  // upper bound of the bucket.
+	}
+	return pEntry->iMax;
+}
+
+static int _compare_entries (GldiProfileEntry *pEntry1, GldiProfileEntry *pEntry2)
+{
+	return (pEntry1->iTotal < pEntry2->iTotal ? 1 : pEntry1->iTotal > pEntry2->iTotal ? -1 : 0);  // slowest first
+}
+
+gchar *gldi_profiler_get_report (gint iNbEntries, const gchar *cCategory)
+{
+	int iCategory = -1, i;
+	if (cCategory != NULL && *cCategory != '\0')
+	{
+		for (i = 0; i < GLDI_NB_PROFILE_CATEGORIES; i ++)
+		{
+			if (strcmp (cCategory, s_cCategoryNames[i]) == 0)
+				break;
+		}
+		if (i == GLDI_NB_PROFILE_CATEGORIES)
+			cd_warning ("no such category '%s'", cCategory);
+		iCategory = i;  // an unknown category gives an empty list
+	}
+
+	GString *sJson = g_string_new ("{");
+	gint64 t = g_get_monotonic_time ();
+	g_string_append_printf (sJson, "\"enabled\": %s, \"duration_us\": %" G_GINT64_FORMAT ", \"profiled_us\": %" G_GINT64_FORMAT ",",
+		g_bGldiProfilerEnabled ? "true" : "false",
+		s_iStartTime != 0 ? t - s_iStartTime : 0,
+		s_iEnabledTime + (g_bGldiProfilerEnabled ? t - s_iEnableTime : 0));
+
+	G_LOCK (s_entries);
+	// totals per category.
+	guint iCount[GLDI_NB_PROFILE_CATEGORIES] = {0};
+	gint64 iTotal[GLDI_NB_PROFILE_CATEGORIES] = {0};
+	GList *pEntriesList = (s_pEntries ? g_hash_table_get_values (s_pEntries) : NULL);
+	GList *e;
+	GldiProfileEntry *pEntry;
+	for (e = pEntriesList; e != NULL; e = e->next)
+	{
+		pEntry = e->data;
+		iCount[pEntry->iCategory] += pEntry->iCount;
+		iTotal[pEntry->iCategory] += pEntry->iTotal;
+	}
+	g_string_append (sJson, " \"categories\": {");
+	for (i = 0; i < GLDI_NB_PROFILE_CATEGORIES; i ++)
+	{
+		g_string_append_printf (sJson, "%s\"%s\": {\"count\": %u, \"total_us\": %" G_GINT64_FORMAT "}",
+			i == 0 ? "" : ", ",
+			s_cCategoryNames[i],
+			iCount[i],
+			iTotal[i]);
+	}
+	g_string_append (sJson, "},");
+
+	// counters.
+	g_string_append (sJson, " \"counters\": {");
+	for (i = 0; i < GLDI_NB_PROFILE_COUNTERS; i ++)
+	{
+		g_string_append_printf (sJson, "%s\"%s\": {\"count\": %u, \"mean\": %.1f, \"max\": %u}",
+			i == 0 ? "" : ", ",
+			s_cCounterNames[i],
+			s_counts[i].iCount,
+			(double)s_counts[i].iTotal / MAX (1, s_counts[i].iCount),
+			s_counts[i].iMax);
+	}
+	g_string_append (sJson, "},");
+
+	// the slowest sources.
+	pEntriesList = g_list_sort (pEntriesList, (GCompareFunc)_compare_entries);
+	g_string_append (sJson, " \"top\": [");
+	int n = 0;
+	for (e = pEntriesList; e != NULL && n < iNbEntries; e = e->next)
+	{
+		pEntry = e->data;
+		if (iCategory >= 0 && (int)pEntry->iCategory != iCategory)
+			continue;
+		g_string_append_printf (sJson, "%s\n  {\"category\": \"%s\", \"name\": ", n == 0 ? "" : ",", s_cCategoryNames[pEntry->iCategory]);
+		gldi_profiler_append_json_string (sJson, pEntry->cName);
+		g_string_append (sJson, ", \"context\": ");
+		gldi_profiler_append_json_string (sJson, pEntry->cContext);
+		g_string_append_printf (sJson, ", \"count\": %u, \"total_us\": %" G_GINT64_FORMAT ", \"mean_us\": %" G_GINT64_FORMAT ", \"max_us\": %" G_GINT64_FORMAT ", \"p50_us\": %" G_GINT64_FORMAT ", \"p90_us\": %" G_GINT64_FORMAT ", \"p99_us\": %" G_GINT64_FORMAT "}",
+			pEntry->iCount,
+			pEntry->iTotal,
+			pEntry->iTotal / MAX (1, pEntry->iCount),
+			pEntry->iMax,
+			_get_percentile (pEntry, .5),
+			_get_percentile (pEntry, .9),
+			_get_percentile (pEntry, .99));
+		n ++;
+	}
+	G_UNLOCK (s_entries);
+	g_list_free (pEntriesList);
+	g_string_append (sJson, "]}");
+
+	return g_string_free (sJson, FALSE);
+}
+
+static void _append_cache_stats (GString *sJson, const gchar *cName, guint iNbHits, guint iNbMisses, guint iNbEntries)
+{
+	g_string_append_printf (sJson, "\"%s\": {\"hits\": %u, \"misses\": %u, \"entries\": %u, \"hit_rate\": %.3f}",
+		cName,
+		iNbHits,
+		iNbMisses,
+		iNbEntries,
+		iNbHits + iNbMisses != 0 ? (double)iNbHits / (iNbHits + iNbMisses) : 0.);
+}
+
+static gchar *_get_caches_report (void)
+{
+	GString *sJson = g_string_new ("{");
+	guint iNbHits, iNbMisses, iNbEntries;
+	cairo_dock_get_text_surfaces_cache_stats (&iNbHits, &iNbMisses, &iNbEntries);
+	_append_cache_stats (sJson, "text_surfaces", iNbHits, iNbMisses, iNbEntries);
+	g_string_append_c (sJson, '}');
+	return g_string_free (sJson, FALSE);
+}
+
+  ////////////
+ /// DBUS ///
+////////////
+
+static const gchar *s_cIntrospection =
+	DBUS_INTROSPECT_1_0_XML_DOCTYPE_DECL_NODE
+	"<node>\n"
+	" <interface name=\"org.freedesktop.DBus.Introspectable\">\n"
+	"  <method name=\"Introspect\"><arg name=\"data\" direction=\"out\" type=\"s\"/></method>\n"
+	" </interface>\n"
+	" <interface name=\""GLDI_PROFILER_DBUS_INTERFACE"\">\n"
+	"  <method name=\"Enable\"><arg name=\"enable\" direction=\"in\" type=\"b\"/></method>\n"
+	"  <method name=\"Reset\"/>\n"
+	"  <method name=\"GetReport\">\n"
+	"   <arg name=\"nb_entries\" direction=\"in\" type=\"i\"/>\n"
+	"   <arg name=\"category\" direction=\"in\" type=\"s\"/>\n"
+	"   <arg name=\"report\" direction=\"out\" type=\"s\"/>\n"
+	"  </method>\n"
+	"  <method name=\"GetResources\"><arg name=\"report\" direction=\"out\" type=\"s\"/></method>\n"
+	"  <method name=\"SetBudget\">\n"
+	"   <arg name=\"module\" direction=\"in\" type=\"s\"/>\n"
+	"   <arg name=\"cpu_load\" direction=\"in\" type=\"d\"/>\n"
+	"   <arg name=\"memory_kb\" direction=\"in\" type=\"i\"/>\n"
+	"  </method>\n"
+	"  <method name=\"GetTextures\"><arg name=\"report\" direction=\"out\" type=\"s\"/></method>\n"
+	"  <method name=\"SetTexturesBudget\"><arg name=\"memory_kb\" direction=\"in\" type=\"i\"/></method>\n"
+	"  <method name=\"GetCaches\"><arg name=\"report\" direction=\"out\" type=\"s\"/></method>\n"
+	" </interface>\n"
+	"</node>\n";
+
+static DBusHandlerResult _on_dbus_message (DBusConnection *pConnection, DBusMessage *pMessage, G_GNUC_UNUSED void *data)
+{
+	DBusMessage *pReply = NULL;
+	if (dbus_message_is_method_call (pMessage, GLDI_PROFILER_DBUS_INTERFACE, "GetReport"))
+	{
+		dbus_int32_t iNbEntries = 0;
+		const char *cCategory = NULL;
+		if (dbus_message_get_args (pMessage, NULL, DBUS_TYPE_INT32, &iNbEntries, DBUS_TYPE_STRING, &cCategory, DBUS_TYPE_INVALID))
+		{
+			gchar *cReport = gldi_profiler_get_report (iNbEntries, cCategory);
+			pReply = dbus_message_new_method_return (pMessage);
+			dbus_message_append_args (pReply, DBUS_TYPE_STRING, &cReport, DBUS_TYPE_INVALID);
+			g_free (cReport);
+		}
+	}
+	else if (dbus_message_is_method_call (pMessage, GLDI_PROFILER_DBUS_INTERFACE, "Enable"))
+	{
+		dbus_bool_t bEnable = FALSE;
+		if (dbus_message_get_args (pMessage, NULL, DBUS_TYPE_BOOLEAN, &bEnable, DBUS_TYPE_INVALID))
+		{
+			gldi_profiler_enable (bEnable);
+			pReply = dbus_message_new_method_return (pMessage);
+		}
+	}
+	else if (dbus_message_is_method_call (pMessage, GLDI_PROFILER_DBUS_INTERFACE, "Reset"))
+	{
+		gldi_profiler_reset ();
+		pReply = dbus_message_new_method_return (pMessage);
+	}
+	else if (dbus_message_is_method_call (pMessage, GLDI_PROFILER_DBUS_INTERFACE, "GetResources"))
+	{
+		gchar *cReport = gldi_module_instances_get_resources_report ();
+		pReply = dbus_message_new_method_return (pMessage);
+		dbus_message_append_args (pReply, DBUS_TYPE_STRING, &cReport, DBUS_TYPE_INVALID);
+		g_free (cReport);
+	}
+	else if (dbus_message_is_method_call (pMessage, GLDI_PROFILER_DBUS_INTERFACE, "SetBudget"))
+	{
+		const char *cModuleName = NULL;
+		double fCpuLoad = 0;
+		dbus_int32_t iMemory = 0;
+		if (dbus_message_get_args (pMessage, NULL, DBUS_TYPE_STRING, &cModuleName, DBUS_TYPE_DOUBLE, &fCpuLoad, DBUS_TYPE_INT32, &iMemory, DBUS_TYPE_INVALID))
+		{
+			gldi_module_instances_set_budget (cModuleName, fCpuLoad, (gint64)iMemory * 1024);
+			pReply = dbus_message_new_method_return (pMessage);
+		}
+	}
+	else if (dbus_message_is_method_call (pMessage, GLDI_PROFILER_DBUS_INTERFACE, "GetTextures"))
+	{
+		gchar *cReport = gldi_textures_get_report ();
+		pReply = dbus_message_new_method_return (pMessage);
+		dbus_message_append_args (pReply, DBUS_TYPE_STRING, &cReport, DBUS_TYPE_INVALID);
+		g_free (cReport);
+	}
+	else if (dbus_message_is_method_call (pMessage, GLDI_PROFILER_DBUS_INTERFACE, "SetTexturesBudget"))
+	{
+		dbus_int32_t iMemory = 0;
+		if (dbus_message_get_args (pMessage, NULL, DBUS_TYPE_INT32, &iMemory, DBUS_TYPE_INVALID))
+		{
+			gldi_textures_set_budget ((gint64)iMemory * 1024);
+			pReply = dbus_message_new_method_return (pMessage);
+		}
+	}
+	else if (dbus_message_is_method_call (pMessage, GLDI_PROFILER_DBUS_INTERFACE, "GetCaches"))
+	{
+		gchar *cReport = _get_caches_report ();
+		pReply = dbus_message_new_method_return (pMessage);
+		dbus_message_append_args (pReply, DBUS_TYPE_STRING, &cReport, DBUS_TYPE_INVALID);
+		g_free (cReport);
+	}
+	else if (dbus_message_is_method_call (pMessage, DBUS_INTERFACE_INTROSPECTABLE, "Introspect"))
+	{
+		pReply = dbus_message_new_method_return (pMessage);
+		dbus_message_append_args (pReply, DBUS_TYPE_STRING, &s_cIntrospection, DBUS_TYPE_INVALID);
+	}
+	else
+		return DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
+
+	if (pReply == NULL)  // wrong arguments
+		pReply = dbus_message_new_error (pMessage, DBUS_ERROR_INVALID_ARGS, "invalid arguments");
+	dbus_connection_send (pConnection, pReply, NULL);
+	dbus_message_unref (pReply);
+	return DBUS_HANDLER_RESULT_HANDLED;
+}
+
+void gldi_profiler_register_dbus_service (void)
+{
+	DBusGConnection *pGConnection = cairo_dock_get_session_connection ();
+	if (pGConnection == NULL)
+		return;
+	static const DBusObjectPathVTable vtable = {NULL, _on_dbus_message, NULL, NULL, NULL, NULL};
+	DBusConnection *pConnection = dbus_g_connection_get_connection (pGConnection);
+	if (! dbus_connection_register_object_path (pConnection, GLDI_PROFILER_DBUS_PATH, &vtable, NULL))
+	{
+		cd_warning ("couldn't register the profiler on the bus");
+		return;
+	}
+	cairo_dock_register_service_name (GLDI_PROFILER_DBUS_NAME);
+}
@@ -0,0 +1,124 @@
+/*
+* This file is a part of the Cairo-Dock project
+*
+* Copyright : (C) see the 'copyright' file.
+* E-mail    : see the 'copyright' file.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 3
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __CAIRO_DOCK_PROFILER__
+#define  __CAIRO_DOCK_PROFILER__
+
+#include <glib.h>
+G_BEGIN_DECLS
+
+/**
+*@file cairo-dock-profiler.h A profiler that tells where the time of the dock goes: drawing and layout of the containers, rendering of the icons, notifications, texture uploads, updates of the Tasks and X events.
+ *
+ * Each measure is added to the histogram of its source (a container, an applet, a callback), so that the slowest ones can be found on a running dock. When disabled (the default), a measure costs a single test.
+ *
+ * It can be driven from the outside on the session bus, with the service GLDI_PROFILER_DBUS_NAME:
+ * dbus-send --session --print-reply --dest=org.cairodock.Profiler /org/cairodock/Profiler org.cairodock.Profiler.Enable boolean:true
+ * dbus-send --session --print-reply --dest=org.cairodock.Profiler /org/cairodock/Profiler org.cairodock.Profiler.GetReport int32:10 string:"notification"
+ *
+ * The same service gives the resources used by each applet (see \ref gldi_module_instances_get_resources_report), and lets set their budget (CPU load in % of a core, memory in kB, 0 for no limit):
+ * dbus-send --session --print-reply --dest=org.cairodock.Profiler /org/cairodock/Profiler org.cairodock.Profiler.GetResources
+ * dbus-send --session --print-reply --dest=org.cairodock.Profiler /org/cairodock/Profiler org.cairodock.Profiler.SetBudget string:"System-Monitor" double:2 int32:20000
+ *
+ * And the memory taken by the images of each container (see \ref gldi_textures_get_report), with a budget for all of them (in kB, 0 for no limit):
+ * dbus-send --session --print-reply --dest=org.cairodock.Profiler /org/cairodock/Profiler org.cairodock.Profiler.GetTextures
+ * dbus-send --session --print-reply --dest=org.cairodock.Profiler /org/cairodock/Profiler org.cairodock.Profiler.SetTexturesBudget int32:100000
+ *
+ * And the hit rates of the caches (see \ref cairo_dock_get_text_surfaces_cache_stats):
+ * dbus-send --session --print-reply --dest=org.cairodock.Profiler /org/cairodock/Profiler org.cairodock.Profiler.GetCaches
+ */
+
+#define GLDI_PROFILER_DBUS_NAME "org.cairodock.Profiler"
+#define GLDI_PROFILER_DBUS_PATH "/org/cairodock/Profiler"
+#define GLDI_PROFILER_DBUS_INTERFACE "org.cairodock.Profiler"
+
+/// Kinds of measures.
+typedef enum {
+	GLDI_PROFILE_FRAME = 0,  // drawing of a container
+	GLDI_PROFILE_LAYOUT,  // computation of the icons positions of a dock
+	GLDI_PROFILE_ICON_RENDER,  // rendering of the icons, per applet (or per dock for the other icons)
+	GLDI_PROFILE_NOTIFICATION,  // a notification callback
+	GLDI_PROFILE_TEXTURE_UPLOAD,  // upload of an image to the graphic card
+	GLDI_PROFILE_TASK_UPDATE,  // the 'update' callback of a Task
+	GLDI_PROFILE_X_EVENTS,  // processing of the X events
+	GLDI_NB_PROFILE_CATEGORIES
+} GldiProfileCategory;
+
+/// Kinds of counts, sampled once per frame.
+typedef enum {
+	GLDI_PROFILE_DRAW_CALLS = 0,  // draw calls used for the icons of a dock
+	GLDI_PROFILE_STATE_CHANGES,  // texture bindings and blending changes used for the icons of a dock
+	GLDI_NB_PROFILE_COUNTERS
+} GldiProfileCounter;
+
+extern gboolean g_bGldiProfilerEnabled;
+
+/** Start a measure.
+*@return the current time, or 0 if the profiler is disabled; to be passed to \ref gldi_profile_end
+*/
+#define gldi_profile_begin() (G_UNLIKELY (g_bGldiProfilerEnabled) ? g_get_monotonic_time () : 0)
+
+/** End a measure started with \ref gldi_profile_begin. The names are only evaluated if the measure is recorded.
+*@param iStartTime the value returned by \ref gldi_profile_begin
+*@param iCategory the kind of measure
+*@param pSource the source of the measure (the samples are aggregated per source and category)
+*@param cName name of the source, or NULL if pSource is a function (it will then be named after its symbol)
+*@param cContext additional info about the source (its container, its notification, ...), or NULL
+*/
+#define gldi_profile_end(iStartTime, iCategory, pSource, cName, cContext) do {\
+	if (G_UNLIKELY (iStartTime != 0))\
+		gldi_profiler_add_sample (iCategory, pSource, cName, cContext, g_get_monotonic_time () - iStartTime);\
+	} while (0)
+
+/** Add a sample to a counter, if the profiler is enabled.
+*@param iCounter the kind of count
+*@param iValue the value counted during this frame
+*/
+#define gldi_profile_count(iCounter, iValue) do {\
+	if (G_UNLIKELY (g_bGldiProfilerEnabled))\
+		gldi_profiler_add_count (iCounter, iValue);\
+	} while (0)
+
+// internal functions
+void gldi_profiler_add_sample (GldiProfileCategory iCategory, gconstpointer pSource, const gchar *cName, const gchar *cContext, gint64 iDuration);
+void gldi_profiler_add_count (GldiProfileCounter iCounter, guint iValue);
+void gldi_profiler_append_json_string (GString *sJson, const gchar *str);
+
+/** Enable or disable the profiler. Enabling it doesn't clear the previous measures.
+*@param bEnable TRUE to enable it
+*/
+void gldi_profiler_enable (gboolean bEnable);
+
+/** Forget all the measures.
+*/
+void gldi_profiler_reset (void);
+
+/** Get a report of the measures, as JSON: the total per category, the mean and max of each counter, and the N sources that took the most time, with their histograms summarized (count, mean, max, percentiles).
+*@param iNbEntries maximum number of sources to list
+*@param cCategory only list the sources of this category ("frame", "layout", "icon-render", "notification", "texture-upload", "task-update", "x-events"), or NULL for all
+*@return the report, to be freed with g_free.
+*/
+gchar *gldi_profiler_get_report (gint iNbEntries, const gchar *cCategory);
+
+/** Make the profiler available on the session bus (see above). Does nothing if the bus is not available.
+*/
+void gldi_profiler_register_dbus_service (void);
+
+G_END_DECLS
+#endif
@@ -20,6 +20,7 @@
 #include "gldi-config.h"  // GLDI_VERSION
 #include "cairo-dock-icon-facility.h"  // 
 #include "cairo-dock-dock-facility.h"  // cairo_dock_trigger_redraw_subdock_content_on_icon
+#include "cairo-dock-icon-index.h"  // cairo_dock_icon_index_invalidate
 #include "cairo-dock-surface-factory.h"
 #include "cairo-dock-backends-manager.h"  // cairo_dock_set_renderer
 #include "cairo-dock-log.h"
@@ -205,6 +206,7 @@ static gboolean delete_object (GldiObject *obj)
 	{
 		GList *pSubIcons = icon->pSubDock->icons;
 		icon->pSubDock->icons = NULL;
+		cairo_dock_icon_index_invalidate (icon->pSubDock);
 		GList *ic;
 		for (ic = pSubIcons; ic != NULL; ic = ic->next)
 		{
@@ -395,6 +395,7 @@ typedef struct _Icon Icon;
 typedef struct _GldiContainer GldiContainer;
 typedef struct _GldiContainerInterface GldiContainerInterface;
 typedef struct _CairoDock CairoDock;
+typedef struct _CairoDockIconIndex CairoDockIconIndex;
 typedef struct _CairoDesklet CairoDesklet;
 typedef struct _CairoDialog CairoDialog;
 typedef struct _CairoFlyingContainer CairoFlyingContainer;
@@ -728,60 +728,185 @@ cairo_surface_t * cairo_dock_rotate_surface (cairo_surface_t *pSurface, double f
 }
 
 
-cairo_surface_t *cairo_dock_create_surface_from_text_full (const gchar *cText, GldiTextDescription *pTextDescription, double fMaxScale, int iMaxWidth, int *iTextWidth, int *iTextHeight)
+  ////////////////////
+ /// TEXT LAYOUTS ///
+////////////////////
+
+#define CD_TEXT_LAYOUTS_POOL_SIZE 8  // labels, quick-infos, dialogs, and a few applets' texts.
+
+typedef struct {
+	PangoLayout *pLayout;
+	PangoFontDescription *pBaseDesc;  // the font of the description when the layout was made, to know if it still matches.
+	gint iSize;
+	double fScale;
+	gboolean bUseMarkup;
+	int iMaxLineWidth;
+	gchar *cText;  // text currently in the layout
+	PangoRectangle log;  // and its extents
+} CDTextLayout;
+
+typedef struct {
+	int iWidth;
+	int iHeight;
+	double fZoomX;
+	double fRadius;
+	double fLineWidth;
+	gboolean bDrawBackground;
+} CDTextGeometry;
+
+static PangoContext *s_pPangoContext = NULL;
+static int s_iPangoContextStamp = 0;
+static CDTextLayout s_pTextLayouts[CD_TEXT_LAYOUTS_POOL_SIZE];
+static int s_iNextTextLayout = 0;
+
+static void _clear_text_layout (CDTextLayout *pTextLayout)
 {
-	g_return_val_if_fail (cText != NULL && pTextDescription != NULL, NULL);
-	cairo_t *pSourceContext = _get_source_context ();
-	g_return_val_if_fail (pSourceContext != NULL && cairo_status (pSourceContext) == CAIRO_STATUS_SUCCESS, NULL);
+	if (pTextLayout->pLayout != NULL)
+		g_object_unref (pTextLayout->pLayout);
+	if (pTextLayout->pBaseDesc != NULL)
+		pango_font_description_free (pTextLayout->pBaseDesc);
+	g_free (pTextLayout->cText);
+	memset (pTextLayout, 0, sizeof (CDTextLayout));
+}
+
+static void _reset_text_layouts (void)
+{
+	int i;
+	for (i = 0; i < CD_TEXT_LAYOUTS_POOL_SIZE; i ++)
+		_clear_text_layout (&s_pTextLayouts[i]);
+	s_iNextTextLayout = 0;
+	if (s_pPangoContext != NULL)
+	{
+		g_object_unref (s_pPangoContext);
+		s_pPangoContext = NULL;
+	}
+}
+
+static PangoContext *_get_pango_context (void)
+{
+	int iStamp = gldi_style_colors_get_stamp ();
+	if (s_pPangoContext != NULL && iStamp != s_iPangoContextStamp)  // the style has changed (it may come with new font options), make new layouts.
+		_reset_text_layouts ();
+	if (s_pPangoContext == NULL)
+	{
+		cairo_t *pSourceContext = _get_source_context ();
+		if (pSourceContext == NULL || cairo_status (pSourceContext) != CAIRO_STATUS_SUCCESS)
+		{
+			if (pSourceContext != NULL)
+				cairo_destroy (pSourceContext);
+			return NULL;
+		}
+		s_pPangoContext = pango_cairo_create_context (pSourceContext);  // the pango context doesn't keep the cairo context alive.
+		cairo_destroy (pSourceContext);
+		s_iPangoContextStamp = iStamp;
+	}
+	return s_pPangoContext;
+}
+
+static CDTextLayout *_get_text_layout (GldiTextDescription *pTextDescription, double fMaxScale)
+{
+	PangoContext *pContext = _get_pango_context ();
+	if (pContext == NULL)
+		return NULL;
 	
-	//\_________________ get the font description
 	PangoFontDescription *pDesc = gldi_text_description_get_description (pTextDescription);
-	if (!pDesc)
-		cd_debug ("no text desc for '%s'", cText);
 	int iSize = gldi_text_description_get_size (pTextDescription);
-	pango_font_description_set_absolute_size (pDesc, fMaxScale * iSize * PANGO_SCALE);
+	int iMaxLineWidth = 0;
+	if (pTextDescription->fMaxRelativeWidth != 0)
+		iMaxLineWidth = pTextDescription->fMaxRelativeWidth * gldi_desktop_get_width() / g_desktopGeometry.iNbScreens;  // use the mean screen width since the text might be placed anywhere on the X screen.
 	
-	//\_________________ create a layout
-	PangoLayout *pLayout = pango_cairo_create_layout (pSourceContext);
-	pango_layout_set_font_description (pLayout, pDesc);
+	//\_________________ look for a layout with the same font and parameters.
+	CDTextLayout *pTextLayout;
+	int i;
+	for (i = 0; i < CD_TEXT_LAYOUTS_POOL_SIZE; i ++)
+	{
+		pTextLayout = &s_pTextLayouts[i];
+		if (pTextLayout->pLayout != NULL
+		&& pTextLayout->iSize == iSize
+		&& pTextLayout->fScale == fMaxScale
+		&& pTextLayout->bUseMarkup == pTextDescription->bUseMarkup
+		&& pTextLayout->iMaxLineWidth == iMaxLineWidth
+		&& (pDesc == NULL ? pTextLayout->pBaseDesc == NULL : pTextLayout->pBaseDesc != NULL && pango_font_description_equal (pDesc, pTextLayout->pBaseDesc)))
+			return pTextLayout;
+	}
 	
-	if (pTextDescription->bUseMarkup)
-		pango_layout_set_markup (pLayout, cText, -1);
-	else
-		pango_layout_set_text (pLayout, cText, -1);
+	//\_________________ none, recycle the oldest one.
+	pTextLayout = &s_pTextLayouts[s_iNextTextLayout];
+	s_iNextTextLayout = (s_iNextTextLayout + 1) % CD_TEXT_LAYOUTS_POOL_SIZE;
+	_clear_text_layout (pTextLayout);
 	
-	//\_________________ handle max width
-	if (pTextDescription->fMaxRelativeWidth != 0)
+	pTextLayout->pLayout = pango_layout_new (pContext);
+	pTextLayout->iSize = iSize;
+	pTextLayout->fScale = fMaxScale;
+	pTextLayout->bUseMarkup = pTextDescription->bUseMarkup;
+	pTextLayout->iMaxLineWidth = iMaxLineWidth;
+	if (pDesc != NULL)
 	{
-		int iMaxLineWidth = pTextDescription->fMaxRelativeWidth * gldi_desktop_get_width() / g_desktopGeometry.iNbScreens;  // use the mean screen width since the text might be placed anywhere on the X screen.
-		pango_layout_set_width (pLayout, iMaxLineWidth * PANGO_SCALE);  // PANGO_WRAP_WORD by default
+		pTextLayout->pBaseDesc = pango_font_description_copy (pDesc);
+		PangoFontDescription *pScaledDesc = pango_font_description_copy (pDesc);
+		pango_font_description_set_absolute_size (pScaledDesc, fMaxScale * iSize * PANGO_SCALE);
+		pango_layout_set_font_description (pTextLayout->pLayout, pScaledDesc);  // the layout makes its own copy
+		pango_font_description_free (pScaledDesc);
 	}
-	PangoRectangle log;
-	pango_layout_get_pixel_extents (pLayout, NULL, &log);
+	if (iMaxLineWidth != 0)
+		pango_layout_set_width (pTextLayout->pLayout, iMaxLineWidth * PANGO_SCALE);  // PANGO_WRAP_WORD by default
+	return pTextLayout;
+}
+
+static void _set_text_layout_text (CDTextLayout *pTextLayout, const gchar *cText)
+{
+	if (pTextLayout->cText != NULL && strcmp (pTextLayout->cText, cText) == 0)  // already laid out, we know its extents.
+		return;
+	g_free (pTextLayout->cText);
+	pTextLayout->cText = g_strdup (cText);
 	
-	//\_________________ load the layout into a surface
-	gboolean bDrawBackground = ! pTextDescription->bNoDecorations;
-	double fRadius = (pTextDescription->bUseDefaultColors ? MIN (myStyleParam.iCornerRadius * .75, iSize/2) : fMaxScale * MAX (pTextDescription->iMargin, MIN (6, iSize/2)));  // permet d'avoir un rayon meme si on n'a pas de marge.
+	if (pTextLayout->bUseMarkup)
+		pango_layout_set_markup (pTextLayout->pLayout, cText, -1);
+	else
+		pango_layout_set_text (pTextLayout->pLayout, cText, -1);
+	pango_layout_get_pixel_extents (pTextLayout->pLayout, NULL, &pTextLayout->log);
+}
+
+static void _get_text_geometry (CDTextLayout *pTextLayout, GldiTextDescription *pTextDescription, double fMaxScale, int iMaxWidth, CDTextGeometry *pGeometry)
+{
+	const PangoRectangle *log = &pTextLayout->log;
+	int iSize = pTextLayout->iSize;
+	pGeometry->bDrawBackground = ! pTextDescription->bNoDecorations;
+	pGeometry->fRadius = (pTextDescription->bUseDefaultColors ? MIN (myStyleParam.iCornerRadius * .75, iSize/2) : fMaxScale * MAX (pTextDescription->iMargin, MIN (6, iSize/2)));  // permet d'avoir un rayon meme si on n'a pas de marge.
 	int iOutlineMargin = 2*pTextDescription->iMargin * fMaxScale + (pTextDescription->bOutlined ? 2 : 0);  // outlined => +1 tout autour des lettres.
-	double fZoomX = ((iMaxWidth != 0 && log.width + iOutlineMargin > iMaxWidth) ? (double)iMaxWidth / (log.width + iOutlineMargin) : 1.);
-	double fLineWidth = 1;
+	pGeometry->fZoomX = ((iMaxWidth != 0 && log->width + iOutlineMargin > iMaxWidth) ? (double)iMaxWidth / (log->width + iOutlineMargin) : 1.);
+	pGeometry->fLineWidth = 1;
 	
-	*iTextWidth = (log.width + iOutlineMargin) * fZoomX + 2*fLineWidth;  // le texte + la marge de chaque cote.
-	if (bDrawBackground)  // quand on trace le cadre, on evite qu'avec des petits textes genre "1" on obtienne un fond tout rond.
+	pGeometry->iWidth = (log->width + iOutlineMargin) * pGeometry->fZoomX + 2*pGeometry->fLineWidth;  // le texte + la marge de chaque cote.
+	if (pGeometry->bDrawBackground)  // quand on trace le cadre, on evite qu'avec des petits textes genre "1" on obtienne un fond tout rond.
 	{
-		*iTextWidth = MAX (*iTextWidth, 2 * fRadius + 10);
-		if (iMaxWidth != 0 && *iTextWidth > iMaxWidth)
-			*iTextWidth = iMaxWidth;
+		pGeometry->iWidth = MAX (pGeometry->iWidth, 2 * pGeometry->fRadius + 10);
+		if (iMaxWidth != 0 && pGeometry->iWidth > iMaxWidth)
+			pGeometry->iWidth = iMaxWidth;
 	}
-	*iTextHeight = log.height + iOutlineMargin + 2*fLineWidth;
+	pGeometry->iHeight = log->height + iOutlineMargin + 2*pGeometry->fLineWidth;
+}
+
+static cairo_surface_t *_create_surface_from_text_layout (CDTextLayout *pTextLayout, GldiTextDescription *pTextDescription, double fMaxScale, int iMaxWidth, int *iTextWidth, int *iTextHeight)
+{
+	PangoLayout *pLayout = pTextLayout->pLayout;
+	const PangoRectangle *log = &pTextLayout->log;
+	CDTextGeometry geom;
+	_get_text_geometry (pTextLayout, pTextDescription, fMaxScale, iMaxWidth, &geom);
+	double fZoomX = geom.fZoomX;
+	double fRadius = geom.fRadius;
+	double fLineWidth = geom.fLineWidth;
+	*iTextWidth = geom.iWidth;
+	*iTextHeight = geom.iHeight;
 	
+	//\_________________ load the layout into a surface
 	cairo_surface_t* pNewSurface = cairo_dock_create_blank_surface (
 		*iTextWidth,
 		*iTextHeight);
 	cairo_t* pCairoContext = cairo_create (pNewSurface);
 	
 	//\_________________ draw the background
-	if (bDrawBackground)  // non transparent.
+	if (geom.bDrawBackground)  // non transparent.
 	{
 		cairo_save (pCairoContext);
 		double fFrameWidth = *iTextWidth - 2 * fRadius - fLineWidth;
@@ -804,12 +929,12 @@ cairo_surface_t *cairo_dock_create_surface_from_text_full (const gchar *cText, G
 		cairo_restore(pCairoContext);
 	}
 	
-	//g_print ("%s : log = %d;%d\n", cText, (int) log.x, (int) log.y);
-	int dx = (*iTextWidth - log.width * fZoomX)/2;  // pour se centrer.
-	int dy = (*iTextHeight - log.height)/2;  // pour se centrer.
+	//g_print ("%s : log = %d;%d\n", cText, (int) log->x, (int) log->y);
+	int dx = (*iTextWidth - log->width * fZoomX)/2;  // pour se centrer.
+	int dy = (*iTextHeight - log->height)/2;  // pour se centrer.
 	cairo_translate (pCairoContext,
-		-log.x*fZoomX + dx,
-		-log.y + dy);
+		-log->x*fZoomX + dx,
+		-log->y + dy);
 	
 	//\_________________ On dessine les contours du texte.
 	if (pTextDescription->bOutlined)
@@ -852,12 +977,192 @@ cairo_surface_t *cairo_dock_create_surface_from_text_full (const gchar *cText, G
 	*iTextWidth = *iTextWidth/** / fMaxScale*/;
 	*iTextHeight = *iTextHeight/** / fMaxScale*/;
 	
-	g_object_unref (pLayout);
-	pango_font_description_set_absolute_size (pDesc, iSize * PANGO_SCALE);
-	cairo_destroy (pSourceContext);
 	return pNewSurface;
 }
 
+cairo_surface_t *cairo_dock_create_surface_from_text_full (const gchar *cText, GldiTextDescription *pTextDescription, double fMaxScale, int iMaxWidth, int *iTextWidth, int *iTextHeight)
+{
+	g_return_val_if_fail (cText != NULL && pTextDescription != NULL, NULL);
+	if (gldi_text_description_get_description (pTextDescription) == NULL)
+		cd_debug ("no text desc for '%s'", cText);
+	
+	CDTextLayout *pTextLayout = _get_text_layout (pTextDescription, fMaxScale);
+	g_return_val_if_fail (pTextLayout != NULL, NULL);
+	_set_text_layout_text (pTextLayout, cText);
+	
+	return _create_surface_from_text_layout (pTextLayout, pTextDescription, fMaxScale, iMaxWidth, iTextWidth, iTextHeight);
+}
+
+
+
+  ///////////////////////////
+ /// TEXT SURFACES CACHE ///
+///////////////////////////
+
+#define CD_TEXT_SURFACES_CACHE_SIZE 256  // labels of all the icons + a few quick-infos states
+
+typedef struct {
+	gchar *cKey;
+	cairo_surface_t *pSurface;
+	int iWidth;
+	int iHeight;
+} CDTextSurface;
+
+static GHashTable *s_hTextSurfaces = NULL;  // key -> link in the LRU list
+static GQueue s_pTextSurfacesLRU = G_QUEUE_INIT;  // most recently used first
+static guint s_iNbTextSurfacesHits = 0;
+static guint s_iNbTextSurfacesMisses = 0;
+
+static gchar *_get_text_surface_key (const gchar *cText, GldiTextDescription *pTextDescription, double fMaxScale, int iMaxWidth)
+{
+	GString *sKey = g_string_new ("");
+	g_string_printf (sKey, "%u:%s", (guint)strlen (cText), cText);  // the length makes the key unambiguous, whatever the text contains.
+	
+	PangoFontDescription *pDesc = gldi_text_description_get_description (pTextDescription);
+	gchar *cFont = (pDesc ? pango_font_description_to_string (pDesc) : NULL);
+	g_string_append_printf (sKey, "|%s|%d|%.3f|%d|%d%d%d%d|%d",
+		cFont,
+		gldi_text_description_get_size (pTextDescription),
+		fMaxScale,
+		iMaxWidth,
+		pTextDescription->bNoDecorations,
+		pTextDescription->bOutlined,
+		pTextDescription->bUseMarkup,
+		pTextDescription->bUseDefaultColors,
+		pTextDescription->iMargin);
+	g_free (cFont);
+	
+	if (pTextDescription->bUseDefaultColors)  // colors and radius come from the global style.
+	{
+		g_string_append_printf (sKey, "|s%d", gldi_style_colors_get_stamp ());
+	}
+	else
+	{
+		GldiColor *c[3] = {&pTextDescription->fColorStart, &pTextDescription->fBackgroundColor, &pTextDescription->fLineColor};
+		int i;
+		for (i = 0; i < 3; i ++)
+			g_string_append_printf (sKey, "|%.3f,%.3f,%.3f,%.3f", c[i]->rgba.red, c[i]->rgba.green, c[i]->rgba.blue, c[i]->rgba.alpha);
+	}
+	if (pTextDescription->fMaxRelativeWidth != 0)  // the max width of a line depends on the screen.
+		g_string_append_printf (sKey, "|%d", (int)(pTextDescription->fMaxRelativeWidth * gldi_desktop_get_width() / g_desktopGeometry.iNbScreens));
+	
+	return g_string_free (sKey, FALSE);
+}
+
+static void _free_text_surface (CDTextSurface *pText)
+{
+	cairo_surface_destroy (pText->pSurface);
+	g_free (pText->cKey);
+	g_free (pText);
+}
+
+static CDTextSurface *_lookup_text_surface (const gchar *cKey)
+{
+	if (s_hTextSurfaces == NULL)
+		s_hTextSurfaces = g_hash_table_new (g_str_hash, g_str_equal);  // keys belong to the entries.
+	GList *pLink = g_hash_table_lookup (s_hTextSurfaces, cKey);
+	if (pLink == NULL)
+	{
+		s_iNbTextSurfacesMisses ++;
+		return NULL;
+	}
+	s_iNbTextSurfacesHits ++;
+	g_queue_unlink (&s_pTextSurfacesLRU, pLink);  // move it to the front.
+	g_queue_push_head_link (&s_pTextSurfacesLRU, pLink);
+	return pLink->data;
+}
+
+static void _insert_text_surface (gchar *cKey, cairo_surface_t *pSurface, int iWidth, int iHeight)  // takes ownership of the key and of the reference on the surface.
+{
+	CDTextSurface *pText = g_new0 (CDTextSurface, 1);
+	pText->cKey = cKey;
+	pText->pSurface = pSurface;
+	pText->iWidth = iWidth;
+	pText->iHeight = iHeight;
+	g_queue_push_head (&s_pTextSurfacesLRU, pText);
+	g_hash_table_insert (s_hTextSurfaces, cKey, s_pTextSurfacesLRU.head);
+	
+	if (s_pTextSurfacesLRU.length > CD_TEXT_SURFACES_CACHE_SIZE)  // drop the least recently used one.
+	{
+		CDTextSurface *pOldText = g_queue_pop_tail (&s_pTextSurfacesLRU);
+		g_hash_table_remove (s_hTextSurfaces, pOldText->cKey);
+		_free_text_surface (pOldText);  // icons using it keep their own reference.
+	}
+}
+
+cairo_surface_t *cairo_dock_create_surface_from_text_cached (const gchar *cText, GldiTextDescription *pTextDescription, double fMaxScale, int iMaxWidth, int *iTextWidth, int *iTextHeight)
+{
+	g_return_val_if_fail (cText != NULL && pTextDescription != NULL, NULL);
+	cairo_surface_t *pSurface = NULL;
+	cairo_dock_create_surfaces_from_texts (&cText, 1, pTextDescription, fMaxScale, iMaxWidth, &pSurface, iTextWidth, iTextHeight);
+	return pSurface;
+}
+
+void cairo_dock_create_surfaces_from_texts (const gchar **cTexts, int iNbTexts, GldiTextDescription *pTextDescription, double fMaxScale, int iMaxWidth, cairo_surface_t **pSurfaces, int *iTextWidths, int *iTextHeights)
+{
+	g_return_if_fail (cTexts != NULL && pTextDescription != NULL);
+	CDTextLayout *pTextLayout = NULL;  // only get it if some text has to be rendered.
+	CDTextSurface *pText;
+	gchar *cKey;
+	int i;
+	for (i = 0; i < iNbTexts; i ++)
+	{
+		pSurfaces[i] = NULL;
+		iTextWidths[i] = iTextHeights[i] = 0;
+		if (cTexts[i] == NULL)
+			continue;
+		
+		cKey = _get_text_surface_key (cTexts[i], pTextDescription, fMaxScale, iMaxWidth);
+		pText = _lookup_text_surface (cKey);
+		if (pText != NULL)  // hit
+		{
+			g_free (cKey);
+			pSurfaces[i] = cairo_surface_reference (pText->pSurface);
+			iTextWidths[i] = pText->iWidth;
+			iTextHeights[i] = pText->iHeight;
+		}
+		else  // miss -> render the text with the layout shared by the whole batch and add it to the cache.
+		{
+			if (pTextLayout == NULL)
+				pTextLayout = _get_text_layout (pTextDescription, fMaxScale);
+			if (pTextLayout == NULL)
+			{
+				g_free (cKey);
+				continue;
+			}
+			_set_text_layout_text (pTextLayout, cTexts[i]);
+			pSurfaces[i] = _create_surface_from_text_layout (pTextLayout, pTextDescription, fMaxScale, iMaxWidth, &iTextWidths[i], &iTextHeights[i]);
+			if (pSurfaces[i] != NULL)
+				_insert_text_surface (cKey, cairo_surface_reference (pSurfaces[i]), iTextWidths[i], iTextHeights[i]);
+			else
+				g_free (cKey);
+		}
+	}
+}
+
+void cairo_dock_reset_text_surfaces_cache (void)
+{
+	if (s_iNbTextSurfacesHits + s_iNbTextSurfacesMisses != 0)
+		cd_debug ("text surfaces: %u hits, %u misses (%.1f%%)", s_iNbTextSurfacesHits, s_iNbTextSurfacesMisses, 100. * s_iNbTextSurfacesHits / (s_iNbTextSurfacesHits + s_iNbTextSurfacesMisses));
+	CDTextSurface *pText;
+	while ((pText = g_queue_pop_head (&s_pTextSurfacesLRU)) != NULL)
+		_free_text_surface (pText);
+	if (s_hTextSurfaces != NULL)
+		g_hash_table_remove_all (s_hTextSurfaces);
+	
+	_reset_text_layouts ();  // a new font or a new screen may come with new font options.
+}
+
+void cairo_dock_get_text_surfaces_cache_stats (guint *iNbHits, guint *iNbMisses, guint *iNbEntries)
+{
+	if (iNbHits)
+		*iNbHits = s_iNbTextSurfacesHits;
+	if (iNbMisses)
+		*iNbMisses = s_iNbTextSurfacesMisses;
+	if (iNbEntries)
+		*iNbEntries = s_pTextSurfacesLRU.length;
+}
+
 
 cairo_surface_t * cairo_dock_duplicate_surface (cairo_surface_t *pSurface, double fWidth, double fHeight, double fDesiredWidth, double fDesiredHeight)
 {
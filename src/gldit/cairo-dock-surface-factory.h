@@ -64,7 +64,9 @@ typedef enum {
 	/// orientation 270° rotation
 	CAIRO_DOCK_ORIENTATION_ROT_270 	= 7<<3,
 	/// load the image as a strip if possible.
-	CAIRO_DOCK_ANIMATED_IMAGE = 1<<6
+	CAIRO_DOCK_ANIMATED_IMAGE = 1<<6,
+	/// the image will not be modified once loaded (in OpenGL, its texture can then be immutable and compressed).
+	CAIRO_DOCK_STATIC_IMAGE = 1<<7
 	} CairoDockLoadImageModifier;
 /// mask to get the orientation from a CairoDockLoadImageModifier.
 #define CAIRO_DOCK_ORIENTATION_MASK (7<<3)
@@ -176,6 +178,40 @@ cairo_surface_t *cairo_dock_create_surface_from_text_full (const gchar *cText, G
 */
 #define cairo_dock_create_surface_from_text(cText, pLabelDescription, iTextWidthPtr, iTextHeightPtr) cairo_dock_create_surface_from_text_full (cText, pLabelDescription, 1., 0, iTextWidthPtr, iTextHeightPtr) 
 
+/** Same as \ref cairo_dock_create_surface_from_text_full, but the surface is taken from a cache of the last rendered texts when possible (identical labels, quick-infos going back to a previous value, ...). The surface must not be drawn on, since it may be shared.
+*@param cText the text.
+*@param pLabelDescription description of the text rendering.
+*@param fMaxScale maximum zoom of the text.
+*@param iMaxWidth maximum authorized width for the surface; it will be zoomed in to fits this limit. 0 for no limit.
+*@param iTextWidth will be filled the width of the resulting surface.
+*@param iTextHeight will be filled the height of the resulting surface.
+*@return a new reference on the surface, to destroy with cairo_surface_destroy().
+*/
+cairo_surface_t *cairo_dock_create_surface_from_text_cached (const gchar *cText, GldiTextDescription *pLabelDescription, double fMaxScale, int iMaxWidth, int *iTextWidth, int *iTextHeight);
+
+/** Create the surfaces of several texts rendered with the same text description, in one pass (for instance all the labels of the icons after a change of their size). Surfaces are taken from the cache of texts when possible, and the other ones are added to it.
+*@param cTexts the texts (NULL entries give a NULL surface).
+*@param iNbTexts number of texts.
+*@param pLabelDescription description of the text rendering.
+*@param fMaxScale maximum zoom of the texts.
+*@param iMaxWidth maximum authorized width for the surfaces. 0 for no limit.
+*@param pSurfaces will be filled with a new reference on the surface of each text, to destroy with cairo_surface_destroy().
+*@param iTextWidths will be filled with the widths of the surfaces.
+*@param iTextHeights will be filled with the heights of the surfaces.
+*/
+void cairo_dock_create_surfaces_from_texts (const gchar **cTexts, int iNbTexts, GldiTextDescription *pLabelDescription, double fMaxScale, int iMaxWidth, cairo_surface_t **pSurfaces, int *iTextWidths, int *iTextHeights);
+
+/** Empty the cache of text surfaces. The surfaces still used by some icons are not destroyed until they are released.
+*/
+void cairo_dock_reset_text_surfaces_cache (void);
+
+/** Get the statistics of the cache of text surfaces, since the beginning.
+*@param iNbHits will be filled with the number of texts that were found in the cache, or NULL.
+*@param iNbMisses will be filled with the number of texts that had to be rendered, or NULL.
+*@param iNbEntries will be filled with the current number of texts in the cache, or NULL.
+*/
+void cairo_dock_get_text_surfaces_cache_stats (guint *iNbHits, guint *iNbMisses, guint *iNbEntries);
+
 /** Create a surface identical to another, possibly resizing it.
 *@param pSurface surface to duplicate.
 *@param fWidth the width of the surface.
@@ -19,8 +19,11 @@
 #include <math.h>
 #include <string.h>
 #include <stdlib.h>
+#include <time.h>  // clock_gettime
 
 #include "cairo-dock-log.h"
+#include "cairo-dock-profiler.h"  // gldi_profile_begin
+#include "cairo-dock-module-instance-manager.h"  // gldi_module_instance_add_cpu_time
 #include "cairo-dock-task.h"
 
 #ifndef GLIB_VERSION_2_32
@@ -60,6 +63,49 @@
 	G_THREAD_UNREF (pTask->pThread);\
 	g_free (pTask); } while (0)
 
+static inline gint64 _get_thread_cpu_time (void)  // in us
+{
+	struct timespec t;
+	clock_gettime (CLOCK_THREAD_CPUTIME_ID, &t);
+	return (gint64)t.tv_sec * 1000000 + t.tv_nsec / 1000;
+}
+
+static inline gboolean _perform_update (GldiTask *pTask)
+{
+	GldiUpdateSyncFunc update = pTask->update;
+	GldiModuleInstance *pOwner = pTask->pOwner;  // the update may destroy the task.
+	GldiModuleInstance *pPrevInstance = gldi_module_instance_set_current (pOwner);  // what the update creates belongs to the owner of the task.
+	gint64 iCpuTime = (pOwner ? _get_thread_cpu_time () : 0);
+	gint64 iProfileTime = gldi_profile_begin ();
+	gboolean bContinue = update (pTask->pSharedMemory);
+	gldi_profile_end (iProfileTime, GLDI_PROFILE_TASK_UPDATE, (gconstpointer)update, NULL, NULL);  // named after the callback, which tells the applet
+	if (pOwner)
+		gldi_module_instance_add_cpu_time (pOwner, _get_thread_cpu_time () - iCpuTime);
+	gldi_module_instance_set_current (pPrevInstance);
+	return bContinue;
+}
+
+static void _schedule_next_iteration_within_budget (GldiTask *pTask)
+{
+	if (pTask->pOwner != NULL && pTask->iPeriod != 0)
+	{
+		if (gldi_module_instance_is_over_cpu_budget (pTask->pOwner))  // its applet uses more CPU than allowed -> slow it down until it goes back under its budget.
+		{
+			pTask->bThrottled = TRUE;
+			_schedule_next_iteration (pTask);
+			gldi_task_downgrade_frequency (pTask);  // restarts the timer with a longer period; nothing to do once at the lowest frequency.
+			return;
+		}
+		if (pTask->bThrottled)
+		{
+			pTask->bThrottled = FALSE;
+			gldi_task_set_normal_frequency (pTask);
+		}
+	}
+	pTask->iFrequencyState = GLDI_TASK_FREQUENCY_NORMAL;
+	_schedule_next_iteration (pTask);
+}
+
 static gboolean _launch_task_timer (GldiTask *pTask)
 {
 	gldi_task_launch (pTask);
@@ -72,7 +118,7 @@ static gboolean _check_for_update_idle (GldiTask *pTask)
 	{
 		if (! pTask->bDiscard)  // of course if the task has been discarded before, don't do anything.
 		{
-			pTask->bContinue = pTask->update (pTask->pSharedMemory);
+			pTask->bContinue = _perform_update (pTask);
 		}
 		pTask->bNeedsUpdate = FALSE;  // now update is done, we won't do it any more until the next iteration, even is we loop on this function.
 	}
@@ -106,7 +152,11 @@ static gboolean _check_for_update_idle (GldiTask *pTask)
 		}
 		
 		pTask->iSidUpdateIdle = 0;  // set it before the unlock, as it is accessed in the thread part
+		gint64 iThreadCpuTime = pTask->iThreadCpuTime;
+		pTask->iThreadCpuTime = 0;
 		g_mutex_unlock (pTask->pMutex);
+		if (pTask->pOwner)
+			gldi_module_instance_add_cpu_time (pTask->pOwner, iThreadCpuTime);
 		
 		// schedule the next iteration if necessary.
 		if (! pTask->bContinue)
@@ -115,8 +165,7 @@ static gboolean _check_for_update_idle (GldiTask *pTask)
 		}
 		else
 		{
-			pTask->iFrequencyState = GLDI_TASK_FREQUENCY_NORMAL;
-			_schedule_next_iteration (pTask);
+			_schedule_next_iteration_within_budget (pTask);
 		}
 		pTask->bIsRunning = FALSE;
 		return FALSE;  // the update is now finished, quit.
@@ -133,7 +182,9 @@ static gpointer _get_data_threaded (GldiTask *pTask)
 	
 	//\_______________________ get the data
 	_set_elapsed_time (pTask);
+	gint64 iCpuTime = _get_thread_cpu_time ();
 	pTask->get_data (pTask->pSharedMemory);
+	pTask->iThreadCpuTime += _get_thread_cpu_time () - iCpuTime;  // it will be attributed to the owner from the main thread.
 	
 	// and signal that data are ready to be processed.
 	pTask->bNeedsUpdate = TRUE;  // this is only accessed by the update fonction, which is triggered just after, so no need to protect this variable.
@@ -161,15 +212,14 @@ void gldi_task_launch (GldiTask *pTask)
 	if (pTask->get_data == NULL)  // no asynchronous work -> just call the 'update' and directly schedule the next iteration
 	{
 		_set_elapsed_time (pTask);
-		pTask->bContinue = pTask->update (pTask->pSharedMemory);
+		pTask->bContinue = _perform_update (pTask);
 		if (! pTask->bContinue)
 		{
 			_cancel_next_iteration (pTask);
 		}
 		else
 		{
-			pTask->iFrequencyState = GLDI_TASK_FREQUENCY_NORMAL;
-			_schedule_next_iteration (pTask);
+			_schedule_next_iteration_within_budget (pTask);
 		}
 	}
 	else  // launch the asynchronous work in a thread
@@ -230,6 +280,7 @@ GldiTask *gldi_task_new_full (int iPeriod, GldiGetDataAsyncFunc get_data, GldiUp
 	pTask->free_data = free_data;
 	pTask->pSharedMemory = pSharedMemory;
 	pTask->pClock = g_timer_new ();
+	pTask->pOwner = gldi_module_instance_get_current ();
 	G_MUTEX_INIT (pTask->pMutex);
 	if (iPeriod != 0)
 	{
@@ -86,6 +86,9 @@ struct _GldiTask {
 	GCond *pCond;  // condition to awake the thread (if periodic).
 	gboolean bRunThread;  // condition value: whether to run the thread or exit.
 	GMutex *pMutex;  // mutex associated with the condition.
+	GldiModuleInstance *pOwner;  // instance that created the Task (see gldi_module_instance_set_current), its CPU time is attributed to it; NULL for the dock itself.
+	gint64 iThreadCpuTime;  // CPU time of the thread since the last update, in us.
+	gboolean bThrottled;  // TRUE if the Task is slowed down because its owner is over its CPU budget.
 } ;
 
 
@@ -0,0 +1,352 @@
+/*
+* This file is a part of the Cairo-Dock project
+*
+* Copyright : (C) see the 'copyright' file.
+* E-mail    : see the 'copyright' file.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 3
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cairo-dock-log.h"
+#include "cairo-dock-icon-factory.h"  // cairo_dock_load_icon_image
+#include "cairo-dock-icon-facility.h"  // cairo_dock_icon_get_allocated_width
+#include "cairo-dock-overlay.h"  // CairoOverlay
+#include "cairo-dock-container.h"  // gldi_container_is_visible
+#include "cairo-dock-dock-factory.h"  // CairoDock
+#include "cairo-dock-dock-manager.h"  // gldi_docks_foreach
+#include "cairo-dock-desklet-factory.h"  // CairoDesklet
+#include "cairo-dock-desklet-manager.h"  // gldi_desklets_foreach
+#include "cairo-dock-profiler.h"  // gldi_profiler_append_json_string
+#include "cairo-dock-draw-opengl.h"  // cairo_dock_get_texture_size
+#include "cairo-dock-texture-manager.h"
+
+
+#define GLDI_TEXTURES_CHECK_PERIOD 30  // s; it's also the precision of the hiding time.
+
+typedef struct {
+	gint64 iHiddenSince;  // time (in s, monotonic) since which the sub-dock is hidden.
+	gboolean bImagesReleased;  // TRUE if its icons have released their images, until it's shown again.
+} GldiHiddenDock;
+
+typedef struct {
+	GldiContainer *pContainer;
+	const gchar *cType;
+	const gchar *cName;
+	gint iNbIcons;
+	gint64 iSurfaceSize;
+	gint64 iTextureSize;
+} GldiContainerImages;
+
+static GHashTable *s_pHiddenDocks = NULL;  // hidden sub-dock -> GldiHiddenDock; kept out of CairoDock to preserve its ABI.
+static gint64 s_iBudget = 0;
+static guint s_iSidCheck = 0;
+static guint s_iNbEvictions = 0;  // number of times a sub-dock released its images
+static guint s_iNbReleasedImages = 0;
+static guint s_iNbRestorations = 0;
+
+
+  ////////////////
+ /// COUNTING ///
+////////////////
+
+void gldi_textures_get_image_buffer_size (const CairoDockImageBuffer *pImage, gint64 *iSurfaceSize, gint64 *iTextureSize)
+{
+	*iSurfaceSize = 0;
+	*iTextureSize = 0;
+	if (pImage->pSurface != NULL && cairo_surface_get_type (pImage->pSurface) == CAIRO_SURFACE_TYPE_IMAGE)
+		*iSurfaceSize = (gint64)cairo_image_surface_get_stride (pImage->pSurface) * cairo_image_surface_get_height (pImage->pSurface);
+	if (pImage->iTexture != 0)
+	{
+		*iTextureSize = cairo_dock_get_texture_size (pImage->iTexture, pImage->iWidth, pImage->iHeight);  // RGBA, + mipmaps
+	}
+}
+
+static void _add_image_buffer (const CairoDockImageBuffer *pImage, GldiContainerImages *pImages)
+{
+	gint64 iSurfaceSize, iTextureSize;
+	gldi_textures_get_image_buffer_size (pImage, &iSurfaceSize, &iTextureSize);
+	pImages->iSurfaceSize += iSurfaceSize;
+	pImages->iTextureSize += iTextureSize;
+}
+
+static void _add_icon (Icon *icon, GldiContainerImages *pImages)
+{
+	if (icon == NULL)
+		return;
+	pImages->iNbIcons ++;
+	_add_image_buffer (&icon->image, pImages);
+	_add_image_buffer (&icon->label, pImages);  // labels may share their surface with other icons (see cairo_dock_create_surface_from_text_cached), so they can be over-estimated.
+	CairoOverlay *pOverlay;
+	GList *ov;
+	for (ov = icon->pOverlays; ov != NULL; ov = ov->next)
+	{
+		pOverlay = ov->data;
+		_add_image_buffer (&pOverlay->image, pImages);
+	}
+}
+
+static void _count_dock (G_GNUC_UNUSED gchar *cDockName, CairoDock *pDock, GList **pList)
+{
+	GldiContainerImages *pImages = g_new0 (GldiContainerImages, 1);
+	pImages->pContainer = CAIRO_CONTAINER (pDock);
+	pImages->cType = (pDock->iRefCount > 0 ? "sub-dock" : "dock");
+	pImages->cName = pDock->cDockName;
+	g_list_foreach (pDock->icons, (GFunc)_add_icon, pImages);
+	*pList = g_list_prepend (*pList, pImages);
+}
+
+static gboolean _count_desklet (CairoDesklet *pDesklet, GList **pList)
+{
+	GldiContainerImages *pImages = g_new0 (GldiContainerImages, 1);
+	pImages->pContainer = CAIRO_CONTAINER (pDesklet);
+	pImages->cType = "desklet";
+	pImages->cName = (pDesklet->pIcon ? pDesklet->pIcon->cName : NULL);
+	_add_icon (pDesklet->pIcon, pImages);
+	g_list_foreach (pDesklet->icons, (GFunc)_add_icon, pImages);
+	*pList = g_list_prepend (*pList, pImages);
+	return FALSE;  // continue
+}
+
+static GList *_count_containers (gint64 *iTotalSize)
+{
+	GList *pList = NULL;
+	gldi_docks_foreach ((GHFunc)_count_dock, &pList);
+	gldi_desklets_foreach ((GldiDeskletForeachFunc)_count_desklet, &pList);
+	gint64 iSize = 0;
+	GldiContainerImages *pImages;
+	GList *c;
+	for (c = pList; c != NULL; c = c->next)
+	{
+		pImages = c->data;
+		iSize += pImages->iSurfaceSize + pImages->iTextureSize;
+	}
+	*iTotalSize = iSize;
+	return pList;
+}
+
+
+  ////////////////
+ /// EVICTION ///
+////////////////
+
+static inline GldiHiddenDock *_get_hidden_dock (CairoDock *pDock)
+{
+	return (s_pHiddenDocks ? g_hash_table_lookup (s_pHiddenDocks, pDock) : NULL);
+}
+
+static gboolean _on_dock_destroyed (G_GNUC_UNUSED gpointer data, CairoDock *pDock)
+{
+	if (s_pHiddenDocks)
+		g_hash_table_remove (s_pHiddenDocks, pDock);
+	return GLDI_NOTIFICATION_LET_PASS;
+}
+
+static inline gboolean _icon_can_be_released (Icon *icon)
+{
+	return (icon->pModuleInstance == NULL  // applets draw their own icon, we couldn't get it back.
+		&& icon->pDataRenderer == NULL
+		&& icon->iSidLoadImage == 0  // it will be loaded anyway
+		&& ! icon->bDamaged
+		&& ! icon->bNeedApplyBackground);
+}
+
+static gint64 _release_dock (CairoDock *pDock, GldiHiddenDock *pHidden)
+{
+	gint64 iSize = 0, iSurfaceSize, iTextureSize;
+	Icon *icon;
+	GList *ic;
+	for (ic = pDock->icons; ic != NULL; ic = ic->next)
+	{
+		icon = ic->data;
+		if (! _icon_can_be_released (icon) || (icon->image.pSurface == NULL && icon->image.iTexture == 0))
+			continue;
+		gldi_textures_get_image_buffer_size (&icon->image, &iSurfaceSize, &iTextureSize);
+		iSize += iSurfaceSize + iTextureSize;
+		cairo_dock_unload_image_buffer (&icon->image);  // the label and the overlays are kept, they are small and can't always be rebuilt.
+		s_iNbReleasedImages ++;
+	}
+	pHidden->bImagesReleased = TRUE;
+	s_iNbEvictions ++;
+	cd_debug ("the sub-dock %s released %" G_GINT64_FORMAT " kB of images", pDock->cDockName, iSize / 1024);
+	return iSize;
+}
+
+void gldi_textures_restore_dock (CairoDock *pDock)
+{
+	GldiHiddenDock *pHidden = (pDock ? _get_hidden_dock (pDock) : NULL);
+	if (pHidden == NULL || ! pHidden->bImagesReleased)
+		return;
+	pHidden->bImagesReleased = FALSE;
+	cd_debug ("the sub-dock %s loads its images again", pDock->cDockName);
+	Icon *icon;
+	GList *ic;
+	for (ic = pDock->icons; ic != NULL; ic = ic->next)  // load them now rather than in an idle, so that the dock doesn't show empty icons first.
+	{
+		icon = ic->data;
+		if (_icon_can_be_released (icon)
+		&& icon->image.pSurface == NULL && icon->image.iTexture == 0
+		&& cairo_dock_icon_get_allocated_width (icon) > 0)
+			cairo_dock_load_icon_image (icon, CAIRO_CONTAINER (pDock));
+	}
+	s_iNbRestorations ++;
+}
+
+static gint _compare_hiding_time (GldiContainerImages *pImages1, GldiContainerImages *pImages2)
+{
+	GldiHiddenDock *pHidden1 = _get_hidden_dock (CAIRO_DOCK (pImages1->pContainer));
+	GldiHiddenDock *pHidden2 = _get_hidden_dock (CAIRO_DOCK (pImages2->pContainer));
+	return (pHidden1->iHiddenSince < pHidden2->iHiddenSince ? -1 : pHidden1->iHiddenSince > pHidden2->iHiddenSince ? 1 : 0);  // oldest first
+}
+
+static gboolean _check_containers (G_GNUC_UNUSED gpointer data)
+{
+	gint64 t = g_get_monotonic_time () / G_USEC_PER_SEC;
+	gint64 iTotalSize;
+	GList *pList = _count_containers (&iTotalSize);
+
+	//\_____________ update the hiding time of the sub-docks, and release the ones that have been hidden for too long.
+	GList *pCandidates = NULL;
+	GldiContainerImages *pImages;
+	GldiHiddenDock *pHidden;
+	CairoDock *pDock;
+	GList *c;
+	for (c = pList; c != NULL; c = c->next)
+	{
+		pImages = c->data;
+		if (! CAIRO_DOCK_IS_DOCK (pImages->pContainer))
+			continue;
+		pDock = CAIRO_DOCK (pImages->pContainer);
+		pHidden = _get_hidden_dock (pDock);
+		if (pDock->iRefCount == 0 || gldi_container_is_visible (pImages->pContainer))  // shown, or not a sub-dock any more.
+		{
+			if (pHidden != NULL)
+			{
+				gldi_textures_restore_dock (pDock);  // in case it was shown without going through cairo_dock_show_subdock.
+				g_hash_table_remove (s_pHiddenDocks, pDock);
+			}
+			continue;
+		}
+		if (pHidden == NULL)
+		{
+			pHidden = g_new0 (GldiHiddenDock, 1);
+			pHidden->iHiddenSince = t;
+			g_hash_table_insert (s_pHiddenDocks, pDock, pHidden);
+		}
+		if (pHidden->bImagesReleased || t - pHidden->iHiddenSince < GLDI_TEXTURES_CHECK_PERIOD)  // let it be hidden for a moment, it's often opened again just after.
+			continue;
+		if (t - pHidden->iHiddenSince >= GLDI_TEXTURES_EVICTION_DELAY)
+			iTotalSize -= _release_dock (pDock, pHidden);
+		else
+			pCandidates = g_list_prepend (pCandidates, pImages);
+	}
+
+	//\_____________ if we're over budget, release the other hidden sub-docks, the oldest first.
+	if (s_iBudget > 0 && iTotalSize > s_iBudget)
+	{
+		pCandidates = g_list_sort (pCandidates, (GCompareFunc)_compare_hiding_time);
+		for (c = pCandidates; c != NULL && iTotalSize > s_iBudget; c = c->next)
+		{
+			pImages = c->data;
+			pDock = CAIRO_DOCK (pImages->pContainer);
+			iTotalSize -= _release_dock (pDock, _get_hidden_dock (pDock));
+		}
+		if (iTotalSize > s_iBudget)
+			cd_debug ("the images take %" G_GINT64_FORMAT " kB, more than the budget (%" G_GINT64_FORMAT " kB)", iTotalSize / 1024, s_iBudget / 1024);
+	}
+
+	g_list_free (pCandidates);
+	g_list_free_full (pList, g_free);
+	return TRUE;
+}
+
+void gldi_textures_set_budget (gint64 iBudget)
+{
+	s_iBudget = MAX (0, iBudget);
+	if (s_iSidCheck != 0)
+		_check_containers (NULL);  // apply it now.
+}
+
+void gldi_textures_init (void)
+{
+	if (s_iSidCheck != 0)
+		return;
+	s_pHiddenDocks = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
+	gldi_object_register_notification (&myDockObjectMgr,
+		NOTIFICATION_DESTROY,
+		(GldiNotificationFunc) _on_dock_destroyed,
+		GLDI_RUN_AFTER, NULL);
+	s_iSidCheck = g_timeout_add_seconds (GLDI_TEXTURES_CHECK_PERIOD, (GSourceFunc)_check_containers, NULL);
+}
+
+
+  //////////////
+ /// REPORT ///
+//////////////
+
+static gint _compare_size (GldiContainerImages *pImages1, GldiContainerImages *pImages2)
+{
+	gint64 iSize1 = pImages1->iSurfaceSize + pImages1->iTextureSize;
+	gint64 iSize2 = pImages2->iSurfaceSize + pImages2->iTextureSize;
+	return (iSize1 < iSize2 ? 1 : iSize1 > iSize2 ? -1 : 0);  // biggest first
+}
+
+gchar *gldi_textures_get_report (void)
+{
+	gint64 t = g_get_monotonic_time () / G_USEC_PER_SEC;
+	gint64 iTotalSize;
+	GList *pList = _count_containers (&iTotalSize);
+	pList = g_list_sort (pList, (GCompareFunc)_compare_size);
+
+	gint64 iSurfaceSize = 0, iTextureSize = 0;
+	GldiContainerImages *pImages;
+	GList *c;
+	for (c = pList; c != NULL; c = c->next)
+	{
+		pImages = c->data;
+		iSurfaceSize += pImages->iSurfaceSize;
+		iTextureSize += pImages->iTextureSize;
+	}
+
+	GString *sJson = g_string_new ("");
+	g_string_append_printf (sJson, "{\"surfaces_kb\": %" G_GINT64_FORMAT ", \"textures_kb\": %" G_GINT64_FORMAT ", \"budget_kb\": %" G_GINT64_FORMAT ", \"evictions\": %u, \"released_images\": %u, \"restorations\": %u,\n \"containers\": [",
+		iSurfaceSize / 1024,
+		iTextureSize / 1024,
+		s_iBudget / 1024,
+		s_iNbEvictions,
+		s_iNbReleasedImages,
+		s_iNbRestorations);
+	GldiHiddenDock *pHidden;
+	for (c = pList; c != NULL; c = c->next)
+	{
+		pImages = c->data;
+		g_string_append_printf (sJson, "%s\n  {\"type\": \"%s\", \"name\": ", c == pList ? "" : ",", pImages->cType);
+		gldi_profiler_append_json_string (sJson, pImages->cName);
+		g_string_append_printf (sJson, ", \"visible\": %s, \"icons\": %d, \"surfaces_kb\": %" G_GINT64_FORMAT ", \"textures_kb\": %" G_GINT64_FORMAT,
+			gldi_container_is_visible (pImages->pContainer) ? "true" : "false",
+			pImages->iNbIcons,
+			pImages->iSurfaceSize / 1024,
+			pImages->iTextureSize / 1024);
+		if (CAIRO_DOCK_IS_DOCK (pImages->pContainer))
+		{
+			pHidden = _get_hidden_dock (CAIRO_DOCK (pImages->pContainer));
+			g_string_append_printf (sJson, ", \"hidden_s\": %" G_GINT64_FORMAT ", \"released\": %s",
+				pHidden != NULL ? t - pHidden->iHiddenSince : 0,
+				pHidden != NULL && pHidden->bImagesReleased ? "true" : "false");
+		}
+		g_string_append_c (sJson, '}');
+	}
+	g_string_append (sJson, "]}");
+
+	g_list_free_full (pList, g_free);
+	return g_string_free (sJson, FALSE);
+}
@@ -0,0 +1,69 @@
+/*
+* This file is a part of the Cairo-Dock project
+*
+* Copyright : (C) see the 'copyright' file.
+* E-mail    : see the 'copyright' file.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 3
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __CAIRO_DOCK_TEXTURE_MANAGER__
+#define  __CAIRO_DOCK_TEXTURE_MANAGER__
+
+#include <glib.h>
+
+#include "cairo-dock-struct.h"
+G_BEGIN_DECLS
+
+/**
+*@file cairo-dock-texture-manager.h Keeps the memory taken by the images of the icons under control.
+ *
+ * The images of the icons (surfaces in RAM, textures on the graphic card) are counted per container.
+ * The images of a sub-dock that has been hidden for a long time are released, and loaded again from their source (file, window icon, ...) as soon as they are needed (the sub-dock is shown, its content is drawn on its icon, ...).
+ * With a budget, the hidden sub-docks are released earlier, the oldest first, until the images of all the containers fit in it.
+ * Only the images that the dock can load again by itself are released: those of applets and data-renderers are left untouched.
+ *
+ * The counters can be read on the bus, through the service of the profiler (see cairo-dock-profiler.h).
+ */
+
+/// Number of seconds a sub-dock must stay hidden before its images are released.
+#define GLDI_TEXTURES_EVICTION_DELAY 600
+
+/** Start watching the containers. Called once at init.
+*/
+void gldi_textures_init (void);
+
+/** Set the maximum memory the images of the icons should take. When it's exceeded, the hidden sub-docks release their images without waiting.
+*@param iBudget the budget in bytes (surfaces + textures), or 0 for no limit.
+*/
+void gldi_textures_set_budget (gint64 iBudget);
+
+/** Load again the images of a dock that were released. Does nothing if the dock didn't release anything.
+*@param pDock the dock
+*/
+void gldi_textures_restore_dock (CairoDock *pDock);
+
+/** Get the memory taken by an image buffer.
+*@param pImage the image buffer
+*@param iSurfaceSize returns the size of its surface, in bytes
+*@param iTextureSize returns the size of its texture, in bytes
+*/
+void gldi_textures_get_image_buffer_size (const CairoDockImageBuffer *pImage, gint64 *iSurfaceSize, gint64 *iTextureSize);
+
+/** Get a report of the memory taken by the images, as JSON: the totals, the budget, the number of releases, and the detail per container, biggest first.
+*@return the report, to be freed with g_free.
+*/
+gchar *gldi_textures_get_report (void);
+
+G_END_DECLS
+#endif
@@ -0,0 +1,215 @@
+/**
+* This file is a part of the Cairo-Dock project
+*
+* Copyright : (C) see the 'copyright' file.
+* E-mail    : see the 'copyright' file.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 3
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+
+#include "cairo-dock-log.h"
+#include "cairo-dock-trace.h"
+
+#define GLDI_TRACE_MAX_EVENTS 256
+
+typedef struct {
+	gint64 iTime;  // monotonic time, in us
+	guint iEvent;
+	gint64 iData[2];
+} GldiTraceEntry;
+
+typedef struct _GldiTraceRing GldiTraceRing;
+struct _GldiTraceRing {
+	GldiTraceEntry pEntries[GLDI_TRACE_RING_SIZE];
+	gint iNbEntries;  // total number of events written; only the owner thread writes it
+	gint iFree;  // 1 if its thread has ended and it can be reused by another one
+	guint iThreadNum;
+	GldiTraceRing *pNext;  // rings are never freed
+};
+
+gboolean g_bGldiTraceEnabled = FALSE;
+
+static const gchar *s_cEventNames[GLDI_TRACE_MAX_EVENTS] = {"none"};
+static gint s_iNbEvents = 1;
+static GldiTraceRing *s_pRings = NULL;  // list of rings, only prepended
+static gint s_iNbRings = 0;
+static gchar *s_cDumpFilePath = NULL;
+G_LOCK_DEFINE_STATIC (s_events);
+
+  ////////////
+ /// RING ///
+////////////
+
+#ifdef GLIB_VERSION_2_32
+static void _release_ring (GldiTraceRing *pRing)
+{
+	g_atomic_int_set (&pRing->iFree, 1);
+}
+static GPrivate s_pThreadRing = G_PRIVATE_INIT ((GDestroyNotify)_release_ring);
+
+static GldiTraceRing *_get_thread_ring (void)
+{
+	GldiTraceRing *pRing = g_private_get (&s_pThreadRing);
+	if (G_LIKELY (pRing != NULL))
+		return pRing;
+	
+	// take the ring of a finished thread, or make a new one.
+	for (pRing = g_atomic_pointer_get (&s_pRings); pRing != NULL; pRing = pRing->pNext)
+	{
+		if (g_atomic_int_compare_and_exchange (&pRing->iFree, 1, 0))
+			break;
+	}
+	if (pRing == NULL)
+	{
+		pRing = g_new0 (GldiTraceRing, 1);
+		pRing->iThreadNum = g_atomic_int_add (&s_iNbRings, 1);
+		do
+		{
+			pRing->pNext = g_atomic_pointer_get (&s_pRings);
+		}
+		while (! g_atomic_pointer_compare_and_exchange (&s_pRings, pRing->pNext, pRing));
+	}
+	g_private_set (&s_pThreadRing, pRing);
+	return pRing;
+}
+
+void gldi_trace_record (guint iEvent, gint64 a, gint64 b)
+{
+	GldiTraceRing *pRing = _get_thread_ring ();
+	guint n = (guint) pRing->iNbEntries;
+	GldiTraceEntry *pEntry = &pRing->pEntries[n & (GLDI_TRACE_RING_SIZE - 1)];
+	pEntry->iTime = g_get_monotonic_time ();
+	pEntry->iEvent = iEvent;
+	pEntry->iData[0] = a;
+	pEntry->iData[1] = b;
+	g_atomic_int_set (&pRing->iNbEntries, (gint)(n + 1));  // publish the event (full barrier)
+}
+#else
+void gldi_trace_record (G_GNUC_UNUSED guint iEvent, G_GNUC_UNUSED gint64 a, G_GNUC_UNUSED gint64 b)
+{
+	// no thread-local storage with this version of GLib.
+}
+#endif
+
+guint gldi_trace_register_event (const gchar *cName)
+{
+	g_return_val_if_fail (cName != NULL, 0);
+	G_LOCK (s_events);
+	guint iEvent = 0;
+	int i;
+	for (i = 1; i < s_iNbEvents; i ++)  // already registered (a module that is reloaded, for instance).
+	{
+		if (strcmp (s_cEventNames[i], cName) == 0)
+		{
+			iEvent = i;
+			break;
+		}
+	}
+	if (iEvent == 0 && s_iNbEvents < GLDI_TRACE_MAX_EVENTS)
+	{
+		s_cEventNames[s_iNbEvents] = cName;
+		iEvent = s_iNbEvents;
+		g_atomic_int_set (&s_iNbEvents, s_iNbEvents + 1);
+	}
+	G_UNLOCK (s_events);
+	if (iEvent == 0)
+		cd_warning ("too many trace events, '%s' will not be traced", cName);
+	return iEvent;
+}
+
+  ////////////
+ /// DUMP ///
+////////////
+
+// printf is not async-signal-safe, so we format the numbers ourselves.
+static void _write_str (int fd, const char *str)
+{
+	ssize_t r = write (fd, str, strlen (str));
+	(void)r;
+}
+static void _write_int (int fd, gint64 i)
+{
+	char buf[24];
+	int k = sizeof (buf) - 1;
+	buf[k] = '\0';
+	guint64 u = (i < 0 ? - (guint64)i : (guint64)i);
+	do
+	{
+		buf[--k] = '0' + (u % 10);
+		u /= 10;
+	}
+	while (u != 0);
+	if (i < 0)
+		buf[--k] = '-';
+	_write_str (fd, &buf[k]);
+}
+
+void gldi_trace_dump (int fd)
+{
+	gint iNbEvents = g_atomic_int_get (&s_iNbEvents);
+	_write_str (fd, "# time(us) thread event a b\n");
+	GldiTraceRing *pRing;
+	for (pRing = g_atomic_pointer_get (&s_pRings); pRing != NULL; pRing = pRing->pNext)
+	{
+		guint n = (guint) g_atomic_int_get (&pRing->iNbEntries);
+		guint k = (n > GLDI_TRACE_RING_SIZE ? n - GLDI_TRACE_RING_SIZE : 0);
+		for (; k != n; k ++)
+		{
+			GldiTraceEntry *pEntry = &pRing->pEntries[k & (GLDI_TRACE_RING_SIZE - 1)];
+			_write_int (fd, pEntry->iTime);
+			_write_str (fd, " ");
+			_write_int (fd, pRing->iThreadNum);
+			_write_str (fd, " ");
+			_write_str (fd, (pEntry->iEvent < (guint)iNbEvents ? s_cEventNames[pEntry->iEvent] : "?"));
+			_write_str (fd, " ");
+			_write_int (fd, pEntry->iData[0]);
+			_write_str (fd, " ");
+			_write_int (fd, pEntry->iData[1]);
+			_write_str (fd, "\n");
+		}
+	}
+}
+
+void gldi_trace_dump_to_file (void)
+{
+	if (! g_bGldiTraceEnabled || s_cDumpFilePath == NULL)
+		return;
+	int fd = open (s_cDumpFilePath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		return;
+	gldi_trace_dump (fd);
+	close (fd);
+}
+
+static void _on_dump_signal (G_GNUC_UNUSED int signal)
+{
+	gldi_trace_dump_to_file ();
+}
+
+void gldi_trace_enable (gboolean bEnable)
+{
+	if (bEnable && s_cDumpFilePath == NULL)
+	{
+		s_cDumpFilePath = g_strdup_printf ("%s/cairo-dock-trace-%d.txt", g_get_tmp_dir (), getpid ());  // computed now, we can't allocate in a signal handler.
+		signal (SIGUSR2, _on_dump_signal);
+		int fd = open (s_cDumpFilePath, O_WRONLY | O_CREAT | O_TRUNC, 0644);  // an empty dump tells the outside that the signal can be sent now.
+		if (fd >= 0)
+			close (fd);
+		cd_message ("trace enabled; send SIGUSR2 to dump it into %s", s_cDumpFilePath);
+	}
+	g_bGldiTraceEnabled = bEnable;
+}
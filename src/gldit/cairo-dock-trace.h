@@ -0,0 +1,79 @@
+/*
+* This file is a part of the Cairo-Dock project
+*
+* Copyright : (C) see the 'copyright' file.
+* E-mail    : see the 'copyright' file.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 3
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __CAIRO_DOCK_TRACE__
+#define  __CAIRO_DOCK_TRACE__
+
+#include <glib.h>
+G_BEGIN_DECLS
+
+/**
+*@file cairo-dock-trace.h A light binary trace of what the dock is doing, to diagnose latencies without verbose logs.
+ *
+ * Each thread records its events into its own ring buffer (timestamp, event ID, 2 integers), without any lock or formatting; older events are overwritten. The rings can be dumped as text on demand (SIGUSR2, or \ref gldi_trace_dump) or when the dock crashes.
+ * 
+ * Register an event once with \ref gldi_trace_register_event, then record it with \ref gldi_trace; when the trace is disabled (the default), it costs a single test.
+ */
+
+/// Number of events kept per thread (power of 2).
+#define GLDI_TRACE_RING_SIZE 4096
+
+extern gboolean g_bGldiTraceEnabled;
+
+/** Record an event into the ring of the current thread, if the trace is enabled.
+*@param iEvent an event ID given by \ref gldi_trace_register_event
+*@param a first data of the event
+*@param b second data of the event
+*/
+#define gldi_trace(iEvent, a, b) do {\
+	if (G_UNLIKELY (g_bGldiTraceEnabled))\
+		gldi_trace_record (iEvent, a, b);\
+	} while (0)
+
+/** Get the ID of an event, registering it the first time. Typically used with a static variable, in the places where the trace is enabled.
+*@param pEventId pointer to the variable holding the ID (0 if not yet registered)
+*@param cName name of the event (a static string)
+*/
+#define gldi_trace_get_event(pEventId, cName) (*(pEventId) != 0 ? *(pEventId) : (*(pEventId) = gldi_trace_register_event (cName)))
+
+// internal function
+void gldi_trace_record (guint iEvent, gint64 a, gint64 b);
+
+/** Register a new kind of event.
+*@param cName its name, as it will appear in the dumps (a static string).
+*@return the ID of the event, or 0 if there are too many events.
+*/
+guint gldi_trace_register_event (const gchar *cName);
+
+/** Enable or disable the trace. When enabled, SIGUSR2 dumps the trace in a file of the temporary folder; this file is created empty as soon as the signal can be sent.
+*@param bEnable TRUE to enable it
+*/
+void gldi_trace_enable (gboolean bEnable);
+
+/** Write the events of all the threads, oldest first for each of them. Only uses async-signal-safe functions, so it can be called from a signal handler (the events being written at the same moment may be inconsistent).
+*@param fd a file descriptor
+*/
+void gldi_trace_dump (int fd);
+
+/** Dump the trace into the file given by \ref gldi_trace_enable, if enabled. Can be called from a signal handler.
+*/
+void gldi_trace_dump_to_file (void);
+
+G_END_DECLS
+#endif
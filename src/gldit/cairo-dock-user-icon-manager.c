@@ -17,6 +17,7 @@
 * along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <string.h>  // strcmp
 #include <glib/gstdio.h>
 
 #include "cairo-dock-icon-facility.h"  // cairo_dock_compare_icons_order
@@ -40,12 +41,8 @@ extern gchar *g_cCurrentLaunchersPath;
 // private
 
 
-Icon *gldi_user_icon_new (const gchar *cConfFile)
+static Icon *_user_icon_new (const gchar *cConfFile, GKeyFile *pKeyFile, gchar *cDesktopFilePath)  // takes ownership of the key-file and the path.
 {
-	gchar *cDesktopFilePath = g_strdup_printf ("%s/%s", g_cCurrentLaunchersPath, cConfFile);
-	GKeyFile* pKeyFile = cairo_dock_open_key_file (cDesktopFilePath);
-	g_return_val_if_fail (pKeyFile != NULL, NULL);
-	
 	Icon *pIcon = NULL;
 	
 	//\__________________ get the type of the icon
@@ -96,6 +93,8 @@ Icon *gldi_user_icon_new (const gchar *cConfFile)
 		break;
 		default:
 			cd_warning ("unknown user icon type for file %s", cDesktopFilePath);
+			g_free (cDesktopFilePath);
+			g_key_file_free (pKeyFile);
 		return NULL;
 	}
 	
@@ -110,41 +109,93 @@ Icon *gldi_user_icon_new (const gchar *cConfFile)
 	return pIcon;
 }
 
+Icon *gldi_user_icon_new (const gchar *cConfFile)
+{
+	gchar *cDesktopFilePath = g_strdup_printf ("%s/%s", g_cCurrentLaunchersPath, cConfFile);
+	GKeyFile* pKeyFile = cairo_dock_open_key_file (cDesktopFilePath);
+	if (pKeyFile == NULL)  // a warning has already been emitted
+	{
+		g_free (cDesktopFilePath);
+		return NULL;
+	}
+	return _user_icon_new (cConfFile, pKeyFile, cDesktopFilePath);
+}
+
 
-void gldi_user_icons_new_from_directory (const gchar *cDirectory)
+static void _insert_user_icon (Icon *icon, const gchar *cFileName)
 {
-	cd_message ("%s (%s)", __func__, cDirectory);
+	if (icon == NULL || icon->cDesktopFileName == NULL)  // if the icon couldn't be loaded, remove it from the theme (it's useless to try and fail to load it each time).
+	{
+		if (icon)
+			gldi_object_unref (GLDI_OBJECT(icon));
+		cd_warning ("Unable to load a valid icon from '%s/%s'; the file is either unreadable, unvalid or does not correspond to any installed program, and will be deleted", g_cCurrentLaunchersPath, cFileName);
+		gchar *cDesktopFilePath = g_strdup_printf ("%s/%s", g_cCurrentLaunchersPath, cFileName);
+		cairo_dock_delete_conf_file (cDesktopFilePath);
+		g_free (cDesktopFilePath);
+		return;
+	}
+	
+	CairoDock *pParentDock = gldi_dock_get (icon->cParentDockName);
+	if (pParentDock != NULL)  // a priori toujours vrai.
+	{
+		gldi_icon_insert_in_container (icon, CAIRO_CONTAINER(pParentDock), ! CAIRO_DOCK_ANIMATE_ICON);
+	}
+}
+
+GList *gldi_user_icons_new_from_directory_full (const gchar *cDirectory, const gchar *cDockName)
+{
+	cd_message ("%s (%s, %s)", __func__, cDirectory, cDockName);
 	GDir *dir = g_dir_open (cDirectory, 0, NULL);
-	g_return_if_fail (dir != NULL);
+	g_return_val_if_fail (dir != NULL, NULL);
 	
+	GList *pSkippedFiles = NULL;
 	Icon* icon;
 	const gchar *cFileName;
-	CairoDock *pParentDock;
-
+	gchar *cDesktopFilePath, *cContainer;
+	GKeyFile *pKeyFile;
+	gboolean bInDock;
 	while ((cFileName = g_dir_read_name (dir)) != NULL)
 	{
-		if (g_str_has_suffix (cFileName, ".desktop"))
+		if (! g_str_has_suffix (cFileName, ".desktop"))
+			continue;
+		if (cDockName == NULL)
 		{
 			icon = gldi_user_icon_new (cFileName);
-			if (icon == NULL || icon->cDesktopFileName == NULL)  // if the icon couldn't be loaded, remove it from the theme (it's useless to try and fail to load it each time).
+		}
+		else  // only load the icons of this dock now.
+		{
+			cDesktopFilePath = g_strdup_printf ("%s/%s", g_cCurrentLaunchersPath, cFileName);
+			pKeyFile = cairo_dock_open_key_file (cDesktopFilePath);
+			if (pKeyFile == NULL)
 			{
-				if (icon)
-					gldi_object_unref (GLDI_OBJECT(icon));
-				cd_warning ("Unable to load a valid icon from '%s/%s'; the file is either unreadable, unvalid or does not correspond to any installed program, and will be deleted", g_cCurrentLaunchersPath, cFileName);
-				gchar *cDesktopFilePath = g_strdup_printf ("%s/%s", g_cCurrentLaunchersPath, cFileName);
-				cairo_dock_delete_conf_file (cDesktopFilePath);
 				g_free (cDesktopFilePath);
-				continue;
+				icon = NULL;
 			}
-			
-			pParentDock = gldi_dock_get (icon->cParentDockName);
-			if (pParentDock != NULL)  // a priori toujours vrai.
+			else
 			{
-				gldi_icon_insert_in_container (icon, CAIRO_CONTAINER(pParentDock), ! CAIRO_DOCK_ANIMATE_ICON);
+				cContainer = g_key_file_get_string (pKeyFile, "Desktop Entry", "Container", NULL);
+				bInDock = (cContainer == NULL || *cContainer == '\0' ? strcmp (cDockName, CAIRO_DOCK_MAIN_DOCK_NAME) == 0 : strcmp (cDockName, cContainer) == 0);
+				g_free (cContainer);
+				if (! bInDock)
+				{
+					pSkippedFiles = g_list_prepend (pSkippedFiles, g_strdup (cFileName));
+					g_key_file_free (pKeyFile);
+					g_free (cDesktopFilePath);
+					continue;
+				}
+				icon = _user_icon_new (cFileName, pKeyFile, cDesktopFilePath);
 			}
 		}
+		_insert_user_icon (icon, cFileName);
 	}
 	g_dir_close (dir);
+	return pSkippedFiles;
+}
+
+void gldi_user_icon_load (const gchar *cConfFile)
+{
+	Icon *icon = gldi_user_icon_new (cConfFile);
+	_insert_user_icon (icon, cConfFile);
 }
 
 
@@ -71,7 +71,19 @@ typedef enum {
 Icon *gldi_user_icon_new (const gchar *cConfFile);
 
 
-void gldi_user_icons_new_from_directory (const gchar *cDirectory);
+/** Load the user icons (launchers, sub-dock icons, separators) of a directory, and insert them into their dock.
+*@param cDirectory the directory
+*@param cDockName if not NULL, only the icons that belong to this dock are loaded now.
+*@return the list of the file names that have been skipped, to be loaded later with \ref gldi_user_icon_load.
+*/
+GList *gldi_user_icons_new_from_directory_full (const gchar *cDirectory, const gchar *cDockName);
+
+#define gldi_user_icons_new_from_directory(cDirectory) gldi_user_icons_new_from_directory_full (cDirectory, NULL)
+
+/** Load a user icon and insert it into its dock. If it can't be loaded, its file is removed from the theme.
+*@param cConfFile name of the .desktop file, inside the launchers folder.
+*/
+void gldi_user_icon_load (const gchar *cConfFile);
 
 
 void gldi_register_user_icons_manager (void);
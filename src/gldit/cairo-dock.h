@@ -50,6 +50,7 @@
 #include <gldit/cairo-dock-class-icon-manager.h>
 #include <gldit/cairo-dock-application-facility.h>
 #include <gldit/cairo-dock-icon-facility.h>
+#include <gldit/cairo-dock-icon-index.h>
 #include <gldit/cairo-dock-icon-factory.h>
 #include "gldi-icon-names.h"
 // managers.
@@ -90,10 +91,13 @@
 #include <gldit/cairo-dock-keyfile-utilities.h>
 #include <gldit/cairo-dock-keybinder.h>
 #include <gldit/cairo-dock-task.h>
+#include <gldit/cairo-dock-trace.h>
+#include <gldit/cairo-dock-profiler.h>
 #include <gldit/cairo-dock-particle-system.h>
 #include <gldit/cairo-dock-packages.h>
 #include <gldit/cairo-dock-surface-factory.h>
 #include <gldit/cairo-dock-image-buffer.h>
+#include <gldit/cairo-dock-texture-manager.h>
 #include <gldit/cairo-dock-style-facility.h>
 #include <gldit/cairo-dock-style-manager.h>
 
@@ -49,6 +49,8 @@
 #include "cairo-dock-container.h"  // GldiContainerManagerBackend
 #include "cairo-dock-X-utilities.h"
 #include "cairo-dock-task.h"
+#include "cairo-dock-trace.h"  // gldi_trace
+#include "cairo-dock-profiler.h"  // gldi_profile_begin
 #include "cairo-dock-glx.h"
 #include "cairo-dock-egl.h"
 #define _MANAGER_DEF_
@@ -365,6 +367,9 @@ static gboolean _cairo_dock_unstack_Xevents (G_GNUC_UNUSED gpointer data)
 	Window Xid;
 	Window root = DefaultRootWindow (s_XDisplay);
 	
+	gint64 iTraceStartTime = (G_UNLIKELY (g_bGldiTraceEnabled) ? g_get_monotonic_time () : 0);
+	gint64 iProfileTime = gldi_profile_begin ();
+	
 	// read the messages on the fd, and put them in the event queue
 	int i, nb_msg = XEventsQueued (s_XDisplay, QueuedAfterReading);
 	//g_print ("%d X msg\n", nb_msg);
@@ -379,7 +384,12 @@ static gboolean _cairo_dock_unstack_Xevents (G_GNUC_UNUSED gpointer data)
 		// process the event
 		if (event.type == ClientMessage)  // inter-client message
 		{
-			cd_debug ("+ message: %s (%ld/%ld)", XGetAtomName (s_XDisplay, event.xclient.message_type), Xid, root);
+			if (cd_log_is_enabled (G_LOG_LEVEL_DEBUG))  // XGetAtomName is a round-trip to the server.
+			{
+				char *cAtomName = XGetAtomName (s_XDisplay, event.xclient.message_type);
+				cd_debug ("+ message: %s (%ld/%ld)", cAtomName, Xid, root);
+				XFree (cAtomName);
+			}
 			
 			// make a new message or get the existing one from previous startup events on this window
 			GString *pMsg = NULL;
@@ -723,6 +733,14 @@ static gboolean _cairo_dock_unstack_Xevents (G_GNUC_UNUSED gpointer data)
 	}
 	
 	XFlush (s_XDisplay);  // now that there are no more messages in the input queue, flush the output queue
+	
+	if (G_UNLIKELY (g_bGldiTraceEnabled) && nb_msg != 0)
+	{
+		static guint s_iXEventsEvent = 0;
+		gldi_trace (gldi_trace_get_event (&s_iXEventsEvent, "x-events"), nb_msg, g_get_monotonic_time () - iTraceStartTime);  // nb events, duration
+	}
+	if (nb_msg != 0)  // don't count the empty polls
+		gldi_profile_end (iProfileTime, GLDI_PROFILE_X_EVENTS, (gconstpointer)_cairo_dock_unstack_Xevents, "X events", NULL);
 	return TRUE;
 }
 
@@ -842,6 +860,59 @@ static cairo_surface_t *_get_desktop_bg_surface (void)  // attention : fonction
 	return pDesktopBgSurface;
 }
 
+typedef struct {
+	gchar *cDisplayName;
+	Pixmap iRootPixmapID;
+	int iDesktopWidth, iDesktopHeight;
+	} CDDesktopBgCapture;
+
+static gpointer _prepare_desktop_bg_capture (void)  // main thread: only reads the ID of the pixmap; the thread grabs it on its own X connection, since Xlib is not initialized for threads.
+{
+	Pixmap iRootPixmapID = cairo_dock_get_window_background_pixmap (DefaultRootWindow (s_XDisplay));
+	if (iRootPixmapID == 0)
+		return NULL;
+	CDDesktopBgCapture *pCapture = g_new0 (CDDesktopBgCapture, 1);
+	pCapture->cDisplayName = g_strdup (DisplayString (s_XDisplay));
+	pCapture->iRootPixmapID = iRootPixmapID;
+	pCapture->iDesktopWidth = gldi_desktop_get_width();
+	pCapture->iDesktopHeight = gldi_desktop_get_height();
+	return pCapture;
+}
+
+static cairo_surface_t *_capture_desktop_bg_surface (gpointer data)  // called in a thread: no access to the dock here.
+{
+	CDDesktopBgCapture *pCapture = data;
+	cairo_surface_t *pBgSurface = cairo_dock_create_surface_from_pixmap (pCapture->cDisplayName, pCapture->iRootPixmapID);
+	if (pBgSurface == NULL)
+		return NULL;
+	int iWidth = cairo_image_surface_get_width (pBgSurface);
+	int iHeight = cairo_image_surface_get_height (pBgSurface);
+	if (iWidth >= pCapture->iDesktopWidth && iHeight >= pCapture->iDesktopHeight)  // image
+		return pBgSurface;
+	
+	// single color or pattern/color gradation -> repeat it over the whole desktop.
+	cairo_surface_t *pDesktopBgSurface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32,
+		pCapture->iDesktopWidth,
+		pCapture->iDesktopHeight);
+	cairo_t *pCairoContext = cairo_create (pDesktopBgSurface);
+	cairo_pattern_t *pPattern = cairo_pattern_create_for_surface (pBgSurface);
+	cairo_pattern_set_extend (pPattern, CAIRO_EXTEND_REPEAT);
+	cairo_set_source (pCairoContext, pPattern);
+	cairo_set_operator (pCairoContext, CAIRO_OPERATOR_SOURCE);
+	cairo_paint (pCairoContext);
+	cairo_destroy (pCairoContext);
+	cairo_pattern_destroy (pPattern);
+	cairo_surface_destroy (pBgSurface);
+	return pDesktopBgSurface;
+}
+
+static void _free_desktop_bg_capture (gpointer data)
+{
+	CDDesktopBgCapture *pCapture = data;
+	g_free (pCapture->cDisplayName);
+	g_free (pCapture);
+}
+
 
 static void _refresh (void)
 {
@@ -1232,6 +1303,9 @@ static void init (void)
 	dmb.get_desktops_names     = _get_desktops_names;
 	dmb.set_desktops_names     = _set_desktops_names;
 	dmb.get_desktop_bg_surface = _get_desktop_bg_surface;
+	dmb.prepare_desktop_bg_capture = _prepare_desktop_bg_capture;
+	dmb.capture_desktop_bg_surface = _capture_desktop_bg_surface;
+	dmb.free_desktop_bg_capture    = _free_desktop_bg_capture;
 	dmb.set_current_desktop    = _set_current_desktop;
 	dmb.set_nb_desktops        = _set_nb_desktops;
 	dmb.refresh                = _refresh;
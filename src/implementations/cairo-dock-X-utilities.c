@@ -30,6 +30,9 @@
 #include <X11/extensions/Xinerama.h>  // Note: Xinerama is deprecated by XRandr >= 1.3
 #endif
 #include <X11/extensions/Xrandr.h>
+#include <X11/extensions/XShm.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
 #endif
 
 #include "cairo-dock-log.h"
@@ -37,6 +40,7 @@
 #include "cairo-dock-surface-factory.h"  // cairo_dock_create_surface_from_xicon_buffer
 #include "cairo-dock-desktop-manager.h"
 #include "cairo-dock-opengl.h"  // for texture_from_pixmap
+#include "cairo-dock-draw-opengl.h"  // cairo_dock_build_texture_mipmaps
 #include "cairo-dock-X-utilities.h"
 
 #include <cairo/cairo-xlib.h>  // needed for cairo_xlib_surface_create
@@ -665,6 +669,167 @@ GdkPixbuf *cairo_dock_get_pixbuf_from_pixmap (int XPixmapID, gboolean bAddAlpha)
 	return pIconPixbuf;
 }
 
+static inline int _get_mask_shift (unsigned long mask, int *iNbBits)
+{
+	int iShift = 0;
+	while (mask != 0 && (mask & 1) == 0)
+	{
+		mask >>= 1;
+		iShift ++;
+	}
+	*iNbBits = 0;
+	while (mask & 1)
+	{
+		mask >>= 1;
+		(*iNbBits) ++;
+	}
+	return iShift;
+}
+static inline guint32 _get_channel (unsigned long pixel, int iShift, int iNbBits)
+{
+	if (iNbBits == 0)
+		return 0;
+	guint32 c = (pixel >> iShift) & ((1 << iNbBits) - 1);
+	if (iNbBits < 8)
+		c = (c * 255) / ((1 << iNbBits) - 1);
+	else if (iNbBits > 8)
+		c >>= (iNbBits - 8);
+	return c;
+}
+static cairo_surface_t *_create_surface_from_ximage (XImage *pImage)
+{
+	g_return_val_if_fail (pImage != NULL, NULL);
+	cairo_surface_t *pSurface;
+	guint iWidth = pImage->width, iHeight = pImage->height;
+	
+	//\__________________ on convertit les pixels en ARGB opaque.
+	pSurface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, iWidth, iHeight);
+	guchar *pData = cairo_image_surface_get_data (pSurface);
+	int iStride = cairo_image_surface_get_stride (pSurface);
+	guint32 *pRow;
+	guint i, j;
+	int iHostOrder = (G_BYTE_ORDER == G_LITTLE_ENDIAN ? LSBFirst : MSBFirst);
+	if (pImage->bits_per_pixel == 32 && pImage->byte_order == iHostOrder
+	&& pImage->red_mask == 0xff0000 && pImage->green_mask == 0xff00 && pImage->blue_mask == 0xff)  // cas le plus courant : meme format que cairo.
+	{
+		for (j = 0; j < iHeight; j ++)
+		{
+			guint32 *pSrc = (guint32*)(pImage->data + j * pImage->bytes_per_line);
+			pRow = (guint32*)(pData + j * iStride);
+			for (i = 0; i < iWidth; i ++)
+				pRow[i] = pSrc[i] | 0xff000000;
+		}
+	}
+	else  // cas general (16 bits, etc).
+	{
+		int rb, gb, bb;
+		int rs = _get_mask_shift (pImage->red_mask, &rb);
+		int gs = _get_mask_shift (pImage->green_mask, &gb);
+		int bs = _get_mask_shift (pImage->blue_mask, &bb);
+		unsigned long pixel;
+		for (j = 0; j < iHeight; j ++)
+		{
+			pRow = (guint32*)(pData + j * iStride);
+			for (i = 0; i < iWidth; i ++)
+			{
+				pixel = XGetPixel (pImage, i, j);
+				pRow[i] = 0xff000000
+					| (_get_channel (pixel, rs, rb) << 16)
+					| (_get_channel (pixel, gs, gb) << 8)
+					| _get_channel (pixel, bs, bb);
+			}
+		}
+	}
+	cairo_surface_mark_dirty (pSurface);
+	return pSurface;
+}
+
+#ifdef HAVE_XEXTEND
+static XImage *_get_ximage_shm (Display *pDisplay, Pixmap XPixmapID, Visual *pVisual, int iDepth, guint iWidth, guint iHeight, XShmSegmentInfo *pShmInfo)
+{
+	if (! XShmQueryExtension (pDisplay))
+		return NULL;
+	XImage *pImage = XShmCreateImage (pDisplay, pVisual, iDepth, ZPixmap, NULL, pShmInfo, iWidth, iHeight);
+	if (pImage == NULL)
+		return NULL;
+	pShmInfo->shmid = shmget (IPC_PRIVATE, pImage->bytes_per_line * pImage->height, IPC_CREAT | 0600);
+	if (pShmInfo->shmid < 0)
+	{
+		XDestroyImage (pImage);
+		return NULL;
+	}
+	pShmInfo->shmaddr = pImage->data = shmat (pShmInfo->shmid, NULL, 0);
+	pShmInfo->readOnly = False;
+	gboolean bAttached = (pShmInfo->shmaddr != (char*)-1 && XShmAttach (pDisplay, pShmInfo));
+	XSync (pDisplay, False);
+	shmctl (pShmInfo->shmid, IPC_RMID, NULL);  // the segment is freed once both sides have detached it.
+	if (bAttached && XShmGetImage (pDisplay, XPixmapID, pImage, 0, 0, AllPlanes))
+		return pImage;
+	
+	if (bAttached)
+		XShmDetach (pDisplay, pShmInfo);
+	XDestroyImage (pImage);  // doesn't free the data of a shared image.
+	if (pShmInfo->shmaddr != (char*)-1)
+		shmdt (pShmInfo->shmaddr);
+	return NULL;
+}
+#endif
+
+cairo_surface_t *cairo_dock_create_surface_from_pixmap (const gchar *cDisplayName, Pixmap XPixmapID)
+{
+	g_return_val_if_fail (XPixmapID != 0, NULL);
+	Display *pDisplay = XOpenDisplay (cDisplayName);  // our own connection, so that the main one is neither blocked nor used from 2 threads.
+	if (pDisplay == NULL)
+		return NULL;
+	
+	Window root;  // inutile.
+	int x, y;  // inutile.
+	guint border_width;  // inutile.
+	guint iWidth, iHeight, iDepth;
+	Visual *pVisual = DefaultVisual (pDisplay, DefaultScreen (pDisplay));
+	XImage *pImage = NULL;
+	gboolean bShm = FALSE;
+	#ifdef HAVE_XEXTEND
+	XShmSegmentInfo shminfo;
+	#endif
+	if (XGetGeometry (pDisplay, XPixmapID, &root, &x, &y, &iWidth, &iHeight, &border_width, &iDepth)
+	&& (int)iDepth == DefaultDepth (pDisplay, DefaultScreen (pDisplay))  // sinon on ne connait pas le format des pixels.
+	&& pVisual->class == TrueColor)
+	{
+		#ifdef HAVE_XEXTEND
+		pImage = _get_ximage_shm (pDisplay, XPixmapID, pVisual, iDepth, iWidth, iHeight, &shminfo);  // the pixels don't go through the socket.
+		bShm = (pImage != NULL);
+		#endif
+		if (pImage == NULL)
+			pImage = XGetImage (pDisplay, XPixmapID, 0, 0, iWidth, iHeight, AllPlanes, ZPixmap);
+	}
+	
+	cairo_surface_t *pSurface = NULL;
+	if (pImage != NULL)
+	{
+		//\__________________ un pixmap n'a pas de visuel, donc XGetImage laisse les masques a 0 ; on y met ceux du visuel par defaut pour la conversion.
+		pImage->red_mask = pVisual->red_mask;
+		pImage->green_mask = pVisual->green_mask;
+		pImage->blue_mask = pVisual->blue_mask;
+		pSurface = _create_surface_from_ximage (pImage);
+		
+		#ifdef HAVE_XEXTEND
+		if (bShm)
+			XShmDetach (pDisplay, &shminfo);
+		#endif
+		XDestroyImage (pImage);
+		#ifdef HAVE_XEXTEND
+		if (bShm)
+			shmdt (shminfo.shmaddr);
+		#endif
+	}
+	else
+		cd_debug ("couldn't grab the pixmap %lu", XPixmapID);
+	
+	XCloseDisplay (pDisplay);
+	return pSurface;
+}
+
 
 void cairo_dock_set_nb_viewports (int iNbViewportX, int iNbViewportY)
 {
@@ -1681,12 +1846,13 @@ GLuint cairo_dock_texture_from_pixmap (Window Xid, Pixmap iBackingPixmap)
 	
 	g_openglConfig.bindTexImage (display, glxpixmap, GLX_FRONT_LEFT_EXT, NULL);
 	
-	glTexParameteri (GL_TEXTURE_2D,
-		GL_TEXTURE_MIN_FILTER,
-		g_bEasterEggs ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
-	if (g_bEasterEggs)
-		glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
+	glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	if (g_bEasterEggs)  // it switches to the mipmap filter only if it could build them.
+	{
+		cairo_dock_build_texture_mipmaps (texture, attrib.width, attrib.height);
+		glBindTexture (GL_TEXTURE_2D, texture);
+	}
 	
 	// draw using iBackingPixmap as texture
 	glBegin (GL_QUADS);
@@ -66,6 +66,9 @@ Pixmap cairo_dock_get_window_background_pixmap (Window Xid);
 
 GdkPixbuf *cairo_dock_get_pixbuf_from_pixmap (int XPixmapID, gboolean bAddAlpha);
 
+// grab the content of a pixmap into an opaque image surface. It opens its own connection to the display (and uses XShm if possible), so it can be called from a thread.
+cairo_surface_t *cairo_dock_create_surface_from_pixmap (const gchar *cDisplayName, Pixmap XPixmapID);
+
 void cairo_dock_set_nb_viewports (int iNbViewportX, int iNbViewportY);
 void cairo_dock_set_nb_desktops (gulong iNbDesktops);
 
@@ -624,12 +624,25 @@ static void cd_render_opengl_default (CairoDock *pDock)
 	if (pFirstDrawnElement == NULL)
 		return;
 	
+	// only draw the icons that intersect the area being repainted (the rest is already in the back buffer).
+	GdkRectangle *pArea = &pDock->container.pRepaint->repaintArea;
+	double fXMin = (pDock->container.bIsHorizontal ? pArea->x : pArea->y), fXMax = (pDock->container.bIsHorizontal ? pArea->x + pArea->width : pArea->y + pArea->height);
+	double fXLeft, fXRight;
+	cairo_dock_begin_icons_batch ();
 	Icon *icon;
 	GList *ic = pFirstDrawnElement;
 	do
 	{
 		icon = ic->data;
 		
+		fXLeft = icon->fDrawX + icon->fScale + 1;
+		fXRight = icon->fDrawX + (icon->fWidth - 1) * icon->fScale * icon->fWidthFactor - 1;
+		if ((fXLeft >= fXMax || fXRight <= fXMin) && ! icon->bPointed)  // the pointed icon has its label, which can be larger than the icon.
+		{
+			ic = cairo_dock_get_next_element (ic, pDock->icons);
+			continue;
+		}
+		
 		glPushMatrix ();
 		if (myIconsParam.iSeparatorType != CAIRO_DOCK_NORMAL_SEPARATOR && icon->cFileName == NULL && GLDI_OBJECT_IS_SEPARATOR_ICON (icon))
 			_cairo_dock_draw_separator_opengl (icon, pDock, fDockMagnitude);
@@ -639,6 +652,7 @@ static void cd_render_opengl_default (CairoDock *pDock)
 		
 		ic = cairo_dock_get_next_element (ic, pDock->icons);
 	} while (ic != pFirstDrawnElement);
+	cairo_dock_end_icons_batch ();
 	//glDisable (GL_LIGHTING);
 }
 
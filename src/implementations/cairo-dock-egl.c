@@ -39,6 +39,10 @@ extern GldiContainer *g_pPrimaryContainer;
 static EGLDisplay *s_eglDisplay = NULL;
 static EGLContext s_eglContext = 0;
 static EGLConfig s_eglConfig = 0;
+static gboolean s_bBufferAgeAvailable = FALSE;
+#ifndef EGL_BUFFER_AGE_EXT
+#define EGL_BUFFER_AGE_EXT 0x313D
+#endif
 
 static gboolean _check_client_egl_extension (const char *extName)
 {
@@ -133,6 +137,8 @@ static gboolean _initialize_opengl_backend (gboolean bForceOpenGL)
 		g_openglConfig.bTextureFromPixmapAvailable = (g_openglConfig.bindTexImage && g_openglConfig.releaseTexImage);
 	}
 	
+	s_bBufferAgeAvailable = _check_client_egl_extension ("EGL_EXT_buffer_age");
+	
 	return TRUE;
 }
 
@@ -170,7 +176,25 @@ static void _init_surface (G_GNUC_UNUSED GtkWidget *pWidget, GldiContainer *pCon
 	#endif
 	pContainer->eglSurface = eglCreateWindowSurface (dpy, s_eglConfig, native_window, NULL);
 	
+	// without buffer-age, ask to keep the back buffer so that we can repaint only the damaged parts (it may fail, we'll then repaint everything).
+	if (! s_bBufferAgeAvailable)
+		eglSurfaceAttrib (dpy, pContainer->eglSurface, EGL_SWAP_BEHAVIOR, EGL_BUFFER_PRESERVED);
+}
+
+static gint _container_get_buffer_age (GldiContainer *pContainer)
+{
+	EGLSurface surface = pContainer->eglSurface;
+	EGLDisplay *dpy = s_eglDisplay;
+	EGLint iValue = 0;
+	if (s_bBufferAgeAvailable)
+	{
+		eglQuerySurface (dpy, surface, EGL_BUFFER_AGE_EXT, &iValue);
+		return iValue;
+	}
+	eglQuerySurface (dpy, surface, EGL_SWAP_BEHAVIOR, &iValue);
+	return (iValue == EGL_BUFFER_PRESERVED ? 1 : 0);
 }
+
 static void _container_init (GldiContainer *pContainer)
 {
 	cairo_dock_set_default_rgba_visual (pContainer->pWidget);
@@ -222,6 +246,7 @@ void gldi_register_egl_backend (void)
 	gmb.container_end_draw = _container_end_draw;
 	gmb.container_init = _container_init;
 	gmb.container_finish = _container_finish;
+	gmb.container_get_buffer_age = _container_get_buffer_age;
 	gldi_gl_manager_register_backend (&gmb);
 }
 
@@ -70,6 +70,14 @@ typedef struct {
 	gdouble fNeedleScale;
 	gint iNeedleWidth, iNeedleHeight;
 	GaugeImage *pImageNeedle;
+	// pre-rendered needle
+	gint iNbNeedleFrames;  // 0 <=> the needle is rotated on each update.
+	gboolean bNeedleAtlasLoaded;  // the atlas is made by the first drawing, since the pivot depends on the path (Cairo or OpenGL).
+	gint iNbNeedleAtlasFrames;  // frames actually pre-rendered (can be less than iNbNeedleFrames for a big needle), 0 if none.
+	gint iNeedleFrameSize;
+	gint iNbNeedleColumns, iNbNeedleRows;
+	cairo_surface_t *pNeedleAtlasSurface;  // the needle at iNbNeedleAtlasFrames angles, from posStart to posStop, for the Cairo path...
+	GLuint iNeedleAtlasTexture;  // ... or for the OpenGL path.
 	// images list
 	GaugeIndicatorEffect iEffect;
 	gint iNbImages;
@@ -97,10 +105,22 @@ typedef struct {
 	GaugeImage *pImageForeground;
 	GList *pIndicatorList;
 	GaugeMultiDisplay iMultiDisplay;
+	gint iNbNeedleFrames;
 } Gauge;
 
+#define CD_GAUGE_MAX_NEEDLE_FRAMES 360
+#define CD_GAUGE_MAX_NEEDLE_ATLAS_SIZE (4*1024*1024)  // in bytes; a bigger needle gets less frames, or none and is rotated.
+
 
 extern gboolean g_bUseOpenGL;
+extern gboolean g_bEasterEggs;
+
+static gint s_iDefaultNbNeedleFrames = 0;
+
+void cairo_dock_set_gauge_needle_frames (int iNbFrames)
+{
+	s_iDefaultNbNeedleFrames = CLAMP (iNbFrames, 0, CD_GAUGE_MAX_NEEDLE_FRAMES);
+}
 
   ////////////////////////////////////////////
  /////////////// LOAD GAUGE /////////////////
@@ -117,7 +137,7 @@ static double _str2double (xmlChar *s)
 static void _load_gauge_image (GaugeImage *pGaugeImage, const gchar *cThemePath, const xmlChar *cImageName, int iWidth, int iHeight)
 {
 	pGaugeImage->cImagePath = g_strdup_printf ("%s/%s", cThemePath, (gchar *) cImageName);
-	cairo_dock_load_image_buffer (&pGaugeImage->image, pGaugeImage->cImagePath, iWidth, iHeight, 0);
+	cairo_dock_load_image_buffer (&pGaugeImage->image, pGaugeImage->cImagePath, iWidth, iHeight, CAIRO_DOCK_STATIC_IMAGE);
 }
 
 static GaugeImage *_new_gauge_image (const gchar *cThemePath, const xmlChar *cImageName, int iWidth, int iHeight)
@@ -133,8 +153,114 @@ static void _reload_gauge_image (GaugeImage *pGaugeImage, int iWidth, int iHeigh
 	
 	if (pGaugeImage->cImagePath)
 	{
-		cairo_dock_load_image_buffer (&pGaugeImage->image, pGaugeImage->cImagePath, iWidth, iHeight, 0);
+		cairo_dock_load_image_buffer (&pGaugeImage->image, pGaugeImage->cImagePath, iWidth, iHeight, CAIRO_DOCK_STATIC_IMAGE);
+	}
+}
+
+static inline double _get_needle_angle (GaugeIndicator *pGaugeIndicator, double fValue)  // in radians
+{
+	double fAngle = (pGaugeIndicator->posStart + fValue * (pGaugeIndicator->posStop - pGaugeIndicator->posStart)) * G_PI / 180.;
+	if (pGaugeIndicator->direction < 0)
+		fAngle = - fAngle;
+	return fAngle;
+}
+
+static inline int _get_needle_frame (GaugeIndicator *pGaugeIndicator, double fValue)
+{
+	int k = fValue * (pGaugeIndicator->iNbNeedleAtlasFrames - 1) + .5;
+	return MAX (0, MIN (pGaugeIndicator->iNbNeedleAtlasFrames - 1, k));
+}
+
+static void _unload_needle_atlas (GaugeIndicator *pGaugeIndicator)
+{
+	if (pGaugeIndicator->pNeedleAtlasSurface != NULL)
+	{
+		cairo_surface_destroy (pGaugeIndicator->pNeedleAtlasSurface);
+		pGaugeIndicator->pNeedleAtlasSurface = NULL;
+	}
+	if (pGaugeIndicator->iNeedleAtlasTexture != 0)
+	{
+		_cairo_dock_delete_texture (pGaugeIndicator->iNeedleAtlasTexture);
+		pGaugeIndicator->iNeedleAtlasTexture = 0;
+	}
+	pGaugeIndicator->iNbNeedleAtlasFrames = 0;
+	pGaugeIndicator->bNeedleAtlasLoaded = FALSE;
+}
+
+static void _load_needle_atlas (GaugeIndicator *pGaugeIndicator, gboolean bOpenGL)
+{
+	pGaugeIndicator->bNeedleAtlasLoaded = TRUE;  // don't try again until the needle is reloaded.
+	GaugeImage *pGaugeImage = pGaugeIndicator->pImageNeedle;
+	int N = pGaugeIndicator->iNbNeedleFrames;
+	if (N < 2 || pGaugeImage == NULL || pGaugeImage->image.pSurface == NULL)
+		return;
+	gint64 t0 = g_get_monotonic_time ();
+	
+	// pivot of the needle inside its image, as each path places it (the OpenGL path uses the scaled offset).
+	double ox = (bOpenGL ? pGaugeIndicator->fNeedleScale * pGaugeIndicator->iNeedleOffsetX : pGaugeIndicator->iNeedleOffsetX);
+	double oy = (bOpenGL ? pGaugeIndicator->iNeedleHeight / 2. : pGaugeIndicator->iNeedleOffsetY);
+	
+	// each frame is a square centered on the pivot, large enough to hold the needle at any angle.
+	double dx = MAX (ox, pGaugeIndicator->iNeedleWidth - ox);
+	double dy = MAX (oy, pGaugeIndicator->iNeedleHeight - oy);
+	int r = ceil (sqrt (dx*dx + dy*dy)) + 1;
+	int iFrameSize = 2 * r;
+	
+	// limit the number of frames to what fits in a texture and in our memory budget; if even 2 frames don't fit, the needle will be rotated.
+	int iMaxSize = G_MAXINT;
+	if (bOpenGL)
+		glGetIntegerv (GL_MAX_TEXTURE_SIZE, &iMaxSize);
+	int iMaxFramesPerSide = iMaxSize / iFrameSize;
+	N = MIN (N, iMaxFramesPerSide * iMaxFramesPerSide);
+	N = MIN (N, CD_GAUGE_MAX_NEEDLE_ATLAS_SIZE / (4 * iFrameSize * iFrameSize));
+	if (N < 2)
+	{
+		cd_debug ("gauge: the needle is too big to be pre-rendered (%dx%d), it will be rotated", iFrameSize, iFrameSize);
+		return;
+	}
+	int iNbColumns = ceil (sqrt (N));
+	int iNbRows = (N + iNbColumns - 1) / iNbColumns;
+	
+	cairo_surface_t *pAtlasSurface = NULL;
+	cairo_t *pCairoContext;
+	if (bOpenGL)  // only the texture is needed, draw right into it.
+	{
+		pCairoContext = cairo_dock_begin_draw_new_texture (iNbColumns * iFrameSize, iNbRows * iFrameSize);
+		g_return_if_fail (pCairoContext != NULL);
+	}
+	else
+	{
+		pAtlasSurface = cairo_dock_create_blank_surface (iNbColumns * iFrameSize, iNbRows * iFrameSize);
+		g_return_if_fail (cairo_surface_status (pAtlasSurface) == CAIRO_STATUS_SUCCESS);
+		pCairoContext = cairo_create (pAtlasSurface);
+	}
+	int k, x, y;
+	for (k = 0; k < N; k ++)
+	{
+		x = (k % iNbColumns) * iFrameSize;
+		y = (k / iNbColumns) * iFrameSize;
+		cairo_save (pCairoContext);
+		cairo_rectangle (pCairoContext, x, y, iFrameSize, iFrameSize);
+		cairo_clip (pCairoContext);
+		cairo_translate (pCairoContext, x + r, y + r);
+		cairo_rotate (pCairoContext, -G_PI/2 + _get_needle_angle (pGaugeIndicator, (double) k / (N - 1)));
+		cairo_set_source_surface (pCairoContext, pGaugeImage->image.pSurface, -ox, -oy);
+		cairo_paint (pCairoContext);
+		cairo_restore (pCairoContext);
+	}
+	
+	if (bOpenGL)
+		pGaugeIndicator->iNeedleAtlasTexture = cairo_dock_end_draw_new_texture (pCairoContext, g_bEasterEggs ? GLDI_TEXTURE_MIPMAPS : 0);
+	else
+	{
+		cairo_destroy (pCairoContext);
+		pGaugeIndicator->pNeedleAtlasSurface = pAtlasSurface;
 	}
+	pGaugeIndicator->iNbNeedleAtlasFrames = N;
+	pGaugeIndicator->iNeedleFrameSize = iFrameSize;
+	pGaugeIndicator->iNbNeedleColumns = iNbColumns;
+	pGaugeIndicator->iNbNeedleRows = iNbRows;
+	cd_debug ("gauge: %d needle frames of %dx%d pre-rendered in %.2fms", N, iFrameSize, iFrameSize, (g_get_monotonic_time () - t0) / 1000.);
 }
 
 static void __load_needle (GaugeIndicator *pGaugeIndicator, int iWidth, int iHeight)
@@ -193,6 +319,7 @@ static void _reload_gauge_needle (GaugeIndicator *pGaugeIndicator, int iWidth, i
 	if (pGaugeImage != NULL)
 	{
 		cairo_dock_unload_image_buffer (&pGaugeImage->image);
+		_unload_needle_atlas (pGaugeIndicator);
 		if (pGaugeImage->cImagePath)
 		{
 			__load_needle (pGaugeIndicator, iWidth, iHeight);
@@ -322,6 +449,7 @@ static gboolean _load_theme (Gauge *pGauge, const gchar *cThemePath)
 			// load the indicators.
 			pGaugeIndicator = g_new0 (GaugeIndicator, 1);
 			pGaugeIndicator->direction = 1;
+			pGaugeIndicator->iNbNeedleFrames = (pGauge->iNbNeedleFrames != 0 ? pGauge->iNbNeedleFrames : s_iDefaultNbNeedleFrames);  // the attribute, else the theme (see below), else the global option.
 			
 			cd_debug ("gauge : On charge un indicateur");
 			cNeedleImage = NULL;
@@ -347,6 +475,11 @@ static gboolean _load_theme (Gauge *pGauge, const gchar *cThemePath)
 						pGaugeIndicator->posStop = _str2double (cNodeContent);
 					else if(xmlStrcmp (pIndicatorNode->name, BAD_CAST "nb images") == 0)
 						pGaugeIndicator->iNbImages = atoi ((char *) cNodeContent);
+					else if(xmlStrcmp (pIndicatorNode->name, BAD_CAST "nb_frames") == 0)
+					{
+						if (pGauge->iNbNeedleFrames == 0)  // the attribute of the renderer prevails.
+							pGaugeIndicator->iNbNeedleFrames = MIN (atoi ((char *) cNodeContent), CD_GAUGE_MAX_NEEDLE_FRAMES);
+					}
 					else if(xmlStrcmp (pIndicatorNode->name, BAD_CAST "offset_x") == 0)
 					{
 						pGaugeIndicator->iNeedleOffsetX = atoi ((char *) cNodeContent);
@@ -524,6 +657,7 @@ static gboolean _load_theme (Gauge *pGauge, const gchar *cThemePath)
 static void load (Gauge *pGauge, G_GNUC_UNUSED Icon *pIcon, CairoGaugeAttribute *pAttribute)
 {
 	// on charge le theme defini en attribut.
+	pGauge->iNbNeedleFrames = MIN (pAttribute->iNbNeedleFrames, CD_GAUGE_MAX_NEEDLE_FRAMES);
 	gboolean bThemeLoaded = _load_theme (pGauge, pAttribute->cThemePath);
 	if (!bThemeLoaded)
 		return;
@@ -570,13 +704,26 @@ static void _draw_gauge_needle (cairo_t *pCairoContext, Gauge *pGauge, GaugeIndi
 	GaugeImage *pGaugeImage = pGaugeIndicator->pImageNeedle;
 	if (pGaugeImage != NULL)
 	{
-		double fAngle = (pGaugeIndicator->posStart + fValue * (pGaugeIndicator->posStop - pGaugeIndicator->posStart)) * G_PI / 180.;
-		if (pGaugeIndicator->direction < 0)
-			fAngle = - fAngle;
-		
 		double fHalfX = CAIRO_DATA_RENDERER (pGauge)->iWidth / 2.0f * (1 + pGaugeIndicator->posX);
 		double fHalfY = CAIRO_DATA_RENDERER (pGauge)->iHeight / 2.0f * (1 - pGaugeIndicator->posY);
 		
+		if (! pGaugeIndicator->bNeedleAtlasLoaded)
+			_load_needle_atlas (pGaugeIndicator, FALSE);
+		if (pGaugeIndicator->pNeedleAtlasSurface != NULL)  // just blit the pre-rendered frame.
+		{
+			int k = _get_needle_frame (pGaugeIndicator, fValue);
+			int iFrameSize = pGaugeIndicator->iNeedleFrameSize;
+			double x = fHalfX - iFrameSize/2, y = fHalfY - iFrameSize/2;
+			cairo_set_source_surface (pCairoContext, pGaugeIndicator->pNeedleAtlasSurface,
+				x - (k % pGaugeIndicator->iNbNeedleColumns) * iFrameSize,
+				y - (k / pGaugeIndicator->iNbNeedleColumns) * iFrameSize);
+			cairo_rectangle (pCairoContext, x, y, iFrameSize, iFrameSize);
+			cairo_fill (pCairoContext);
+			return;
+		}
+		
+		double fAngle = _get_needle_angle (pGaugeIndicator, fValue);
+		
 		cairo_save (pCairoContext);
 		
 		cairo_translate (pCairoContext, fHalfX, fHalfY);
@@ -757,11 +904,24 @@ static void _draw_gauge_needle_opengl (Gauge *pGauge, GaugeIndicator *pGaugeIndi
 	g_return_if_fail (pGaugeImage != NULL);
 	
 	int iWidth = pGauge->dataRenderer.iWidth, iHeight = pGauge->dataRenderer.iHeight;
-	if(pGaugeImage->image.iTexture != 0)
+	if (! pGaugeIndicator->bNeedleAtlasLoaded)
+		_load_needle_atlas (pGaugeIndicator, TRUE);
+	if (pGaugeIndicator->iNeedleAtlasTexture != 0)  // just draw the pre-rendered frame.
 	{
-		double fAngle = (pGaugeIndicator->posStart + fValue * (pGaugeIndicator->posStop - pGaugeIndicator->posStart));
-		if (pGaugeIndicator->direction < 0)
-			fAngle = - fAngle;
+		int k = _get_needle_frame (pGaugeIndicator, fValue);
+		int n = pGaugeIndicator->iNbNeedleColumns, m = pGaugeIndicator->iNbNeedleRows;
+		glPushMatrix ();
+		glTranslatef (iWidth / 2.0f * pGaugeIndicator->posX, iHeight / 2.0f * pGaugeIndicator->posY, 0.);
+		glBindTexture (GL_TEXTURE_2D, pGaugeIndicator->iNeedleAtlasTexture);
+		_cairo_dock_apply_current_texture_portion_at_size_with_offset ((double) (k % n) / n, (double) (k / n) / m,
+			1. / n, 1. / m,
+			pGaugeIndicator->iNeedleFrameSize, pGaugeIndicator->iNeedleFrameSize,
+			0., 0.);
+		glPopMatrix ();
+	}
+	else if (pGaugeImage->image.iTexture != 0)
+	{
+		double fAngle = _get_needle_angle (pGaugeIndicator, fValue) * 180. / G_PI;
 		double fHalfX = iWidth / 2.0f * (0 + pGaugeIndicator->posX);
 		double fHalfY = iHeight / 2.0f * (0 + pGaugeIndicator->posY);
 		
@@ -964,6 +1124,8 @@ static void _cairo_dock_free_gauge_indicator(GaugeIndicator *pGaugeIndicator)
 	
 	_cairo_dock_free_gauge_image (pGaugeIndicator->pImageNeedle, TRUE);
 	
+	_unload_needle_atlas (pGaugeIndicator);
+	
 	g_free (pGaugeIndicator);
 }
 static void unload (Gauge *pGauge)
@@ -37,11 +37,18 @@ struct _CairoGaugeAttribute {
 	CairoDataRendererAttribute rendererAttribute;
 	/// path to a gauge theme.
 	const gchar *cThemePath;
+	/// number of positions of the needles to pre-render when the gauge is first drawn; the needles are then blitted instead of being rotated on each update. It is lowered for big needles, so that they fit in a texture and in a few MB. 0 to use the value of the theme (its indicators can have a <nb_frames> node), or else the global one (see \ref cairo_dock_set_gauge_needle_frames) [0 by default].
+	gint iNbNeedleFrames;
 };
 
 
 void cairo_dock_register_data_renderer_gauge (void);
 
+/** Set the number of positions of the needles to pre-render, for the gauges whose attribute and theme don't define it.
+*@param iNbFrames number of frames, 0 to rotate the needles on each update (the default).
+*/
+void cairo_dock_set_gauge_needle_frames (int iNbFrames);
+
 
 G_END_DECLS
 #endif
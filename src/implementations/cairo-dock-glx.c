@@ -40,8 +40,12 @@ extern GldiContainer *g_pPrimaryContainer;
 static Display *s_XDisplay = NULL;
 static GLXContext s_XContext = 0;
 static XVisualInfo *s_XVisInfo = NULL;
+static gboolean s_bBufferAgeAvailable = FALSE;
 GdkVisual *s_pGdkVisual = NULL;
 #define _gldi_container_get_Xid(pContainer) GDK_WINDOW_XID (gldi_container_get_gdk_window(pContainer))
+#ifndef GLX_BACK_BUFFER_AGE_EXT
+#define GLX_BACK_BUFFER_AGE_EXT 0x20F4
+#endif
 
 static gboolean _check_client_glx_extension (const char *extName)
 {
@@ -213,6 +217,8 @@ static gboolean _initialize_opengl_backend (gboolean bForceOpenGL)
 		g_openglConfig.bTextureFromPixmapAvailable = (g_openglConfig.bindTexImage && g_openglConfig.releaseTexImage);
 	}
 	
+	s_bBufferAgeAvailable = _check_client_glx_extension ("GLX_EXT_buffer_age");
+	
 	return TRUE;
 }
 
@@ -240,6 +246,17 @@ static void _container_end_draw (GldiContainer *pContainer)
 	glXSwapBuffers (dpy, Xid);
 }
 
+static gint _container_get_buffer_age (GldiContainer *pContainer)
+{
+	if (! s_bBufferAgeAvailable)
+		return 1;  // most drivers keep the back buffer, that's what we always assumed.
+	Window Xid = _gldi_container_get_Xid (pContainer);
+	Display *dpy = s_XDisplay;
+	unsigned int iAge = 0;
+	glXQueryDrawable (dpy, Xid, GLX_BACK_BUFFER_AGE_EXT, &iAge);
+	return iAge;
+}
+
 static void _container_init (GldiContainer *pContainer)
 {
 	// Set the visual we found during the init
@@ -282,6 +299,7 @@ void gldi_register_glx_backend (void)
 	gmb.container_end_draw = _container_end_draw;
 	gmb.container_init = _container_init;
 	gmb.container_finish = _container_finish;
+	gmb.container_get_buffer_age = _container_get_buffer_age;
 	gldi_gl_manager_register_backend (&gmb);
 
 	s_XDisplay = cairo_dock_get_X_display ();  // initialize it once and for all at the beginning; we use this display rather than the GDK one to avoid the GDK X errors check.
@@ -26,6 +26,7 @@
 #include "cairo-dock-dock-factory.h"
 #include "cairo-dock-backends-manager.h"
 #include "cairo-dock-draw-opengl.h"
+#include "cairo-dock-opengl.h"  // g_openglConfig
 #include "cairo-dock-draw.h"
 #include "cairo-dock-container.h"
 #include "cairo-dock-icon-manager.h"  // myIconsParam.quickInfoTextDescription
@@ -42,10 +43,18 @@ typedef struct _Graph {
 	GLuint iBackgroundTexture;
 	gint iMargin;
 	gboolean bMixGraphs;
+	// OpenGL
+	GLuint iVertexBuffer;  // history of the values, on the GPU (0 if VBOs are not available).
+	GLfloat *pVertices;  // same, on the CPU.
+	gint iNbVerticesPerValue;
+	gint iUploadedIndex;  // last slot that has been uploaded.
+	gint iUploadedMemorySize;
+	gdouble *pUploadedMinMax;  // range of the values when they were uploaded.
 	} Graph;
 
 
 extern gboolean g_bUseOpenGL;
+extern CairoDockGLConfig g_openglConfig;
 
 
 static void render (Graph *pGraph, cairo_t *pCairoContext)
@@ -205,25 +214,282 @@ static void render (Graph *pGraph, cairo_t *pCairoContext)
 		cairo_dock_render_overlays_to_context (pRenderer, i, pCairoContext);
 	}
 }
-/* not used
+  ///////////////////////////////////////////////
+ /////////////// RENDER OPENGL /////////////////
+///////////////////////////////////////////////
+// Each value of the history is stored once in a vertex buffer, at a fixed slot; the slots are then scrolled (or rotated) with the modelview matrix, so that only the newest values have to be uploaded on each update.
+// Line/plain/bar graphs: 2 vertices per slot, (s, v) and (s, 0), + a copy of the slot 0 at x=N to join the 2 parts of the ring buffer.
+// Circle graphs: the center, 2 vertices per slot on the unit circle (scaled by v), + a copy of the first vertex to close the shape.
+#define _CD_GRAPH_VERTEX_SIZE 5  // x, y, r, g, b
+#define _cd_graph_is_circle(pGraph) ((pGraph)->iType == CAIRO_DOCK_GRAPH_CIRCLE || (pGraph)->iType == CAIRO_DOCK_GRAPH_CIRCLE_PLAIN)
+
+static inline void _set_graph_vertex (Graph *pGraph, int iNumValue, int iVertex, GLfloat x, GLfloat y, double v)
+{
+	GLfloat *pVertex = &pGraph->pVertices[(iNumValue * pGraph->iNbVerticesPerValue + iVertex) * _CD_GRAPH_VERTEX_SIZE];
+	pVertex[0] = x;
+	pVertex[1] = y;
+	pVertex[2] = pGraph->fLowColor[3*iNumValue+0] + v * (pGraph->fHighColor[3*iNumValue+0] - pGraph->fLowColor[3*iNumValue+0]);  // same as the gradation pattern: low color at the bottom, high color at the top.
+	pVertex[3] = pGraph->fLowColor[3*iNumValue+1] + v * (pGraph->fHighColor[3*iNumValue+1] - pGraph->fLowColor[3*iNumValue+1]);
+	pVertex[4] = pGraph->fLowColor[3*iNumValue+2] + v * (pGraph->fHighColor[3*iNumValue+2] - pGraph->fLowColor[3*iNumValue+2]);
+}
+
+static inline void _upload_graph_vertices (Graph *pGraph, int iNumValue, int iFirstVertex, int iNbVertices)
+{
+	if (pGraph->iVertexBuffer == 0)  // vertices are read from the client memory.
+		return;
+	gsize iOffset = (iNumValue * pGraph->iNbVerticesPerValue + iFirstVertex) * _CD_GRAPH_VERTEX_SIZE;
+	glBufferSubData (GL_ARRAY_BUFFER,
+		iOffset * sizeof (GLfloat),
+		iNbVertices * _CD_GRAPH_VERTEX_SIZE * sizeof (GLfloat),
+		&pGraph->pVertices[iOffset]);
+}
+
+static void _set_graph_slot (Graph *pGraph, int iNumValue, int s, gboolean bUpload)
+{
+	CairoDataRenderer *pRenderer = CAIRO_DATA_RENDERER (pGraph);
+	CairoDataToRenderer *pData = cairo_data_renderer_get_data (pRenderer);
+	int N = pData->iMemorySize;
+	double fValue = pData->pTabValues[s][iNumValue];
+	if (fValue > CAIRO_DATA_RENDERER_UNDEF_VALUE+1)
+		fValue = MAX (0, MIN (1, (fValue - cairo_data_renderer_get_min_value (pRenderer, iNumValue)) / (cairo_data_renderer_get_max_value (pRenderer, iNumValue) - cairo_data_renderer_get_min_value (pRenderer, iNumValue))));
+	else  // undef value -> let's draw 0
+		fValue = 0;
+	
+	if (_cd_graph_is_circle (pGraph))
+	{
+		double angle = -2*G_PI*(s - .5)/N;
+		_set_graph_vertex (pGraph, iNumValue, 1+2*s, fValue * cos (angle), fValue * sin (angle), fValue);
+		angle = -2*G_PI*(s + .5)/N;
+		_set_graph_vertex (pGraph, iNumValue, 2+2*s, fValue * cos (angle), fValue * sin (angle), fValue);
+		if (bUpload)
+			_upload_graph_vertices (pGraph, iNumValue, 1+2*s, 2);
+		if (s == 0)  // closing vertex.
+		{
+			_set_graph_vertex (pGraph, iNumValue, 2*N+1, fValue * cos (G_PI/N), fValue * sin (G_PI/N), fValue);
+			if (bUpload)
+				_upload_graph_vertices (pGraph, iNumValue, 2*N+1, 1);
+		}
+	}
+	else
+	{
+		_set_graph_vertex (pGraph, iNumValue, 2*s, s, fValue, fValue);
+		_set_graph_vertex (pGraph, iNumValue, 2*s+1, s, 0., 0.);
+		if (bUpload)
+			_upload_graph_vertices (pGraph, iNumValue, 2*s, 2);
+		if (s == 0)  // copy of the first slot, right after the last one.
+		{
+			_set_graph_vertex (pGraph, iNumValue, 2*N, N, fValue, fValue);
+			_set_graph_vertex (pGraph, iNumValue, 2*N+1, N, 0., 0.);
+			if (bUpload)
+				_upload_graph_vertices (pGraph, iNumValue, 2*N, 2);
+		}
+	}
+}
+
+static void _update_graph_vertices (Graph *pGraph, int iCurrentIndex)
+{
+	CairoDataRenderer *pRenderer = CAIRO_DATA_RENDERER (pGraph);
+	CairoDataToRenderer *pData = cairo_data_renderer_get_data (pRenderer);
+	int iNbValues = cairo_data_renderer_get_nb_values (pRenderer);
+	int N = pData->iMemorySize;
+	int i, s;
+	
+	// the whole buffer has to be rebuilt if the history has been resized, or if the range of the values has changed (the vertices hold normalized values).
+	if (pGraph->pVertices == NULL
+	|| pGraph->iUploadedMemorySize != N
+	|| memcmp (pGraph->pUploadedMinMax, pData->pMinMaxValues, 2 * iNbValues * sizeof (gdouble)) != 0)
+	{
+		g_free (pGraph->pVertices);
+		pGraph->iNbVerticesPerValue = 2*N + 2;
+		pGraph->pVertices = g_new0 (GLfloat, iNbValues * pGraph->iNbVerticesPerValue * _CD_GRAPH_VERTEX_SIZE);
+		for (i = 0; i < iNbValues; i ++)
+		{
+			if (_cd_graph_is_circle (pGraph))
+				_set_graph_vertex (pGraph, i, 0, 0., 0., 0.);  // center
+			for (s = 0; s < N; s ++)
+				_set_graph_slot (pGraph, i, s, FALSE);
+		}
+		
+		if (pGraph->pUploadedMinMax == NULL)
+			pGraph->pUploadedMinMax = g_new (gdouble, 2 * iNbValues);
+		memcpy (pGraph->pUploadedMinMax, pData->pMinMaxValues, 2 * iNbValues * sizeof (gdouble));
+		pGraph->iUploadedMemorySize = N;
+		
+		if (g_openglConfig.bVertexBufferAvailable)
+		{
+			if (pGraph->iVertexBuffer == 0)
+				glGenBuffers (1, &pGraph->iVertexBuffer);
+			glBindBuffer (GL_ARRAY_BUFFER, pGraph->iVertexBuffer);
+			glBufferData (GL_ARRAY_BUFFER,
+				iNbValues * pGraph->iNbVerticesPerValue * _CD_GRAPH_VERTEX_SIZE * sizeof (GLfloat),
+				pGraph->pVertices,
+				GL_DYNAMIC_DRAW);
+			glBindBuffer (GL_ARRAY_BUFFER, 0);
+		}
+	}
+	else if (pGraph->iUploadedIndex != iCurrentIndex)  // only upload the values received since the last update (usually just one).
+	{
+		if (pGraph->iVertexBuffer != 0)
+			glBindBuffer (GL_ARRAY_BUFFER, pGraph->iVertexBuffer);
+		s = pGraph->iUploadedIndex;
+		do
+		{
+			s = (s + 1) % N;
+			for (i = 0; i < iNbValues; i ++)
+				_set_graph_slot (pGraph, i, s, TRUE);
+		}
+		while (s != iCurrentIndex);
+		if (pGraph->iVertexBuffer != 0)
+			glBindBuffer (GL_ARRAY_BUFFER, 0);
+	}
+	pGraph->iUploadedIndex = iCurrentIndex;
+}
+
+static inline void _set_graph_pointers (Graph *pGraph, int iNumValue, int iFirstVertex, int iStep)
+{
+	gsize iOffset = (iNumValue * pGraph->iNbVerticesPerValue + iFirstVertex) * _CD_GRAPH_VERTEX_SIZE * sizeof (GLfloat);
+	const gchar *ptr = (pGraph->iVertexBuffer != 0 ? GSIZE_TO_POINTER (iOffset) : (const gchar *) pGraph->pVertices + iOffset);
+	GLsizei iStride = iStep * _CD_GRAPH_VERTEX_SIZE * sizeof (GLfloat);
+	glVertexPointer (2, GL_FLOAT, iStride, ptr);
+	glColorPointer (3, GL_FLOAT, iStride, ptr + 2 * sizeof (GLfloat));
+}
+
+static void _draw_graph_slots_opengl (Graph *pGraph, int iNumValue, int s0, int s1)  // draw the slots [s0;s1] of a line/plain/bar graph.
+{
+	int iNbSlots = s1 - s0 + 1;
+	if (iNbSlots <= 0)
+		return;
+	switch (pGraph->iType)
+	{
+		case CAIRO_DOCK_GRAPH_BAR:
+			_set_graph_pointers (pGraph, iNumValue, 2*s0, 1);
+			glDrawArrays (GL_LINES, 0, 2*iNbSlots);  // each slot is a vertical segment.
+		break;
+		
+		case CAIRO_DOCK_GRAPH_PLAIN:
+			_set_graph_pointers (pGraph, iNumValue, 2*s0, 1);
+			glDrawArrays (GL_TRIANGLE_STRIP, 0, 2*iNbSlots);
+		// no break, draw the line too.
+		case CAIRO_DOCK_GRAPH_LINE:
+		default:
+			_set_graph_pointers (pGraph, iNumValue, 2*s0, 2);  // only the top vertices.
+			glDrawArrays (GL_LINE_STRIP, 0, iNbSlots);
+		break;
+	}
+}
+
 static void render_opengl (Graph *pGraph)
 {
 	g_return_if_fail (pGraph != NULL);
 	
 	CairoDataRenderer *pRenderer = CAIRO_DATA_RENDERER (pGraph);
+	CairoDataToRenderer *pData = cairo_data_renderer_get_data (pRenderer);
+	int iNbValues = cairo_data_renderer_get_nb_values (pRenderer);
+	int iWidth, iHeight;
+	cairo_data_renderer_get_size (pRenderer, &iWidth, &iHeight);
 	
 	if (pGraph->iBackgroundTexture != 0)
 	{
 		_cairo_dock_enable_texture ();
 		_cairo_dock_set_blend_pbuffer ();  // ceci reste un mystere...
-		_cairo_dock_set_alpha (1.);
-		_cairo_dock_apply_texture_at_size_with_alpha (pGraph->iBackgroundTexture, pRenderer->iWidth, pRenderer->iHeight, 1.);
+		_cairo_dock_apply_texture_at_size_with_alpha (pGraph->iBackgroundTexture, iWidth, iHeight, 1.);
 		_cairo_dock_disable_texture ();
 	}
 	
-	/// to be continued ...
+	g_return_if_fail (pRenderer->iRank != 0); // workaround: FIXME
+	int iNbDrawings = iNbValues / pRenderer->iRank;
+	if (iNbDrawings == 0)
+		return;
+	
+	//\________________ upload the new values.
+	int N = pData->iMemorySize;
+	int c = pData->iCurrentIndex;  // slot of the current value.
+	if (c < 0)  // no value yet.
+		c += N;
+	_update_graph_vertices (pGraph, c);
+	
+	//\________________ draw each value.
+	int iMargin = pGraph->iMargin;
+	int w = iWidth - 2*iMargin;
+	double fHeight = iHeight - 2*iMargin;
+	fHeight /= iNbDrawings;
+	int n = MIN (N, w);  // number of visible values.
+	
+	glEnable (GL_BLEND);
+	_cairo_dock_set_blend_alpha ();
+	glEnable (GL_LINE_SMOOTH);
+	glHint (GL_LINE_SMOOTH_HINT, GL_NICEST);
+	glPolygonMode (GL_FRONT_AND_BACK, GL_FILL);
+	glLineWidth (1.);
+	glEnableClientState (GL_VERTEX_ARRAY);
+	glEnableClientState (GL_COLOR_ARRAY);
+	if (pGraph->iVertexBuffer != 0)
+		glBindBuffer (GL_ARRAY_BUFFER, pGraph->iVertexBuffer);
+	
+	int i, iCurrentGraph, iGraphTop, iGraphBottom;
+	for (i = 0; i < iNbValues; i ++)
+	{
+		glPushMatrix ();
+		iCurrentGraph = pGraph->bMixGraphs ? 0 : i;
+		if (_cd_graph_is_circle (pGraph))
+		{
+			double radius = MIN (w, fHeight)/2;
+			glTranslatef (iMargin + w/2. - iWidth/2.,
+				iHeight/2. - iMargin - fHeight/2 - iCurrentGraph * fHeight,
+				0.);
+			glScalef (radius, radius, 1.);
+			glRotatef (360. * c / N, 0., 0., 1.);  // the current value lies at the angle 0.
+			
+			if (pGraph->iType == CAIRO_DOCK_GRAPH_CIRCLE_PLAIN)
+			{
+				_set_graph_pointers (pGraph, i, 0, 1);
+				glDrawArrays (GL_TRIANGLE_FAN, 0, 2*N + 2);
+			}
+			// outline, from the oldest value to the current one.
+			_set_graph_pointers (pGraph, i, 1 + 2*(c+1), 1);
+			glDrawArrays (GL_LINE_STRIP, 0, 2*(N-c-1) + 1);
+			_set_graph_pointers (pGraph, i, 1, 1);
+			glDrawArrays (GL_LINE_STRIP, 0, 2*(c+1));
+		}
+		else
+		{
+			iGraphTop = floor (iCurrentGraph * fHeight) + iMargin;
+			iGraphBottom = floor ((iCurrentGraph + 1) * fHeight) + iMargin;
+			
+			// place the slot of the current value at the right border, with the axis at the bottom of the graph.
+			glTranslatef (iMargin + w - .5 - iWidth/2.,
+				iHeight/2. - iGraphBottom + .5,
+				0.);
+			glScalef (1., iGraphBottom - iGraphTop - 1, 1.);
+			
+			glPushMatrix ();
+			glTranslatef (- c, 0., 0.);
+			_draw_graph_slots_opengl (pGraph, i, MAX (0, c - n + 1), c);  // most recent values.
+			glPopMatrix ();
+			
+			if (c - n + 1 < 0)  // the oldest values are at the end of the buffer.
+			{
+				glTranslatef (- c - N, 0., 0.);
+				_draw_graph_slots_opengl (pGraph, i, N + c - n + 1, N);
+			}
+		}
+		glPopMatrix ();
+	}
+	
+	if (pGraph->iVertexBuffer != 0)
+		glBindBuffer (GL_ARRAY_BUFFER, 0);
+	glDisableClientState (GL_COLOR_ARRAY);
+	glDisableClientState (GL_VERTEX_ARRAY);
+	glDisable (GL_LINE_SMOOTH);
+	glDisable (GL_BLEND);
+	glColor4f (1., 1., 1., 1.);  // the color array has modified the current color.
+	
+	//\________________ draw the overlays.
+	for (i = 0; i < iNbValues; i ++)
+	{
+		cairo_dock_render_overlays_to_texture (pRenderer, i);
+	}
 }
-*/
 
 static inline cairo_surface_t *_cairo_dock_create_graph_background (double fWidth, double fHeight, int iMargin, gdouble *pBackGroundColor, CairoDockTypeGraph iType, int iNbDrawings)
 {
@@ -471,7 +737,7 @@ static void load (Graph *pGraph, G_GNUC_UNUSED Icon *pIcon, CairoGraphAttribute
 		pGraph->fBackGroundColor,
 		pGraph->iType,
 		iNbValues / pRenderer->iRank);
-	if (g_bUseOpenGL && 0)
+	if (g_bUseOpenGL)
 		pGraph->iBackgroundTexture = cairo_dock_create_texture_from_surface (pGraph->pBackgroundSurface);
 	
 	// on complete le data-renderer.
@@ -490,7 +756,7 @@ static void reload (Graph *pGraph)
 	pGraph->pBackgroundSurface = _cairo_dock_create_graph_background (iWidth, iHeight, pGraph->iMargin, pGraph->fBackGroundColor, pGraph->iType, iNbValues / pRenderer->iRank);
 	if (pGraph->iBackgroundTexture != 0)
 		_cairo_dock_delete_texture (pGraph->iBackgroundTexture);
-	if (g_bUseOpenGL && 0)
+	if (g_bUseOpenGL)
 		pGraph->iBackgroundTexture = cairo_dock_create_texture_from_surface (pGraph->pBackgroundSurface);
 	else
 		pGraph->iBackgroundTexture = 0;
@@ -516,6 +782,10 @@ static void unload (Graph *pGraph)
 		cairo_surface_destroy (pGraph->pBackgroundSurface);
 	if (pGraph->iBackgroundTexture != 0)
 		_cairo_dock_delete_texture (pGraph->iBackgroundTexture);
+	if (pGraph->iVertexBuffer != 0)
+		glDeleteBuffers (1, &pGraph->iVertexBuffer);
+	g_free (pGraph->pVertices);
+	g_free (pGraph->pUploadedMinMax);
 	
 	CairoDataRenderer *pRenderer = CAIRO_DATA_RENDERER (pGraph);
 	int iNbValues = cairo_data_renderer_get_nb_values (pRenderer);
@@ -544,7 +814,7 @@ void cairo_dock_register_data_renderer_graph (void)
 	// fill the properties we need
 	pRecord->interface.load              = (CairoDataRendererLoadFunc) load;
 	pRecord->interface.render            = (CairoDataRendererRenderFunc) render;
-	pRecord->interface.render_opengl     = (CairoDataRendererRenderOpenGLFunc) NULL;
+	pRecord->interface.render_opengl     = (CairoDataRendererRenderOpenGLFunc) render_opengl;
 	pRecord->interface.reload            = (CairoDataRendererReloadFunc) reload;
 	pRecord->interface.unload            = (CairoDataRendererUnloadFunc) unload;
 	pRecord->iStructSize                 = sizeof (Graph);
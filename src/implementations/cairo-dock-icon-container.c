@@ -32,6 +32,7 @@
 #include "cairo-dock-separator-manager.h"
 #include "cairo-dock-backends-manager.h"
 #include "cairo-dock-icon-facility.h"
+#include "cairo-dock-icon-factory.h"  // cairo_dock_get_subdock_tile
 #include "cairo-dock-icon-container.h"
 
 CairoDockImageBuffer g_pBoxAboveBuffer;
@@ -45,28 +46,22 @@ extern gboolean g_bUseOpenGL;
 static void _cairo_dock_draw_subdock_content_as_emblem (Icon *pIcon, G_GNUC_UNUSED GldiContainer *pContainer, int w, int h, cairo_t *pCairoContext)
 {
 	//\______________ On dessine les 4 premieres icones du sous-dock en embleme.
-	int wi, hi;
 	int i;
 	Icon *icon;
 	GList *ic;
+	cairo_surface_t *pTile;
 	for (ic = pIcon->pSubDock->icons, i = 0; ic != NULL && i < 4; ic = ic->next)
 	{
 		icon = ic->data;
 		if (GLDI_OBJECT_IS_SEPARATOR_ICON (icon) || icon->image.pSurface == NULL)
 			continue;
 		
-		cairo_dock_get_icon_extent (icon, &wi, &hi);
-		// we could use cairo_dock_print_overlay_on_icon_from_surface (pIcon, icon->image.pSurface, wi, hi, i), but it's slightly optimized to draw it ourselves.
-		
-		cairo_save (pCairoContext);
-		cairo_translate (pCairoContext, (i&1) * w/2, (i/2) * h/2);
-		
-		cairo_scale (pCairoContext, .5 * w / wi, .5 * h / hi);
-		cairo_set_source_surface (pCairoContext, icon->image.pSurface, 0, 0);
+		pTile = cairo_dock_get_subdock_tile (pIcon, i, icon, w/2, h/2);  // only redrawn if this icon has changed.
+		if (pTile == NULL)
+			continue;
+		cairo_set_source_surface (pCairoContext, pTile, (i&1) * (w/2), (i/2) * (h/2));
 		cairo_paint (pCairoContext);
 		
-		cairo_restore (pCairoContext);
-		
 		i ++;
 	}
 }
@@ -93,10 +88,10 @@ static void _cairo_dock_draw_subdock_content_as_emblem_opengl (Icon *pIcon, G_GN
 static void _cairo_dock_draw_subdock_content_as_stack (Icon *pIcon, G_GNUC_UNUSED GldiContainer *pContainer, int w, int h, cairo_t *pCairoContext)
 {
 	//\______________ On dessine les 4 premieres icones du sous-dock en pile.
-	int wi, hi;
 	int i, k=0;
 	Icon *icon;
 	GList *ic;
+	cairo_surface_t *pTile;
 	for (ic = pIcon->pSubDock->icons, i = 0; ic != NULL && i < 3; ic = ic->next)
 	{
 		icon = ic->data;
@@ -120,17 +115,12 @@ static void _cairo_dock_draw_subdock_content_as_stack (Icon *pIcon, G_GNUC_UNUSE
 			default : break;
 		}
 		
-		cairo_dock_get_icon_extent (icon, &wi, &hi);
-		
-		cairo_save (pCairoContext);
-		cairo_translate (pCairoContext, k * w / 10, k * h / 10);
-		
-		cairo_scale (pCairoContext, .8 * w / wi, .8 * h / hi);
-		cairo_set_source_surface (pCairoContext, icon->image.pSurface, 0, 0);
+		pTile = cairo_dock_get_subdock_tile (pIcon, i, icon, .8 * w, .8 * h);
+		if (pTile == NULL)
+			continue;
+		cairo_set_source_surface (pCairoContext, pTile, k * w / 10, k * h / 10);
 		cairo_paint (pCairoContext);
 		
-		cairo_restore (pCairoContext);
-		
 		i ++;
 	}
 }
@@ -191,7 +181,7 @@ static void _cairo_dock_load_box_surface (void)
 		cUserPath ? cUserPath : GLDI_SHARE_DATA_DIR"/icons/box-front.png",
 		iSizeWidth,
 		iSizeHeight,
-		CAIRO_DOCK_FILL_SPACE);
+		CAIRO_DOCK_FILL_SPACE | CAIRO_DOCK_STATIC_IMAGE);
 	
 	cUserPath = cairo_dock_generate_file_path ("box-back");
 	if (! g_file_test (cUserPath, G_FILE_TEST_EXISTS))
@@ -203,7 +193,7 @@ static void _cairo_dock_load_box_surface (void)
 		cUserPath ? cUserPath : GLDI_SHARE_DATA_DIR"/icons/box-back.png",
 		iSizeWidth,
 		iSizeHeight,
-		CAIRO_DOCK_FILL_SPACE);
+		CAIRO_DOCK_FILL_SPACE | CAIRO_DOCK_STATIC_IMAGE);
 }
 
 static void _cairo_dock_unload_box_surface (void)
@@ -243,9 +233,9 @@ static void _cairo_dock_draw_subdock_content_as_box (Icon *pIcon, GldiContainer
 		.8);*/
 	int i;
 	double dx, dy;
-	int wi, hi;
 	Icon *icon;
 	GList *ic;
+	cairo_surface_t *pTile;
 	for (ic = pIcon->pSubDock->icons, i = 0; ic != NULL && i < 3; ic = ic->next, i++)
 	{
 		icon = ic->data;
@@ -272,17 +262,11 @@ static void _cairo_dock_draw_subdock_content_as_box (Icon *pIcon, GldiContainer
 				dx = - .1*i*h;
 		}
 		
-		cairo_dock_get_icon_extent (icon, &wi, &hi);
-		
-		cairo_save (pCairoContext);
-		cairo_translate (pCairoContext, dx, dy);
-		cairo_scale (pCairoContext, .8 * w / wi, .8 * h / hi);
-		cairo_set_source_surface (pCairoContext,
-			icon->image.pSurface,
-			0,
-			0);
+		pTile = cairo_dock_get_subdock_tile (pIcon, i, icon, .8 * w, .8 * h);
+		if (pTile == NULL)
+			continue;
+		cairo_set_source_surface (pCairoContext, pTile, dx, dy);
 		cairo_paint (pCairoContext);
-		cairo_restore (pCairoContext);
 	}
 	cairo_restore (pCairoContext);
 	
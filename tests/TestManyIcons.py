@@ -0,0 +1,46 @@
+from time import time
+import random
+from Test import Test
+
+# Insert a lot of icons in a dock in random order, and check that they end up in the right place
+class TestManyIcons(Test):
+	def __init__(self, dock):
+		self.nb_icons = 1000
+		Test.__init__(self, "Test many icons", dock)
+	
+	def run(self):
+		# add a new dock
+		conf_file = self.d.Add({'type':'Dock'})
+		props = self.d.GetProperties('config-file='+conf_file)
+		if len(props) == 0:
+			self.print_error ("Failed to add the dock")
+			self.end()
+			return
+		dock_name = props[0]['name']
+		
+		# insert the icons in random order, so that each one goes somewhere in the middle of the dock
+		orders = list(range(self.nb_icons))
+		random.shuffle(orders)
+		t = time()
+		for i in orders:
+			self.d.Add({'type':'Launcher', 'container':dock_name, 'name':'icon%d' % i, 'command':'true', 'order':str(i)})
+		dt = time() - t
+		print('['+self.name+'] %d icons inserted in %.2fs' % (self.nb_icons, dt))
+		
+		props = self.d.GetProperties('container='+dock_name)
+		if len(props) != self.nb_icons:
+			self.print_error ("Failed to add all the icons into the dock")
+		for p in props:  # each icon must be at the place given by its order, whatever the insertion order
+			if p['position'] != int(p['name'][len('icon'):]):
+				self.print_error ("Icon %s is at position %d" % (p['name'], p['position']))
+				break
+		
+		# remove the dock and its content
+		t = time()
+		self.d.Remove('config-file='+conf_file)
+		dt = time() - t
+		print('['+self.name+'] %d icons removed in %.2fs' % (self.nb_icons, dt))
+		if len (self.d.GetProperties('container='+dock_name)) != 0:
+			self.print_error ("Failed to remove the content of the dock")
+		
+		self.end()
@@ -0,0 +1,338 @@
+#!/usr/bin/env python3
+#
+# Headless benchmark of the dock.
+# It starts a virtual X server (Xvfb), launches the dock on a scripted copy of the default theme, opens N synthetic windows,
+# replays a pointer trace over the dock, and measures:
+#  - the startup time (until the main dock is drawn once the theme is completely loaded),
+#  - the frame times and the frame intervals (percentiles), when the dock is idle and when it's animated,
+#  - the time spent to compute the layout of the docks,
+#  - the time spent to draw the data-renderers (gauges, graphs, etc) on each update, if an applet uses one (e.g. --modules 'System-Monitor'),
+#  - the CPU usage when idle and when active,
+#  - the memory usage (RSS and peak RSS).
+# The results are printed in JSON, so that they can be compared between 2 commits.
+#
+# The timings come from the trace of the dock (option --trace, dumped on SIGUSR2), so they don't depend on the D-Bus plug-in.
+# The share data and the plug-ins of the dock must be installed (make install), since the dock loads them from their installation path.
+#
+# Requires 'Xvfb', 'xdotool' and PyGObject; a window manager (openbox, metacity or xfwm4) is needed for the taskbar (--wm).
+#
+# Usage: ./benchmark.py [--dock path/to/cairo-dock] [--backend cairo|gl|both] [--windows N] [--trace file] [--output file.json]
+# From the build directory: make benchmark
+
+import argparse
+import json
+import os
+import shutil
+import signal
+import subprocess
+import sys
+import tempfile
+import time
+
+here = os.path.dirname(os.path.abspath(__file__))
+default_theme = os.path.join(here, '..', '..', 'data', 'themes', 'default-theme')
+display_num = 73  # arbitrary, unlikely to be used
+screen_size = (1280, 800)
+
+  ###############
+ ### HELPERS ###
+###############
+
+def now_us():
+	return int(time.monotonic() * 1e6)  # same clock as g_get_monotonic_time()
+
+def percentiles(values, ps=(50, 90, 95, 99)):
+	if not values:
+		return None
+	v = sorted(values)
+	res = {'n': len(v), 'min': v[0], 'max': v[-1], 'mean': round(sum(v) / float(len(v)), 1)}
+	for p in ps:
+		res['p%d' % p] = v[min(len(v) - 1, int(round(p / 100. * (len(v) - 1))))]
+	return res
+
+def cpu_time(pid):  # in s
+	with open('/proc/%d/stat' % pid) as f:
+		fields = f.read().rsplit(')', 1)[1].split()
+	return (int(fields[11]) + int(fields[12])) / float(os.sysconf('SC_CLK_TCK'))  # utime + stime
+
+def memory(pid):  # in kB
+	res = {}
+	with open('/proc/%d/status' % pid) as f:
+		for line in f:
+			if line.startswith('VmRSS:'):
+				res['rss_kb'] = int(line.split()[1])
+			elif line.startswith('VmHWM:'):
+				res['peak_rss_kb'] = int(line.split()[1])
+	return res
+
+def wait_for(predicate, timeout):
+	t0 = time.monotonic()
+	while time.monotonic() - t0 < timeout:
+		if predicate():
+			return True
+		time.sleep(.1)
+	return False
+
+def read_pointer_trace(path):
+	events = []
+	with open(path) as f:
+		for line in f:
+			line = line.strip()
+			if not line or line.startswith('#'):
+				continue
+			t, x, y = line.split()
+			events.append((int(t), float(x), float(y)))
+	return events
+
+def replay_pointer_trace(events, env):
+	# build an xdotool script and run it in one go, much more accurate than one process per movement.
+	script = []
+	last_t = 0
+	for t, x, y in events:
+		if t > last_t:
+			script.append('sleep %.3f' % ((t - last_t) / 1000.))
+			last_t = t
+		script.append('mousemove %d %d' % (x * (screen_size[0] - 1), y * (screen_size[1] - 1)))
+	subprocess.run(['xdotool', '-'], input='\n'.join(script).encode(), env=env, check=True)
+
+  #############
+ ### TRACE ###
+#############
+
+class Trace:
+	def __init__(self, path):
+		self.events = []  # (time, thread, name, a, b)
+		if not os.path.exists(path):
+			return
+		with open(path) as f:
+			for line in f:
+				if line.startswith('#'):
+					continue
+				fields = line.split()
+				if len(fields) == 5:
+					self.events.append((int(fields[0]), int(fields[1]), fields[2], int(fields[3]), int(fields[4])))
+		self.events.sort()
+
+	def merge(self, other):
+		seen = set(self.events)
+		self.events = sorted(self.events + [e for e in other.events if e not in seen])
+
+	def select(self, name, t_start=0, t_end=None):
+		return [e for e in self.events if e[2] == name and e[0] >= t_start and (t_end is None or e[0] <= t_end)]
+
+	def frame_stats(self, t_start, t_end):
+		draws = self.select('dock-draw', t_start, t_end)
+		intervals = []
+		last = {}  # per dock (its depth)
+		for t, _, _, depth, _ in draws:
+			if depth in last:
+				intervals.append(t - last[depth])
+			last[depth] = t
+		duration = max(1, t_end - t_start) / 1e6
+		return {
+			'fps': round(len(draws) / duration, 1),
+			'frame_time_us': percentiles([e[4] for e in draws]),
+			'frame_interval_us': percentiles(intervals),
+		}
+
+  #############
+ ### SETUP ###
+#############
+
+class Session:
+	def __init__(self, args, backend):
+		self.args = args
+		self.backend = backend
+		self.tmp = tempfile.mkdtemp(prefix='cairo-dock-bench-')
+		self.procs = []
+		self.env = dict(os.environ)
+		self.env['DISPLAY'] = ':%d' % display_num
+		self.env['TMPDIR'] = self.tmp  # the trace is dumped there
+		self.env.pop('DESKTOP_SESSION', None)  # same as the other tests: no desktop-specific behaviour
+		self.env.pop('WAYLAND_DISPLAY', None)
+		if backend == 'gl':  # software rendering, so that results don't depend on the GPU of the machine
+			self.env['LIBGL_ALWAYS_SOFTWARE'] = '1'
+			self.env['GALLIUM_DRIVER'] = 'llvmpipe'
+
+	def spawn(self, cmd, **kwargs):
+		p = subprocess.Popen(cmd, env=self.env, **kwargs)
+		self.procs.append(p)
+		return p
+
+	def start_x(self):
+		self.spawn(['Xvfb', ':%d' % display_num, '-screen', '0', '%dx%dx24' % screen_size, '+extension', 'GLX', '+render', '-noreset'],
+			stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+		if not wait_for(lambda: os.path.exists('/tmp/.X11-unix/X%d' % display_num), 10):
+			raise RuntimeError('Xvfb could not be started')
+		if self.args.wm:
+			for wm in ('openbox', 'metacity', 'xfwm4'):
+				if shutil.which(wm):
+					self.spawn([wm], stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+					time.sleep(1)
+					break
+			else:
+				print('no window manager found, the taskbar will stay empty', file=sys.stderr)
+
+	def setup_theme(self):
+		# a copy of the default theme, with a fixed set of applets so that results are comparable over time.
+		theme = os.path.join(self.tmp, 'current_theme')
+		shutil.copytree(self.args.theme, theme)
+		conf = os.path.join(theme, 'cairo-dock.conf')
+		with open(conf) as f:
+			lines = f.readlines()
+		with open(conf, 'w') as f:
+			for line in lines:
+				if line.startswith('modules='):
+					line = 'modules=%s\n' % self.args.modules
+				f.write(line)
+
+	def start_dock(self):
+		cmd = [self.args.dock, '-T', '-d', self.tmp, '--trace', '-c' if self.backend == 'cairo' else '-o']
+		if self.args.gl_only_images and self.backend == 'gl':
+			cmd.append('--gl-only-images')
+		if self.args.lazy_applets:
+			cmd.append('--lazy-applets')
+		if self.args.needle_frames:
+			cmd += ['--gauge-needle-frames', str(self.args.needle_frames)]
+		self.t_launch = now_us()
+		self.dock = self.spawn(cmd, stdout=subprocess.DEVNULL, stderr=open(os.path.join(self.tmp, 'dock.log'), 'w'))
+		self.trace_path = os.path.join(self.tmp, 'cairo-dock-trace-%d.txt' % self.dock.pid)
+		self.trace = Trace('')
+		# the dock creates an empty dump once it handles SIGUSR2; before that, the signal would kill it.
+		def ready():
+			self.check_dock()
+			return os.path.exists(self.trace_path)
+		if not wait_for(ready, 30):
+			raise RuntimeError('the trace of the dock was not enabled after 30s, see %s' % os.path.join(self.tmp, 'dock.log'))
+
+	def dump_trace(self):
+		# the rings are bounded, so we dump after each phase and merge.
+		if os.path.exists(self.trace_path):
+			os.remove(self.trace_path)
+		self.dock.send_signal(signal.SIGUSR2)
+		wait_for(lambda: os.path.exists(self.trace_path) and os.path.getsize(self.trace_path) > 0, 5)
+		time.sleep(.2)  # let it finish writing
+		self.trace.merge(Trace(self.trace_path))
+
+	def check_dock(self):
+		if self.dock.poll() is not None:
+			raise RuntimeError('the dock has quit (code %d), see %s' % (self.dock.returncode, os.path.join(self.tmp, 'dock.log')))
+
+	def stop(self):
+		for p in reversed(self.procs):
+			if p.poll() is None:
+				p.terminate()
+				try:
+					p.wait(5)
+				except subprocess.TimeoutExpired:
+					p.kill()
+		if not self.args.keep:
+			shutil.rmtree(self.tmp, ignore_errors=True)
+
+  ###########
+ ### RUN ###
+###########
+
+def measure_phase(session, duration, action=None):
+	pid = session.dock.pid
+	t_start = now_us()
+	cpu_start = cpu_time(pid)
+	if action:
+		action()
+	remaining = duration - (now_us() - t_start) / 1e6
+	if remaining > 0:
+		time.sleep(remaining)
+	t_end = now_us()
+	cpu = (cpu_time(pid) - cpu_start) / ((t_end - t_start) / 1e6) * 100
+	session.check_dock()
+	session.dump_trace()
+	res = session.trace.frame_stats(t_start, t_end)
+	res['duration_s'] = round((t_end - t_start) / 1e6, 2)
+	res['cpu_percent'] = round(cpu, 1)
+	res['layout_us'] = percentiles([e[4] for e in session.trace.select('dock-layout', t_start, t_end)])
+	res['data_render_us'] = percentiles([e[4] for e in session.trace.select('data-render', t_start, t_end)])
+	return res
+
+def run(args, backend):
+	session = Session(args, backend)
+	try:
+		session.start_x()
+		session.setup_theme()
+		session.start_dock()
+		# wait for the theme to be loaded and the main dock to be drawn with it (the frames drawn while it's loading don't count).
+		def drawn():
+			session.check_dock()
+			session.dump_trace()
+			loaded = session.trace.select('theme-loaded', session.t_launch)
+			return len(loaded) > 0 and len(session.trace.select('dock-draw', loaded[0][0])) > 0
+		if not wait_for(drawn, 60):
+			raise RuntimeError('the theme was not loaded and drawn after 60s')
+		theme_loaded = session.trace.select('theme-loaded', session.t_launch)[0][0]
+		first_draw = min(e[0] for e in session.trace.select('dock-draw', theme_loaded))
+		res = {'backend': backend, 'windows': args.windows, 'startup_ms': round((first_draw - session.t_launch) / 1000., 1)}
+		res['theme_loaded_ms'] = round((theme_loaded - session.t_launch) / 1000., 1)
+		res['startup_layout_us'] = percentiles([e[4] for e in session.trace.select('dock-layout', session.t_launch, first_draw)])
+
+		# let the dock settle down (lazy applets, icons loading), then measure it when nothing happens.
+		time.sleep(args.settle)
+		res['idle'] = measure_phase(session, args.idle)
+
+		# open the windows; the taskbar must insert them in the dock.
+		wins = None
+		if args.windows > 0:
+			t0 = now_us()
+			wins = session.spawn([sys.executable, os.path.join(here, 'synthetic_windows.py'), str(args.windows), str(args.classes), str(args.title_period)],
+				stdout=subprocess.PIPE, stderr=subprocess.DEVNULL)
+			wins.stdout.readline()  # 'ready'
+			time.sleep(args.settle)
+			res['windows_phase'] = measure_phase(session, args.idle)
+			res['windows_phase']['open_ms'] = round((now_us() - t0) / 1000., 1)
+
+		# move the pointer over the dock.
+		events = read_pointer_trace(args.trace)
+		res['active'] = measure_phase(session, events[-1][0] / 1000. if events else 0, lambda: replay_pointer_trace(events, session.env))
+		res['memory'] = memory(session.dock.pid)
+		return res
+	finally:
+		session.stop()
+
+def main():
+	parser = argparse.ArgumentParser(description='Headless benchmark of the dock.')
+	parser.add_argument('--dock', default='cairo-dock', help='path to the executable (default: cairo-dock)')
+	parser.add_argument('--backend', choices=('cairo', 'gl', 'both'), default='both', help='rendering backend; gl uses llvmpipe')
+	parser.add_argument('--gl-only-images', action='store_true', help='with the gl backend, keep the images of the icons on the graphic card only (compare the RSS with and without it)')
+	parser.add_argument('--lazy-applets', action='store_true', help="don't initialize the applets that are not visible on startup (compare startup_ms and theme_loaded_ms with and without it)")
+	parser.add_argument('--needle-frames', type=int, default=0, help='pre-render the needles of the gauges at N positions (compare data_render_us with and without it, with a gauge applet in --modules, e.g. System-monitor)')
+	parser.add_argument('--windows', type=int, default=30, help='number of synthetic windows')
+	parser.add_argument('--classes', type=int, default=6, help='number of different classes among the windows')
+	parser.add_argument('--title-period', type=int, default=250, help='period of the title changes, in ms')
+	parser.add_argument('--trace', default=os.path.join(here, 'traces', 'sweep.trace'), help='pointer trace to replay (see record_pointer.py)')
+	parser.add_argument('--theme', default=default_theme, help='theme to start from')
+	parser.add_argument('--modules', default='Animated icons;illusion;showDesktop', help='applets to activate')
+	parser.add_argument('--idle', type=float, default=5., help='duration of the idle phases, in s')
+	parser.add_argument('--settle', type=float, default=3., help='time to wait before each phase, in s')
+	parser.add_argument('--no-wm', dest='wm', action='store_false', help="don't start a window manager")
+	parser.add_argument('--keep', action='store_true', help='keep the temporary directory (logs, traces)')
+	parser.add_argument('--output', help='also write the results into this file')
+	args = parser.parse_args()
+
+	backends = ('cairo', 'gl') if args.backend == 'both' else (args.backend,)
+	results = {'date': time.strftime('%Y-%m-%d %H:%M:%S'), 'screen': '%dx%d' % screen_size, 'runs': []}
+	failed = False
+	for backend in backends:
+		try:
+			results['runs'].append(run(args, backend))
+		except Exception as e:
+			print('%s: %s' % (backend, e), file=sys.stderr)
+			results['runs'].append({'backend': backend, 'error': str(e)})
+			failed = True
+
+	out = json.dumps(results, indent=2)
+	print(out)
+	if args.output:
+		with open(args.output, 'w') as f:
+			f.write(out + '\n')
+	sys.exit(1 if failed else 0)
+
+if __name__ == '__main__':
+	main()
@@ -0,0 +1,44 @@
+#!/usr/bin/env python3
+#
+# Record the movements of the pointer into a trace that can be replayed by benchmark.py.
+# Each line is: <time in ms> <x> <y>, with x and y relative to the size of the screen (0..1), so that a trace can be replayed on any screen.
+#
+# Usage: ./record_pointer.py <output file> [duration in s]
+#
+# Requires 'xdotool' and 'xdpyinfo'.
+
+import sys
+import subprocess
+import time
+
+def screen_size():
+	out = subprocess.check_output(['xdpyinfo']).decode()
+	for line in out.splitlines():
+		if 'dimensions:' in line:
+			w, h = line.split()[1].split('x')
+			return int(w), int(h)
+	raise RuntimeError('could not get the size of the screen')
+
+def pointer_position():
+	out = subprocess.check_output(['xdotool', 'getmouselocation', '--shell']).decode()
+	pos = dict(l.split('=') for l in out.split())
+	return int(pos['X']), int(pos['Y'])
+
+if __name__ == '__main__':
+	if len(sys.argv) < 2:
+		print('Usage: %s <output file> [duration in s]' % sys.argv[0])
+		sys.exit(1)
+	duration = float(sys.argv[2]) if len(sys.argv) > 2 else 10.
+	w, h = screen_size()
+	print('recording for %.0fs...' % duration)
+	with open(sys.argv[1], 'w') as f:
+		f.write('# time(ms) x y (relative to the screen)\n')
+		t0 = time.monotonic()
+		last = None
+		while time.monotonic() - t0 < duration:
+			x, y = pointer_position()
+			if (x, y) != last:
+				f.write('%d %.4f %.4f\n' % ((time.monotonic() - t0) * 1000, float(x) / w, float(y) / h))
+				last = (x, y)
+			time.sleep(1. / 60)
+	print('done')
@@ -0,0 +1,52 @@
+#!/usr/bin/env python3
+#
+# Open N client windows with an icon and a title that keeps changing, so that the taskbar of the dock has something to do.
+# Windows are spread over a few classes, so that some of them get grouped.
+#
+# Usage: ./synthetic_windows.py [nb windows] [nb classes] [title period in ms]
+#
+# Requires PyGObject (Gtk 3).
+
+import sys
+import gi
+gi.require_version('Gtk', '3.0')
+gi.require_version('GdkPixbuf', '2.0')
+from gi.repository import Gtk, GdkPixbuf, GLib
+
+nb_windows = int(sys.argv[1]) if len(sys.argv) > 1 else 20
+nb_classes = int(sys.argv[2]) if len(sys.argv) > 2 else 5
+period = int(sys.argv[3]) if len(sys.argv) > 3 else 250
+
+windows = []
+counter = [0]
+
+def make_icon(i):
+	# a plain square of a color specific to the class
+	pixbuf = GdkPixbuf.Pixbuf.new(GdkPixbuf.Colorspace.RGB, True, 8, 48, 48)
+	r = (97 * i) % 256
+	g = (57 * i + 80) % 256
+	b = (31 * i + 160) % 256
+	pixbuf.fill((r << 24) | (g << 16) | (b << 8) | 0xff)
+	return pixbuf
+
+def change_titles():
+	# change the title of one window out of 4 each time, like busy applications would do (terminals, players, browsers).
+	counter[0] += 1
+	for i in range(counter[0] % 4, len(windows), 4):
+		windows[i].set_title('bench window %d - %d%%' % (i, (counter[0] + i) % 100))
+	return True
+
+for i in range(nb_windows):
+	c = i % nb_classes
+	w = Gtk.Window()
+	w.set_wmclass('bench-app-%d' % c, 'Bench-app-%d' % c)
+	w.set_title('bench window %d' % i)
+	w.set_icon(make_icon(c))
+	w.set_default_size(200, 100)
+	w.move(50 + 10 * i, 50 + 10 * i)
+	w.show()
+	windows.append(w)
+
+GLib.timeout_add(period, change_titles)
+print('ready', flush=True)  # let the benchmark know the windows are mapped
+Gtk.main()
@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+#
+# Test of the HTTP cache of the dock (cairo_dock_get_cached_url_file, in cairo-dock-packages.c), against a local stand-in of the themes server.
+# The server serves a few files with an ETag and/or a Last-Modified date, answers "304 Not Modified" to conditional requests, and records every request and the connection it came from.
+# The functions are called directly in libgldi (ctypes), with a temporary cache directory (XDG_CACHE_HOME); no X server or D-Bus is needed.
+#
+# Usage: ./test_http_cache.py [--lib path/to/libgldi.so]
+# From the build directory: make test-http-cache
+
+import argparse
+import ctypes
+import ctypes.util
+import hashlib
+import os
+import shutil
+import socket
+import sys
+import tempfile
+import threading
+from email.utils import formatdate
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+  #######################
+ ### STAND-IN SERVER ###
+#########################
+
+class Handler(BaseHTTPRequestHandler):
+	protocol_version = 'HTTP/1.1'  # keep-alive, so that the reuse of the connections can be checked
+
+	def do_GET(self):
+		srv = self.server
+		srv.connections.add(self.connection)
+		f = srv.files.get(self.path)
+		if f is None:
+			status = 404
+		else:
+			status = 200
+			inm = self.headers.get('If-None-Match')
+			ims = self.headers.get('If-Modified-Since')
+			if inm is not None and 'etag' in f:
+				if inm == f['etag']:
+					status = 304
+			elif ims is not None and 'date' in f and ims == f['date']:
+				status = 304
+		srv.requests.append({'path': self.path, 'status': status, 'connection': id(self.connection),
+			'if-none-match': self.headers.get('If-None-Match'), 'if-modified-since': self.headers.get('If-Modified-Since')})
+
+		body = f['content'] if status == 200 else (b'' if status == 304 else b'<!DOCTYPE html><p>Not Found</p>')
+		self.send_response(status)
+		if f is not None:
+			if 'etag' in f:
+				self.send_header('ETag', f['etag'])
+			if 'date' in f:
+				self.send_header('Last-Modified', f['date'])
+		if status != 304:
+			self.send_header('Content-Length', str(len(body)))
+		self.end_headers()
+		self.wfile.write(body)
+
+	def log_message(self, *args):
+		pass
+
+class Server:
+	def __init__(self):
+		self.httpd = ThreadingHTTPServer(('127.0.0.1', 0), Handler)
+		self.httpd.daemon_threads = True
+		self.httpd.files = {}
+		self.httpd.requests = []
+		self.httpd.connections = set()
+		self.url = 'http://127.0.0.1:%d' % self.httpd.server_address[1]
+		self.thread = threading.Thread(target=self.httpd.serve_forever)
+		self.thread.start()
+
+	def set_file(self, path, content, etag=True, date=True):
+		f = {'content': content}
+		if etag:
+			f['etag'] = '"%s"' % hashlib.md5(content).hexdigest()
+		if date:
+			f['date'] = formatdate(usegmt=True)
+		self.httpd.files[path] = f
+
+	def last_request(self):
+		return self.httpd.requests[-1]
+
+	def nb_connections(self):
+		return len(set(r['connection'] for r in self.httpd.requests))
+
+	def stop(self):
+		self.httpd.shutdown()
+		self.httpd.server_close()
+		for s in self.httpd.connections:  # also close the kept-alive connections, so that the server is really unreachable
+			try:
+				s.shutdown(socket.SHUT_RDWR)
+			except OSError:
+				pass
+		self.thread.join()
+
+  ############
+ ### TEST ###
+############
+
+class TestHttpCache:
+	def __init__(self, lib, cache_dir):
+		self.name = 'TestHttpCache'
+		self.error = 0
+		self.cache_dir = cache_dir
+		self.gldi = ctypes.CDLL(lib)
+		self.gldi.cairo_dock_get_cached_url_file.restype = ctypes.c_void_p
+		self.gldi.cairo_dock_get_cached_url_file.argtypes = [ctypes.c_char_p, ctypes.c_void_p]
+		self.gldi.g_free.argtypes = [ctypes.c_void_p]
+
+	def get(self, url):
+		ptr = self.gldi.cairo_dock_get_cached_url_file(url.encode(), None)
+		if not ptr:
+			return None
+		path = ctypes.string_at(ptr).decode()
+		self.gldi.g_free(ptr)
+		return path
+
+	def check(self, cond, err):
+		if not cond:
+			print('['+self.name+'] '+err)
+			self.error = 1
+
+	def check_file(self, path, content):
+		self.check(path is not None, 'no file returned')
+		if path is None:
+			return
+		self.check(os.path.dirname(path) == os.path.join(self.cache_dir, 'cairo-dock', 'http', 'objects'), 'the file is not in the cache (%s)' % path)
+		self.check(os.path.basename(path) == hashlib.sha1(content).hexdigest(), 'the file is not stored under its checksum (%s)' % path)
+		with open(path, 'rb') as f:
+			self.check(f.read() == content, 'wrong content in %s' % path)
+
+	def run(self):
+		srv = Server()
+		try:
+			self.run_with_server(srv)
+		finally:
+			srv.stop()
+
+		# the server is gone: the cached copy is used, and a file that was never downloaded fails.
+		path = self.get(srv.url + '/themes/list.conf')
+		self.check_file(path, b'#!CD\n[Theme2]\n')
+		self.check(self.get(srv.url + '/themes/unknown') is None, 'a file was returned while the server is unreachable')
+
+		if self.error == 0:
+			print('['+self.name+'] \033[32msuccess\033[m')
+		else:
+			print('['+self.name+'] \033[31merror\033[m')
+		return self.error
+
+	def run_with_server(self, srv):
+		# first access: downloaded and stored under its checksum.
+		srv.set_file('/themes/list.conf', b'#!CD\n[Theme1]\n')
+		path1 = self.get(srv.url + '/themes/list.conf')
+		self.check(srv.last_request()['status'] == 200, 'the file was not downloaded')
+		self.check_file(path1, b'#!CD\n[Theme1]\n')
+
+		# second access: revalidated with the ETag, not downloaded again.
+		path = self.get(srv.url + '/themes/list.conf')
+		req = srv.last_request()
+		self.check(req['if-none-match'] == srv.httpd.files['/themes/list.conf']['etag'], 'the ETag was not sent (%s)' % req['if-none-match'])
+		self.check(req['status'] == 304, 'the cached copy was not revalidated')
+		self.check(path == path1, 'the cached copy was not used')
+
+		# the file changes on the server: the new version replaces the previous one.
+		srv.set_file('/themes/list.conf', b'#!CD\n[Theme2]\n')
+		path2 = self.get(srv.url + '/themes/list.conf')
+		self.check(srv.last_request()['status'] == 200, 'the new version was not downloaded')
+		self.check_file(path2, b'#!CD\n[Theme2]\n')
+		self.check(not os.path.exists(path1), 'the previous version was not removed')
+
+		# a server that only gives a date: revalidated with If-Modified-Since.
+		srv.set_file('/themes/Theme2/preview', b'\x89PNG fake preview', etag=False)
+		path = self.get(srv.url + '/themes/Theme2/preview')
+		self.get(srv.url + '/themes/Theme2/preview')
+		req = srv.last_request()
+		self.check(req['if-modified-since'] == srv.httpd.files['/themes/Theme2/preview']['date'], 'the date was not sent (%s)' % req['if-modified-since'])
+		self.check(req['status'] == 304, 'the cached copy was not revalidated with its date')
+
+		# the same content under 2 URLs is stored once.
+		srv.set_file('/themes/Theme3/preview', b'\x89PNG fake preview')
+		path3 = self.get(srv.url + '/themes/Theme3/preview')
+		self.check(path3 == path, 'the same content was stored twice')
+
+		# a missing file is an error, and is not cached.
+		self.check(self.get(srv.url + '/themes/Theme4/preview') is None, 'a missing file was returned')
+
+		# all the requests went through the same connection.
+		if curl_version() >= (7, 57):
+			self.check(srv.nb_connections() == 1, 'the connection was not reused (%d connections)' % srv.nb_connections())
+
+def curl_version():
+	lib = ctypes.CDLL(ctypes.util.find_library('curl'))
+	lib.curl_version.restype = ctypes.c_char_p
+	v = lib.curl_version().decode().split()[0].split('/')[1]  # "libcurl/7.81.0 ..."
+	return tuple(int(x) for x in v.split('.')[:2])
+
+  ############
+ ### MAIN ###
+############
+
+if __name__ == '__main__':
+	parser = argparse.ArgumentParser(description='Test of the HTTP cache of the dock.')
+	parser.add_argument('--lib', default=ctypes.util.find_library('gldi'), help='path to libgldi')
+	args = parser.parse_args()
+	if args.lib is None:
+		sys.exit('libgldi not found, use --lib')
+
+	cache_dir = tempfile.mkdtemp(prefix='cairo-dock-cache-')
+	os.environ['XDG_CACHE_HOME'] = cache_dir  # before the first call to g_get_user_cache_dir()
+	try:
+		r = TestHttpCache(args.lib, cache_dir).run()
+	finally:
+		shutil.rmtree(cache_dir)
+	sys.exit(r)
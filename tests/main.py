@@ -23,6 +23,7 @@ from TestStackIcon import TestStackIcon
 from TestTaskbar import TestTaskbar, TestTaskbar2
 from TestIconManager import TestIconManager
 from TestDesklet import TestDesklet
+from TestManyIcons import TestManyIcons
 
 from CairoDock import CairoDock
 dock = CairoDock()
@@ -54,6 +55,8 @@ if __name__ == '__main__':
 			TestIconManager(dock).run()
 		elif sys.argv[1] == "TestDesklet":
 			TestDesklet(dock).run()
+		elif sys.argv[1] == "TestManyIcons":
+			TestManyIcons(dock).run()
 		else:
 			print ("Unknown test")
 	else:  # run them all